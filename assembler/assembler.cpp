@@ -8,6 +8,7 @@
 #include <filesystem>
 #include <map>
 #include <string_view> // NEW: For efficient prefix checking
+#include <charconv>
 
 using namespace std;
 
@@ -25,24 +26,39 @@ unordered_map<string, int> rTypeFunctMap = {
     {"add", 0b0000}, {"sub", 0b0001}, {"mul", 0b0010},
     {"div", 0b0011}, {"slt", 0b0100}, {"sll", 0b0101},
     {"seq", 0b0110}, {"snez", 0b0111}, {"min", 0b1000},
-    {"abs", 0b1001}, {"neg", 0b1011}
+    {"abs", 0b1001}, {"neg", 0b1011}, {"shfl.down", 0b1100},
+    {"shfl.xor", 0b1101}, {"mulq", 0b1010}, {"sra", 0b1110}
 };
 
 unordered_map<string, int> iTypeFunctMap = {
     {"addi", 0b0000}, {"muli", 0b0010}, {"slli", 0b1010},
-    {"divi", 0b0011}, {"seqi", 0b1011}
+    {"divi", 0b0011}, {"seqi", 0b1011}, {"shfl.downi", 0b1100},
+    {"shfl.xori", 0b1101}, {"srai", 0b0100}
 };
 
 unordered_map<string, int> fTypeFunctMap = {
     {"fadd.s", 0b0000}, {"fsub.s", 0b0001}, {"fmul.s", 0b0010},
     {"fdiv.s", 0b0011}, {"flt.s", 0b0100}, {"fneg.s", 0b0101},
     {"feq.s",  0b0110}, {"fmin.s", 0b0111}, {"fabs.s", 0b1000},
-    {"fcvt.w.s", 0b1001}, {"fcvt.s.w", 0b1010}
+    {"fcvt.w.s", 0b1001}, {"fcvt.s.w", 0b1010}, {"fshfl.down.s", 0b1100},
+    {"fshfl.xor.s", 0b1101}, {"fmadd.s", 0b1110}, {"fmsub.s", 0b1111},
+    {"fabsdiff.s", 0b1011}, {"fsqdiff.s", 0b1011}, {"fminidx.s", 0b1011},
+    {"fadd.bf2", 0b1011}, {"fsub.bf2", 0b1011}, {"fmul.bf2", 0b1011},
+    {"fsqdiff.bf2", 0b1011}, {"fmin.bf2", 0b1011}, {"fcvt.bf2.s", 0b1011},
+    {"fcvt.s.bf2.lo", 0b1011}, {"fcvt.s.bf2.hi", 0b1011}
+};
+
+// Extended F-type ops share funct4 1011, funct5 in [23:19] selects the op
+unordered_map<string, int> fTypeExtFunctMap = {
+    {"fabsdiff.s", 0b00000}, {"fsqdiff.s", 0b00001}, {"fminidx.s", 0b00010},
+    {"fadd.bf2", 0b00011}, {"fsub.bf2", 0b00100}, {"fmul.bf2", 0b00101},
+    {"fsqdiff.bf2", 0b00110}, {"fmin.bf2", 0b00111}, {"fcvt.bf2.s", 0b01000},
+    {"fcvt.s.bf2.lo", 0b01001}, {"fcvt.s.bf2.hi", 0b01010}
 };
 
 unordered_map<string, int> cTypeFunctMap = {
     {"j", 0b000}, {"beqz", 0b001}, {"beqo", 0b010},
-    {"ret", 0b011}, {"sync", 0b110}, {"exit", 0b111}
+    {"ret", 0b011}, {"gsync", 0b100}, {"sync", 0b110}, {"exit", 0b111}
 };
 
 unordered_map<string, int> xTypeFunctMap = {
@@ -189,7 +205,7 @@ uint32_t encodeFType(string op, const vector<string>& args, bool is_scalar) {
     int opcode = 0b010;
     uint32_t scalar_bit = is_scalar ? 1 : 0;
     int funct4 = fTypeFunctMap[op];
-    int rd = 0, rs1 = 0, rs2 = 0;
+    int rd = 0, rs1 = 0, rs2 = 0, rs3 = 0;
 
     // Determine the register map to use for each operand based on instruction and scalar flag
     auto get_int_reg = [&](const string& reg_name) {
@@ -200,8 +216,10 @@ uint32_t encodeFType(string op, const vector<string>& args, bool is_scalar) {
     };
     
     // Ensure correct number of arguments based on the operation
-    if (op == "fneg.s" || op == "fabs.s" || op == "fcvt.w.s" || op == "fcvt.s.w") {
+    if (op == "fneg.s" || op == "fabs.s" || op == "fcvt.w.s" || op == "fcvt.s.w" || op == "fcvt.s.bf2.lo" || op == "fcvt.s.bf2.hi") {
          if (args.size() != 3) { cerr << "Error: Instruction '" << op << "' expects 2 register arguments." << endl; return 0; }
+    } else if (op == "fmadd.s" || op == "fmsub.s") { // R4-type fused multiply-add
+         if (args.size() != 5) { cerr << "Error: Instruction '" << op << "' expects 4 register arguments." << endl; return 0; }
     } else { // Binary float ops, comparisons
          if (args.size() != 4) { cerr << "Error: Instruction '" << op << "' expects 3 register arguments." << endl; return 0; }
     }
@@ -227,6 +245,20 @@ uint32_t encodeFType(string op, const vector<string>& args, bool is_scalar) {
         rd = get_float_reg(args[1]);
         rs1 = get_float_reg(args[2]);
         rs2 = get_float_reg(args[3]);
+    } else if (fTypeExtFunctMap.count(op)) { // Extended Float Ops: rd (Float), rs1 (Float), rs2 (Float, not for unpacks), funct5 in the rs3 field
+        rd = get_float_reg(args[1]);
+        rs1 = get_float_reg(args[2]);
+        rs2 = args.size() > 3 ? get_float_reg(args[3]) : 0;
+        rs3 = fTypeExtFunctMap.at(op);
+    } else if (op == "fmadd.s" || op == "fmsub.s") { // Fused Ops: rd = rs1 * rs2 +/- rs3, all Float
+        rd = get_float_reg(args[1]);
+        rs1 = get_float_reg(args[2]);
+        rs2 = get_float_reg(args[3]);
+        rs3 = get_float_reg(args[4]);
+    } else if (op == "fshfl.down.s" || op == "fshfl.xor.s") { // Lane exchange: rd (Float), rs1 (Float), rs2 (Int lane offset)
+        rd = get_float_reg(args[1]);
+        rs1 = get_float_reg(args[2]);
+        rs2 = get_int_reg(args[3]);
     } else {
         // This case should ideally not be reached if the map lookup works,
         // but serves as a fallback error.
@@ -234,7 +266,7 @@ uint32_t encodeFType(string op, const vector<string>& args, bool is_scalar) {
         return 0;
     }
 
-    return (opcode << 29) | (scalar_bit << 28) | (rs2 << 14) | (funct4 << 10) | (rs1 << 5) | rd;
+    return (opcode << 29) | (scalar_bit << 28) | (rs3 << 19) | (rs2 << 14) | (funct4 << 10) | (rs1 << 5) | rd;
 }
 
 uint32_t encodeLoad(string op, const vector<string>& args, bool is_scalar) {
@@ -246,12 +278,21 @@ uint32_t encodeLoad(string op, const vector<string>& args, bool is_scalar) {
     else if (op == "sw") funct3 = 0b001; // Note: encodeStore should handle this
     else if (op == "flw") funct3 = 0b010;
     else if (op == "fsw") funct3 = 0b011; // Note: encodeStore should handle this
+    else if (op == "lw.u") funct3 = 0b100;
+    else if (op == "flw.u") funct3 = 0b101;
     else { cerr << "Internal Error: Unknown load opcode '" << op << "'" << endl; return 0; }
 
+    // Uniform loads read one scalar address and broadcast the word to every lane
+    bool is_uniform = (op == "lw.u" || op == "flw.u");
+    if (is_uniform && is_scalar) {
+        cerr << "Error: Instruction '" << op << "' is vector only (use v." << op << ")." << endl;
+        return 0;
+    }
+
 
     // RD register is the destination register for loads
     int rd;
-    if (op == "flw") { // Float Load
+    if (op == "flw" || op == "flw.u") { // Float Load
         rd = is_scalar ? float_scalar_registerMap.at(args[0]) : float_vector_registerMap.at(args[0]);
     } else { // Integer Load (lw)
         rd = is_scalar ? int_scalar_registerMap.at(args[0])   : int_vector_registerMap.at(args[0]);
@@ -271,8 +312,8 @@ uint32_t encodeLoad(string op, const vector<string>& args, bool is_scalar) {
     
     // RS1 (base address register) is always an Integer Scalar register according to typical ISA practice and your M-type formats
     int rs1;
-    if (is_scalar) {
-        // For s.lw / s.flw, the base register MUST be a scalar integer register.
+    if (is_scalar || is_uniform) {
+        // For s.lw / s.flw (and v.lw.u / v.flw.u), the base register MUST be a scalar integer register.
         if (int_scalar_registerMap.find(rs1Str) == int_scalar_registerMap.end()) {
             cerr << "Error: Invalid base register for '" << op << "'. Must be a scalar int (e.g., sp, s0-s26). Found: '" << rs1Str << "'" << endl;
             return 0;
@@ -381,10 +422,10 @@ uint32_t encodeControl(string op, const vector<string>& args, int pc) {
         
         // Branch offsets are PC-relative and word addressed (offset / 4). Immediate is signed.
         // ISA format: Imm[17:8] at [28:19], Imm[7] at [13], Imm[6:2] at [4:0]
-        uint32_t imm = (offset>>2) & 0x3FFFF; // 18-bit offset in ISA (Imm[17:2])
+        uint32_t imm = (offset>>2) & 0xFFFF; // Imm[17:2], word offset
     
-        uint32_t imm_17_8 = (imm >> 8) & 0x3FF;   // bits [17:8] -> [28:19]
-        uint32_t imm_7    = (imm >> 7) & 0x1;     // bit [7]     -> [13] (Mistake in ISA table? Should be Imm[7] -> bit 13, but your table shows Imm[7] -> bit 13. It should be Imm[7] -> bit 13 or Imm[7] -> Imm[7]. Let's assume Imm[7] goes to bit 13)
+        uint32_t imm_17_8 = (imm >> 6) & 0x3FF;   // bits [17:8] -> [28:19]
+        uint32_t imm_7    = (imm >> 5) & 0x1;     // bit [7]     -> [13]
         uint32_t imm_6_2  = imm & 0x1F;           // bits [6:2]  -> [4:0]
         
         // Check if RS1 is actually zero (beqz x0, label is an unconditional branch in RISC-V)
@@ -395,7 +436,7 @@ uint32_t encodeControl(string op, const vector<string>& args, int pc) {
         return (opcode << 29)
              | (imm_17_8 << 19)
              | (rs2 << 14) // This field is RS2(x0) in ISA table, so hardcoded to 0
-             | (imm_7 << 13) // Assuming Imm[7] goes to bit 13
+             | (imm_7 << 13)
              | (funct3 << 10)
              | (rs1 << 5)
              | imm_6_2;
@@ -418,10 +459,10 @@ uint32_t encodeControl(string op, const vector<string>& args, int pc) {
         
         // Branch offsets are PC-relative and word addressed (offset / 4). Immediate is signed.
         // ISA format: Imm[17:8] at [28:19], Imm[7] at [13], Imm[6:2] at [4:0]
-        uint32_t imm = (offset>>2) & 0x3FFFF; // 18-bit offset in ISA (Imm[17:2])
+        uint32_t imm = (offset>>2) & 0xFFFF; // Imm[17:2], word offset
     
-        uint32_t imm_17_8 = (imm >> 8) & 0x3FF;   // bits [17:8] -> [28:19]
-        uint32_t imm_7    = (imm >> 7) & 0x1;     // bit [7]     -> [13] (Mistake in ISA table? Should be Imm[7] -> bit 13, but your table shows Imm[7] -> bit 13. It should be Imm[7] -> bit 13 or Imm[7] -> Imm[7]. Let's assume Imm[7] goes to bit 13)
+        uint32_t imm_17_8 = (imm >> 6) & 0x3FF;   // bits [17:8] -> [28:19]
+        uint32_t imm_7    = (imm >> 5) & 0x1;     // bit [7]     -> [13]
         uint32_t imm_6_2  = imm & 0x1F;           // bits [6:2]  -> [4:0]
         
         // Check if RS1 is actually zero (beqz x0, label is an unconditional branch in RISC-V)
@@ -432,7 +473,7 @@ uint32_t encodeControl(string op, const vector<string>& args, int pc) {
         return (opcode << 29)
              | (imm_17_8 << 19)
              | (rs2 << 14) // This field is RS2(x0) in ISA table, so hardcoded to 0
-             | (imm_7 << 13) // Assuming Imm[7] goes to bit 13
+             | (imm_7 << 13)
              | (funct3 << 10)
              | (rs1 << 5)
              | imm_6_2;
@@ -476,30 +517,18 @@ uint32_t encodeControl(string op, const vector<string>& args, int pc) {
     }
 
     if (op == "sync") {
-        if (args.size() != 2) { cerr << "Error: Instruction '" << op << "' expects 1 argument (label)." << endl; return 0; }
-        auto it = labelMap.find(args[1]);
-        if(it == labelMap.end()) { cerr << "Error: Undefined label '" << args[1] << "' for jump." << endl; return 0; }
-        uint32_t target = it->second + 4;
-        // int32_t offset = (target - pc);
-        // // Jumps are PC-relative and word addressed (offset / 4). Immediate is signed.
-        // uint32_t imm = (offset >> 2) & 0x3FFFFFF; // 26 bits used in ISA (Imm[27:2])
-        // uint32_t imm_27_12 = (imm >> 10) & 0xFFFF; // corresponds to Imm[27:12] -> bits [28:13]
-        // uint32_t imm_11_2 = imm & 0x3FF;          // corresponds to Imm[11:2] -> bits [9:0]
-        
-        // return (opcode << 29) | (imm_27_12 << 13) | (funct3 << 10) | imm_11_2;
-
-        // We will now forge the arguments for an 'addi s25, zero, <endsync_address>' instruction
-        vector<string> addi_args = {
-            "s25",                       // rd = s25
-            "zero",                      // rs1 = zero
-            to_string(target)   // immediate = address of ENDSYNC
-        };
-        
-        cout << " (interpreted as addi s25, zero, 0x" << hex << target << dec << ") -> ";
-
-        // Reuse the I-Type encoder to generate the instruction word
-        return encodeIType("addi", addi_args, true); // 'true' for scalar
+        // Block barrier: opcode | 16(x) | funct3 = 110 | 10(x)
+        // The compiler still names the instruction after the barrier (sync <endsync_label>),
+        // but the hardware simply resumes at pc + 1 once every warp of the block has arrived.
+        if (args.size() > 2) { cerr << "Error: Instruction '" << op << "' expects at most 1 argument (label)." << endl; return 0; }
+        if (args.size() == 2 && labelMap.find(args[1]) == labelMap.end()) { cerr << "Error: Undefined label '" << args[1] << "' for sync." << endl; return 0; }
+        return (opcode << 29) | (funct3 << 10);
+    }
 
+    if (op == "gsync") {
+        // Grid barrier: opcode | 16(x) | funct3 = 100 | 10(x), every warp of every block of the kernel has to arrive
+        if (args.size() != 1) { cerr << "Error: Instruction '" << op << "' expects no arguments." << endl; return 0; }
+        return (opcode << 29) | (funct3 << 10);
     }
 
 
@@ -605,6 +634,8 @@ int main() {
     ifstream input("assembler/compiler_output/kernel.asm");
     ofstream instrOut("assembler/compiler_output/kernel.instr.hex");
     ofstream dataOut("assembler/compiler_output/kernel.data.hex");
+    // Line map for the testbench profiler: one "<pc> <asm line> <c line>" row per instruction word
+    ofstream lineOut("assembler/compiler_output/kernel.lines");
 
     // Solely for running the test_assembler.py
     // // -- To handle automated testings of assembler --
@@ -641,7 +672,10 @@ int main() {
 
     vector<pair<int, string>> instructions;
     vector<pair<int, uint32_t>> data;
+    map<int, pair<int, int>> sourceLines; // instruction address -> (asm line, C line)
     string line;
+    int asm_line = 0;
+    int c_line = 0; // Set by the compiler's "# line <n>" markers, 0 before the first one
     uint32_t instr_pc = 0;
     uint32_t data_pc = 0;
 
@@ -649,9 +683,20 @@ int main() {
     string current_section = ".text";
     string pending_label = "";
     while (getline(input, line)) {
+        asm_line++;
         // Trim whitespace and remove comments
         line.erase(0, line.find_first_not_of(" \t"));
         line.erase(line.find_last_not_of(" \t") + 1);
+        // A "# line" comment that is not followed by just a number is an ordinary comment
+        if (line.rfind("# line ", 0) == 0) {
+            int marker_line;
+            const char* number_end = line.data() + line.size();
+            auto [parsed_end, error] = from_chars(line.data() + 7, number_end, marker_line);
+            if (error == errc() && parsed_end == number_end) {
+                c_line = marker_line;
+                continue;
+            }
+        }
         if (line.empty() || line[0] == '#') continue;
 
         // Handle section changes
@@ -720,6 +765,7 @@ int main() {
         } else if (current_section == ".text") {
             // Anything left on the line is an instruction
             instructions.emplace_back(instr_pc, line);
+            sourceLines[instr_pc] = {asm_line, c_line};
             instr_pc += 4;
         }
     }
@@ -752,6 +798,7 @@ int main() {
                 // This instruction is fully handled. Print and continue to the next one.
                 cout << "0x" << hex << setw(8) << setfill('0') << instr << dec << endl;
                 instrOut << hex << setw(8) << setfill('0') << instr << endl;
+                lineOut << (pc_addr >> 2) << " " << sourceLines[pc_addr].first << " " << sourceLines[pc_addr].second << endl;
                 continue; // <<< --- THE FIX
             } else {
                 cerr << "Unknown instruction: " << op_with_prefix << endl;
@@ -805,7 +852,7 @@ int main() {
         if (rTypeFunctMap.count(op)) instr = encodeRType(op, {tokens[1], tokens[2], tokens[3]}, is_scalar);
         else if (iTypeFunctMap.count(op)) instr = encodeIType(op, {tokens[1], tokens[2], tokens[3]}, is_scalar);
         else if (fTypeFunctMap.count(op)) instr = encodeFType(op, tokens, is_scalar); // F-type takes full tokens vector
-        else if (op == "lw" || op == "flw") instr = encodeLoad(op, {tokens[1], tokens[2]}, is_scalar);
+        else if (op == "lw" || op == "flw" || op == "lw.u" || op == "flw.u") instr = encodeLoad(op, {tokens[1], tokens[2]}, is_scalar);
         else if (op == "sw" || op == "fsw") instr = encodeStore(op, {tokens[1], tokens[2]}, is_scalar);
         else if (cTypeFunctMap.count(op) || op == "exit") {
             instr = encodeControl(op, tokens, pc_addr); // Control flow is always encoded as scalar operation
@@ -820,6 +867,7 @@ int main() {
         cout << "0x" << hex << setw(8) << setfill('0') << instr << dec << endl;
         instrOut << hex << setw(8) << setfill('0') << instr << endl;
         instrOut.flush();
+        lineOut << (pc_addr >> 2) << " " << sourceLines[pc_addr].first << " " << sourceLines[pc_addr].second << endl;
     }
 
     // Output data section
@@ -833,5 +881,6 @@ int main() {
     input.close();
     instrOut.close();
     dataOut.close();
+    lineOut.close();
     return 0;
 }
\ No newline at end of file
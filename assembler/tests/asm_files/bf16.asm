@@ -0,0 +1,16 @@
+v.flw fv1, 610(x29)
+v.flw fv2, 650(x29)
+v.fsqdiff.bf2 fv3, fv1, fv2
+v.fsw fv3, 900(x29)
+v.fcvt.s.bf2.lo fv4, fv3
+v.fcvt.s.bf2.hi fv5, fv3
+v.fadd.s fv6, fv4, fv5
+v.fsw fv6, 950(x29)
+s.li s1, 600
+s.flw fs1, 0(s1)
+s.flw fs2, 1(s1)
+s.fcvt.bf2.s fs3, fs1, fs2
+s.fsw fs3, 400(s1)
+s.fadd.bf2 fs4, fs3, fs3
+s.fsw fs4, 401(s1)
+exit
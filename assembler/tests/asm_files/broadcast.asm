@@ -0,0 +1,7 @@
+s.li s1, 600
+v.lw.u v1, 0(s1)
+v.flw.u fv1, 1(s1)
+v.add v2, v1, x29
+v.sw v2, 700(x29)
+v.fsw fv1, 750(x29)
+exit
\ No newline at end of file
@@ -0,0 +1,6 @@
+v.lw v1, 600(zero)
+v.lw v2, 610(x29)
+v.add v3, v1, v2
+v.sw v3, 700(x29)
+v.sw x29, 650(zero)
+exit
\ No newline at end of file
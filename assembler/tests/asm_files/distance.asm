@@ -0,0 +1,14 @@
+s.li s1, 600
+v.flw.u fv2, 0(s1)
+v.flw fv1, 610(x29)
+v.fabsdiff.s fv3, fv1, fv2
+v.fsw fv3, 900(x29)
+v.fsqdiff.s fv4, fv1, fv2
+v.fsw fv4, 950(x29)
+s.flw fs1, 0(s1)
+s.flw fs2, 1(s1)
+s.fsqdiff.s fs3, fs1, fs2
+s.fsw fs3, 400(s1)
+s.fabsdiff.s fs4, fs2, fs1
+s.fsw fs4, 401(s1)
+exit
@@ -0,0 +1,22 @@
+s.li s1, 600
+v.flw.u fv2, 0(s1)
+v.flw fv1, 610(x29)
+v.fmul.s fv3, fv1, fv2
+v.fsw fv3, 900(x29)
+s.flw fs1, 1(s1)
+s.flw fs2, 0(s1)
+s.flw fs4, 2(s1)
+s.fmul.s fs3, fs1, fs2
+s.fmul.s fs3, fs3, fs2
+s.fmul.s fs3, fs3, fs2
+s.fmul.s fs3, fs3, fs2
+s.fmul.s fs3, fs3, fs2
+s.fmul.s fs3, fs3, fs2
+s.fmul.s fs3, fs3, fs2
+s.fmul.s fs3, fs3, fs2
+s.fsw fs3, 400(s1)
+s.fmul.s fs5, fs4, fs2
+s.fsw fs5, 401(s1)
+s.fmul.s fs6, fs2, fs4
+s.fsw fs6, 402(s1)
+exit
@@ -0,0 +1,13 @@
+s.li s1, 600
+v.flw.u fv2, 0(s1)
+v.flw.u fv3, 1(s1)
+v.flw fv1, 610(x29)
+v.fmadd.s fv4, fv1, fv2, fv3
+v.fsw fv4, 900(x29)
+v.fmsub.s fv5, fv1, fv1, fv3
+v.fsw fv5, 950(x29)
+s.flw fs1, 0(s1)
+s.flw fs2, 1(s1)
+s.fmadd.s fs3, fs1, fs2, fs2
+s.fsw fs3, 400(s1)
+exit
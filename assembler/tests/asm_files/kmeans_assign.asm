@@ -0,0 +1,27 @@
+v.mul v1, x30, x31
+v.add v1, v1, x29
+v.flw fv1, 1024(v1)
+v.flw fv2, 2048(v1)
+s.li s1, 600
+v.flw.u fv3, 0(s1)
+v.flw.u fv4, 1(s1)
+v.fsqdiff.s fv5, fv1, fv3
+v.fsqdiff.s fv6, fv2, fv4
+v.fadd.s fv7, fv5, fv6
+v.li v2, 0
+v.flw.u fv3, 2(s1)
+v.flw.u fv4, 3(s1)
+v.fsqdiff.s fv5, fv1, fv3
+v.fsqdiff.s fv6, fv2, fv4
+v.fadd.s fv8, fv5, fv6
+v.li v3, 1
+v.fminidx.s fv7, fv8, fv7
+v.flw.u fv3, 4(s1)
+v.flw.u fv4, 5(s1)
+v.fsqdiff.s fv5, fv1, fv3
+v.fsqdiff.s fv6, fv2, fv4
+v.fadd.s fv8, fv5, fv6
+v.li v3, 2
+v.fminidx.s fv7, fv8, fv7
+v.sw v2, 3072(v1)
+exit
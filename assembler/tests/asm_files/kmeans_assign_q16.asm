@@ -0,0 +1,41 @@
+v.mul v1, x30, x31
+v.add v1, v1, x29
+v.lw v2, 1024(v1)
+v.lw v3, 2048(v1)
+s.li s1, 600
+v.lw.u v4, 0(s1)
+v.lw.u v5, 1(s1)
+v.sub v6, v2, v4
+v.mulq v6, v6, v6
+v.sub v7, v3, v5
+v.mulq v7, v7, v7
+v.add v8, v6, v7
+v.li v9, 0
+v.lw.u v4, 2(s1)
+v.lw.u v5, 3(s1)
+v.sub v6, v2, v4
+v.mulq v6, v6, v6
+v.sub v7, v3, v5
+v.mulq v7, v7, v7
+v.add v10, v6, v7
+v.slt v11, v10, v8
+v.min v8, v8, v10
+v.li v12, 1
+v.sub v12, v12, v9
+v.mul v12, v12, v11
+v.add v9, v9, v12
+v.lw.u v4, 4(s1)
+v.lw.u v5, 5(s1)
+v.sub v6, v2, v4
+v.mulq v6, v6, v6
+v.sub v7, v3, v5
+v.mulq v7, v7, v7
+v.add v10, v6, v7
+v.slt v11, v10, v8
+v.min v8, v8, v10
+v.li v12, 2
+v.sub v12, v12, v9
+v.mul v12, v12, v11
+v.add v9, v9, v12
+v.sw v9, 3072(v1)
+exit
@@ -0,0 +1,3304 @@
+s.li s0, 4648
+s.li sp, 4648
+s.addi sp, sp, -648
+s.sw ra, 644(sp)
+s.sw s0, 640(sp)
+s.addi s0, sp, 648
+# line 7
+# line 8
+# line 9
+# line 10
+# line 13
+# line 16
+# line 17
+# line 19
+# line 23
+# line 24
+# line 25
+# line 27
+# line 29
+# line 32
+# line 33
+# line 34
+# line 35
+# line 36
+# line 37
+# line 38
+# line 39
+# line 46
+s.li s3, 18056
+s.li s2, 18072
+s.sw s2, 0(s3)
+s.li s3, 17800
+s.li s2, 17816
+s.sw s2, 0(s3)
+s.li s3, 17544
+s.li s2, 17560
+s.sw s2, 0(s3)
+s.li s3, 17288
+s.li s2, 17304
+s.sw s2, 0(s3)
+s.li s3, 17032
+s.li s2, 17048
+s.sw s2, 0(s3)
+s.li s3, 16776
+s.li s2, 16792
+s.sw s2, 0(s3)
+s.li s3, 16520
+s.li s2, 16536
+s.sw s2, 0(s3)
+s.li s3, 16264
+s.li s2, 16280
+s.sw s2, 0(s3)
+s.li s3, 16008
+s.li s2, 16024
+s.sw s2, 0(s3)
+s.li s3, 15752
+s.li s2, 15768
+s.sw s2, 0(s3)
+s.li s3, 15496
+s.li s2, 15512
+s.sw s2, 0(s3)
+s.li s3, 15240
+s.li s2, 15256
+s.sw s2, 0(s3)
+s.li s3, 17944
+s.li s2, 15
+s.sw s2, 0(s3)
+s.li s3, 16664
+s.li s2, 15
+s.sw s2, 0(s3)
+s.li s3, 15384
+s.li s2, 1
+s.sw s2, 0(s3)
+s.li s3, 17952
+s.li s2, 0
+s.sw s2, 0(s3)
+s.li s3, 17688
+s.li s2, 0
+s.sw s2, 0(s3)
+s.li s3, 17432
+s.li s2, 1
+s.sw s2, 0(s3)
+s.li s3, 17176
+s.li s2, 2
+s.sw s2, 0(s3)
+s.li s3, 16920
+s.li s2, 3
+s.sw s2, 0(s3)
+s.li s3, 16672
+s.li s2, 1
+s.sw s2, 0(s3)
+s.li s3, 16408
+s.li s2, 0
+s.sw s2, 0(s3)
+s.li s3, 16152
+s.li s2, 1
+s.sw s2, 0(s3)
+s.li s3, 15896
+s.li s2, 2
+s.sw s2, 0(s3)
+s.li s3, 15640
+s.li s2, 3
+s.sw s2, 0(s3)
+s.li s3, 15392
+s.li s2, 2
+s.sw s2, 0(s3)
+s.li s3, 15128
+s.li s2, 0
+s.sw s2, 0(s3)
+s.li s3, 18060
+s.sw sp, 0(s3)
+s.li s3, 17804
+s.sw sp, 0(s3)
+s.li s3, 17548
+s.sw sp, 0(s3)
+s.li s3, 17292
+s.sw sp, 0(s3)
+s.li s3, 17036
+s.sw sp, 0(s3)
+s.li s3, 16780
+s.sw sp, 0(s3)
+s.li s3, 16524
+s.sw sp, 0(s3)
+s.li s3, 16268
+s.sw sp, 0(s3)
+s.li s3, 16012
+s.sw sp, 0(s3)
+s.li s3, 15756
+s.sw sp, 0(s3)
+s.li s3, 15500
+s.sw sp, 0(s3)
+s.li s3, 15244
+s.sw sp, 0(s3)
+s.li s3, 18064
+s.sw ra, 0(s3)
+s.li s3, 16784
+s.sw ra, 0(s3)
+s.li s3, 15504
+s.sw ra, 0(s3)
+s.li s3, 18044
+s.sw s0, 0(s3)
+s.li s3, 17788
+s.sw s0, 0(s3)
+s.li s3, 17532
+s.sw s0, 0(s3)
+s.li s3, 17276
+s.sw s0, 0(s3)
+s.li s3, 17020
+s.sw s0, 0(s3)
+s.li s3, 16764
+s.sw s0, 0(s3)
+s.li s3, 16508
+s.sw s0, 0(s3)
+s.li s3, 16252
+s.sw s0, 0(s3)
+s.li s3, 15996
+s.sw s0, 0(s3)
+s.li s3, 15740
+s.sw s0, 0(s3)
+s.li s3, 15484
+s.sw s0, 0(s3)
+s.li s3, 15228
+s.sw s0, 0(s3)
+s.li s2, 18056
+s.lw gp, 0(s2)
+s.li s2, 17972
+s.lw s24, 0(s2)
+s.li s2, 17964
+s.lw s26, 0(s2)
+v.li v1, 17804
+v.lw sp, 0(v1)
+v.li v1, 17800
+v.lw gp, 0(v1)
+v.li v1, 17788
+v.lw v0, 0(v1)
+v.li v1, 17688
+v.lw v26, 0(v1)
+v.li v2, 17548
+v.lw sp, 0(v2)
+v.li v2, 17544
+v.lw gp, 0(v2)
+v.li v2, 17532
+v.lw v0, 0(v2)
+v.li v2, 17432
+v.lw v26, 0(v2)
+v.li v3, 17292
+v.lw sp, 0(v3)
+v.li v3, 17288
+v.lw gp, 0(v3)
+v.li v3, 17276
+v.lw v0, 0(v3)
+v.li v3, 17176
+v.lw v26, 0(v3)
+v.li v4, 17036
+v.lw sp, 0(v4)
+v.li v4, 17032
+v.lw gp, 0(v4)
+v.li v4, 17020
+v.lw v0, 0(v4)
+v.li v4, 16920
+v.lw v26, 0(v4)
+s.j kernel_start0
+warp_switch1:
+s.seqi s2, s24, 0
+s.beqz s2, warp_check5
+s.li s3, 17940
+s.li t0, 1
+s.sw t0, 0(s3)
+s.li s3, 18068
+s.sw zero, 0(s3)
+s.li s3, 18064
+s.sw ra, 0(s3)
+s.li s3, 18060
+s.sw sp, 0(s3)
+s.li s3, 18056
+s.sw gp, 0(s3)
+s.li s3, 18052
+s.sw tp, 0(s3)
+s.li s3, 18048
+s.sw s0, 0(s3)
+s.li s3, 18044
+s.sw s1, 0(s3)
+s.li s3, 18040
+s.sw s2, 0(s3)
+s.li s3, 18036
+s.sw s3, 0(s3)
+s.li s3, 17948
+s.sw s25, 0(s3)
+s.li s3, 17944
+s.sw s26, 0(s3)
+s.li s3, 17816
+s.fsw fs31, 0(s3)
+v.li v5, 17812
+v.sw zero, 0(v5)
+v.li v5, 17808
+v.sw ra, 0(v5)
+v.li v5, 17804
+v.sw sp, 0(v5)
+v.li v5, 17800
+v.sw gp, 0(v5)
+v.li v5, 17796
+v.sw tp, 0(v5)
+v.li v5, 17792
+v.sw v0, 0(v5)
+v.li v5, 17788
+v.sw v1, 0(v5)
+v.li v5, 17784
+v.sw v2, 0(v5)
+v.li v5, 17780
+v.sw v3, 0(v5)
+v.li v5, 17776
+v.sw v4, 0(v5)
+v.li v5, 17772
+v.sw v5, 0(v5)
+v.li v5, 17768
+v.sw v6, 0(v5)
+v.li v5, 17764
+v.sw v7, 0(v5)
+v.li v5, 17760
+v.sw v8, 0(v5)
+v.li v5, 17756
+v.sw v9, 0(v5)
+v.li v5, 17752
+v.sw v10, 0(v5)
+v.li v5, 17748
+v.sw v11, 0(v5)
+v.li v5, 17744
+v.sw v12, 0(v5)
+v.li v5, 17740
+v.sw v13, 0(v5)
+v.li v5, 17736
+v.sw v14, 0(v5)
+v.li v5, 17732
+v.sw v15, 0(v5)
+v.li v5, 17728
+v.sw v16, 0(v5)
+v.li v5, 17724
+v.sw v17, 0(v5)
+v.li v5, 17720
+v.sw v18, 0(v5)
+v.li v5, 17716
+v.sw v19, 0(v5)
+v.li v5, 17712
+v.sw v20, 0(v5)
+v.li v5, 17708
+v.sw v21, 0(v5)
+v.li v5, 17704
+v.sw v22, 0(v5)
+v.li v5, 17700
+v.sw v23, 0(v5)
+v.li v5, 17696
+v.sw v24, 0(v5)
+v.li v5, 17692
+v.sw v25, 0(v5)
+v.li v5, 17688
+v.sw v26, 0(v5)
+v.li v5, 17684
+v.fsw fv0, 0(v5)
+v.li v5, 17680
+v.fsw fv1, 0(v5)
+v.li v5, 17676
+v.fsw fv2, 0(v5)
+v.li v5, 17672
+v.fsw fv3, 0(v5)
+v.li v5, 17668
+v.fsw fv4, 0(v5)
+v.li v5, 17664
+v.fsw fv5, 0(v5)
+v.li v5, 17660
+v.fsw fv6, 0(v5)
+v.li v5, 17656
+v.fsw fv7, 0(v5)
+v.li v5, 17652
+v.fsw fv8, 0(v5)
+v.li v5, 17648
+v.fsw fv9, 0(v5)
+v.li v5, 17644
+v.fsw fv10, 0(v5)
+v.li v5, 17640
+v.fsw fv11, 0(v5)
+v.li v5, 17636
+v.fsw fv12, 0(v5)
+v.li v5, 17632
+v.fsw fv13, 0(v5)
+v.li v5, 17628
+v.fsw fv14, 0(v5)
+v.li v5, 17624
+v.fsw fv15, 0(v5)
+v.li v5, 17620
+v.fsw fv16, 0(v5)
+v.li v5, 17616
+v.fsw fv17, 0(v5)
+v.li v5, 17612
+v.fsw fv18, 0(v5)
+v.li v5, 17608
+v.fsw fv19, 0(v5)
+v.li v5, 17604
+v.fsw fv20, 0(v5)
+v.li v5, 17600
+v.fsw fv21, 0(v5)
+v.li v5, 17596
+v.fsw fv22, 0(v5)
+v.li v5, 17592
+v.fsw fv23, 0(v5)
+v.li v5, 17588
+v.fsw fv24, 0(v5)
+v.li v5, 17584
+v.fsw fv25, 0(v5)
+v.li v5, 17580
+v.fsw fv26, 0(v5)
+v.li v5, 17576
+v.fsw fv27, 0(v5)
+v.li v5, 17572
+v.fsw fv28, 0(v5)
+v.li v5, 17568
+v.fsw fv29, 0(v5)
+v.li v5, 17564
+v.fsw fv30, 0(v5)
+v.li v5, 17560
+v.fsw fv31, 0(v5)
+v.li v1, 17556
+v.sw zero, 0(v1)
+v.li v1, 17552
+v.sw ra, 0(v1)
+v.li v1, 17548
+v.sw sp, 0(v1)
+v.li v1, 17544
+v.sw gp, 0(v1)
+v.li v1, 17540
+v.sw tp, 0(v1)
+v.li v1, 17536
+v.sw v0, 0(v1)
+v.li v1, 17532
+v.sw v1, 0(v1)
+v.li v1, 17528
+v.sw v2, 0(v1)
+v.li v1, 17524
+v.sw v3, 0(v1)
+v.li v1, 17520
+v.sw v4, 0(v1)
+v.li v1, 17516
+v.sw v5, 0(v1)
+v.li v1, 17512
+v.sw v6, 0(v1)
+v.li v1, 17508
+v.sw v7, 0(v1)
+v.li v1, 17504
+v.sw v8, 0(v1)
+v.li v1, 17500
+v.sw v9, 0(v1)
+v.li v1, 17496
+v.sw v10, 0(v1)
+v.li v1, 17492
+v.sw v11, 0(v1)
+v.li v1, 17488
+v.sw v12, 0(v1)
+v.li v1, 17484
+v.sw v13, 0(v1)
+v.li v1, 17480
+v.sw v14, 0(v1)
+v.li v1, 17476
+v.sw v15, 0(v1)
+v.li v1, 17472
+v.sw v16, 0(v1)
+v.li v1, 17468
+v.sw v17, 0(v1)
+v.li v1, 17464
+v.sw v18, 0(v1)
+v.li v1, 17460
+v.sw v19, 0(v1)
+v.li v1, 17456
+v.sw v20, 0(v1)
+v.li v1, 17452
+v.sw v21, 0(v1)
+v.li v1, 17448
+v.sw v22, 0(v1)
+v.li v1, 17444
+v.sw v23, 0(v1)
+v.li v1, 17440
+v.sw v24, 0(v1)
+v.li v1, 17436
+v.sw v25, 0(v1)
+v.li v1, 17432
+v.sw v26, 0(v1)
+v.li v1, 17428
+v.fsw fv0, 0(v1)
+v.li v1, 17424
+v.fsw fv1, 0(v1)
+v.li v1, 17420
+v.fsw fv2, 0(v1)
+v.li v1, 17416
+v.fsw fv3, 0(v1)
+v.li v1, 17412
+v.fsw fv4, 0(v1)
+v.li v1, 17408
+v.fsw fv5, 0(v1)
+v.li v1, 17404
+v.fsw fv6, 0(v1)
+v.li v1, 17400
+v.fsw fv7, 0(v1)
+v.li v1, 17396
+v.fsw fv8, 0(v1)
+v.li v1, 17392
+v.fsw fv9, 0(v1)
+v.li v1, 17388
+v.fsw fv10, 0(v1)
+v.li v1, 17384
+v.fsw fv11, 0(v1)
+v.li v1, 17380
+v.fsw fv12, 0(v1)
+v.li v1, 17376
+v.fsw fv13, 0(v1)
+v.li v1, 17372
+v.fsw fv14, 0(v1)
+v.li v1, 17368
+v.fsw fv15, 0(v1)
+v.li v1, 17364
+v.fsw fv16, 0(v1)
+v.li v1, 17360
+v.fsw fv17, 0(v1)
+v.li v1, 17356
+v.fsw fv18, 0(v1)
+v.li v1, 17352
+v.fsw fv19, 0(v1)
+v.li v1, 17348
+v.fsw fv20, 0(v1)
+v.li v1, 17344
+v.fsw fv21, 0(v1)
+v.li v1, 17340
+v.fsw fv22, 0(v1)
+v.li v1, 17336
+v.fsw fv23, 0(v1)
+v.li v1, 17332
+v.fsw fv24, 0(v1)
+v.li v1, 17328
+v.fsw fv25, 0(v1)
+v.li v1, 17324
+v.fsw fv26, 0(v1)
+v.li v1, 17320
+v.fsw fv27, 0(v1)
+v.li v1, 17316
+v.fsw fv28, 0(v1)
+v.li v1, 17312
+v.fsw fv29, 0(v1)
+v.li v1, 17308
+v.fsw fv30, 0(v1)
+v.li v1, 17304
+v.fsw fv31, 0(v1)
+v.li v1, 17300
+v.sw zero, 0(v1)
+v.li v1, 17296
+v.sw ra, 0(v1)
+v.li v1, 17292
+v.sw sp, 0(v1)
+v.li v1, 17288
+v.sw gp, 0(v1)
+v.li v1, 17284
+v.sw tp, 0(v1)
+v.li v1, 17280
+v.sw v0, 0(v1)
+v.li v1, 17276
+v.sw v1, 0(v1)
+v.li v1, 17272
+v.sw v2, 0(v1)
+v.li v1, 17268
+v.sw v3, 0(v1)
+v.li v1, 17264
+v.sw v4, 0(v1)
+v.li v1, 17260
+v.sw v5, 0(v1)
+v.li v1, 17256
+v.sw v6, 0(v1)
+v.li v1, 17252
+v.sw v7, 0(v1)
+v.li v1, 17248
+v.sw v8, 0(v1)
+v.li v1, 17244
+v.sw v9, 0(v1)
+v.li v1, 17240
+v.sw v10, 0(v1)
+v.li v1, 17236
+v.sw v11, 0(v1)
+v.li v1, 17232
+v.sw v12, 0(v1)
+v.li v1, 17228
+v.sw v13, 0(v1)
+v.li v1, 17224
+v.sw v14, 0(v1)
+v.li v1, 17220
+v.sw v15, 0(v1)
+v.li v1, 17216
+v.sw v16, 0(v1)
+v.li v1, 17212
+v.sw v17, 0(v1)
+v.li v1, 17208
+v.sw v18, 0(v1)
+v.li v1, 17204
+v.sw v19, 0(v1)
+v.li v1, 17200
+v.sw v20, 0(v1)
+v.li v1, 17196
+v.sw v21, 0(v1)
+v.li v1, 17192
+v.sw v22, 0(v1)
+v.li v1, 17188
+v.sw v23, 0(v1)
+v.li v1, 17184
+v.sw v24, 0(v1)
+v.li v1, 17180
+v.sw v25, 0(v1)
+v.li v1, 17176
+v.sw v26, 0(v1)
+v.li v1, 17172
+v.fsw fv0, 0(v1)
+v.li v1, 17168
+v.fsw fv1, 0(v1)
+v.li v1, 17164
+v.fsw fv2, 0(v1)
+v.li v1, 17160
+v.fsw fv3, 0(v1)
+v.li v1, 17156
+v.fsw fv4, 0(v1)
+v.li v1, 17152
+v.fsw fv5, 0(v1)
+v.li v1, 17148
+v.fsw fv6, 0(v1)
+v.li v1, 17144
+v.fsw fv7, 0(v1)
+v.li v1, 17140
+v.fsw fv8, 0(v1)
+v.li v1, 17136
+v.fsw fv9, 0(v1)
+v.li v1, 17132
+v.fsw fv10, 0(v1)
+v.li v1, 17128
+v.fsw fv11, 0(v1)
+v.li v1, 17124
+v.fsw fv12, 0(v1)
+v.li v1, 17120
+v.fsw fv13, 0(v1)
+v.li v1, 17116
+v.fsw fv14, 0(v1)
+v.li v1, 17112
+v.fsw fv15, 0(v1)
+v.li v1, 17108
+v.fsw fv16, 0(v1)
+v.li v1, 17104
+v.fsw fv17, 0(v1)
+v.li v1, 17100
+v.fsw fv18, 0(v1)
+v.li v1, 17096
+v.fsw fv19, 0(v1)
+v.li v1, 17092
+v.fsw fv20, 0(v1)
+v.li v1, 17088
+v.fsw fv21, 0(v1)
+v.li v1, 17084
+v.fsw fv22, 0(v1)
+v.li v1, 17080
+v.fsw fv23, 0(v1)
+v.li v1, 17076
+v.fsw fv24, 0(v1)
+v.li v1, 17072
+v.fsw fv25, 0(v1)
+v.li v1, 17068
+v.fsw fv26, 0(v1)
+v.li v1, 17064
+v.fsw fv27, 0(v1)
+v.li v1, 17060
+v.fsw fv28, 0(v1)
+v.li v1, 17056
+v.fsw fv29, 0(v1)
+v.li v1, 17052
+v.fsw fv30, 0(v1)
+v.li v1, 17048
+v.fsw fv31, 0(v1)
+v.li v1, 17044
+v.sw zero, 0(v1)
+v.li v1, 17040
+v.sw ra, 0(v1)
+v.li v1, 17036
+v.sw sp, 0(v1)
+v.li v1, 17032
+v.sw gp, 0(v1)
+v.li v1, 17028
+v.sw tp, 0(v1)
+v.li v1, 17024
+v.sw v0, 0(v1)
+v.li v1, 17020
+v.sw v1, 0(v1)
+v.li v1, 17016
+v.sw v2, 0(v1)
+v.li v1, 17012
+v.sw v3, 0(v1)
+v.li v1, 17008
+v.sw v4, 0(v1)
+v.li v1, 17004
+v.sw v5, 0(v1)
+v.li v1, 17000
+v.sw v6, 0(v1)
+v.li v1, 16996
+v.sw v7, 0(v1)
+v.li v1, 16992
+v.sw v8, 0(v1)
+v.li v1, 16988
+v.sw v9, 0(v1)
+v.li v1, 16984
+v.sw v10, 0(v1)
+v.li v1, 16980
+v.sw v11, 0(v1)
+v.li v1, 16976
+v.sw v12, 0(v1)
+v.li v1, 16972
+v.sw v13, 0(v1)
+v.li v1, 16968
+v.sw v14, 0(v1)
+v.li v1, 16964
+v.sw v15, 0(v1)
+v.li v1, 16960
+v.sw v16, 0(v1)
+v.li v1, 16956
+v.sw v17, 0(v1)
+v.li v1, 16952
+v.sw v18, 0(v1)
+v.li v1, 16948
+v.sw v19, 0(v1)
+v.li v1, 16944
+v.sw v20, 0(v1)
+v.li v1, 16940
+v.sw v21, 0(v1)
+v.li v1, 16936
+v.sw v22, 0(v1)
+v.li v1, 16932
+v.sw v23, 0(v1)
+v.li v1, 16928
+v.sw v24, 0(v1)
+v.li v1, 16924
+v.sw v25, 0(v1)
+v.li v1, 16920
+v.sw v26, 0(v1)
+v.li v1, 16916
+v.fsw fv0, 0(v1)
+v.li v1, 16912
+v.fsw fv1, 0(v1)
+v.li v1, 16908
+v.fsw fv2, 0(v1)
+v.li v1, 16904
+v.fsw fv3, 0(v1)
+v.li v1, 16900
+v.fsw fv4, 0(v1)
+v.li v1, 16896
+v.fsw fv5, 0(v1)
+v.li v1, 16892
+v.fsw fv6, 0(v1)
+v.li v1, 16888
+v.fsw fv7, 0(v1)
+v.li v1, 16884
+v.fsw fv8, 0(v1)
+v.li v1, 16880
+v.fsw fv9, 0(v1)
+v.li v1, 16876
+v.fsw fv10, 0(v1)
+v.li v1, 16872
+v.fsw fv11, 0(v1)
+v.li v1, 16868
+v.fsw fv12, 0(v1)
+v.li v1, 16864
+v.fsw fv13, 0(v1)
+v.li v1, 16860
+v.fsw fv14, 0(v1)
+v.li v1, 16856
+v.fsw fv15, 0(v1)
+v.li v1, 16852
+v.fsw fv16, 0(v1)
+v.li v1, 16848
+v.fsw fv17, 0(v1)
+v.li v1, 16844
+v.fsw fv18, 0(v1)
+v.li v1, 16840
+v.fsw fv19, 0(v1)
+v.li v1, 16836
+v.fsw fv20, 0(v1)
+v.li v1, 16832
+v.fsw fv21, 0(v1)
+v.li v1, 16828
+v.fsw fv22, 0(v1)
+v.li v1, 16824
+v.fsw fv23, 0(v1)
+v.li v1, 16820
+v.fsw fv24, 0(v1)
+v.li v1, 16816
+v.fsw fv25, 0(v1)
+v.li v1, 16812
+v.fsw fv26, 0(v1)
+v.li v1, 16808
+v.fsw fv27, 0(v1)
+v.li v1, 16804
+v.fsw fv28, 0(v1)
+v.li v1, 16800
+v.fsw fv29, 0(v1)
+v.li v1, 16796
+v.fsw fv30, 0(v1)
+v.li v1, 16792
+v.fsw fv31, 0(v1)
+s.j load_next_warp3
+warp_check5:
+s.seqi s2, s24, 1
+s.beqz s2, warp_check6
+s.li s2, 16660
+s.li t0, 1
+s.sw t0, 0(s2)
+s.li s2, 16788
+s.sw zero, 0(s2)
+s.li s2, 16784
+s.sw ra, 0(s2)
+s.li s2, 16780
+s.sw sp, 0(s2)
+s.li s2, 16776
+s.sw gp, 0(s2)
+s.li s2, 16772
+s.sw tp, 0(s2)
+s.li s2, 16768
+s.sw s0, 0(s2)
+s.li s2, 16764
+s.sw s1, 0(s2)
+s.li s2, 16760
+s.sw s2, 0(s2)
+s.li s2, 16668
+s.sw s25, 0(s2)
+s.li s2, 16664
+s.sw s26, 0(s2)
+s.li s2, 16536
+s.fsw fs31, 0(s2)
+v.li v1, 16532
+v.sw zero, 0(v1)
+v.li v1, 16528
+v.sw ra, 0(v1)
+v.li v1, 16524
+v.sw sp, 0(v1)
+v.li v1, 16520
+v.sw gp, 0(v1)
+v.li v1, 16516
+v.sw tp, 0(v1)
+v.li v1, 16512
+v.sw v0, 0(v1)
+v.li v1, 16508
+v.sw v1, 0(v1)
+v.li v1, 16504
+v.sw v2, 0(v1)
+v.li v1, 16500
+v.sw v3, 0(v1)
+v.li v1, 16496
+v.sw v4, 0(v1)
+v.li v1, 16492
+v.sw v5, 0(v1)
+v.li v1, 16488
+v.sw v6, 0(v1)
+v.li v1, 16484
+v.sw v7, 0(v1)
+v.li v1, 16480
+v.sw v8, 0(v1)
+v.li v1, 16476
+v.sw v9, 0(v1)
+v.li v1, 16472
+v.sw v10, 0(v1)
+v.li v1, 16468
+v.sw v11, 0(v1)
+v.li v1, 16464
+v.sw v12, 0(v1)
+v.li v1, 16460
+v.sw v13, 0(v1)
+v.li v1, 16456
+v.sw v14, 0(v1)
+v.li v1, 16452
+v.sw v15, 0(v1)
+v.li v1, 16448
+v.sw v16, 0(v1)
+v.li v1, 16444
+v.sw v17, 0(v1)
+v.li v1, 16440
+v.sw v18, 0(v1)
+v.li v1, 16436
+v.sw v19, 0(v1)
+v.li v1, 16432
+v.sw v20, 0(v1)
+v.li v1, 16428
+v.sw v21, 0(v1)
+v.li v1, 16424
+v.sw v22, 0(v1)
+v.li v1, 16420
+v.sw v23, 0(v1)
+v.li v1, 16416
+v.sw v24, 0(v1)
+v.li v1, 16412
+v.sw v25, 0(v1)
+v.li v1, 16408
+v.sw v26, 0(v1)
+v.li v1, 16404
+v.fsw fv0, 0(v1)
+v.li v1, 16400
+v.fsw fv1, 0(v1)
+v.li v1, 16396
+v.fsw fv2, 0(v1)
+v.li v1, 16392
+v.fsw fv3, 0(v1)
+v.li v1, 16388
+v.fsw fv4, 0(v1)
+v.li v1, 16384
+v.fsw fv5, 0(v1)
+v.li v1, 16380
+v.fsw fv6, 0(v1)
+v.li v1, 16376
+v.fsw fv7, 0(v1)
+v.li v1, 16372
+v.fsw fv8, 0(v1)
+v.li v1, 16368
+v.fsw fv9, 0(v1)
+v.li v1, 16364
+v.fsw fv10, 0(v1)
+v.li v1, 16360
+v.fsw fv11, 0(v1)
+v.li v1, 16356
+v.fsw fv12, 0(v1)
+v.li v1, 16352
+v.fsw fv13, 0(v1)
+v.li v1, 16348
+v.fsw fv14, 0(v1)
+v.li v1, 16344
+v.fsw fv15, 0(v1)
+v.li v1, 16340
+v.fsw fv16, 0(v1)
+v.li v1, 16336
+v.fsw fv17, 0(v1)
+v.li v1, 16332
+v.fsw fv18, 0(v1)
+v.li v1, 16328
+v.fsw fv19, 0(v1)
+v.li v1, 16324
+v.fsw fv20, 0(v1)
+v.li v1, 16320
+v.fsw fv21, 0(v1)
+v.li v1, 16316
+v.fsw fv22, 0(v1)
+v.li v1, 16312
+v.fsw fv23, 0(v1)
+v.li v1, 16308
+v.fsw fv24, 0(v1)
+v.li v1, 16304
+v.fsw fv25, 0(v1)
+v.li v1, 16300
+v.fsw fv26, 0(v1)
+v.li v1, 16296
+v.fsw fv27, 0(v1)
+v.li v1, 16292
+v.fsw fv28, 0(v1)
+v.li v1, 16288
+v.fsw fv29, 0(v1)
+v.li v1, 16284
+v.fsw fv30, 0(v1)
+v.li v1, 16280
+v.fsw fv31, 0(v1)
+v.li v1, 16276
+v.sw zero, 0(v1)
+v.li v1, 16272
+v.sw ra, 0(v1)
+v.li v1, 16268
+v.sw sp, 0(v1)
+v.li v1, 16264
+v.sw gp, 0(v1)
+v.li v1, 16260
+v.sw tp, 0(v1)
+v.li v1, 16256
+v.sw v0, 0(v1)
+v.li v1, 16252
+v.sw v1, 0(v1)
+v.li v1, 16248
+v.sw v2, 0(v1)
+v.li v1, 16244
+v.sw v3, 0(v1)
+v.li v1, 16240
+v.sw v4, 0(v1)
+v.li v1, 16236
+v.sw v5, 0(v1)
+v.li v1, 16232
+v.sw v6, 0(v1)
+v.li v1, 16228
+v.sw v7, 0(v1)
+v.li v1, 16224
+v.sw v8, 0(v1)
+v.li v1, 16220
+v.sw v9, 0(v1)
+v.li v1, 16216
+v.sw v10, 0(v1)
+v.li v1, 16212
+v.sw v11, 0(v1)
+v.li v1, 16208
+v.sw v12, 0(v1)
+v.li v1, 16204
+v.sw v13, 0(v1)
+v.li v1, 16200
+v.sw v14, 0(v1)
+v.li v1, 16196
+v.sw v15, 0(v1)
+v.li v1, 16192
+v.sw v16, 0(v1)
+v.li v1, 16188
+v.sw v17, 0(v1)
+v.li v1, 16184
+v.sw v18, 0(v1)
+v.li v1, 16180
+v.sw v19, 0(v1)
+v.li v1, 16176
+v.sw v20, 0(v1)
+v.li v1, 16172
+v.sw v21, 0(v1)
+v.li v1, 16168
+v.sw v22, 0(v1)
+v.li v1, 16164
+v.sw v23, 0(v1)
+v.li v1, 16160
+v.sw v24, 0(v1)
+v.li v1, 16156
+v.sw v25, 0(v1)
+v.li v1, 16152
+v.sw v26, 0(v1)
+v.li v1, 16148
+v.fsw fv0, 0(v1)
+v.li v1, 16144
+v.fsw fv1, 0(v1)
+v.li v1, 16140
+v.fsw fv2, 0(v1)
+v.li v1, 16136
+v.fsw fv3, 0(v1)
+v.li v1, 16132
+v.fsw fv4, 0(v1)
+v.li v1, 16128
+v.fsw fv5, 0(v1)
+v.li v1, 16124
+v.fsw fv6, 0(v1)
+v.li v1, 16120
+v.fsw fv7, 0(v1)
+v.li v1, 16116
+v.fsw fv8, 0(v1)
+v.li v1, 16112
+v.fsw fv9, 0(v1)
+v.li v1, 16108
+v.fsw fv10, 0(v1)
+v.li v1, 16104
+v.fsw fv11, 0(v1)
+v.li v1, 16100
+v.fsw fv12, 0(v1)
+v.li v1, 16096
+v.fsw fv13, 0(v1)
+v.li v1, 16092
+v.fsw fv14, 0(v1)
+v.li v1, 16088
+v.fsw fv15, 0(v1)
+v.li v1, 16084
+v.fsw fv16, 0(v1)
+v.li v1, 16080
+v.fsw fv17, 0(v1)
+v.li v1, 16076
+v.fsw fv18, 0(v1)
+v.li v1, 16072
+v.fsw fv19, 0(v1)
+v.li v1, 16068
+v.fsw fv20, 0(v1)
+v.li v1, 16064
+v.fsw fv21, 0(v1)
+v.li v1, 16060
+v.fsw fv22, 0(v1)
+v.li v1, 16056
+v.fsw fv23, 0(v1)
+v.li v1, 16052
+v.fsw fv24, 0(v1)
+v.li v1, 16048
+v.fsw fv25, 0(v1)
+v.li v1, 16044
+v.fsw fv26, 0(v1)
+v.li v1, 16040
+v.fsw fv27, 0(v1)
+v.li v1, 16036
+v.fsw fv28, 0(v1)
+v.li v1, 16032
+v.fsw fv29, 0(v1)
+v.li v1, 16028
+v.fsw fv30, 0(v1)
+v.li v1, 16024
+v.fsw fv31, 0(v1)
+v.li v1, 16020
+v.sw zero, 0(v1)
+v.li v1, 16016
+v.sw ra, 0(v1)
+v.li v1, 16012
+v.sw sp, 0(v1)
+v.li v1, 16008
+v.sw gp, 0(v1)
+v.li v1, 16004
+v.sw tp, 0(v1)
+v.li v1, 16000
+v.sw v0, 0(v1)
+v.li v1, 15996
+v.sw v1, 0(v1)
+v.li v1, 15992
+v.sw v2, 0(v1)
+v.li v1, 15988
+v.sw v3, 0(v1)
+v.li v1, 15984
+v.sw v4, 0(v1)
+v.li v1, 15980
+v.sw v5, 0(v1)
+v.li v1, 15976
+v.sw v6, 0(v1)
+v.li v1, 15972
+v.sw v7, 0(v1)
+v.li v1, 15968
+v.sw v8, 0(v1)
+v.li v1, 15964
+v.sw v9, 0(v1)
+v.li v1, 15960
+v.sw v10, 0(v1)
+v.li v1, 15956
+v.sw v11, 0(v1)
+v.li v1, 15952
+v.sw v12, 0(v1)
+v.li v1, 15948
+v.sw v13, 0(v1)
+v.li v1, 15944
+v.sw v14, 0(v1)
+v.li v1, 15940
+v.sw v15, 0(v1)
+v.li v1, 15936
+v.sw v16, 0(v1)
+v.li v1, 15932
+v.sw v17, 0(v1)
+v.li v1, 15928
+v.sw v18, 0(v1)
+v.li v1, 15924
+v.sw v19, 0(v1)
+v.li v1, 15920
+v.sw v20, 0(v1)
+v.li v1, 15916
+v.sw v21, 0(v1)
+v.li v1, 15912
+v.sw v22, 0(v1)
+v.li v1, 15908
+v.sw v23, 0(v1)
+v.li v1, 15904
+v.sw v24, 0(v1)
+v.li v1, 15900
+v.sw v25, 0(v1)
+v.li v1, 15896
+v.sw v26, 0(v1)
+v.li v1, 15892
+v.fsw fv0, 0(v1)
+v.li v1, 15888
+v.fsw fv1, 0(v1)
+v.li v1, 15884
+v.fsw fv2, 0(v1)
+v.li v1, 15880
+v.fsw fv3, 0(v1)
+v.li v1, 15876
+v.fsw fv4, 0(v1)
+v.li v1, 15872
+v.fsw fv5, 0(v1)
+v.li v1, 15868
+v.fsw fv6, 0(v1)
+v.li v1, 15864
+v.fsw fv7, 0(v1)
+v.li v1, 15860
+v.fsw fv8, 0(v1)
+v.li v1, 15856
+v.fsw fv9, 0(v1)
+v.li v1, 15852
+v.fsw fv10, 0(v1)
+v.li v1, 15848
+v.fsw fv11, 0(v1)
+v.li v1, 15844
+v.fsw fv12, 0(v1)
+v.li v1, 15840
+v.fsw fv13, 0(v1)
+v.li v1, 15836
+v.fsw fv14, 0(v1)
+v.li v1, 15832
+v.fsw fv15, 0(v1)
+v.li v1, 15828
+v.fsw fv16, 0(v1)
+v.li v1, 15824
+v.fsw fv17, 0(v1)
+v.li v1, 15820
+v.fsw fv18, 0(v1)
+v.li v1, 15816
+v.fsw fv19, 0(v1)
+v.li v1, 15812
+v.fsw fv20, 0(v1)
+v.li v1, 15808
+v.fsw fv21, 0(v1)
+v.li v1, 15804
+v.fsw fv22, 0(v1)
+v.li v1, 15800
+v.fsw fv23, 0(v1)
+v.li v1, 15796
+v.fsw fv24, 0(v1)
+v.li v1, 15792
+v.fsw fv25, 0(v1)
+v.li v1, 15788
+v.fsw fv26, 0(v1)
+v.li v1, 15784
+v.fsw fv27, 0(v1)
+v.li v1, 15780
+v.fsw fv28, 0(v1)
+v.li v1, 15776
+v.fsw fv29, 0(v1)
+v.li v1, 15772
+v.fsw fv30, 0(v1)
+v.li v1, 15768
+v.fsw fv31, 0(v1)
+v.li v1, 15764
+v.sw zero, 0(v1)
+v.li v1, 15760
+v.sw ra, 0(v1)
+v.li v1, 15756
+v.sw sp, 0(v1)
+v.li v1, 15752
+v.sw gp, 0(v1)
+v.li v1, 15748
+v.sw tp, 0(v1)
+v.li v1, 15744
+v.sw v0, 0(v1)
+v.li v1, 15740
+v.sw v1, 0(v1)
+v.li v1, 15736
+v.sw v2, 0(v1)
+v.li v1, 15732
+v.sw v3, 0(v1)
+v.li v1, 15728
+v.sw v4, 0(v1)
+v.li v1, 15724
+v.sw v5, 0(v1)
+v.li v1, 15720
+v.sw v6, 0(v1)
+v.li v1, 15716
+v.sw v7, 0(v1)
+v.li v1, 15712
+v.sw v8, 0(v1)
+v.li v1, 15708
+v.sw v9, 0(v1)
+v.li v1, 15704
+v.sw v10, 0(v1)
+v.li v1, 15700
+v.sw v11, 0(v1)
+v.li v1, 15696
+v.sw v12, 0(v1)
+v.li v1, 15692
+v.sw v13, 0(v1)
+v.li v1, 15688
+v.sw v14, 0(v1)
+v.li v1, 15684
+v.sw v15, 0(v1)
+v.li v1, 15680
+v.sw v16, 0(v1)
+v.li v1, 15676
+v.sw v17, 0(v1)
+v.li v1, 15672
+v.sw v18, 0(v1)
+v.li v1, 15668
+v.sw v19, 0(v1)
+v.li v1, 15664
+v.sw v20, 0(v1)
+v.li v1, 15660
+v.sw v21, 0(v1)
+v.li v1, 15656
+v.sw v22, 0(v1)
+v.li v1, 15652
+v.sw v23, 0(v1)
+v.li v1, 15648
+v.sw v24, 0(v1)
+v.li v1, 15644
+v.sw v25, 0(v1)
+v.li v1, 15640
+v.sw v26, 0(v1)
+v.li v1, 15636
+v.fsw fv0, 0(v1)
+v.li v1, 15632
+v.fsw fv1, 0(v1)
+v.li v1, 15628
+v.fsw fv2, 0(v1)
+v.li v1, 15624
+v.fsw fv3, 0(v1)
+v.li v1, 15620
+v.fsw fv4, 0(v1)
+v.li v1, 15616
+v.fsw fv5, 0(v1)
+v.li v1, 15612
+v.fsw fv6, 0(v1)
+v.li v1, 15608
+v.fsw fv7, 0(v1)
+v.li v1, 15604
+v.fsw fv8, 0(v1)
+v.li v1, 15600
+v.fsw fv9, 0(v1)
+v.li v1, 15596
+v.fsw fv10, 0(v1)
+v.li v1, 15592
+v.fsw fv11, 0(v1)
+v.li v1, 15588
+v.fsw fv12, 0(v1)
+v.li v1, 15584
+v.fsw fv13, 0(v1)
+v.li v1, 15580
+v.fsw fv14, 0(v1)
+v.li v1, 15576
+v.fsw fv15, 0(v1)
+v.li v1, 15572
+v.fsw fv16, 0(v1)
+v.li v1, 15568
+v.fsw fv17, 0(v1)
+v.li v1, 15564
+v.fsw fv18, 0(v1)
+v.li v1, 15560
+v.fsw fv19, 0(v1)
+v.li v1, 15556
+v.fsw fv20, 0(v1)
+v.li v1, 15552
+v.fsw fv21, 0(v1)
+v.li v1, 15548
+v.fsw fv22, 0(v1)
+v.li v1, 15544
+v.fsw fv23, 0(v1)
+v.li v1, 15540
+v.fsw fv24, 0(v1)
+v.li v1, 15536
+v.fsw fv25, 0(v1)
+v.li v1, 15532
+v.fsw fv26, 0(v1)
+v.li v1, 15528
+v.fsw fv27, 0(v1)
+v.li v1, 15524
+v.fsw fv28, 0(v1)
+v.li v1, 15520
+v.fsw fv29, 0(v1)
+v.li v1, 15516
+v.fsw fv30, 0(v1)
+v.li v1, 15512
+v.fsw fv31, 0(v1)
+s.j load_next_warp3
+warp_check6:
+s.seqi s2, s24, 2
+s.beqz s2, warp_check7
+s.li s2, 15380
+s.li t0, 1
+s.sw t0, 0(s2)
+s.li s2, 15508
+s.sw zero, 0(s2)
+s.li s2, 15504
+s.sw ra, 0(s2)
+s.li s2, 15500
+s.sw sp, 0(s2)
+s.li s2, 15496
+s.sw gp, 0(s2)
+s.li s2, 15492
+s.sw tp, 0(s2)
+s.li s2, 15488
+s.sw s0, 0(s2)
+s.li s2, 15484
+s.sw s1, 0(s2)
+s.li s2, 15480
+s.sw s2, 0(s2)
+s.li s2, 15388
+s.sw s25, 0(s2)
+s.li s2, 15384
+s.sw s26, 0(s2)
+s.li s2, 15256
+s.fsw fs31, 0(s2)
+v.li v1, 15252
+v.sw zero, 0(v1)
+v.li v1, 15248
+v.sw ra, 0(v1)
+v.li v1, 15244
+v.sw sp, 0(v1)
+v.li v1, 15240
+v.sw gp, 0(v1)
+v.li v1, 15236
+v.sw tp, 0(v1)
+v.li v1, 15232
+v.sw v0, 0(v1)
+v.li v1, 15228
+v.sw v1, 0(v1)
+v.li v1, 15224
+v.sw v2, 0(v1)
+v.li v1, 15220
+v.sw v3, 0(v1)
+v.li v1, 15216
+v.sw v4, 0(v1)
+v.li v1, 15212
+v.sw v5, 0(v1)
+v.li v1, 15208
+v.sw v6, 0(v1)
+v.li v1, 15204
+v.sw v7, 0(v1)
+v.li v1, 15200
+v.sw v8, 0(v1)
+v.li v1, 15196
+v.sw v9, 0(v1)
+v.li v1, 15192
+v.sw v10, 0(v1)
+v.li v1, 15188
+v.sw v11, 0(v1)
+v.li v1, 15184
+v.sw v12, 0(v1)
+v.li v1, 15180
+v.sw v13, 0(v1)
+v.li v1, 15176
+v.sw v14, 0(v1)
+v.li v1, 15172
+v.sw v15, 0(v1)
+v.li v1, 15168
+v.sw v16, 0(v1)
+v.li v1, 15164
+v.sw v17, 0(v1)
+v.li v1, 15160
+v.sw v18, 0(v1)
+v.li v1, 15156
+v.sw v19, 0(v1)
+v.li v1, 15152
+v.sw v20, 0(v1)
+v.li v1, 15148
+v.sw v21, 0(v1)
+v.li v1, 15144
+v.sw v22, 0(v1)
+v.li v1, 15140
+v.sw v23, 0(v1)
+v.li v1, 15136
+v.sw v24, 0(v1)
+v.li v1, 15132
+v.sw v25, 0(v1)
+v.li v1, 15128
+v.sw v26, 0(v1)
+v.li v1, 15124
+v.fsw fv0, 0(v1)
+v.li v1, 15120
+v.fsw fv1, 0(v1)
+v.li v1, 15116
+v.fsw fv2, 0(v1)
+v.li v1, 15112
+v.fsw fv3, 0(v1)
+v.li v1, 15108
+v.fsw fv4, 0(v1)
+v.li v1, 15104
+v.fsw fv5, 0(v1)
+v.li v1, 15100
+v.fsw fv6, 0(v1)
+v.li v1, 15096
+v.fsw fv7, 0(v1)
+v.li v1, 15092
+v.fsw fv8, 0(v1)
+v.li v1, 15088
+v.fsw fv9, 0(v1)
+v.li v1, 15084
+v.fsw fv10, 0(v1)
+v.li v1, 15080
+v.fsw fv11, 0(v1)
+v.li v1, 15076
+v.fsw fv12, 0(v1)
+v.li v1, 15072
+v.fsw fv13, 0(v1)
+v.li v1, 15068
+v.fsw fv14, 0(v1)
+v.li v1, 15064
+v.fsw fv15, 0(v1)
+v.li v1, 15060
+v.fsw fv16, 0(v1)
+v.li v1, 15056
+v.fsw fv17, 0(v1)
+v.li v1, 15052
+v.fsw fv18, 0(v1)
+v.li v1, 15048
+v.fsw fv19, 0(v1)
+v.li v1, 15044
+v.fsw fv20, 0(v1)
+v.li v1, 15040
+v.fsw fv21, 0(v1)
+v.li v1, 15036
+v.fsw fv22, 0(v1)
+v.li v1, 15032
+v.fsw fv23, 0(v1)
+v.li v1, 15028
+v.fsw fv24, 0(v1)
+v.li v1, 15024
+v.fsw fv25, 0(v1)
+v.li v1, 15020
+v.fsw fv26, 0(v1)
+v.li v1, 15016
+v.fsw fv27, 0(v1)
+v.li v1, 15012
+v.fsw fv28, 0(v1)
+v.li v1, 15008
+v.fsw fv29, 0(v1)
+v.li v1, 15004
+v.fsw fv30, 0(v1)
+v.li v1, 15000
+v.fsw fv31, 0(v1)
+s.j load_next_warp3
+warp_check7:
+load_next_warp3:
+s.li s2, 17940
+s.lw s2, 0(s2)
+s.beqz s2, load_warp_09
+s.li s2, 16660
+s.lw s2, 0(s2)
+s.beqz s2, load_warp_110
+s.li s2, 15380
+s.lw s2, 0(s2)
+s.beqz s2, load_warp_211
+s.j no_more_warps8
+load_warp_09:
+s.li s2, 18068
+s.lw zero, 0(s2)
+s.li s2, 18064
+s.lw ra, 0(s2)
+s.li s2, 18060
+s.lw sp, 0(s2)
+s.li s2, 18056
+s.lw gp, 0(s2)
+s.li s2, 18052
+s.lw tp, 0(s2)
+s.li s2, 18048
+s.lw s0, 0(s2)
+s.li s2, 18044
+s.lw s1, 0(s2)
+s.li s2, 18040
+s.lw s2, 0(s2)
+s.li s2, 17948
+s.lw s25, 0(s2)
+s.li s2, 17944
+s.lw s26, 0(s2)
+s.li s2, 17816
+s.flw fs31, 0(s2)
+v.li v5, 17812
+v.lw zero, 0(v5)
+v.li v5, 17808
+v.lw ra, 0(v5)
+v.li v5, 17804
+v.lw sp, 0(v5)
+v.li v5, 17800
+v.lw gp, 0(v5)
+v.li v5, 17796
+v.lw tp, 0(v5)
+v.li v5, 17792
+v.lw v0, 0(v5)
+v.li v5, 17788
+v.lw v1, 0(v5)
+v.li v5, 17784
+v.lw v2, 0(v5)
+v.li v5, 17780
+v.lw v3, 0(v5)
+v.li v5, 17776
+v.lw v4, 0(v5)
+v.li v5, 17772
+v.lw v5, 0(v5)
+v.li v5, 17768
+v.lw v6, 0(v5)
+v.li v5, 17764
+v.lw v7, 0(v5)
+v.li v5, 17760
+v.lw v8, 0(v5)
+v.li v5, 17756
+v.lw v9, 0(v5)
+v.li v5, 17752
+v.lw v10, 0(v5)
+v.li v5, 17748
+v.lw v11, 0(v5)
+v.li v5, 17744
+v.lw v12, 0(v5)
+v.li v5, 17740
+v.lw v13, 0(v5)
+v.li v5, 17736
+v.lw v14, 0(v5)
+v.li v5, 17732
+v.lw v15, 0(v5)
+v.li v5, 17728
+v.lw v16, 0(v5)
+v.li v5, 17724
+v.lw v17, 0(v5)
+v.li v5, 17720
+v.lw v18, 0(v5)
+v.li v5, 17716
+v.lw v19, 0(v5)
+v.li v5, 17712
+v.lw v20, 0(v5)
+v.li v5, 17708
+v.lw v21, 0(v5)
+v.li v5, 17704
+v.lw v22, 0(v5)
+v.li v5, 17700
+v.lw v23, 0(v5)
+v.li v5, 17696
+v.lw v24, 0(v5)
+v.li v5, 17692
+v.lw v25, 0(v5)
+v.li v5, 17688
+v.lw v26, 0(v5)
+v.li v5, 17684
+v.flw fv0, 0(v5)
+v.li v5, 17680
+v.flw fv1, 0(v5)
+v.li v5, 17676
+v.flw fv2, 0(v5)
+v.li v5, 17672
+v.flw fv3, 0(v5)
+v.li v5, 17668
+v.flw fv4, 0(v5)
+v.li v5, 17664
+v.flw fv5, 0(v5)
+v.li v5, 17660
+v.flw fv6, 0(v5)
+v.li v5, 17656
+v.flw fv7, 0(v5)
+v.li v5, 17652
+v.flw fv8, 0(v5)
+v.li v5, 17648
+v.flw fv9, 0(v5)
+v.li v5, 17644
+v.flw fv10, 0(v5)
+v.li v5, 17640
+v.flw fv11, 0(v5)
+v.li v5, 17636
+v.flw fv12, 0(v5)
+v.li v5, 17632
+v.flw fv13, 0(v5)
+v.li v5, 17628
+v.flw fv14, 0(v5)
+v.li v5, 17624
+v.flw fv15, 0(v5)
+v.li v5, 17620
+v.flw fv16, 0(v5)
+v.li v5, 17616
+v.flw fv17, 0(v5)
+v.li v5, 17612
+v.flw fv18, 0(v5)
+v.li v5, 17608
+v.flw fv19, 0(v5)
+v.li v5, 17604
+v.flw fv20, 0(v5)
+v.li v5, 17600
+v.flw fv21, 0(v5)
+v.li v5, 17596
+v.flw fv22, 0(v5)
+v.li v5, 17592
+v.flw fv23, 0(v5)
+v.li v5, 17588
+v.flw fv24, 0(v5)
+v.li v5, 17584
+v.flw fv25, 0(v5)
+v.li v5, 17580
+v.flw fv26, 0(v5)
+v.li v5, 17576
+v.flw fv27, 0(v5)
+v.li v5, 17572
+v.flw fv28, 0(v5)
+v.li v5, 17568
+v.flw fv29, 0(v5)
+v.li v5, 17564
+v.flw fv30, 0(v5)
+v.li v5, 17560
+v.flw fv31, 0(v5)
+v.li v1, 17556
+v.lw zero, 0(v1)
+v.li v1, 17552
+v.lw ra, 0(v1)
+v.li v1, 17548
+v.lw sp, 0(v1)
+v.li v1, 17544
+v.lw gp, 0(v1)
+v.li v1, 17540
+v.lw tp, 0(v1)
+v.li v1, 17536
+v.lw v0, 0(v1)
+v.li v1, 17532
+v.lw v1, 0(v1)
+v.li v1, 17528
+v.lw v2, 0(v1)
+v.li v1, 17524
+v.lw v3, 0(v1)
+v.li v1, 17520
+v.lw v4, 0(v1)
+v.li v1, 17516
+v.lw v5, 0(v1)
+v.li v1, 17512
+v.lw v6, 0(v1)
+v.li v1, 17508
+v.lw v7, 0(v1)
+v.li v1, 17504
+v.lw v8, 0(v1)
+v.li v1, 17500
+v.lw v9, 0(v1)
+v.li v1, 17496
+v.lw v10, 0(v1)
+v.li v1, 17492
+v.lw v11, 0(v1)
+v.li v1, 17488
+v.lw v12, 0(v1)
+v.li v1, 17484
+v.lw v13, 0(v1)
+v.li v1, 17480
+v.lw v14, 0(v1)
+v.li v1, 17476
+v.lw v15, 0(v1)
+v.li v1, 17472
+v.lw v16, 0(v1)
+v.li v1, 17468
+v.lw v17, 0(v1)
+v.li v1, 17464
+v.lw v18, 0(v1)
+v.li v1, 17460
+v.lw v19, 0(v1)
+v.li v1, 17456
+v.lw v20, 0(v1)
+v.li v1, 17452
+v.lw v21, 0(v1)
+v.li v1, 17448
+v.lw v22, 0(v1)
+v.li v1, 17444
+v.lw v23, 0(v1)
+v.li v1, 17440
+v.lw v24, 0(v1)
+v.li v1, 17436
+v.lw v25, 0(v1)
+v.li v1, 17432
+v.lw v26, 0(v1)
+v.li v1, 17428
+v.flw fv0, 0(v1)
+v.li v1, 17424
+v.flw fv1, 0(v1)
+v.li v1, 17420
+v.flw fv2, 0(v1)
+v.li v1, 17416
+v.flw fv3, 0(v1)
+v.li v1, 17412
+v.flw fv4, 0(v1)
+v.li v1, 17408
+v.flw fv5, 0(v1)
+v.li v1, 17404
+v.flw fv6, 0(v1)
+v.li v1, 17400
+v.flw fv7, 0(v1)
+v.li v1, 17396
+v.flw fv8, 0(v1)
+v.li v1, 17392
+v.flw fv9, 0(v1)
+v.li v1, 17388
+v.flw fv10, 0(v1)
+v.li v1, 17384
+v.flw fv11, 0(v1)
+v.li v1, 17380
+v.flw fv12, 0(v1)
+v.li v1, 17376
+v.flw fv13, 0(v1)
+v.li v1, 17372
+v.flw fv14, 0(v1)
+v.li v1, 17368
+v.flw fv15, 0(v1)
+v.li v1, 17364
+v.flw fv16, 0(v1)
+v.li v1, 17360
+v.flw fv17, 0(v1)
+v.li v1, 17356
+v.flw fv18, 0(v1)
+v.li v1, 17352
+v.flw fv19, 0(v1)
+v.li v1, 17348
+v.flw fv20, 0(v1)
+v.li v1, 17344
+v.flw fv21, 0(v1)
+v.li v1, 17340
+v.flw fv22, 0(v1)
+v.li v1, 17336
+v.flw fv23, 0(v1)
+v.li v1, 17332
+v.flw fv24, 0(v1)
+v.li v1, 17328
+v.flw fv25, 0(v1)
+v.li v1, 17324
+v.flw fv26, 0(v1)
+v.li v1, 17320
+v.flw fv27, 0(v1)
+v.li v1, 17316
+v.flw fv28, 0(v1)
+v.li v1, 17312
+v.flw fv29, 0(v1)
+v.li v1, 17308
+v.flw fv30, 0(v1)
+v.li v1, 17304
+v.flw fv31, 0(v1)
+v.li v1, 17300
+v.lw zero, 0(v1)
+v.li v1, 17296
+v.lw ra, 0(v1)
+v.li v1, 17292
+v.lw sp, 0(v1)
+v.li v1, 17288
+v.lw gp, 0(v1)
+v.li v1, 17284
+v.lw tp, 0(v1)
+v.li v1, 17280
+v.lw v0, 0(v1)
+v.li v1, 17276
+v.lw v1, 0(v1)
+v.li v1, 17272
+v.lw v2, 0(v1)
+v.li v1, 17268
+v.lw v3, 0(v1)
+v.li v1, 17264
+v.lw v4, 0(v1)
+v.li v1, 17260
+v.lw v5, 0(v1)
+v.li v1, 17256
+v.lw v6, 0(v1)
+v.li v1, 17252
+v.lw v7, 0(v1)
+v.li v1, 17248
+v.lw v8, 0(v1)
+v.li v1, 17244
+v.lw v9, 0(v1)
+v.li v1, 17240
+v.lw v10, 0(v1)
+v.li v1, 17236
+v.lw v11, 0(v1)
+v.li v1, 17232
+v.lw v12, 0(v1)
+v.li v1, 17228
+v.lw v13, 0(v1)
+v.li v1, 17224
+v.lw v14, 0(v1)
+v.li v1, 17220
+v.lw v15, 0(v1)
+v.li v1, 17216
+v.lw v16, 0(v1)
+v.li v1, 17212
+v.lw v17, 0(v1)
+v.li v1, 17208
+v.lw v18, 0(v1)
+v.li v1, 17204
+v.lw v19, 0(v1)
+v.li v1, 17200
+v.lw v20, 0(v1)
+v.li v1, 17196
+v.lw v21, 0(v1)
+v.li v1, 17192
+v.lw v22, 0(v1)
+v.li v1, 17188
+v.lw v23, 0(v1)
+v.li v1, 17184
+v.lw v24, 0(v1)
+v.li v1, 17180
+v.lw v25, 0(v1)
+v.li v1, 17176
+v.lw v26, 0(v1)
+v.li v1, 17172
+v.flw fv0, 0(v1)
+v.li v1, 17168
+v.flw fv1, 0(v1)
+v.li v1, 17164
+v.flw fv2, 0(v1)
+v.li v1, 17160
+v.flw fv3, 0(v1)
+v.li v1, 17156
+v.flw fv4, 0(v1)
+v.li v1, 17152
+v.flw fv5, 0(v1)
+v.li v1, 17148
+v.flw fv6, 0(v1)
+v.li v1, 17144
+v.flw fv7, 0(v1)
+v.li v1, 17140
+v.flw fv8, 0(v1)
+v.li v1, 17136
+v.flw fv9, 0(v1)
+v.li v1, 17132
+v.flw fv10, 0(v1)
+v.li v1, 17128
+v.flw fv11, 0(v1)
+v.li v1, 17124
+v.flw fv12, 0(v1)
+v.li v1, 17120
+v.flw fv13, 0(v1)
+v.li v1, 17116
+v.flw fv14, 0(v1)
+v.li v1, 17112
+v.flw fv15, 0(v1)
+v.li v1, 17108
+v.flw fv16, 0(v1)
+v.li v1, 17104
+v.flw fv17, 0(v1)
+v.li v1, 17100
+v.flw fv18, 0(v1)
+v.li v1, 17096
+v.flw fv19, 0(v1)
+v.li v1, 17092
+v.flw fv20, 0(v1)
+v.li v1, 17088
+v.flw fv21, 0(v1)
+v.li v1, 17084
+v.flw fv22, 0(v1)
+v.li v1, 17080
+v.flw fv23, 0(v1)
+v.li v1, 17076
+v.flw fv24, 0(v1)
+v.li v1, 17072
+v.flw fv25, 0(v1)
+v.li v1, 17068
+v.flw fv26, 0(v1)
+v.li v1, 17064
+v.flw fv27, 0(v1)
+v.li v1, 17060
+v.flw fv28, 0(v1)
+v.li v1, 17056
+v.flw fv29, 0(v1)
+v.li v1, 17052
+v.flw fv30, 0(v1)
+v.li v1, 17048
+v.flw fv31, 0(v1)
+v.li v1, 17044
+v.lw zero, 0(v1)
+v.li v1, 17040
+v.lw ra, 0(v1)
+v.li v1, 17036
+v.lw sp, 0(v1)
+v.li v1, 17032
+v.lw gp, 0(v1)
+v.li v1, 17028
+v.lw tp, 0(v1)
+v.li v1, 17024
+v.lw v0, 0(v1)
+v.li v1, 17020
+v.lw v1, 0(v1)
+v.li v1, 17016
+v.lw v2, 0(v1)
+v.li v1, 17012
+v.lw v3, 0(v1)
+v.li v1, 17008
+v.lw v4, 0(v1)
+v.li v1, 17004
+v.lw v5, 0(v1)
+v.li v1, 17000
+v.lw v6, 0(v1)
+v.li v1, 16996
+v.lw v7, 0(v1)
+v.li v1, 16992
+v.lw v8, 0(v1)
+v.li v1, 16988
+v.lw v9, 0(v1)
+v.li v1, 16984
+v.lw v10, 0(v1)
+v.li v1, 16980
+v.lw v11, 0(v1)
+v.li v1, 16976
+v.lw v12, 0(v1)
+v.li v1, 16972
+v.lw v13, 0(v1)
+v.li v1, 16968
+v.lw v14, 0(v1)
+v.li v1, 16964
+v.lw v15, 0(v1)
+v.li v1, 16960
+v.lw v16, 0(v1)
+v.li v1, 16956
+v.lw v17, 0(v1)
+v.li v1, 16952
+v.lw v18, 0(v1)
+v.li v1, 16948
+v.lw v19, 0(v1)
+v.li v1, 16944
+v.lw v20, 0(v1)
+v.li v1, 16940
+v.lw v21, 0(v1)
+v.li v1, 16936
+v.lw v22, 0(v1)
+v.li v1, 16932
+v.lw v23, 0(v1)
+v.li v1, 16928
+v.lw v24, 0(v1)
+v.li v1, 16924
+v.lw v25, 0(v1)
+v.li v1, 16920
+v.lw v26, 0(v1)
+v.li v1, 16916
+v.flw fv0, 0(v1)
+v.li v1, 16912
+v.flw fv1, 0(v1)
+v.li v1, 16908
+v.flw fv2, 0(v1)
+v.li v1, 16904
+v.flw fv3, 0(v1)
+v.li v1, 16900
+v.flw fv4, 0(v1)
+v.li v1, 16896
+v.flw fv5, 0(v1)
+v.li v1, 16892
+v.flw fv6, 0(v1)
+v.li v1, 16888
+v.flw fv7, 0(v1)
+v.li v1, 16884
+v.flw fv8, 0(v1)
+v.li v1, 16880
+v.flw fv9, 0(v1)
+v.li v1, 16876
+v.flw fv10, 0(v1)
+v.li v1, 16872
+v.flw fv11, 0(v1)
+v.li v1, 16868
+v.flw fv12, 0(v1)
+v.li v1, 16864
+v.flw fv13, 0(v1)
+v.li v1, 16860
+v.flw fv14, 0(v1)
+v.li v1, 16856
+v.flw fv15, 0(v1)
+v.li v1, 16852
+v.flw fv16, 0(v1)
+v.li v1, 16848
+v.flw fv17, 0(v1)
+v.li v1, 16844
+v.flw fv18, 0(v1)
+v.li v1, 16840
+v.flw fv19, 0(v1)
+v.li v1, 16836
+v.flw fv20, 0(v1)
+v.li v1, 16832
+v.flw fv21, 0(v1)
+v.li v1, 16828
+v.flw fv22, 0(v1)
+v.li v1, 16824
+v.flw fv23, 0(v1)
+v.li v1, 16820
+v.flw fv24, 0(v1)
+v.li v1, 16816
+v.flw fv25, 0(v1)
+v.li v1, 16812
+v.flw fv26, 0(v1)
+v.li v1, 16808
+v.flw fv27, 0(v1)
+v.li v1, 16804
+v.flw fv28, 0(v1)
+v.li v1, 16800
+v.flw fv29, 0(v1)
+v.li v1, 16796
+v.flw fv30, 0(v1)
+v.li v1, 16792
+v.flw fv31, 0(v1)
+s.j kernel_start0
+load_warp_110:
+s.li s2, 16788
+s.lw zero, 0(s2)
+s.li s2, 16784
+s.lw ra, 0(s2)
+s.li s2, 16780
+s.lw sp, 0(s2)
+s.li s2, 16776
+s.lw gp, 0(s2)
+s.li s2, 16772
+s.lw tp, 0(s2)
+s.li s2, 16768
+s.lw s0, 0(s2)
+s.li s2, 16764
+s.lw s1, 0(s2)
+s.li s2, 16760
+s.lw s2, 0(s2)
+s.li s2, 16668
+s.lw s25, 0(s2)
+s.li s2, 16664
+s.lw s26, 0(s2)
+s.li s2, 16536
+s.flw fs31, 0(s2)
+v.li v1, 16532
+v.lw zero, 0(v1)
+v.li v1, 16528
+v.lw ra, 0(v1)
+v.li v1, 16524
+v.lw sp, 0(v1)
+v.li v1, 16520
+v.lw gp, 0(v1)
+v.li v1, 16516
+v.lw tp, 0(v1)
+v.li v1, 16512
+v.lw v0, 0(v1)
+v.li v1, 16508
+v.lw v1, 0(v1)
+v.li v1, 16504
+v.lw v2, 0(v1)
+v.li v1, 16500
+v.lw v3, 0(v1)
+v.li v1, 16496
+v.lw v4, 0(v1)
+v.li v1, 16492
+v.lw v5, 0(v1)
+v.li v1, 16488
+v.lw v6, 0(v1)
+v.li v1, 16484
+v.lw v7, 0(v1)
+v.li v1, 16480
+v.lw v8, 0(v1)
+v.li v1, 16476
+v.lw v9, 0(v1)
+v.li v1, 16472
+v.lw v10, 0(v1)
+v.li v1, 16468
+v.lw v11, 0(v1)
+v.li v1, 16464
+v.lw v12, 0(v1)
+v.li v1, 16460
+v.lw v13, 0(v1)
+v.li v1, 16456
+v.lw v14, 0(v1)
+v.li v1, 16452
+v.lw v15, 0(v1)
+v.li v1, 16448
+v.lw v16, 0(v1)
+v.li v1, 16444
+v.lw v17, 0(v1)
+v.li v1, 16440
+v.lw v18, 0(v1)
+v.li v1, 16436
+v.lw v19, 0(v1)
+v.li v1, 16432
+v.lw v20, 0(v1)
+v.li v1, 16428
+v.lw v21, 0(v1)
+v.li v1, 16424
+v.lw v22, 0(v1)
+v.li v1, 16420
+v.lw v23, 0(v1)
+v.li v1, 16416
+v.lw v24, 0(v1)
+v.li v1, 16412
+v.lw v25, 0(v1)
+v.li v1, 16408
+v.lw v26, 0(v1)
+v.li v1, 16404
+v.flw fv0, 0(v1)
+v.li v1, 16400
+v.flw fv1, 0(v1)
+v.li v1, 16396
+v.flw fv2, 0(v1)
+v.li v1, 16392
+v.flw fv3, 0(v1)
+v.li v1, 16388
+v.flw fv4, 0(v1)
+v.li v1, 16384
+v.flw fv5, 0(v1)
+v.li v1, 16380
+v.flw fv6, 0(v1)
+v.li v1, 16376
+v.flw fv7, 0(v1)
+v.li v1, 16372
+v.flw fv8, 0(v1)
+v.li v1, 16368
+v.flw fv9, 0(v1)
+v.li v1, 16364
+v.flw fv10, 0(v1)
+v.li v1, 16360
+v.flw fv11, 0(v1)
+v.li v1, 16356
+v.flw fv12, 0(v1)
+v.li v1, 16352
+v.flw fv13, 0(v1)
+v.li v1, 16348
+v.flw fv14, 0(v1)
+v.li v1, 16344
+v.flw fv15, 0(v1)
+v.li v1, 16340
+v.flw fv16, 0(v1)
+v.li v1, 16336
+v.flw fv17, 0(v1)
+v.li v1, 16332
+v.flw fv18, 0(v1)
+v.li v1, 16328
+v.flw fv19, 0(v1)
+v.li v1, 16324
+v.flw fv20, 0(v1)
+v.li v1, 16320
+v.flw fv21, 0(v1)
+v.li v1, 16316
+v.flw fv22, 0(v1)
+v.li v1, 16312
+v.flw fv23, 0(v1)
+v.li v1, 16308
+v.flw fv24, 0(v1)
+v.li v1, 16304
+v.flw fv25, 0(v1)
+v.li v1, 16300
+v.flw fv26, 0(v1)
+v.li v1, 16296
+v.flw fv27, 0(v1)
+v.li v1, 16292
+v.flw fv28, 0(v1)
+v.li v1, 16288
+v.flw fv29, 0(v1)
+v.li v1, 16284
+v.flw fv30, 0(v1)
+v.li v1, 16280
+v.flw fv31, 0(v1)
+v.li v1, 16276
+v.lw zero, 0(v1)
+v.li v1, 16272
+v.lw ra, 0(v1)
+v.li v1, 16268
+v.lw sp, 0(v1)
+v.li v1, 16264
+v.lw gp, 0(v1)
+v.li v1, 16260
+v.lw tp, 0(v1)
+v.li v1, 16256
+v.lw v0, 0(v1)
+v.li v1, 16252
+v.lw v1, 0(v1)
+v.li v1, 16248
+v.lw v2, 0(v1)
+v.li v1, 16244
+v.lw v3, 0(v1)
+v.li v1, 16240
+v.lw v4, 0(v1)
+v.li v1, 16236
+v.lw v5, 0(v1)
+v.li v1, 16232
+v.lw v6, 0(v1)
+v.li v1, 16228
+v.lw v7, 0(v1)
+v.li v1, 16224
+v.lw v8, 0(v1)
+v.li v1, 16220
+v.lw v9, 0(v1)
+v.li v1, 16216
+v.lw v10, 0(v1)
+v.li v1, 16212
+v.lw v11, 0(v1)
+v.li v1, 16208
+v.lw v12, 0(v1)
+v.li v1, 16204
+v.lw v13, 0(v1)
+v.li v1, 16200
+v.lw v14, 0(v1)
+v.li v1, 16196
+v.lw v15, 0(v1)
+v.li v1, 16192
+v.lw v16, 0(v1)
+v.li v1, 16188
+v.lw v17, 0(v1)
+v.li v1, 16184
+v.lw v18, 0(v1)
+v.li v1, 16180
+v.lw v19, 0(v1)
+v.li v1, 16176
+v.lw v20, 0(v1)
+v.li v1, 16172
+v.lw v21, 0(v1)
+v.li v1, 16168
+v.lw v22, 0(v1)
+v.li v1, 16164
+v.lw v23, 0(v1)
+v.li v1, 16160
+v.lw v24, 0(v1)
+v.li v1, 16156
+v.lw v25, 0(v1)
+v.li v1, 16152
+v.lw v26, 0(v1)
+v.li v1, 16148
+v.flw fv0, 0(v1)
+v.li v1, 16144
+v.flw fv1, 0(v1)
+v.li v1, 16140
+v.flw fv2, 0(v1)
+v.li v1, 16136
+v.flw fv3, 0(v1)
+v.li v1, 16132
+v.flw fv4, 0(v1)
+v.li v1, 16128
+v.flw fv5, 0(v1)
+v.li v1, 16124
+v.flw fv6, 0(v1)
+v.li v1, 16120
+v.flw fv7, 0(v1)
+v.li v1, 16116
+v.flw fv8, 0(v1)
+v.li v1, 16112
+v.flw fv9, 0(v1)
+v.li v1, 16108
+v.flw fv10, 0(v1)
+v.li v1, 16104
+v.flw fv11, 0(v1)
+v.li v1, 16100
+v.flw fv12, 0(v1)
+v.li v1, 16096
+v.flw fv13, 0(v1)
+v.li v1, 16092
+v.flw fv14, 0(v1)
+v.li v1, 16088
+v.flw fv15, 0(v1)
+v.li v1, 16084
+v.flw fv16, 0(v1)
+v.li v1, 16080
+v.flw fv17, 0(v1)
+v.li v1, 16076
+v.flw fv18, 0(v1)
+v.li v1, 16072
+v.flw fv19, 0(v1)
+v.li v1, 16068
+v.flw fv20, 0(v1)
+v.li v1, 16064
+v.flw fv21, 0(v1)
+v.li v1, 16060
+v.flw fv22, 0(v1)
+v.li v1, 16056
+v.flw fv23, 0(v1)
+v.li v1, 16052
+v.flw fv24, 0(v1)
+v.li v1, 16048
+v.flw fv25, 0(v1)
+v.li v1, 16044
+v.flw fv26, 0(v1)
+v.li v1, 16040
+v.flw fv27, 0(v1)
+v.li v1, 16036
+v.flw fv28, 0(v1)
+v.li v1, 16032
+v.flw fv29, 0(v1)
+v.li v1, 16028
+v.flw fv30, 0(v1)
+v.li v1, 16024
+v.flw fv31, 0(v1)
+v.li v1, 16020
+v.lw zero, 0(v1)
+v.li v1, 16016
+v.lw ra, 0(v1)
+v.li v1, 16012
+v.lw sp, 0(v1)
+v.li v1, 16008
+v.lw gp, 0(v1)
+v.li v1, 16004
+v.lw tp, 0(v1)
+v.li v1, 16000
+v.lw v0, 0(v1)
+v.li v1, 15996
+v.lw v1, 0(v1)
+v.li v1, 15992
+v.lw v2, 0(v1)
+v.li v1, 15988
+v.lw v3, 0(v1)
+v.li v1, 15984
+v.lw v4, 0(v1)
+v.li v1, 15980
+v.lw v5, 0(v1)
+v.li v1, 15976
+v.lw v6, 0(v1)
+v.li v1, 15972
+v.lw v7, 0(v1)
+v.li v1, 15968
+v.lw v8, 0(v1)
+v.li v1, 15964
+v.lw v9, 0(v1)
+v.li v1, 15960
+v.lw v10, 0(v1)
+v.li v1, 15956
+v.lw v11, 0(v1)
+v.li v1, 15952
+v.lw v12, 0(v1)
+v.li v1, 15948
+v.lw v13, 0(v1)
+v.li v1, 15944
+v.lw v14, 0(v1)
+v.li v1, 15940
+v.lw v15, 0(v1)
+v.li v1, 15936
+v.lw v16, 0(v1)
+v.li v1, 15932
+v.lw v17, 0(v1)
+v.li v1, 15928
+v.lw v18, 0(v1)
+v.li v1, 15924
+v.lw v19, 0(v1)
+v.li v1, 15920
+v.lw v20, 0(v1)
+v.li v1, 15916
+v.lw v21, 0(v1)
+v.li v1, 15912
+v.lw v22, 0(v1)
+v.li v1, 15908
+v.lw v23, 0(v1)
+v.li v1, 15904
+v.lw v24, 0(v1)
+v.li v1, 15900
+v.lw v25, 0(v1)
+v.li v1, 15896
+v.lw v26, 0(v1)
+v.li v1, 15892
+v.flw fv0, 0(v1)
+v.li v1, 15888
+v.flw fv1, 0(v1)
+v.li v1, 15884
+v.flw fv2, 0(v1)
+v.li v1, 15880
+v.flw fv3, 0(v1)
+v.li v1, 15876
+v.flw fv4, 0(v1)
+v.li v1, 15872
+v.flw fv5, 0(v1)
+v.li v1, 15868
+v.flw fv6, 0(v1)
+v.li v1, 15864
+v.flw fv7, 0(v1)
+v.li v1, 15860
+v.flw fv8, 0(v1)
+v.li v1, 15856
+v.flw fv9, 0(v1)
+v.li v1, 15852
+v.flw fv10, 0(v1)
+v.li v1, 15848
+v.flw fv11, 0(v1)
+v.li v1, 15844
+v.flw fv12, 0(v1)
+v.li v1, 15840
+v.flw fv13, 0(v1)
+v.li v1, 15836
+v.flw fv14, 0(v1)
+v.li v1, 15832
+v.flw fv15, 0(v1)
+v.li v1, 15828
+v.flw fv16, 0(v1)
+v.li v1, 15824
+v.flw fv17, 0(v1)
+v.li v1, 15820
+v.flw fv18, 0(v1)
+v.li v1, 15816
+v.flw fv19, 0(v1)
+v.li v1, 15812
+v.flw fv20, 0(v1)
+v.li v1, 15808
+v.flw fv21, 0(v1)
+v.li v1, 15804
+v.flw fv22, 0(v1)
+v.li v1, 15800
+v.flw fv23, 0(v1)
+v.li v1, 15796
+v.flw fv24, 0(v1)
+v.li v1, 15792
+v.flw fv25, 0(v1)
+v.li v1, 15788
+v.flw fv26, 0(v1)
+v.li v1, 15784
+v.flw fv27, 0(v1)
+v.li v1, 15780
+v.flw fv28, 0(v1)
+v.li v1, 15776
+v.flw fv29, 0(v1)
+v.li v1, 15772
+v.flw fv30, 0(v1)
+v.li v1, 15768
+v.flw fv31, 0(v1)
+v.li v1, 15764
+v.lw zero, 0(v1)
+v.li v1, 15760
+v.lw ra, 0(v1)
+v.li v1, 15756
+v.lw sp, 0(v1)
+v.li v1, 15752
+v.lw gp, 0(v1)
+v.li v1, 15748
+v.lw tp, 0(v1)
+v.li v1, 15744
+v.lw v0, 0(v1)
+v.li v1, 15740
+v.lw v1, 0(v1)
+v.li v1, 15736
+v.lw v2, 0(v1)
+v.li v1, 15732
+v.lw v3, 0(v1)
+v.li v1, 15728
+v.lw v4, 0(v1)
+v.li v1, 15724
+v.lw v5, 0(v1)
+v.li v1, 15720
+v.lw v6, 0(v1)
+v.li v1, 15716
+v.lw v7, 0(v1)
+v.li v1, 15712
+v.lw v8, 0(v1)
+v.li v1, 15708
+v.lw v9, 0(v1)
+v.li v1, 15704
+v.lw v10, 0(v1)
+v.li v1, 15700
+v.lw v11, 0(v1)
+v.li v1, 15696
+v.lw v12, 0(v1)
+v.li v1, 15692
+v.lw v13, 0(v1)
+v.li v1, 15688
+v.lw v14, 0(v1)
+v.li v1, 15684
+v.lw v15, 0(v1)
+v.li v1, 15680
+v.lw v16, 0(v1)
+v.li v1, 15676
+v.lw v17, 0(v1)
+v.li v1, 15672
+v.lw v18, 0(v1)
+v.li v1, 15668
+v.lw v19, 0(v1)
+v.li v1, 15664
+v.lw v20, 0(v1)
+v.li v1, 15660
+v.lw v21, 0(v1)
+v.li v1, 15656
+v.lw v22, 0(v1)
+v.li v1, 15652
+v.lw v23, 0(v1)
+v.li v1, 15648
+v.lw v24, 0(v1)
+v.li v1, 15644
+v.lw v25, 0(v1)
+v.li v1, 15640
+v.lw v26, 0(v1)
+v.li v1, 15636
+v.flw fv0, 0(v1)
+v.li v1, 15632
+v.flw fv1, 0(v1)
+v.li v1, 15628
+v.flw fv2, 0(v1)
+v.li v1, 15624
+v.flw fv3, 0(v1)
+v.li v1, 15620
+v.flw fv4, 0(v1)
+v.li v1, 15616
+v.flw fv5, 0(v1)
+v.li v1, 15612
+v.flw fv6, 0(v1)
+v.li v1, 15608
+v.flw fv7, 0(v1)
+v.li v1, 15604
+v.flw fv8, 0(v1)
+v.li v1, 15600
+v.flw fv9, 0(v1)
+v.li v1, 15596
+v.flw fv10, 0(v1)
+v.li v1, 15592
+v.flw fv11, 0(v1)
+v.li v1, 15588
+v.flw fv12, 0(v1)
+v.li v1, 15584
+v.flw fv13, 0(v1)
+v.li v1, 15580
+v.flw fv14, 0(v1)
+v.li v1, 15576
+v.flw fv15, 0(v1)
+v.li v1, 15572
+v.flw fv16, 0(v1)
+v.li v1, 15568
+v.flw fv17, 0(v1)
+v.li v1, 15564
+v.flw fv18, 0(v1)
+v.li v1, 15560
+v.flw fv19, 0(v1)
+v.li v1, 15556
+v.flw fv20, 0(v1)
+v.li v1, 15552
+v.flw fv21, 0(v1)
+v.li v1, 15548
+v.flw fv22, 0(v1)
+v.li v1, 15544
+v.flw fv23, 0(v1)
+v.li v1, 15540
+v.flw fv24, 0(v1)
+v.li v1, 15536
+v.flw fv25, 0(v1)
+v.li v1, 15532
+v.flw fv26, 0(v1)
+v.li v1, 15528
+v.flw fv27, 0(v1)
+v.li v1, 15524
+v.flw fv28, 0(v1)
+v.li v1, 15520
+v.flw fv29, 0(v1)
+v.li v1, 15516
+v.flw fv30, 0(v1)
+v.li v1, 15512
+v.flw fv31, 0(v1)
+s.j kernel_start0
+load_warp_211:
+s.li s2, 15508
+s.lw zero, 0(s2)
+s.li s2, 15504
+s.lw ra, 0(s2)
+s.li s2, 15500
+s.lw sp, 0(s2)
+s.li s2, 15496
+s.lw gp, 0(s2)
+s.li s2, 15492
+s.lw tp, 0(s2)
+s.li s2, 15488
+s.lw s0, 0(s2)
+s.li s2, 15484
+s.lw s1, 0(s2)
+s.li s2, 15480
+s.lw s2, 0(s2)
+s.li s2, 15388
+s.lw s25, 0(s2)
+s.li s2, 15384
+s.lw s26, 0(s2)
+s.li s2, 15256
+s.flw fs31, 0(s2)
+v.li v1, 15252
+v.lw zero, 0(v1)
+v.li v1, 15248
+v.lw ra, 0(v1)
+v.li v1, 15244
+v.lw sp, 0(v1)
+v.li v1, 15240
+v.lw gp, 0(v1)
+v.li v1, 15236
+v.lw tp, 0(v1)
+v.li v1, 15232
+v.lw v0, 0(v1)
+v.li v1, 15228
+v.lw v1, 0(v1)
+v.li v1, 15224
+v.lw v2, 0(v1)
+v.li v1, 15220
+v.lw v3, 0(v1)
+v.li v1, 15216
+v.lw v4, 0(v1)
+v.li v1, 15212
+v.lw v5, 0(v1)
+v.li v1, 15208
+v.lw v6, 0(v1)
+v.li v1, 15204
+v.lw v7, 0(v1)
+v.li v1, 15200
+v.lw v8, 0(v1)
+v.li v1, 15196
+v.lw v9, 0(v1)
+v.li v1, 15192
+v.lw v10, 0(v1)
+v.li v1, 15188
+v.lw v11, 0(v1)
+v.li v1, 15184
+v.lw v12, 0(v1)
+v.li v1, 15180
+v.lw v13, 0(v1)
+v.li v1, 15176
+v.lw v14, 0(v1)
+v.li v1, 15172
+v.lw v15, 0(v1)
+v.li v1, 15168
+v.lw v16, 0(v1)
+v.li v1, 15164
+v.lw v17, 0(v1)
+v.li v1, 15160
+v.lw v18, 0(v1)
+v.li v1, 15156
+v.lw v19, 0(v1)
+v.li v1, 15152
+v.lw v20, 0(v1)
+v.li v1, 15148
+v.lw v21, 0(v1)
+v.li v1, 15144
+v.lw v22, 0(v1)
+v.li v1, 15140
+v.lw v23, 0(v1)
+v.li v1, 15136
+v.lw v24, 0(v1)
+v.li v1, 15132
+v.lw v25, 0(v1)
+v.li v1, 15128
+v.lw v26, 0(v1)
+v.li v1, 15124
+v.flw fv0, 0(v1)
+v.li v1, 15120
+v.flw fv1, 0(v1)
+v.li v1, 15116
+v.flw fv2, 0(v1)
+v.li v1, 15112
+v.flw fv3, 0(v1)
+v.li v1, 15108
+v.flw fv4, 0(v1)
+v.li v1, 15104
+v.flw fv5, 0(v1)
+v.li v1, 15100
+v.flw fv6, 0(v1)
+v.li v1, 15096
+v.flw fv7, 0(v1)
+v.li v1, 15092
+v.flw fv8, 0(v1)
+v.li v1, 15088
+v.flw fv9, 0(v1)
+v.li v1, 15084
+v.flw fv10, 0(v1)
+v.li v1, 15080
+v.flw fv11, 0(v1)
+v.li v1, 15076
+v.flw fv12, 0(v1)
+v.li v1, 15072
+v.flw fv13, 0(v1)
+v.li v1, 15068
+v.flw fv14, 0(v1)
+v.li v1, 15064
+v.flw fv15, 0(v1)
+v.li v1, 15060
+v.flw fv16, 0(v1)
+v.li v1, 15056
+v.flw fv17, 0(v1)
+v.li v1, 15052
+v.flw fv18, 0(v1)
+v.li v1, 15048
+v.flw fv19, 0(v1)
+v.li v1, 15044
+v.flw fv20, 0(v1)
+v.li v1, 15040
+v.flw fv21, 0(v1)
+v.li v1, 15036
+v.flw fv22, 0(v1)
+v.li v1, 15032
+v.flw fv23, 0(v1)
+v.li v1, 15028
+v.flw fv24, 0(v1)
+v.li v1, 15024
+v.flw fv25, 0(v1)
+v.li v1, 15020
+v.flw fv26, 0(v1)
+v.li v1, 15016
+v.flw fv27, 0(v1)
+v.li v1, 15012
+v.flw fv28, 0(v1)
+v.li v1, 15008
+v.flw fv29, 0(v1)
+v.li v1, 15004
+v.flw fv30, 0(v1)
+v.li v1, 15000
+v.flw fv31, 0(v1)
+s.j kernel_start0
+no_more_warps8:
+s.j kernel_end2
+kernel_start0:
+# line 47
+v.addi v1, v26, 0
+v.addi v2, v1, 0
+# line 48
+v.li v1, 0
+v.addi v3, v1, 0
+# line 51
+loop_start12:
+# line 54
+v.flw.u fv4, 636(sp)
+v.addi v1, v2, 0
+v.addi v1, v1, 1
+v.slli v1, v1, 2
+v.li v4, 616
+v.sub v1, v4, v1
+v.add v1, v1, sp
+v.flw fv5, 0(v1)
+v.fsub.s fv3, fv4, fv5
+v.fabs.s fv2, fv3
+v.flw.u fv5, 624(sp)
+v.addi v1, v2, 0
+v.addi v1, v1, 1
+v.slli v1, v1, 2
+v.li v4, 580
+v.sub v1, v4, v1
+v.add v1, v1, sp
+v.flw fv6, 0(v1)
+v.fsub.s fv4, fv5, fv6
+v.fabs.s fv3, fv4
+v.fadd.s fv1, fv2, fv3
+v.fmin.s fv2, fv1, fv1
+# line 55
+v.li v1, 0
+v.addi v4, v1, 0
+# line 57
+v.flw.u fv5, 632(sp)
+v.addi v1, v2, 0
+v.addi v1, v1, 1
+v.slli v1, v1, 2
+v.li v5, 616
+v.sub v1, v5, v1
+v.add v1, v1, sp
+v.flw fv6, 0(v1)
+v.fsub.s fv4, fv5, fv6
+v.fabs.s fv3, fv4
+v.flw.u fv6, 620(sp)
+v.addi v1, v2, 0
+v.addi v1, v1, 1
+v.slli v1, v1, 2
+v.li v5, 580
+v.sub v1, v5, v1
+v.add v1, v1, sp
+v.flw fv7, 0(v1)
+v.fsub.s fv5, fv6, fv7
+v.fabs.s fv4, fv5
+v.fadd.s fv1, fv3, fv4
+v.fmin.s fv3, fv1, fv1
+# line 58
+v.fmin.s fv6, fv3, fv3
+v.fmin.s fv10, fv2, fv2
+v.li v1, 1
+v.addi v5, v4, 0
+v.fminidx.s fv10, fv6, fv10
+v.fmin.s fv2, fv10, fv10
+v.addi v4, v5, 0
+# line 60
+v.flw.u fv6, 628(sp)
+v.addi v1, v2, 0
+v.addi v1, v1, 1
+v.slli v1, v1, 2
+v.li v5, 616
+v.sub v1, v5, v1
+v.add v1, v1, sp
+v.flw fv7, 0(v1)
+v.fsub.s fv5, fv6, fv7
+v.fabs.s fv4, fv5
+v.flw.u fv7, 616(sp)
+v.addi v1, v2, 0
+v.addi v1, v1, 1
+v.slli v1, v1, 2
+v.li v5, 580
+v.sub v1, v5, v1
+v.add v1, v1, sp
+v.flw fv8, 0(v1)
+v.fsub.s fv6, fv7, fv8
+v.fabs.s fv5, fv6
+v.fadd.s fv1, fv4, fv5
+v.fmin.s fv3, fv1, fv1
+# line 61
+v.fmin.s fv6, fv3, fv3
+v.fmin.s fv10, fv2, fv2
+v.li v1, 2
+v.addi v5, v4, 0
+v.fminidx.s fv10, fv6, fv10
+v.fmin.s fv2, fv10, fv10
+v.addi v4, v5, 0
+# line 63
+v.li v1, 0
+v.addi v5, v2, 0
+v.addi v5, v5, 1
+v.slli v5, v5, 2
+v.li v6, 172
+v.sub v5, v6, v5
+v.add v5, v5, sp
+v.sw v1, 0(v5)
+# line 64
+v.addi v5, v4, 0
+v.addi v7, v2, 0
+v.addi v7, v7, 1
+v.slli v7, v7, 2
+v.li v8, 544
+v.sub v7, v8, v7
+v.add v7, v7, sp
+v.lw v6, 0(v7)
+sx.slt s26, v5, v6
+v.li v5, 1
+v.addi v6, v2, 0
+v.addi v6, v6, 1
+v.slli v6, v6, 2
+v.li v7, 172
+v.sub v6, v7, v6
+v.add v6, v6, sp
+v.sw v5, 0(v6)
+s.li s26, 15
+# line 65
+v.addi v6, v2, 0
+v.addi v6, v6, 1
+v.slli v6, v6, 2
+v.li v7, 544
+v.sub v6, v7, v6
+v.add v6, v6, sp
+v.lw v5, 0(v6)
+v.addi v6, v4, 0
+sx.slt s26, v5, v6
+v.li v5, 1
+v.addi v6, v2, 0
+v.addi v6, v6, 1
+v.slli v6, v6, 2
+v.li v7, 172
+v.sub v6, v7, v6
+v.add v6, v6, sp
+v.sw v5, 0(v6)
+s.li s26, 15
+# line 66
+v.addi v1, v4, 0
+v.addi v5, v2, 0
+v.addi v5, v5, 1
+v.slli v5, v5, 2
+v.li v6, 544
+v.sub v5, v6, v5
+v.add v5, v5, sp
+v.sw v1, 0(v5)
+# line 69
+s.li s2, 0
+s.sw s2, 124(sp)
+for_start14:
+s.lw s3, 124(sp)
+s.li s4, 3
+s.slt s2, s3, s4
+s.beqz s2, for_end15
+# line 70
+v.lui v1, %hi(.LC0)
+v.flw fv1, %lo(.LC0)(v1)
+v.lw.u v1, 124(sp)
+v.muli v1, v1, 9
+v.addi v5, v2, 0
+v.add v1, v1, v5
+v.addi v1, v1, 1
+v.slli v1, v1, 2
+v.li v5, 388
+v.sub v1, v5, v1
+v.add v1, v1, sp
+v.fsw fv1, 0(v1)
+# line 71
+v.lui v1, %hi(.LC1)
+v.flw fv1, %lo(.LC1)(v1)
+v.lw.u v1, 124(sp)
+v.muli v1, v1, 9
+v.addi v5, v2, 0
+v.add v1, v1, v5
+v.addi v1, v1, 1
+v.slli v1, v1, 2
+v.li v5, 280
+v.sub v1, v5, v1
+v.add v1, v1, sp
+v.fsw fv1, 0(v1)
+# line 72
+v.li v1, 0
+v.lw.u v5, 124(sp)
+v.muli v5, v5, 9
+v.addi v6, v2, 0
+v.add v5, v5, v6
+v.addi v5, v5, 1
+v.slli v5, v5, 2
+v.li v6, 496
+v.sub v5, v6, v5
+v.add v5, v5, sp
+v.sw v1, 0(v5)
+# line 69
+for_update16:
+s.lw s2, 124(sp)
+s.addi s3, s2, 1
+s.sw s3, 124(sp)
+s.j for_start14
+for_end15:
+# line 74
+v.addi v1, v2, 0
+v.addi v1, v1, 1
+v.slli v1, v1, 2
+v.li v5, 616
+v.sub v1, v5, v1
+v.add v1, v1, sp
+v.flw fv1, 0(v1)
+v.addi v1, v4, 0
+v.muli v1, v1, 9
+v.addi v5, v2, 0
+v.add v1, v1, v5
+v.addi v1, v1, 1
+v.slli v1, v1, 2
+v.li v5, 388
+v.sub v1, v5, v1
+v.add v1, v1, sp
+v.fsw fv1, 0(v1)
+# line 75
+v.addi v1, v2, 0
+v.addi v1, v1, 1
+v.slli v1, v1, 2
+v.li v5, 580
+v.sub v1, v5, v1
+v.add v1, v1, sp
+v.flw fv1, 0(v1)
+v.addi v1, v4, 0
+v.muli v1, v1, 9
+v.addi v5, v2, 0
+v.add v1, v1, v5
+v.addi v1, v1, 1
+v.slli v1, v1, 2
+v.li v5, 280
+v.sub v1, v5, v1
+v.add v1, v1, sp
+v.fsw fv1, 0(v1)
+# line 76
+v.li v1, 1
+v.addi v5, v4, 0
+v.muli v5, v5, 9
+v.addi v6, v2, 0
+v.add v5, v5, v6
+v.addi v5, v5, 1
+v.slli v5, v5, 2
+v.li v6, 496
+v.sub v5, v6, v5
+v.add v5, v5, sp
+v.sw v1, 0(v5)
+# line 79
+s.li s2, 0
+s.sw s2, 120(sp)
+for_start17:
+s.lw s4, 120(sp)
+s.li s5, 4
+s.slt s2, s4, s5
+s.beqz s2, for_end18
+# line 81
+sync endsync20
+endsync20: 
+# line 83
+v.addi v5, v2, 0
+v.li v7, 1
+v.lw.u v8, 120(sp)
+v.sll v6, v7, v8
+v.add v1, v5, v6
+v.addi v5, v1, 0
+# line 86
+v.addi v6, v5, 0
+v.li v7, 9
+sx.slt s26, v6, v7
+# line 87
+s.li s2, 0
+s.sw s2, 124(sp)
+for_start21:
+s.lw s4, 124(sp)
+s.li s5, 3
+s.slt s2, s4, s5
+s.beqz s2, for_end22
+# line 88
+v.lw.u v6, 124(sp)
+v.muli v6, v6, 9
+v.addi v7, v2, 0
+v.add v6, v6, v7
+v.addi v6, v6, 1
+v.slli v6, v6, 2
+v.li v7, 388
+v.sub v6, v7, v6
+v.add v6, v6, sp
+v.flw fv4, 0(v6)
+v.lw.u v6, 124(sp)
+v.muli v6, v6, 9
+v.addi v7, v5, 0
+v.add v6, v6, v7
+v.addi v6, v6, 1
+v.slli v6, v6, 2
+v.li v7, 388
+v.sub v6, v7, v6
+v.add v6, v6, sp
+v.flw fv5, 0(v6)
+v.fadd.s fv1, fv4, fv5
+v.lw.u v6, 124(sp)
+v.muli v6, v6, 9
+v.addi v7, v2, 0
+v.add v6, v6, v7
+v.addi v6, v6, 1
+v.slli v6, v6, 2
+v.li v7, 388
+v.sub v6, v7, v6
+v.add v6, v6, sp
+v.fsw fv1, 0(v6)
+# line 89
+v.lw.u v6, 124(sp)
+v.muli v6, v6, 9
+v.addi v7, v2, 0
+v.add v6, v6, v7
+v.addi v6, v6, 1
+v.slli v6, v6, 2
+v.li v7, 280
+v.sub v6, v7, v6
+v.add v6, v6, sp
+v.flw fv4, 0(v6)
+v.lw.u v6, 124(sp)
+v.muli v6, v6, 9
+v.addi v7, v5, 0
+v.add v6, v6, v7
+v.addi v6, v6, 1
+v.slli v6, v6, 2
+v.li v7, 280
+v.sub v6, v7, v6
+v.add v6, v6, sp
+v.flw fv5, 0(v6)
+v.fadd.s fv1, fv4, fv5
+v.lw.u v6, 124(sp)
+v.muli v6, v6, 9
+v.addi v7, v2, 0
+v.add v6, v6, v7
+v.addi v6, v6, 1
+v.slli v6, v6, 2
+v.li v7, 280
+v.sub v6, v7, v6
+v.add v6, v6, sp
+v.fsw fv1, 0(v6)
+# line 90
+v.lw.u v8, 124(sp)
+v.muli v8, v8, 9
+v.addi v9, v2, 0
+v.add v8, v8, v9
+v.addi v8, v8, 1
+v.slli v8, v8, 2
+v.li v9, 496
+v.sub v8, v9, v8
+v.add v8, v8, sp
+v.lw v7, 0(v8)
+v.lw.u v9, 124(sp)
+v.muli v9, v9, 9
+v.addi v10, v5, 0
+v.add v9, v9, v10
+v.addi v9, v9, 1
+v.slli v9, v9, 2
+v.li v10, 496
+v.sub v9, v10, v9
+v.add v9, v9, sp
+v.lw v8, 0(v9)
+v.add v6, v7, v8
+v.lw.u v7, 124(sp)
+v.muli v7, v7, 9
+v.addi v8, v2, 0
+v.add v7, v7, v8
+v.addi v7, v7, 1
+v.slli v7, v7, 2
+v.li v8, 496
+v.sub v7, v8, v7
+v.add v7, v7, sp
+v.sw v6, 0(v7)
+# line 87
+for_update23:
+s.lw s2, 124(sp)
+s.addi s4, s2, 1
+s.sw s4, 124(sp)
+s.j for_start21
+for_end22:
+# line 92
+v.addi v8, v2, 0
+v.addi v8, v8, 1
+v.slli v8, v8, 2
+v.li v9, 172
+v.sub v8, v9, v8
+v.add v8, v8, sp
+v.lw v7, 0(v8)
+v.addi v9, v5, 0
+v.addi v9, v9, 1
+v.slli v9, v9, 2
+v.li v10, 172
+v.sub v9, v10, v9
+v.add v9, v9, sp
+v.lw v8, 0(v9)
+v.add v6, v7, v8
+v.addi v7, v2, 0
+v.addi v7, v7, 1
+v.slli v7, v7, 2
+v.li v8, 172
+v.sub v7, v8, v7
+v.add v7, v7, sp
+v.sw v6, 0(v7)
+# line 86
+s.li s26, 15
+# line 79
+for_update19:
+s.lw s2, 120(sp)
+s.addi s5, s2, 1
+s.sw s5, 120(sp)
+s.j for_start17
+for_end18:
+# line 99
+gsync
+# line 100
+v.addi v1, v3, 0
+v.addi v6, v1, 1
+v.addi v3, v6, 0
+# line 101
+s.li s2, 0
+s.sw s2, 124(sp)
+for_start24:
+s.lw s6, 124(sp)
+s.li s7, 3
+s.slt s2, s6, s7
+s.beqz s2, for_end25
+# line 102
+v.li v7, 0
+v.lw.u v9, 124(sp)
+v.muli v9, v9, 9
+v.li v10, 0
+v.add v9, v9, v10
+v.addi v9, v9, 1
+v.slli v9, v9, 2
+v.li v10, 496
+v.sub v9, v10, v9
+v.add v9, v9, sp
+v.lw v8, 0(v9)
+sx.slt s26, v7, v8
+# line 103
+v.lw.u v7, 124(sp)
+v.muli v7, v7, 9
+v.li v8, 0
+v.add v7, v7, v8
+v.addi v7, v7, 1
+v.slli v7, v7, 2
+v.li v8, 388
+v.sub v7, v8, v7
+v.add v7, v7, sp
+v.flw fv4, 0(v7)
+v.lw.u v8, 124(sp)
+v.muli v8, v8, 9
+v.li v9, 0
+v.add v8, v8, v9
+v.addi v8, v8, 1
+v.slli v8, v8, 2
+v.li v9, 496
+v.sub v8, v9, v8
+v.add v8, v8, sp
+v.lw v7, 0(v8)
+v.fcvt.s.w fv5, v7
+v.fdiv.s fv1, fv4, fv5
+v.lw.u v7, 124(sp)
+v.addi v7, v7, 1
+v.slli v7, v7, 2
+v.li v8, 640
+v.sub v7, v8, v7
+v.add v7, v7, sp
+v.fsw fv1, 0(v7)
+# line 104
+v.lw.u v7, 124(sp)
+v.muli v7, v7, 9
+v.li v8, 0
+v.add v7, v7, v8
+v.addi v7, v7, 1
+v.slli v7, v7, 2
+v.li v8, 280
+v.sub v7, v8, v7
+v.add v7, v7, sp
+v.flw fv4, 0(v7)
+v.lw.u v8, 124(sp)
+v.muli v8, v8, 9
+v.li v9, 0
+v.add v8, v8, v9
+v.addi v8, v8, 1
+v.slli v8, v8, 2
+v.li v9, 496
+v.sub v8, v9, v8
+v.add v8, v8, sp
+v.lw v7, 0(v8)
+v.fcvt.s.w fv5, v7
+v.fdiv.s fv1, fv4, fv5
+v.lw.u v7, 124(sp)
+v.addi v7, v7, 1
+v.slli v7, v7, 2
+v.li v8, 628
+v.sub v7, v8, v7
+v.add v7, v7, sp
+v.fsw fv1, 0(v7)
+# line 102
+s.li s26, 15
+# line 101
+for_update26:
+s.lw s2, 124(sp)
+s.addi s6, s2, 1
+s.sw s6, 124(sp)
+s.j for_start24
+for_end25:
+# line 107
+v.addi v1, v3, 0
+v.li v7, 1
+v.slli v7, v7, 2
+v.li v8, 500
+v.sub v7, v8, v7
+v.add v7, v7, sp
+v.sw v1, 0(v7)
+# line 108
+v.li v1, 0
+v.li v7, 1
+v.slli v7, v7, 2
+v.li v8, 136
+v.sub v7, v8, v7
+v.add v7, v7, sp
+v.sw v1, 0(v7)
+# line 109
+v.lw.u v7, 500(sp)
+v.lw.u v8, 168(sp)
+sx.slt s26, v7, v8
+v.li v7, 1
+v.li v8, 1
+v.slli v8, v8, 2
+v.li v9, 136
+v.sub v8, v9, v8
+v.add v8, v8, sp
+v.sw v7, 0(v8)
+s.li s26, 15
+# line 110
+v.lw.u v7, 504(sp)
+v.addi v9, v3, 0
+v.li v10, 1
+v.add v8, v9, v10
+sx.slt s26, v7, v8
+v.li v7, 0
+v.li v8, 1
+v.slli v8, v8, 2
+v.li v9, 136
+v.sub v8, v9, v8
+v.add v8, v8, sp
+v.sw v7, 0(v8)
+s.li s26, 15
+# line 113
+gsync
+# line 51
+s.li s7, 1
+s.slli s7, s7, 2
+s.li s8, 136
+s.sub s7, s8, s7
+s.add s7, s7, sp
+s.lw s2, 0(s7)
+s.beqz s2, loop_end13
+s.j loop_start12
+loop_end13:
+# line 46
+s.j warp_switch1
+kernel_end2:
+# line 117
+s.li s2, 636
+s.lw s3, 0(s2)
+s.li s2, 2496
+s.sw s3, 0(s2)
+s.li s2, 632
+s.lw s3, 0(s2)
+s.li s2, 2488
+s.sw s3, 0(s2)
+s.li s2, 628
+s.lw s3, 0(s2)
+s.li s2, 2476
+s.sw s3, 0(s2)
+# line 118
+s.li s2, 624
+s.lw s3, 0(s2)
+s.li s2, 2472
+s.sw s3, 0(s2)
+s.li s2, 620
+s.lw s3, 0(s2)
+s.li s2, 2464
+s.sw s3, 0(s2)
+s.li s2, 616
+s.lw s3, 0(s2)
+s.li s2, 2452
+s.sw s3, 0(s2)
+# line 119
+s.li s2, 496
+s.lw s3, 0(s2)
+s.li s2, 2448
+s.sw s3, 0(s2)
+# line 121
+s.li s1, 5
+s.j f_end
+# line 39
+f_end:
+s.lw s0, 640(sp)
+s.lw ra, 644(sp)
+s.addi sp, sp, 648
+exit
+.size f, .-f
+
+	.section .rodata
+	.align 2
+.LC0:
+	.word 0
+	.align 2
+.LC1:
+	.word 0
+
+	.data
@@ -0,0 +1,284 @@
+v.mul v20, x30, x31
+v.add v20, v20, x29
+v.srai v18, v20, 4
+v.slli v18, v18, 4
+s.li s1, 600
+s.lw s2, 6(s1)
+v.lw.u v7, 6(s1)
+s.lw s10, 8(s1)
+s.lw s6, 10(s1)
+s.slli s7, s6, 4
+v.lw.u v19, 10(s1)
+v.slli v19, v19, 4
+s.addi s11, s26, 0
+v.li v9, 1
+v.fcvt.s.w fv9, v9
+v.fcvt.s.w fv10, x0
+sx.slt s8, v20, v9
+s.li s9, 0
+iteration:
+v.fcvt.s.w fv11, x0
+v.fcvt.s.w fv12, x0
+v.fcvt.s.w fv13, x0
+v.fcvt.s.w fv14, x0
+v.fcvt.s.w fv15, x0
+v.fcvt.s.w fv16, x0
+v.li v10, 0
+v.li v11, 0
+v.li v12, 0
+v.li v13, 0
+v.addi v1, v20, 0
+s.li s3, 0
+assign_loop:
+s.slt s4, s3, s2
+beqz s4, assign_reduce
+sx.slt s26, v1, v7
+v.flw fv1, 1024(v1)
+v.flw fv2, 2048(v1)
+v.flw.u fv3, 0(s1)
+v.flw.u fv4, 1(s1)
+v.fsqdiff.s fv5, fv1, fv3
+v.fsqdiff.s fv6, fv2, fv4
+v.fadd.s fv7, fv5, fv6
+v.li v2, 0
+v.flw.u fv3, 2(s1)
+v.flw.u fv4, 3(s1)
+v.fsqdiff.s fv5, fv1, fv3
+v.fsqdiff.s fv6, fv2, fv4
+v.fadd.s fv8, fv5, fv6
+v.li v3, 1
+v.fminidx.s fv7, fv8, fv7
+v.flw.u fv3, 4(s1)
+v.flw.u fv4, 5(s1)
+v.fsqdiff.s fv5, fv1, fv3
+v.fsqdiff.s fv6, fv2, fv4
+v.fadd.s fv8, fv5, fv6
+v.li v3, 2
+v.fminidx.s fv7, fv8, fv7
+v.lw v3, 3072(v1)
+v.sw v2, 3072(v1)
+s.addi s26, s11, 0
+v.slt v8, v1, v7
+v.sub v4, v2, v3
+v.snez v4, v4
+v.mul v4, v4, v8
+v.add v13, v13, v4
+v.seqi v5, v2, 0
+v.mul v5, v5, v8
+v.add v10, v10, v5
+v.fcvt.s.w fv3, v5
+v.fmadd.s fv11, fv3, fv1, fv11
+v.fmadd.s fv14, fv3, fv2, fv14
+v.seqi v5, v2, 1
+v.mul v5, v5, v8
+v.add v11, v11, v5
+v.fcvt.s.w fv3, v5
+v.fmadd.s fv12, fv3, fv1, fv12
+v.fmadd.s fv15, fv3, fv2, fv15
+v.seqi v5, v2, 2
+v.mul v5, v5, v8
+v.add v12, v12, v5
+v.fcvt.s.w fv3, v5
+v.fmadd.s fv13, fv3, fv1, fv13
+v.fmadd.s fv16, fv3, fv2, fv16
+v.add v1, v1, v19
+s.add s3, s3, s7
+j assign_loop
+assign_reduce:
+v.li v6, 8
+v.fshfl.xor.s fv4, fv11, v6
+v.fmadd.s fv11, fv9, fv4, fv11
+v.fshfl.xor.s fv4, fv12, v6
+v.fmadd.s fv12, fv9, fv4, fv12
+v.fshfl.xor.s fv4, fv13, v6
+v.fmadd.s fv13, fv9, fv4, fv13
+v.fshfl.xor.s fv4, fv14, v6
+v.fmadd.s fv14, fv9, fv4, fv14
+v.fshfl.xor.s fv4, fv15, v6
+v.fmadd.s fv15, fv9, fv4, fv15
+v.fshfl.xor.s fv4, fv16, v6
+v.fmadd.s fv16, fv9, fv4, fv16
+v.shfl.xori v4, v10, 8
+v.add v10, v10, v4
+v.shfl.xori v4, v11, 8
+v.add v11, v11, v4
+v.shfl.xori v4, v12, 8
+v.add v12, v12, v4
+v.shfl.xori v4, v13, 8
+v.add v13, v13, v4
+v.li v6, 4
+v.fshfl.xor.s fv4, fv11, v6
+v.fmadd.s fv11, fv9, fv4, fv11
+v.fshfl.xor.s fv4, fv12, v6
+v.fmadd.s fv12, fv9, fv4, fv12
+v.fshfl.xor.s fv4, fv13, v6
+v.fmadd.s fv13, fv9, fv4, fv13
+v.fshfl.xor.s fv4, fv14, v6
+v.fmadd.s fv14, fv9, fv4, fv14
+v.fshfl.xor.s fv4, fv15, v6
+v.fmadd.s fv15, fv9, fv4, fv15
+v.fshfl.xor.s fv4, fv16, v6
+v.fmadd.s fv16, fv9, fv4, fv16
+v.shfl.xori v4, v10, 4
+v.add v10, v10, v4
+v.shfl.xori v4, v11, 4
+v.add v11, v11, v4
+v.shfl.xori v4, v12, 4
+v.add v12, v12, v4
+v.shfl.xori v4, v13, 4
+v.add v13, v13, v4
+v.li v6, 2
+v.fshfl.xor.s fv4, fv11, v6
+v.fmadd.s fv11, fv9, fv4, fv11
+v.fshfl.xor.s fv4, fv12, v6
+v.fmadd.s fv12, fv9, fv4, fv12
+v.fshfl.xor.s fv4, fv13, v6
+v.fmadd.s fv13, fv9, fv4, fv13
+v.fshfl.xor.s fv4, fv14, v6
+v.fmadd.s fv14, fv9, fv4, fv14
+v.fshfl.xor.s fv4, fv15, v6
+v.fmadd.s fv15, fv9, fv4, fv15
+v.fshfl.xor.s fv4, fv16, v6
+v.fmadd.s fv16, fv9, fv4, fv16
+v.shfl.xori v4, v10, 2
+v.add v10, v10, v4
+v.shfl.xori v4, v11, 2
+v.add v11, v11, v4
+v.shfl.xori v4, v12, 2
+v.add v12, v12, v4
+v.shfl.xori v4, v13, 2
+v.add v13, v13, v4
+v.li v6, 1
+v.fshfl.xor.s fv4, fv11, v6
+v.fmadd.s fv11, fv9, fv4, fv11
+v.fshfl.xor.s fv4, fv12, v6
+v.fmadd.s fv12, fv9, fv4, fv12
+v.fshfl.xor.s fv4, fv13, v6
+v.fmadd.s fv13, fv9, fv4, fv13
+v.fshfl.xor.s fv4, fv14, v6
+v.fmadd.s fv14, fv9, fv4, fv14
+v.fshfl.xor.s fv4, fv15, v6
+v.fmadd.s fv15, fv9, fv4, fv15
+v.fshfl.xor.s fv4, fv16, v6
+v.fmadd.s fv16, fv9, fv4, fv16
+v.shfl.xori v4, v10, 1
+v.add v10, v10, v4
+v.shfl.xori v4, v11, 1
+v.add v11, v11, v4
+v.shfl.xori v4, v12, 1
+v.add v12, v12, v4
+v.shfl.xori v4, v13, 1
+v.add v13, v13, v4
+v.fsw fv11, 6144(v18)
+v.fsw fv12, 6145(v18)
+v.fsw fv13, 6146(v18)
+v.fsw fv14, 6147(v18)
+v.fsw fv15, 6148(v18)
+v.fsw fv16, 6149(v18)
+v.sw v10, 6150(v18)
+v.sw v11, 6151(v18)
+v.sw v12, 6152(v18)
+v.sw v13, 6153(v18)
+gsync
+beqz s8, iteration_end
+v.fcvt.s.w fv11, x0
+v.fcvt.s.w fv12, x0
+v.fcvt.s.w fv13, x0
+v.fcvt.s.w fv14, x0
+v.fcvt.s.w fv15, x0
+v.fcvt.s.w fv16, x0
+v.li v10, 0
+v.li v11, 0
+v.li v12, 0
+v.li v13, 0
+s.li s5, 6144
+s.li s12, 0
+partials_loop:
+s.slt s4, s12, s6
+beqz s4, update
+v.flw.u fv4, 0(s5)
+v.fmadd.s fv11, fv9, fv4, fv11
+v.flw.u fv4, 1(s5)
+v.fmadd.s fv12, fv9, fv4, fv12
+v.flw.u fv4, 2(s5)
+v.fmadd.s fv13, fv9, fv4, fv13
+v.flw.u fv4, 3(s5)
+v.fmadd.s fv14, fv9, fv4, fv14
+v.flw.u fv4, 4(s5)
+v.fmadd.s fv15, fv9, fv4, fv15
+v.flw.u fv4, 5(s5)
+v.fmadd.s fv16, fv9, fv4, fv16
+v.lw.u v4, 6(s5)
+v.add v10, v10, v4
+v.lw.u v4, 7(s5)
+v.add v11, v11, v4
+v.lw.u v4, 8(s5)
+v.add v12, v12, v4
+v.lw.u v4, 9(s5)
+v.add v13, v13, v4
+s.addi s5, s5, 16
+s.addi s12, s12, 1
+j partials_loop
+update:
+v.snez v4, v10
+v.seqi v5, v10, 0
+v.fcvt.s.w fv7, v4
+v.fcvt.s.w fv8, v5
+v.fcvt.s.w fv5, v10
+v.fdiv.s fv6, fv11, fv5
+v.flw.u fv17, 0(s1)
+v.fmadd.s fv18, fv8, fv17, fv10
+v.fmadd.s fv6, fv7, fv6, fv18
+v.fsw fv6, 600(zero)
+v.fdiv.s fv6, fv14, fv5
+v.flw.u fv17, 1(s1)
+v.fmadd.s fv18, fv8, fv17, fv10
+v.fmadd.s fv6, fv7, fv6, fv18
+v.fsw fv6, 601(zero)
+v.snez v4, v11
+v.seqi v5, v11, 0
+v.fcvt.s.w fv7, v4
+v.fcvt.s.w fv8, v5
+v.fcvt.s.w fv5, v11
+v.fdiv.s fv6, fv12, fv5
+v.flw.u fv17, 2(s1)
+v.fmadd.s fv18, fv8, fv17, fv10
+v.fmadd.s fv6, fv7, fv6, fv18
+v.fsw fv6, 602(zero)
+v.fdiv.s fv6, fv15, fv5
+v.flw.u fv17, 3(s1)
+v.fmadd.s fv18, fv8, fv17, fv10
+v.fmadd.s fv6, fv7, fv6, fv18
+v.fsw fv6, 603(zero)
+v.snez v4, v12
+v.seqi v5, v12, 0
+v.fcvt.s.w fv7, v4
+v.fcvt.s.w fv8, v5
+v.fcvt.s.w fv5, v12
+v.fdiv.s fv6, fv13, fv5
+v.flw.u fv17, 4(s1)
+v.fmadd.s fv18, fv8, fv17, fv10
+v.fmadd.s fv6, fv7, fv6, fv18
+v.fsw fv6, 604(zero)
+v.fdiv.s fv6, fv16, fv5
+v.flw.u fv17, 5(s1)
+v.fmadd.s fv18, fv8, fv17, fv10
+v.fmadd.s fv6, fv7, fv6, fv18
+v.fsw fv6, 605(zero)
+v.sw v13, 607(zero)
+s.lw s13, 7(s1)
+s.lw s14, 9(s1)
+s.slt s15, s14, s13
+s.addi s16, s9, 1
+s.slt s17, s16, s10
+s.mul s15, s15, s17
+s.sw s16, 11(s1)
+s.sw s15, 12(s1)
+iteration_end:
+gsync
+s.addi s9, s9, 1
+s.lw s15, 12(s1)
+beqz s15, done
+j iteration
+done:
+exit
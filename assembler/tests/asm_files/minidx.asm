@@ -0,0 +1,19 @@
+v.flw fv7, 610(x29)
+v.li v2, 0
+v.flw fv8, 650(x29)
+v.li v3, 1
+v.fminidx.s fv7, fv8, fv7
+v.flw fv8, 690(x29)
+v.li v3, 2
+v.fminidx.s fv7, fv8, fv7
+v.fsw fv7, 900(x29)
+v.sw v2, 950(x29)
+s.li s1, 600
+s.flw fs7, 0(s1)
+s.li s2, 0
+s.flw fs8, 1(s1)
+s.li s3, 1
+s.fminidx.s fs7, fs8, fs7
+s.fsw fs7, 400(s1)
+s.sw s2, 401(s1)
+exit
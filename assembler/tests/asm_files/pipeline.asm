@@ -0,0 +1,13 @@
+s.li s1, 0
+s.li s2, 16
+v.li v1, 0
+loop:
+v.add v1, v1, x29
+v.addi v1, v1, 3
+v.sub v2, v1, x29
+v.add v1, v2, x29
+s.addi s1, s1, 1
+s.seq s3, s1, s2
+s.beqz s3, loop
+v.sw v1, 500(x29)
+exit
\ No newline at end of file
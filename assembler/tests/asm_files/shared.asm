@@ -0,0 +1,11 @@
+lui v1, 256
+v.slli v2, x29, 2
+v.add v2, v2, v1
+v.addi v5, x29, 100
+v.sw v5, 0(v2)
+sync
+v.lw v3, 4(v2)
+v.sw v3, 800(x29)
+v.lw v4, 0(v1)
+v.sw v4, 850(x29)
+exit
\ No newline at end of file
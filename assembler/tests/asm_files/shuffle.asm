@@ -0,0 +1,27 @@
+v.addi v1, x29, 0
+v.shfl.xori v2, v1, 8
+v.add v1, v1, v2
+v.shfl.xori v2, v1, 4
+v.add v1, v1, v2
+v.shfl.xori v2, v1, 2
+v.add v1, v1, v2
+v.shfl.xori v2, v1, 1
+v.add v1, v1, v2
+v.sw v1, 42(x29)
+v.li v3, 8
+v.shfl.down v4, x29, v3
+v.sw v4, 100(x29)
+v.fcvt.s.w fv1, x29
+v.fshfl.down.s fv2, fv1, v3
+v.fadd.s fv1, fv1, fv2
+v.li v3, 4
+v.fshfl.down.s fv2, fv1, v3
+v.fadd.s fv1, fv1, fv2
+v.li v3, 2
+v.fshfl.down.s fv2, fv1, v3
+v.fadd.s fv1, fv1, fv2
+v.li v3, 1
+v.fshfl.down.s fv2, fv1, v3
+v.fadd.s fv1, fv1, fv2
+v.fsw fv1, 200(x29)
+exit
\ No newline at end of file
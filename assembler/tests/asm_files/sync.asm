@@ -0,0 +1,6 @@
+v.sw x29, 300(x29)
+sync
+v.sub v1, x31, x29
+v.lw v2, 299(v1)
+v.sw v2, 400(x29)
+exit
\ No newline at end of file
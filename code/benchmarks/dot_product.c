@@ -0,0 +1,36 @@
+// Dot product, benchmark kernel (hardware/tb/bench.py)
+// One product per thread, then the same tree reduction as reduce.c over the products
+// Preprocessed with cpp -P -DN=<elements> -DHALF=<N / 2> before the compiler
+
+int f(){
+    float x[N];
+    float y[N];
+    float products[N];
+    float total[1];
+    int i;
+    int stride;
+    int j;
+
+    kernel(N){
+        i = threadId.x;
+        x[i] = 0.5 + (i * 3);
+        y[i] = 0.25 + (i * 5);
+        products[i] = x[i] * y[i];
+    }
+
+    for (stride = HALF; stride > 0; stride = stride >> 1) {
+        kernel(HALF){
+            i = threadId.x;
+            // An array index is a single name or constant, the partner index goes through j
+            j = i + stride;
+            if (i < stride) {
+                products[i] = products[i] + products[j];
+            }
+        }
+    }
+
+    total[0] = products[0];
+    OUT total[1];
+
+    return 5;
+}
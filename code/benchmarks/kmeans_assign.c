@@ -0,0 +1,47 @@
+// K-means assignment step, benchmark kernel (hardware/tb/bench.py)
+// N points of D dimensions against K centroids, every thread labels one point
+// Preprocessed with cpp -P -DN=<points> -DK=<centroids> -DD=<dimensions> before the compiler
+
+int f(){
+    float points[D][N];
+    float centroids[K][D];
+    int labels[N];
+    int i;
+    int k;
+    int d;
+    int best;
+    float best_distance;
+    float distance;
+
+    // Centroids spread over the point range
+    for (k = 0; k < K; k++) {
+        for (d = 0; d < D; d++) {
+            centroids[k][d] = 0.5 + (k * 97 + d * 31);
+        }
+    }
+
+    kernel(N){
+        i = threadId.x;
+        for (d = 0; d < D; d++) {
+            points[d][i] = 0.0 + (i * 7 + d * 13);
+        }
+
+        best = 0;
+        best_distance = 1000000000.0;
+        for (k = 0; k < K; k++) {
+            distance = 0.0;
+            for (d = 0; d < D; d++) {
+                distance = distance + fsqdiff(points[d][i], centroids[k][d]);
+            }
+            if (distance < best_distance) {
+                best_distance = distance;
+                best = k;
+            }
+        }
+        labels[i] = best;
+    }
+
+    OUT labels[N];
+
+    return 5;
+}
@@ -0,0 +1,30 @@
+// Matrix-vector product, benchmark kernel (hardware/tb/bench.py)
+// y = A x for a ROWS x COLS matrix, one thread per row
+// Preprocessed with cpp -P -DROWS=<rows> -DCOLS=<columns> before the compiler
+
+int f(){
+    float a[ROWS][COLS];
+    float x[COLS];
+    float y[ROWS];
+    float sum;
+    int i;
+    int j;
+
+    for (j = 0; j < COLS; j++) {
+        x[j] = 0.5 + (j * 3);
+    }
+
+    kernel(ROWS){
+        i = threadId.x;
+        sum = 0.0;
+        for (j = 0; j < COLS; j++) {
+            a[i][j] = 0.25 + (i * 7 + j);
+            sum = sum + a[i][j] * x[j];
+        }
+        y[i] = sum;
+    }
+
+    OUT y[ROWS];
+
+    return 5;
+}
@@ -0,0 +1,32 @@
+// Tree reduction, benchmark kernel (hardware/tb/bench.py)
+// Sums N values in log2(N) levels, every level is its own kernel so the levels are ordered across all warps
+// Preprocessed with cpp -P -DN=<values> -DHALF=<N / 2> before the compiler
+
+int f(){
+    float values[N];
+    float total[1];
+    int i;
+    int stride;
+    int j;
+
+    kernel(N){
+        i = threadId.x;
+        values[i] = 0.5 + (i * 3);
+    }
+
+    for (stride = HALF; stride > 0; stride = stride >> 1) {
+        kernel(HALF){
+            i = threadId.x;
+            // An array index is a single name or constant, the partner index goes through j
+            j = i + stride;
+            if (i < stride) {
+                values[i] = values[i] + values[j];
+            }
+        }
+    }
+
+    total[0] = values[0];
+    OUT total[1];
+
+    return 5;
+}
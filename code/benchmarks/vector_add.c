@@ -0,0 +1,21 @@
+// Vector addition, benchmark kernel (hardware/tb/bench.py)
+// c[i] = a[i] + b[i] over N elements, one thread per element
+// Preprocessed with cpp -P -DN=<elements> before the compiler
+
+int f(){
+    float a[N];
+    float b[N];
+    float c[N];
+    int i;
+
+    kernel(N){
+        i = threadId.x;
+        a[i] = 0.5 + (i * 3);
+        b[i] = 0.25 + (i * 5);
+        c[i] = a[i] + b[i];
+    }
+
+    OUT c[N];
+
+    return 5;
+}
@@ -0,0 +1,92 @@
+/*-----------------------------------------------------------------------------
+                    COMMAND QUEUE RUNTIME FOR ZYNQ PS
+   Queues kernel launches in the command queue of the PL (command_queue.sv),
+   which hands them to the dispatcher back to back. Header only, shared by
+   ps_driver.c and the Verilator testbenches.
+
+   A chain of kernels is pushed in one go and runs without the ARM in between.
+   A launch pushed with LAUNCH_FENCE stops the queue once it is done, so the
+   host can work on its results, command_queue_resume() lets the rest go.
+-------------------------------------------------------------------------------*/
+
+#ifndef COMMAND_QUEUE_H
+#define COMMAND_QUEUE_H
+
+#include <stdint.h>
+
+// --- Control and Status Registers, next to CONTROL_REG_OFFSET and STATUS_REG_OFFSET ---
+#define QUEUE_BASE_INSTR_REG_OFFSET      0x08 // Configuration of the next push (base_instr .. warps_per_block of gpu.sv)
+#define QUEUE_BASE_DATA_REG_OFFSET       0x0C
+#define QUEUE_NUM_BLOCKS_REG_OFFSET      0x10
+#define QUEUE_WARPS_PER_BLOCK_REG_OFFSET 0x14
+#define QUEUE_PUSH_REG_OFFSET            0x18 // Write the launch flags to push the configuration above
+#define QUEUE_STATUS_REG_OFFSET          0x1C // Bits below, launches waiting in bits 15:8
+#define QUEUE_COMPLETED_REG_OFFSET       0x34 // Launches done since reset
+#define QUEUE_CONTROL_REG_OFFSET         0x38 // Write QUEUE_RESUME and/or QUEUE_CLEAR_INTERRUPT
+
+#define QUEUE_STATUS_FULL      (1u << 0)
+#define QUEUE_STATUS_BUSY      (1u << 1) // A launch is running or waiting
+#define QUEUE_STATUS_FENCED    (1u << 2) // Stopped after a LAUNCH_FENCE launch
+#define QUEUE_STATUS_INTERRUPT (1u << 3)
+#define QUEUE_STATUS_COUNT(status) (((status) >> 8) & 0xFFu)
+
+#define QUEUE_RESUME          (1u << 0)
+#define QUEUE_CLEAR_INTERRUPT (1u << 1)
+
+#define QUEUE_DEPTH 8
+
+// --- Launch flags (LAUNCH_FLAG_* in common.svh) ---
+#define LAUNCH_FENCE     (1u << 0) // The queue stops after this launch until command_queue_resume()
+#define LAUNCH_INTERRUPT (1u << 1) // Raises the interrupt when this launch is done
+
+typedef struct {
+    uint32_t base_instr;      // Instruction memory address of the kernel
+    uint32_t base_data;       // Data memory address of its arguments
+    uint32_t num_blocks;      // Launches of 0 blocks are dropped by the queue
+    uint32_t warps_per_block;
+} kernel_launch_t;
+
+static inline uint32_t command_queue_status(volatile void* regs) {
+    volatile uint32_t* words = (volatile uint32_t*)regs;
+    return words[QUEUE_STATUS_REG_OFFSET / 4];
+}
+
+// Pushes a launch, waits while the queue is full. Returns straight away, the launch runs when the ones
+// before it are done
+static inline void command_queue_push(volatile void* regs, const kernel_launch_t* launch, uint32_t flags) {
+    volatile uint32_t* words = (volatile uint32_t*)regs;
+    while (command_queue_status(regs) & QUEUE_STATUS_FULL) {
+    }
+    words[QUEUE_BASE_INSTR_REG_OFFSET / 4] = launch->base_instr;
+    words[QUEUE_BASE_DATA_REG_OFFSET / 4] = launch->base_data;
+    words[QUEUE_NUM_BLOCKS_REG_OFFSET / 4] = launch->num_blocks;
+    words[QUEUE_WARPS_PER_BLOCK_REG_OFFSET / 4] = launch->warps_per_block;
+    words[QUEUE_PUSH_REG_OFFSET / 4] = flags & (LAUNCH_FENCE | LAUNCH_INTERRUPT);
+}
+
+// Waits until every launch is done or the queue stopped at a fence, returns the status at that point
+static inline uint32_t command_queue_wait(volatile void* regs) {
+    uint32_t status;
+    do {
+        status = command_queue_status(regs);
+    } while ((status & QUEUE_STATUS_BUSY) && !(status & QUEUE_STATUS_FENCED));
+    return status;
+}
+
+// Lets the launches behind a fence run
+static inline void command_queue_resume(volatile void* regs) {
+    volatile uint32_t* words = (volatile uint32_t*)regs;
+    words[QUEUE_CONTROL_REG_OFFSET / 4] = QUEUE_RESUME;
+}
+
+static inline void command_queue_clear_interrupt(volatile void* regs) {
+    volatile uint32_t* words = (volatile uint32_t*)regs;
+    words[QUEUE_CONTROL_REG_OFFSET / 4] = QUEUE_CLEAR_INTERRUPT;
+}
+
+static inline uint32_t command_queue_completed(volatile void* regs) {
+    volatile uint32_t* words = (volatile uint32_t*)regs;
+    return words[QUEUE_COMPLETED_REG_OFFSET / 4];
+}
+
+#endif
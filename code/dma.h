@@ -0,0 +1,108 @@
+/*-----------------------------------------------------------------------------
+                      DMA ENGINE RUNTIME FOR ZYNQ PS
+   Builds descriptor chains for the DMA engine of the PL (dma_engine.sv) and
+   starts them through its control registers. Header only, shared by
+   ps_driver.c and the Verilator testbenches.
+
+   The descriptors and the buffers they point to live in DDR the PL can reach,
+   the caller maps that region itself (/dev/mem with O_SYNC on a reserved
+   region, so the ARM caches are out of the way) and passes both its virtual
+   and its physical address.
+-------------------------------------------------------------------------------*/
+
+#ifndef DMA_H
+#define DMA_H
+
+#include <stdint.h>
+
+// --- Control and Status Registers, next to CONTROL_REG_OFFSET and STATUS_REG_OFFSET ---
+#define DMA_CONTROL_REG_OFFSET    0x20 // Write 1 to start the chain, 0 to clear done
+#define DMA_STATUS_REG_OFFSET     0x24 // Bit 0 busy, bit 1 done
+#define DMA_DESCRIPTOR_REG_OFFSET 0x28 // Physical address of the first descriptor
+#define DMA_COMPLETED_REG_OFFSET  0x2C // Descriptors finished since the last start
+#define DMA_WORDS_REG_OFFSET      0x30 // Words copied since the last start
+
+#define DMA_STATUS_BUSY (1u << 0)
+#define DMA_STATUS_DONE (1u << 1)
+
+// --- Descriptor, four words in DDR (layout read by dma_engine.sv) ---
+#define DMA_MAX_WORDS     0xFFFFFFu
+#define DMA_TO_DDR        (1u << 24) // Data memory to DDR, DDR to data memory otherwise
+#define DMA_MEM_WORD_STEP (1u << 25) // Data memory addresses step by 1 (assembly kernels), by 4 otherwise
+
+typedef struct {
+    uint32_t next;        // Physical address of the next descriptor, 0 ends the chain
+    uint32_t ddr_address; // Physical byte address in DDR
+    uint32_t mem_address; // Data memory address, as the kernel sees it
+    uint32_t control;     // Number of words | DMA_TO_DDR | DMA_MEM_WORD_STEP
+} dma_descriptor_t;
+
+typedef struct {
+    volatile dma_descriptor_t* descriptors; // Virtual address of the descriptor area
+    uint32_t physical;                      // Its physical address
+    uint32_t capacity;                      // Number of descriptors that fit
+    uint32_t count;                         // Number of descriptors in the chain
+} dma_chain_t;
+
+static inline void dma_chain_init(dma_chain_t* chain, volatile void* descriptors, uint32_t physical, uint32_t capacity) {
+    chain->descriptors = (volatile dma_descriptor_t*)descriptors;
+    chain->physical = physical;
+    chain->capacity = capacity;
+    chain->count = 0;
+}
+
+// Empties the chain, the descriptor area is reused by the next dma_chain_add
+static inline void dma_chain_clear(dma_chain_t* chain) {
+    chain->count = 0;
+}
+
+// Appends a copy of words words to the chain and links it behind the previous descriptor.
+// Returns 0, or -1 when the chain is full or the copy is too long
+static inline int dma_chain_add(dma_chain_t* chain, uint32_t ddr_address, uint32_t mem_address, uint32_t words, uint32_t flags) {
+    if (chain->count >= chain->capacity || words > DMA_MAX_WORDS) {
+        return -1;
+    }
+
+    volatile dma_descriptor_t* descriptor = &chain->descriptors[chain->count];
+    descriptor->next = 0;
+    descriptor->ddr_address = ddr_address;
+    descriptor->mem_address = mem_address;
+    descriptor->control = words | (flags & (DMA_TO_DDR | DMA_MEM_WORD_STEP));
+
+    if (chain->count > 0) {
+        chain->descriptors[chain->count - 1].next = chain->physical + chain->count * (uint32_t)sizeof(dma_descriptor_t);
+    }
+    chain->count++;
+    return 0;
+}
+
+// Physical address of the first descriptor, 0 for an empty chain (the engine is then done straight away)
+static inline uint32_t dma_chain_head(const dma_chain_t* chain) {
+    return chain->count > 0 ? chain->physical : 0;
+}
+
+// Starts the chain and returns straight away, a kernel can be launched while it runs.
+// regs is the mapped control register window (the same one CONTROL_REG_OFFSET is relative to)
+static inline void dma_start(volatile void* regs, const dma_chain_t* chain) {
+    volatile uint32_t* words = (volatile uint32_t*)regs;
+    words[DMA_CONTROL_REG_OFFSET / 4] = 0;
+    words[DMA_DESCRIPTOR_REG_OFFSET / 4] = dma_chain_head(chain);
+    words[DMA_CONTROL_REG_OFFSET / 4] = 1;
+}
+
+static inline int dma_done(volatile void* regs) {
+    volatile uint32_t* words = (volatile uint32_t*)regs;
+    return (words[DMA_STATUS_REG_OFFSET / 4] & DMA_STATUS_DONE) != 0;
+}
+
+// Waits for the chain to finish and clears done, returns the number of descriptors it completed
+static inline uint32_t dma_wait(volatile void* regs) {
+    volatile uint32_t* words = (volatile uint32_t*)regs;
+    while (!dma_done(regs)) {
+    }
+    uint32_t completed = words[DMA_COMPLETED_REG_OFFSET / 4];
+    words[DMA_CONTROL_REG_OFFSET / 4] = 0;
+    return completed;
+}
+
+#endif
@@ -1,80 +1,122 @@
 // K-means Kernel Definition
-// Input for custom C-to-ElsonV for the PL
-
-// Inputs (Read-only by the kernel)
-float centroids_x[3];
-float centroids_y[3];
-float points_x[9];
-float points_y[9];
-
-// Temporary memory for kernel calculation
-float distances[3][9];
-float shortest_distance[9];
-int best_centroid_index[9];
-
-
-// Reduction buffers
-// The final resutls will be in index [0] of each cluster's array
-float total[3][9];
-float sum_x[3][9];
-float sum_y[3][9];
-
-// -------------------------------
-//          KERNEL LOGIC
-// ------------------------------
-kernel(9) {
-    int i = threadId.x;
+// Input for custom C-to-ElsonV for the PL (compiler/bin/c_compiler), the arrays are the locals of f()
+// in this order and the host passes them through data memory, the asm is under assembler/tests
+
+int f(){
+    // Inputs (the centroids are updated in place at the end of every iteration)
+    float centroids_x[3];
+    float centroids_y[3];
+    float points_x[9];
+    float points_y[9];
+
+    // Label of every point in the previous iteration, the host starts it at -1
+    int prev_label[9];
+
+    // Loop control, the kernel stops after max_iterations[0] or once at most threshold[0] points changed cluster
+    int max_iterations[1];
+    int threshold[1];
+    // Iterations run, written by the kernel
+    int iterations[1];
+
+    // Reduction buffers
+    // The final resutls will be in index [0] of each cluster's array
+    int total[3][9];
+    float sum_x[3][9];
+    float sum_y[3][9];
+    // Points that changed cluster in the last iteration, the result is in changed[0]
+    int changed[9];
+    // Set at the end of every iteration when another one follows
+    int running[1];
+
+    // Thread variables
+    int i;
     int k;
     int h;
     int index;
     int best_centroid;
+    float best;
+    float d;
+    int iter;
 
-    // 1. Assignment Step: Find the nearest centroid for my point
-    distances[0][i] = fabsf(centroids_x[0] - points_x[i]) + fabsf(centroids_y[0] - points_y[i]);
-    distances[1][i] = fabsf(centroids_x[1] - points_x[i]) + fabsf(centroids_y[1] - points_y[i]);
-    distances[2][i] = fabsf(centroids_x[2] - points_x[i]) + fabsf(centroids_y[2] - points_y[i]);
-
-    if (distances[0][i] < distances[1][i]) {
-        shortest_distance[i] = distances[0][i];
-        best_centroid_index[i] = 0;
-    } else {
-        shortest_distance[i] = distances[1][i];
-        best_centroid_index[i] = 1;
-    }
+    // -------------------------------
+    //          KERNEL LOGIC
+    // ------------------------------
+    // A kernel compares with < only (sx.slt sets the thread mask) and its ifs don't nest, the loop
+    // conditions are uniform: read from the arrays, not from thread variables
+    kernel(9) {
+        i = threadId.x;
+        iter = 0;
 
-    if (distances[2][i] < shortest_distance[i]) {
-        best_centroid_index[i] = 2;
-    }
+        // The whole run is one launch, the host waits once
+        do {
+            // 1. Assignment Step: Find the nearest centroid for my point
+            // Every update is on locals, so it compiles to one fminidx.s (ties keep the lower centroid)
+            best = fabsf(centroids_x[0] - points_x[i]) + fabsf(centroids_y[0] - points_y[i]);
+            best_centroid = 0;
 
-    best_centroid = best_centroid_index[i];
-
-    // 2. Update preparation: Initialize reduction buffers
-    for (k = 0; k < 3; k++) {
-        if (k == best_centroid) {
-            sum_x[k][i] = points_x[i];
-            sum_y[k][i] = points_y[i];
-            total[k][i] = 1.0;
-        } else {
-            sum_x[k][i] = 0.0;
-            sum_y[k][i] = 0.0;
-            total[k][i] = 0.0;
-        }
-    }
+            d = fabsf(centroids_x[1] - points_x[i]) + fabsf(centroids_y[1] - points_y[i]);
+            if (d < best) { best = d; best_centroid = 1; }
+
+            d = fabsf(centroids_x[2] - points_x[i]) + fabsf(centroids_y[2] - points_y[i]);
+            if (d < best) { best = d; best_centroid = 2; }
 
-    // 3. Parallel Reduction Sum
-    for (h = 0; h < 4; h++) {
-        // Synchronization barrier: All threads must wait here before the next step.
-        sync;
+            changed[i] = 0;
+            if (best_centroid < prev_label[i]) { changed[i] = 1; }
+            if (prev_label[i] < best_centroid) { changed[i] = 1; }
+            prev_label[i] = best_centroid;
 
-        index = i + (1 << h); // Calculate partner thread index
+            // 2. Update preparation: Initialize reduction buffers
+            for (k = 0; k < 3; k++) {
+                sum_x[k][i] = 0.0;
+                sum_y[k][i] = 0.0;
+                total[k][i] = 0;
+            }
+            sum_x[best_centroid][i] = points_x[i];
+            sum_y[best_centroid][i] = points_y[i];
+            total[best_centroid][i] = 1;
+
+            // 3. Parallel Reduction Sum
+            for (h = 0; h < 4; h++) {
+                // Synchronization barrier: All threads must wait here before the next step.
+                sync;
 
-        // Boundary check to ensure we don't read out of bounds.
-        if (index < 9) {
+                index = i + (1 << h); // Calculate partner thread index
+
+                // Boundary check to ensure we don't read out of bounds.
+                if (index < 9) {
+                    for (k = 0; k < 3; k++) {
+                        sum_x[k][i] += sum_x[k][index];
+                        sum_y[k][i] += sum_y[k][index];
+                        total[k][i] += total[k][index];
+                    }
+                    changed[i] += changed[index];
+                }
+            }
+
+            // 4. Update Step: new centroids from the sums, an empty cluster keeps its centroid
+            // gsync is the grid barrier, the centroids only change once every warp is done with them.
+            // Every thread writes the same values, so no thread has to be singled out
+            gsync;
+            iter++;
             for (k = 0; k < 3; k++) {
-                sum_x[k][i] += sum_x[k][index];
-                sum_y[k][i] += sum_y[k][index];
-                total[k][i] += total[k][index];
+                if (0 < total[k][0]) {
+                    centroids_x[k] = sum_x[k][0] / total[k][0];
+                    centroids_y[k] = sum_y[k][0] / total[k][0];
+                }
             }
-        }
+            iterations[0] = iter;
+            running[0] = 0;
+            if (threshold[0] < changed[0]) { running[0] = 1; }
+            if (max_iterations[0] < iter + 1) { running[0] = 0; }
+
+            // 5. Loop control: the sums are only cleared for the next iteration once every warp has read them
+            gsync;
+        } while (running[0]);
     }
+
+    OUT centroids_x[3];
+    OUT centroids_y[3];
+    OUT iterations[1];
+
+    return 5;
 }
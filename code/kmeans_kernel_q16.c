@@ -0,0 +1,126 @@
+// K-means Kernel Definition, Q16.16 fixed point
+// Input for custom C-to-ElsonV for the PL (compiler/bin/c_compiler), run by ps_driver.c built with -DFIXED_POINT
+// Same layout, steps and L1 distance as kmeans_kernel.c on the integer ALU (fabsf of a q16 is abs),
+// with one difference: there is no divider for integers, the means multiply by reciprocal[n] = 1 / n
+// written by the host. The asm is under assembler/tests
+
+int f(){
+    // Inputs (the centroids are updated in place at the end of every iteration)
+    q16 centroids_x[3];
+    q16 centroids_y[3];
+    q16 points_x[9];
+    q16 points_y[9];
+
+    // Label of every point in the previous iteration, the host starts it at -1
+    int prev_label[9];
+
+    // Loop control, the kernel stops after max_iterations[0] or once at most threshold[0] points changed cluster
+    int max_iterations[1];
+    int threshold[1];
+    // Iterations run, written by the kernel
+    int iterations[1];
+    // 1 / n for every cluster size n, reciprocal[0] is unused
+    q16 reciprocal[10];
+
+    // Reduction buffers
+    // The final resutls will be in index [0] of each cluster's array
+    q16 total[3][9];
+    q16 sum_x[3][9];
+    q16 sum_y[3][9];
+    // Points that changed cluster in the last iteration, the result is in changed[0]
+    int changed[9];
+    // Set at the end of every iteration when another one follows
+    int running[1];
+
+    // Thread variables
+    int i;
+    int k;
+    int h;
+    int index;
+    int best_centroid;
+    q16 best;
+    q16 d;
+    int iter;
+
+    // -------------------------------
+    //          KERNEL LOGIC
+    // ------------------------------
+    // A kernel compares with < only (sx.slt sets the thread mask) and its ifs don't nest, the loop
+    // conditions are uniform: read from the arrays, not from thread variables
+    kernel(9) {
+        i = threadId.x;
+        iter = 0;
+
+        // The whole run is one launch, the host waits once
+        do {
+            // 1. Assignment Step: Find the nearest centroid for my point
+            // Ties keep the lower centroid
+            best = fabsf(centroids_x[0] - points_x[i]) + fabsf(centroids_y[0] - points_y[i]);
+            best_centroid = 0;
+
+            d = fabsf(centroids_x[1] - points_x[i]) + fabsf(centroids_y[1] - points_y[i]);
+            if (d < best) { best = d; best_centroid = 1; }
+
+            d = fabsf(centroids_x[2] - points_x[i]) + fabsf(centroids_y[2] - points_y[i]);
+            if (d < best) { best = d; best_centroid = 2; }
+
+            changed[i] = 0;
+            if (best_centroid < prev_label[i]) { changed[i] = 1; }
+            if (prev_label[i] < best_centroid) { changed[i] = 1; }
+            prev_label[i] = best_centroid;
+
+            // 2. Update preparation: Initialize reduction buffers
+            for (k = 0; k < 3; k++) {
+                sum_x[k][i] = 0;
+                sum_y[k][i] = 0;
+                total[k][i] = 0;
+            }
+            sum_x[best_centroid][i] = points_x[i];
+            sum_y[best_centroid][i] = points_y[i];
+            total[best_centroid][i] = q16_from_int(1);
+
+            // 3. Parallel Reduction Sum
+            for (h = 0; h < 4; h++) {
+                // Synchronization barrier: All threads must wait here before the next step.
+                sync;
+
+                index = i + (1 << h); // Calculate partner thread index
+
+                // Boundary check to ensure we don't read out of bounds.
+                if (index < 9) {
+                    for (k = 0; k < 3; k++) {
+                        sum_x[k][i] += sum_x[k][index];
+                        sum_y[k][i] += sum_y[k][index];
+                        total[k][i] += total[k][index];
+                    }
+                    changed[i] += changed[index];
+                }
+            }
+
+            // 4. Update Step: new centroids from the sums, an empty cluster keeps its centroid
+            // gsync is the grid barrier, the centroids only change once every warp is done with them.
+            // Every thread writes the same values, so no thread has to be singled out
+            gsync;
+            iter++;
+            for (k = 0; k < 3; k++) {
+                if (0 < total[k][0]) {
+                    centroids_x[k] = sum_x[k][0] * reciprocal[q16_to_int(total[k][0])];
+                    centroids_y[k] = sum_y[k][0] * reciprocal[q16_to_int(total[k][0])];
+                }
+            }
+            iterations[0] = iter;
+            running[0] = 0;
+            if (threshold[0] < changed[0]) { running[0] = 1; }
+            if (max_iterations[0] < iter + 1) { running[0] = 0; }
+
+            // 5. Loop control: the sums are only cleared for the next iteration once every warp has read them
+            gsync;
+        } while (running[0]);
+    }
+
+    OUT centroids_x[3];
+    OUT centroids_y[3];
+    OUT iterations[1];
+
+    return 5;
+}
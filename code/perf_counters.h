@@ -0,0 +1,41 @@
+/*-----------------------------------------------------------------------------
+                    PERFORMANCE COUNTER MAP FOR ZYNQ PS
+   Word index of every counter of the counter block of the PL
+   (perf_counters.sv), in the order of perf_counter_t in common.svh. Header
+   only, shared by ps_driver.c and the Verilator testbenches.
+
+   The block keeps a snapshot of the last kernel, the host reads counter n at
+   PERF_COUNTERS_OFFSET + 4 * n. tools/tests/perf_counters_test.cpp checks
+   the indices against common.svh.
+-------------------------------------------------------------------------------*/
+
+#ifndef PERF_COUNTERS_H
+#define PERF_COUNTERS_H
+
+#define PERF_COUNTERS_OFFSET 0x40
+
+#define PERF_CYCLES                     0  // Launch to execution_done
+#define PERF_MEM_BUSY_CYCLES            1  // Cycles with a request on any data memory channel
+#define PERF_BLOCKS                     2  // Blocks completed
+// Summed over the cores
+#define PERF_INSTRUCTIONS_SCALAR        3
+#define PERF_INSTRUCTIONS_VECTOR        4
+#define PERF_INSTRUCTIONS_FPU           5  // Scalar and vector
+#define PERF_INSTRUCTIONS_MEMORY        6  // Loads and stores
+#define PERF_ACTIVE_LANES               7  // Enabled lanes summed over the vector instructions
+#define PERF_LSU_WAIT_CYCLES            8  // Cycles with an LSU request outstanding
+#define PERF_ICACHE_HITS                9
+#define PERF_ICACHE_MISSES              10
+#define PERF_COALESCER_LANE_REQUESTS    11
+#define PERF_COALESCER_MEM_TRANSACTIONS 12
+#define PERF_SCRATCHPAD_ACCESSES        13
+#define PERF_SCRATCHPAD_BANK_CONFLICTS  14
+#define PERF_WARP_ISSUE_CYCLES          15 // Summed over the warps
+#define PERF_WARP_STALL_CYCLES          16
+#define PERF_WARP_IDLE_CYCLES           17
+#define PERF_WARP_STATE_CYCLES          18 // First of NUM_WARP_STATES counters, one per warp_state_t
+
+#define NUM_WARP_STATES   12
+#define PERF_NUM_COUNTERS (PERF_WARP_STATE_CYCLES + NUM_WARP_STATES)
+
+#endif // PERF_COUNTERS_H
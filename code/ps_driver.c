@@ -5,14 +5,38 @@
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <stdint.h>
+#include <math.h>
 #include <fcntl.h>
 #include <sys/mman.h>
 #include <unistd.h>
 
+#include "dma.h"
+#include "command_queue.h"
+#include "perf_counters.h"
+
 // --- Constants for the driver ---
 #define NUM_POINTS 9
 #define NUM_CLUSTERS 3
-#define MAX_ITER 2
+#define MAX_ITER 20 // The kernel stops earlier once at most CONVERGENCE_THRESHOLD points change cluster
+#define CONVERGENCE_THRESHOLD 0
+
+// --- Kernel launch, the compiled kernel runs its warps itself ---
+#define KERNEL_BASE_INSTR 0x0
+#define KERNEL_BASE_DATA 0x0
+
+// --- Number format of the data in PL memory ---
+// Build with -DFIXED_POINT for the Q16.16 kernel (kmeans_kernel_q16.c): every value is then stored as the
+// int32 x * 2^16. The default build runs kmeans_kernel.c on floats. Load the matching kernel into the PL
+#ifdef FIXED_POINT
+typedef int32_t value_t;
+static inline value_t to_value(float x) { return (value_t)(x * 65536.0f + (x < 0 ? -0.5f : 0.5f)); }
+static inline float from_value(value_t v) { return (float)v / 65536.0f; }
+#else
+typedef float value_t;
+static inline value_t to_value(float x) { return x; }
+static inline float from_value(value_t v) { return v; }
+#endif
 
 /*-----------------------------------------------------------------------------
                       THE HARDWARE MEMORY MAP "CONTRACT"
@@ -24,21 +48,82 @@
 // Total size of the memory space to map
 #define BRAM_SIZE 0x10000 // 64 KB, more than enough
 
+// DDR region for the DMA engine, kept away from Linux with a reserved-memory node in the device tree.
+// Mapped through /dev/mem with O_SYNC, so the ARM writes reach DDR before the PL reads them
+#define DDR_BUFFER_PHYSICAL_ADDR 0x1F000000
+#define DDR_BUFFER_SIZE 0x10000
+#define DDR_DESCRIPTORS_OFFSET 0x0000  // Room for MAX_DESCRIPTORS descriptors
+#define DDR_INPUTS_OFFSET 0x1000       // Same order and sizes as the data arrays below
+#define DDR_RESULTS_OFFSET 0x8000      // Final centroids copied back by the DMA engine
+#define MAX_DESCRIPTORS 12
+
 // --- Control and Status Registers ---
 #define CONTROL_REG_OFFSET 0x00 // Offset 0: Write 1 to start, 0 to clear
 #define STATUS_REG_OFFSET  0x04 // Offset 4: Read bit 0 for done status (1 = done)
+// Kernels are launched through the command queue instead (command_queue.h), the whole run is one launch
+
+// --- Performance Counters (perf_counters.h, snapshot of the last kernel) ---
+#define THREADS_PER_WARP            16 // Lanes behind every vector instruction, for the lane utilisation
 
 // --- Data Array Offsets (in bytes, calculated from the PL memory layout) ---
 // These must be calculated based on the order and size of arrays in kmeans_kernel.c
 #define CENTROIDS_X_OFFSET  0x100  // Start data at an offset for clarity
-#define CENTROIDS_Y_OFFSET  (CENTROIDS_X_OFFSET + NUM_CLUSTERS * sizeof(float))
-#define POINTS_X_OFFSET     (CENTROIDS_Y_OFFSET + NUM_CLUSTERS * sizeof(float))
-#define POINTS_Y_OFFSET     (POINTS_X_OFFSET + NUM_POINTS * sizeof(float))
-// Note: Skipping scratchpad arrays, as PS doesn't need to access them directly.
-#define TOTAL_OFFSET        (POINTS_Y_OFFSET + NUM_POINTS * sizeof(float))
-#define SUM_X_OFFSET        (TOTAL_OFFSET + NUM_CLUSTERS * NUM_POINTS * sizeof(float))
-#define SUM_Y_OFFSET        (SUM_X_OFFSET + NUM_CLUSTERS * NUM_POINTS * sizeof(float))
+#define CENTROIDS_Y_OFFSET  (CENTROIDS_X_OFFSET + NUM_CLUSTERS * sizeof(value_t))
+#define POINTS_X_OFFSET     (CENTROIDS_Y_OFFSET + NUM_CLUSTERS * sizeof(value_t))
+#define POINTS_Y_OFFSET     (POINTS_X_OFFSET + NUM_POINTS * sizeof(value_t))
+#define PREV_LABEL_OFFSET   (POINTS_Y_OFFSET + NUM_POINTS * sizeof(value_t))
+#define MAX_ITERATIONS_OFFSET (PREV_LABEL_OFFSET + NUM_POINTS * sizeof(int32_t))
+#define THRESHOLD_OFFSET    (MAX_ITERATIONS_OFFSET + sizeof(int32_t))
+#define ITERATIONS_OFFSET   (THRESHOLD_OFFSET + sizeof(int32_t))
+#ifdef FIXED_POINT
+// 1 / n for n = 0..NUM_POINTS, the Q16 kernel multiplies by it in place of dividing
+#define RECIPROCAL_OFFSET   (ITERATIONS_OFFSET + sizeof(int32_t))
+#define TOTAL_OFFSET        (RECIPROCAL_OFFSET + (NUM_POINTS + 1) * sizeof(value_t))
+#else
+#define TOTAL_OFFSET        (ITERATIONS_OFFSET + sizeof(int32_t))
+#endif
+#define SUM_X_OFFSET        (TOTAL_OFFSET + NUM_CLUSTERS * NUM_POINTS * sizeof(value_t))
+#define SUM_Y_OFFSET        (SUM_X_OFFSET + NUM_CLUSTERS * NUM_POINTS * sizeof(value_t))
+#define CHANGED_OFFSET      (SUM_Y_OFFSET + NUM_CLUSTERS * NUM_POINTS * sizeof(value_t))
 
+/*-----------------------------------------------------------------------------
+   Host reference of the kernel in float, on the same data and with the same rules: L1 distance (both
+   kmeans_kernel.c and kmeans_kernel_q16.c), ties keep the lower centroid, an empty cluster keeps its centroid
+-------------------------------------------------------------------------------*/
+static float reference_distance(float dx, float dy) {
+    return fabsf(dx) + fabsf(dy);
+}
+
+static int reference_kmeans(float* cx, float* cy, const float* px, const float* py) {
+    int label[NUM_POINTS];
+    for (int i = 0; i < NUM_POINTS; i++) label[i] = -1;
+
+    for (int iter = 1; ; iter++) {
+        float sum_x[NUM_CLUSTERS] = {0}, sum_y[NUM_CLUSTERS] = {0};
+        int total[NUM_CLUSTERS] = {0};
+        int changed = 0;
+        for (int i = 0; i < NUM_POINTS; i++) {
+            int best_centroid = 0;
+            float best = reference_distance(cx[0] - px[i], cy[0] - py[i]);
+            for (int k = 1; k < NUM_CLUSTERS; k++) {
+                float d = reference_distance(cx[k] - px[i], cy[k] - py[i]);
+                if (d < best) { best = d; best_centroid = k; }
+            }
+            changed += best_centroid != label[i];
+            label[i] = best_centroid;
+            sum_x[best_centroid] += px[i];
+            sum_y[best_centroid] += py[i];
+            total[best_centroid]++;
+        }
+        for (int k = 0; k < NUM_CLUSTERS; k++) {
+            if (total[k] > 0) {
+                cx[k] = sum_x[k] / total[k];
+                cy[k] = sum_y[k] / total[k];
+            }
+        }
+        if (changed <= CONVERGENCE_THRESHOLD || iter >= MAX_ITER) return iter;
+    }
+}
 
 int main() {
     printf("--- K-Means Host Application Starting ---\n");
@@ -59,68 +144,129 @@ int main() {
     }
     printf("Successfully mapped PL BRAM at physical 0x%X to virtual address %p\n", BRAM_BASE_PHYSICAL_ADDR, bram_virt_base);
 
+    void* ddr_virt_base = mmap(NULL, DDR_BUFFER_SIZE, PROT_READ | PROT_WRITE, MAP_SHARED, mem_fd, DDR_BUFFER_PHYSICAL_ADDR);
+    if (ddr_virt_base == MAP_FAILED) {
+        perror("mmap of the DMA buffer failed");
+        munmap(bram_virt_base, BRAM_SIZE);
+        close(mem_fd);
+        return -1;
+    }
+
     // 3. Create C pointers to the specific hardware registers and data arrays
-    volatile unsigned int* gpu_ctrl_ptr = (unsigned int*)(bram_virt_base + CONTROL_REG_OFFSET);
-    volatile unsigned int* gpu_status_ptr = (unsigned int*)(bram_virt_base + STATUS_REG_OFFSET);
-
-    float* centroids_x_ptr = (float*)(bram_virt_base + CENTROIDS_X_OFFSET);
-    float* centroids_y_ptr = (float*)(bram_virt_base + CENTROIDS_Y_OFFSET);
-    float* points_x_ptr = (float*)(bram_virt_base + POINTS_X_OFFSET);
-    float* points_y_ptr = (float*)(bram_virt_base + POINTS_Y_OFFSET);
-    float* total_ptr = (float*)(bram_virt_base + TOTAL_OFFSET);
-    float* sum_x_ptr = (float*)(bram_virt_base + SUM_X_OFFSET);
-    float* sum_y_ptr = (float*)(bram_virt_base + SUM_Y_OFFSET);
-
-    // 4. Initialize Input Data: Write data from PS to PL's BRAM
+    volatile unsigned int* perf_ptr = (unsigned int*)(bram_virt_base + PERF_COUNTERS_OFFSET);
+    // changed[0] and iterations[0] of the kernel, read once the run is done
+    volatile int32_t* changed_ptr = (int32_t*)(bram_virt_base + CHANGED_OFFSET);
+    volatile int32_t* iterations_ptr = (int32_t*)(bram_virt_base + ITERATIONS_OFFSET);
+
+    // The arrays are staged in DDR with the data memory layout, the DMA engine moves them in and out of the PL
+    // instead of the ARM writing every value across the AXI port. ddr_array() is the DDR copy of an array
+    #define ddr_array(base, offset) ((value_t*)(ddr_virt_base + (base) + (offset) - CENTROIDS_X_OFFSET))
+    #define ddr_physical(base, offset) (DDR_BUFFER_PHYSICAL_ADDR + (base) + (offset) - CENTROIDS_X_OFFSET)
+    value_t* centroids_x_ptr = ddr_array(DDR_INPUTS_OFFSET, CENTROIDS_X_OFFSET);
+    value_t* centroids_y_ptr = ddr_array(DDR_INPUTS_OFFSET, CENTROIDS_Y_OFFSET);
+    value_t* points_x_ptr = ddr_array(DDR_INPUTS_OFFSET, POINTS_X_OFFSET);
+    value_t* points_y_ptr = ddr_array(DDR_INPUTS_OFFSET, POINTS_Y_OFFSET);
+    int32_t* prev_label_ptr = (int32_t*)ddr_array(DDR_INPUTS_OFFSET, PREV_LABEL_OFFSET);
+    int32_t* max_iterations_ptr = (int32_t*)ddr_array(DDR_INPUTS_OFFSET, MAX_ITERATIONS_OFFSET);
+    int32_t* threshold_ptr = (int32_t*)ddr_array(DDR_INPUTS_OFFSET, THRESHOLD_OFFSET);
+#ifdef FIXED_POINT
+    value_t* reciprocal_ptr = ddr_array(DDR_INPUTS_OFFSET, RECIPROCAL_OFFSET);
+#endif
+    value_t* result_x_ptr = ddr_array(DDR_RESULTS_OFFSET, CENTROIDS_X_OFFSET);
+    value_t* result_y_ptr = ddr_array(DDR_RESULTS_OFFSET, CENTROIDS_Y_OFFSET);
+
+    // One chain for the inputs (centroids, points, previous labels, the loop arguments and, for Q16, the
+    // reciprocals are contiguous) and
+    // one for the final centroids, each in its own slice of the descriptor area
+    const uint32_t chain_capacity = MAX_DESCRIPTORS / 2;
+    const uint32_t descriptors_physical = DDR_BUFFER_PHYSICAL_ADDR + DDR_DESCRIPTORS_OFFSET;
+    volatile dma_descriptor_t* descriptors = (volatile dma_descriptor_t*)(ddr_virt_base + DDR_DESCRIPTORS_OFFSET);
+    dma_chain_t load_inputs, store_centroids;
+
+    dma_chain_init(&load_inputs, descriptors, descriptors_physical, chain_capacity);
+    dma_chain_add(&load_inputs, ddr_physical(DDR_INPUTS_OFFSET, CENTROIDS_X_OFFSET), CENTROIDS_X_OFFSET,
+                  (TOTAL_OFFSET - CENTROIDS_X_OFFSET) / sizeof(value_t), 0);
+
+    dma_chain_init(&store_centroids, descriptors + chain_capacity,
+                   descriptors_physical + chain_capacity * sizeof(dma_descriptor_t), chain_capacity);
+    dma_chain_add(&store_centroids, ddr_physical(DDR_RESULTS_OFFSET, CENTROIDS_X_OFFSET), CENTROIDS_X_OFFSET,
+                  2 * NUM_CLUSTERS, DMA_TO_DDR);
+
+    // 4. Initialize Input Data: stage it in DDR and let the DMA engine copy it to the PL
     // TODO: Replace this with actual dataset
-    printf("Writing initial data to PL BRAM...\n");
+    // A dataset larger than the data memory would be split in tiles: start the chain of the next tile right
+    // after writing the start register, the copy runs while the kernel computes the current tile
+    printf("Staging initial data in DDR...\n");
+    float points_x[NUM_POINTS], points_y[NUM_POINTS];
+    float reference_x[NUM_CLUSTERS] = {0.0f, 5.0f, 10.0f};
+    float reference_y[NUM_CLUSTERS] = {0.0f, -5.0f, -10.0f};
     for (int i = 0; i < NUM_POINTS; i++) {
-        points_x_ptr[i] = (float)(i * 2.0); // Example data
-        points_y_ptr[i] = (float)(i * -1.5);
+        points_x[i] = i * 2.0f + 0.3f; // Example data, not on the Q16 grid
+        points_y[i] = i * -1.5f - 0.7f;
+        points_x_ptr[i] = to_value(points_x[i]);
+        points_y_ptr[i] = to_value(points_y[i]);
+        prev_label_ptr[i] = -1; // Every point counts as changed in the first iteration
     }
-    centroids_x_ptr[0] = 0.0; centroids_y_ptr[0] = 0.0;
-    centroids_x_ptr[1] = 5.0; centroids_y_ptr[1] = -5.0;
-    centroids_x_ptr[2] = 10.0; centroids_y_ptr[2] = -10.0;
-
-    // --- Main K-Means Application Loop ---
-    for (int cycle = 0; cycle < MAX_ITER; cycle++) {
-        printf("\n--- Cycle %d ---\n", cycle);
-
-        // 5. Start the PL Accelerator
-        printf("Telling PL to start kernel...\n");
-        *gpu_ctrl_ptr = 1; // Write '1' to the start register
-
-        // 6. Wait for the PL to finish by polling the status register
-        while ((*gpu_status_ptr & 0x1) == 0) {
-            // Wait until the 'done' bit (bit 0) is set to 1 by the PL
-            usleep(10); // Sleep for 10 microseconds to avoid wasting CPU cycles
-        }
-        printf("PL has finished execution.\n");
+    for (int k = 0; k < NUM_CLUSTERS; k++) {
+        centroids_x_ptr[k] = to_value(reference_x[k]);
+        centroids_y_ptr[k] = to_value(reference_y[k]);
+    }
+    *max_iterations_ptr = MAX_ITER;
+    *threshold_ptr = CONVERGENCE_THRESHOLD;
+#ifdef FIXED_POINT
+    reciprocal_ptr[0] = 0;
+    for (int n = 1; n <= NUM_POINTS; n++) {
+        reciprocal_ptr[n] = to_value(1.0f / n);
+    }
+#endif
 
-        // Important: Acknowledge and reset the hardware for the next run
-        *gpu_ctrl_ptr = 0;
+    printf("Copying it to PL memory...\n");
+    dma_start(bram_virt_base, &load_inputs);
+    dma_wait(bram_virt_base);
 
-        // 7. Process Results: The CPU reads the reduction results and calculates the new centroids
-        printf("Updating centroids on PS...\n");
-        for (int k = 0; k < NUM_CLUSTERS; k++) {
-            // Access the final sums, which are in index [0] of each cluster's reduction buffer
-            float final_total = *(total_ptr + k * NUM_POINTS); // Accesses total[k][0]
-            float final_sum_x = *(sum_x_ptr + k * NUM_POINTS); // Accesses sum_x[k][0]
-            float final_sum_y = *(sum_y_ptr + k * NUM_POINTS); // Accesses sum_y[k][0]
-
-            if (final_total > 0.0) {
-                // Calculate and write the new centroid back to the PL's memory for the next iteration
-                centroids_x_ptr[k] = final_sum_x / final_total;
-                centroids_y_ptr[k] = final_sum_y / final_total;
-                printf("  New Centroid %d: (%f, %f)\n", k, centroids_x_ptr[k], centroids_y_ptr[k]);
-            } else {
-                printf("  Centroid %d is empty, not updating.\n", k);
-            }
-        }
+    // 5. One launch for the whole run: the kernel loops over the iterations itself, with a grid barrier
+    // (gsync) between assigning the points and updating the centroids, and stops on its own. Not simulated yet,
+    // KMeansPersistent (hardware/tb/test/gpu-kmeans_tb.cpp) is the test for it
+    const kernel_launch_t kmeans_launch = {KERNEL_BASE_INSTR, KERNEL_BASE_DATA, 1, 1};
+    command_queue_push(bram_virt_base, &kmeans_launch, 0);
+
+    // 6. Wait once for the PL to finish every iteration
+    while (command_queue_status(bram_virt_base) & QUEUE_STATUS_BUSY) {
+        usleep(10); // Sleep for 10 microseconds to avoid wasting CPU cycles
+    }
+    printf("PL has finished execution (%u launches done).\n", command_queue_completed(bram_virt_base));
+
+    unsigned int vector_instructions = perf_ptr[PERF_INSTRUCTIONS_VECTOR];
+    printf("  cycles: %u, instructions: %u, memory busy: %u, LSU wait: %u, lane utilisation: %.2f\n",
+           perf_ptr[PERF_CYCLES], perf_ptr[PERF_INSTRUCTIONS_SCALAR] + vector_instructions,
+           perf_ptr[PERF_MEM_BUSY_CYCLES], perf_ptr[PERF_LSU_WAIT_CYCLES],
+           vector_instructions ? (double)perf_ptr[PERF_ACTIVE_LANES] / (vector_instructions * THREADS_PER_WARP) : 0.0);
+
+    // 7. Results of the last iteration: two words across the AXI port, the centroids come back through the DMA engine
+    int iterations = *iterations_ptr;
+    int32_t changed = *changed_ptr;
+    printf("  %d points changed cluster in the last iteration.\n", changed);
+
+    dma_start(bram_virt_base, &store_centroids);
+    dma_wait(bram_virt_base);
+    printf("\n%s after %d iterations:\n", changed <= CONVERGENCE_THRESHOLD ? "Converged" : "Stopped", iterations);
+    for (int k = 0; k < NUM_CLUSTERS; k++) {
+        printf("  Centroid %d: (%f, %f)\n", k, from_value(result_x_ptr[k]), from_value(result_y_ptr[k]));
+    }
+
+    // Accuracy against the float reference: Q16 rounds every value to 2^-16 and the means go through
+    // the rounded reciprocals, so expect errors around 1e-4 rather than exact results
+    int reference_iterations = reference_kmeans(reference_x, reference_y, points_x, points_y);
+    float max_error = 0.0f;
+    for (int k = 0; k < NUM_CLUSTERS; k++) {
+        max_error = fmaxf(max_error, fabsf(from_value(result_x_ptr[k]) - reference_x[k]));
+        max_error = fmaxf(max_error, fabsf(from_value(result_y_ptr[k]) - reference_y[k]));
     }
+    printf("  Host float reference: %d iterations, largest centroid error %g\n", reference_iterations, max_error);
 
     // 8. Clean up
     printf("\nK-Means complete. Unmapping memory.\n");
+    munmap(ddr_virt_base, DDR_BUFFER_SIZE);
     munmap(bram_virt_base, BRAM_SIZE);
     close(mem_fd);
 
@@ -0,0 +1,11 @@
+int f(){
+    float best = 9.5;
+    int idx = 0;
+    float d = 4.25;
+    if (d < best) { best = d; idx = 1; }
+    d = 7.0;
+    if (d < best) { best = d; idx = 2; }
+    d = 4.25;
+    if (best > d) { best = d; idx = 3; }
+    return idx;
+}
\ No newline at end of file
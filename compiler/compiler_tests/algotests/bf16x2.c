@@ -0,0 +1,11 @@
+float f(){
+    float x = 1.5;
+    float y = 2.0;
+    float cx = 0.5;
+    float cy = 4.0;
+    bf16x2 p = bf16x2_pack(x, y);
+    bf16x2 c = bf16x2_pack(cx, cy);
+    bf16x2 d = fsqdiff(p, c);
+    bf16x2 s = p + c;
+    return bf16x2_lo(d) + bf16x2_hi(d) + bf16x2_lo(s) * bf16x2_hi(s);
+}
\ No newline at end of file
@@ -0,0 +1,6 @@
+float f();
+
+int main()
+{
+    return !(f() == 17.0);
+}
\ No newline at end of file
@@ -0,0 +1,7 @@
+float f(){
+    float a = 4.5;
+    float b = 1.5;
+    float l1 = fabsf(b - a);
+    float l2 = (a - b) * (a - b);
+    return l1 + l2 + fsqdiff(a, b) + fabsdiff(a, b);
+}
\ No newline at end of file
@@ -0,0 +1,8 @@
+float f(){
+    float a = 1.5;
+    float b = 2.0;
+    float c = 0.5;
+    float d = a * b + c;
+    float e = c + a * b - d;
+    return a * b - c + d + e;
+}
\ No newline at end of file
@@ -0,0 +1,6 @@
+float f();
+
+int main()
+{
+    return !(f() == 6.0);
+}
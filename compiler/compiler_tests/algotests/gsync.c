@@ -0,0 +1,16 @@
+int f(){
+    int partial[8];
+    int out[8];
+    int i;
+
+    kernel(8){
+        i = threadId.x;
+        partial[i] = i + i;
+        gsync;
+        out[i] = partial[7 - i];
+    }
+
+    OUT out[8];
+
+    return 5;
+}
\ No newline at end of file
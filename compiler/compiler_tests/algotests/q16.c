@@ -0,0 +1,21 @@
+int f(){
+    q16 x = q16_from_int(3);
+    q16 one = 1;
+    q16 d = x + 1 - one;
+    q16 sq = d * d;
+    q16 below = one - x;
+    q16 s = sq * 2;
+    if (below < one) {
+        s = s + 1;
+    }
+    if (below > 0) {
+        s = 0;
+    }
+    if (below >= 0) {
+        s = 0;
+    }
+    if (x <= 3) {
+        s = s + 1;
+    }
+    return q16_to_int(s);
+}
@@ -0,0 +1,16 @@
+int f(){
+    __shared int partial[8];
+    int out[8];
+    int i;
+
+    kernel(8){
+        i = threadId.x;
+        partial[i] = i + i;
+        sync;
+        out[i] = partial[i];
+    }
+
+    OUT out[8];
+
+    return 5;
+}
\ No newline at end of file
@@ -0,0 +1,16 @@
+int f(){
+    float sum[2][4];
+    int running[1];
+    int i;
+
+    kernel(4){
+        i = threadId.x;
+        do {
+            sum[1][i] += sum[0][i];
+        } while (running[0]);
+    }
+
+    OUT sum[8];
+
+    return 5;
+}
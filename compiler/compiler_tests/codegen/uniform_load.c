@@ -0,0 +1,16 @@
+int f(){
+    float centroids[3];
+    float points[16];
+    float out[16];
+    int offset = 4;
+    int i;
+
+    kernel(16){
+        i = threadId.x;
+        out[i] = centroids[1] - points[i] + offset;
+    }
+
+    OUT out[16];
+
+    return 5;
+}
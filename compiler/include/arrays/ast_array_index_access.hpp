@@ -14,7 +14,7 @@ private:
 public:
     ArrayIndexAccess(NodePtr identifier, NodePtr index) : identifier_(std::move(identifier)), index_(std::move(index)) {}
 
-    std::vector<int> get_linear_index(std::ostream& stream, Context &context, std::string dest_reg) const;
+    std::vector<const Node*> get_indexes() const;
     std::string GetId() const;
     Type GetType(Context& context) const;
     void get_position(std::ostream& stream, Context& context, std::string dest_reg, Type type, Variable& variable) const;
@@ -19,6 +19,7 @@
 #include "operations/ast_logical_operation.hpp"
 #include "operations/ast_unary_operation.hpp"
 #include "operations/ast_operand.hpp"
+#include "operations/ast_operand_ref.hpp"
 #include "operations/ast_sizeof.hpp"
 
 #include "statements/ast_return.hpp"
@@ -43,6 +44,7 @@
 
 #include "specifiers/ast_specifier.hpp"
 #include "specifiers/ast_type_specifier.hpp"
+#include "specifiers/ast_shared_specifier.hpp"
 
 #include "enums/ast_enum_specifier.hpp"
 #include "enums/ast_enum.hpp"
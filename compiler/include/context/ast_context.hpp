@@ -28,6 +28,9 @@ private:
     int current_out_offset = 2500;
 
 
+    // ----- Source Line Tracking ------
+    int source_line = 0; // C line of the statement being emitted, 0 outside of any statement
+
     // ----- Kernel Management ------
     Kernel instruction_state = Kernel::_SCALAR;
     int warp_size = 4;
@@ -35,6 +38,12 @@ private:
     int warp_offset = 15000;
     std::vector<std::string> allocated_thread_regs;
 
+    // ----- Shared Memory Management ------
+    // __shared arrays are placed in the core's scratchpad (SCRATCHPAD_BASE_ADDRESS in common.svh)
+    int shared_base = 0x100000;
+    int shared_size = 1024;
+    int shared_offset = 0;
+
 
 
     // ----- Register Management ------
@@ -101,11 +110,16 @@ public:
     void set_current_out_offset(int size) {current_out_offset -= size;}
     int get_current_out_offset() const {return current_out_offset;}
 
+    //-----------Source Line Tracking ------------
+    void set_source_line(int line) {source_line = line;}
+    int get_source_line() const {return source_line;}
+
     // ---------- Kernel Management ---------------
     void set_instruction_state(Kernel state);
     Kernel get_instruction_state() const { return instruction_state; }
     int get_warp_size() const {return warp_size;}
     std::vector<Warp>& get_warp_file() {return warp_file;}
+    Warp& get_active_warp(); // the scalar code of a kernel runs on its warp file
     int get_warp_offset() const {return warp_offset;}
     void add_thread_reg(std::string thread_reg) {allocated_thread_regs.push_back(thread_reg);}
     std::vector<std::string>& get_thread_regs() {return allocated_thread_regs;} //will be needed for end of program deallocation
@@ -114,12 +128,18 @@ public:
     std::string get_divergence_safe_register(Type type);
     void deallocate_from_all_threads(const std::string& reg_name);
 
+    // ---------- Shared Memory Management ---------
+    int allocate_shared(int size);
+    int get_shared_base() const {return shared_base;}
+
     // ---------- Register Management --------------
     void assign_reg_manager(RegisterFile& new_reg_manager) {reg_manager = &new_reg_manager; }
     void reset_reg_manager(){reg_manager = &main_cpu_registers;}
+    RegisterFile& get_reg_manager() {return *reg_manager; }
     const ScalarRegisterFile& get_main_cpu_regs() const {return main_cpu_registers;}
     
     std::string get_register(Type type) { return reg_manager->get_register(type); }
+    std::pair<std::string, std::string> get_register_pair() { return reg_manager->get_register_pair(); }
     std::string get_return_register() const { return return_register; }
     std::string get_register_name(int reg_number) const {return reg_manager->get_register_name(reg_number); }
     void set_register_type(const std::string &reg_name, Type type) { reg_manager->set_register_type(reg_name, type); }
@@ -174,6 +194,9 @@ public:
     std::string move_instr(Type type) const;
     std::string store_instr(Type type) const;
     std::string load_instr(Type type) const;
+    std::string uniform_load_instr(Type type) const;
+    void emit_move(std::ostream &stream, const std::string &dest_reg, const std::string &src_reg, Type type) const;
+    void promote_to_q16(std::ostream &stream, const std::string &reg, Type from) const;
 
     // ----- Type Management --------
     void push_operation_type(Type type);
@@ -3,6 +3,7 @@
 #include <unordered_map>
 #include <stack>
 #include <set>
+#include <utility>
 #include <iostream>
 #include "ast_context_types.hpp"
 
@@ -50,6 +51,7 @@ public:
     virtual ~RegisterFile() = default;
 
     virtual std::string get_register(Type type);
+    virtual std::pair<std::string, std::string> get_register_pair();
     virtual void deallocate_register(const std::string &reg_name);
     virtual std::string get_register_name(int reg_number) const;
     virtual void set_register_type(const std::string &reg_name, Type type);
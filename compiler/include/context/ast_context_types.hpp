@@ -12,8 +12,10 @@ enum class Type
     _UNSIGNED_INT,
     _INT,
     _LONG,
+    _Q16,       // Q16.16 fixed point in an int register
     _FLOAT,
     _DOUBLE,
+    _BF16X2,    // Two packed bfloat16 values in a float register
     _STRUCT,
     _CUSTOM_STRUCT,
 };
@@ -29,8 +31,10 @@ const std::unordered_map<Type, int> types_mem_shift = {
     {Type::_UNSIGNED_INT, 2},
     {Type::_INT, 2},
     {Type::_LONG, 3},
+    {Type::_Q16, 2},
     {Type::_FLOAT, 2},
     {Type::_DOUBLE, 3},
+    {Type::_BF16X2, 2},
 };
 
 }//namespace ast
@@ -6,6 +6,7 @@ namespace ast{
 enum class ScopeLevel {
     GLOBAL,
     LOCAL,
+    SHARED,
 };
 
 class Variable {
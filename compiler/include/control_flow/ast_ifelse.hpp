@@ -12,6 +12,7 @@ private:
     bool is_ternary_; //tenary op flag
 
     Warp& GetActiveWarp(std::vector<Warp>& warps) const;
+    bool EmitMinIndex(std::ostream& stream, Context& context) const;
 
 public:
     IfStatement(NodePtr condition, NodePtr then_branch, NodePtr else_branch = nullptr, bool is_ternary = false)
@@ -9,9 +9,11 @@ class BuiltInFunction : public Operand {
 private:
     std::string func_name_;
     NodePtr argument_;
+    NodePtr second_argument_;   // Lane offset of shfl_*, subtrahend of fabsdiff/fsqdiff, high half of bf16x2_pack
 
 public:
     BuiltInFunction(const std::string& func_name, NodePtr argument) : func_name_(func_name), argument_(std::move(argument)) {}
+    BuiltInFunction(const std::string& func_name, NodePtr argument, NodePtr second_argument) : func_name_(func_name), argument_(std::move(argument)), second_argument_(std::move(second_argument)) {}
         BuiltInFunction(const std::string& func_name) : func_name_(func_name) {}
 
     Type GetType(Context& context) const override;
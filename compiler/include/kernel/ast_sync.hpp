@@ -7,9 +7,10 @@ namespace ast {
 
 class SyncStatement : public Node {
 private:
+    bool grid_; // gsync, the barrier spans every block of the kernel
 
 public:
-    SyncStatement() = default;
+    explicit SyncStatement(bool grid = false) : grid_(grid) {}
     ~SyncStatement() override = default;
 
     void EmitElsonV(std::ostream& stream, Context& context, std::string dest_reg) const override;
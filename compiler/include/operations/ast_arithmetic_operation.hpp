@@ -25,7 +25,14 @@ public:
     void Print(std::ostream& stream) const override;
     bool isPointerOp(Context &context) const override;
     void ShiftPointerOp(std::ostream &stream, Context &context, std::string dest_reg, const NodePtr& node) const;
+    std::string EmitIntegerAsFloat(std::ostream &stream, Context &context, const NodePtr& node) const;
     Type NewPointerType(Context &context) const;
+    bool IsIntegerScale(Context &context) const;
+    const ArithExpression* AsFloatProduct(Context &context, const NodePtr& node) const;
+    bool EmitFusedMultiplyAdd(std::ostream &stream, Context &context, Type type, std::string dest_reg) const;
+    bool EmitSquaredDifference(std::ostream &stream, Context &context, Type type, std::string dest_reg) const;
+    bool IsFloatDifference(Context &context) const;
+    void EmitFloatDifference(std::ostream &stream, Context &context, std::string dest_reg, const std::string &operation) const;
 
 
 };
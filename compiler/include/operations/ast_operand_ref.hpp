@@ -0,0 +1,25 @@
+#pragma once
+
+#include "ast_node.hpp"
+#include "ast_operand.hpp"
+#include "../structs/ast_struct_access.hpp"
+
+namespace ast {
+
+// Second use of a node that another one owns: the target of a compound assignment (a += b) is also the
+// left operand of its operation, the assignment keeps ownership
+class OperandRef : public Operand {
+private:
+    const Node* node_;
+
+public:
+    OperandRef(const Node* node) : node_(node) {}
+
+    Type GetType(Context& context) const override;
+    void EmitElsonV(std::ostream& stream, Context& context, std::string dest_reg) const override;
+    void Print(std::ostream& stream) const override;
+    bool isPointerOp(Context &context) const override;
+    std::string GetId() const override;
+};
+
+} // namespace ast
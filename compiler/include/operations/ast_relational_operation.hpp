@@ -24,8 +24,13 @@ public:
     void EmitElsonV(std::ostream& stream, Context& context, std::string dest_reg) const override;
     void Print(std::ostream& stream) const override;
     bool isPointerOp(Context &context) const override;
+    RelationOp get_op() const { return op_; }
+    const Node* get_left() const { return left_.get(); }
+    const Node* get_right() const { return right_.get(); }
     void ShiftPointerOp(std::ostream &stream, Context &context, std::string dest_reg, const NodePtr& node) const;
     Type NewPointerType(Context &context) const;
+    void EmitSignedCompare(std::ostream &stream, Context &context, std::string dest_reg, const std::string &left_register, const std::string &right_register) const;
+    void InvertResult(std::ostream &stream, Context &context, const std::string &dest_reg) const;
 
 };
 
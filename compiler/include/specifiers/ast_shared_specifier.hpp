@@ -0,0 +1,22 @@
+#pragma once
+#include "ast_node.hpp"
+#include "ast_specifier.hpp"
+
+namespace ast{
+
+// __shared qualifier: the declared arrays live in the core's scratchpad instead of the stack
+class SharedSpecifier : public Specifier
+{
+private:
+    NodePtr type_specifier_;
+
+public:
+    SharedSpecifier(NodePtr type_specifier) : type_specifier_(std::move(type_specifier)){};
+
+    void define_spec(Context &context) const override;
+    Type GetType() const override;
+    void EmitElsonV(std::ostream &stream, Context &context, std::string dest_reg) const override;
+    void Print(std::ostream &stream) const override;
+};
+
+}//namespace ast
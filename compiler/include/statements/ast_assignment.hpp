@@ -25,6 +25,8 @@ public:
     Assignment(NodePtr unary_expression, NodePtr expression) : unary_expression_(std::move(unary_expression)), expression_(std::move(expression)) {}
 
     std::string GetId() const;
+    const Node* get_target() const { return unary_expression_.get(); }
+    const Node* get_value() const { return expression_.get(); }
 
     int GetArraySize() const;
     bool isArrayInitialization() const;
@@ -2,6 +2,7 @@
 
 #include "../ast_node.hpp"
 #include "../specifiers/ast_type_specifier.hpp"
+#include "../specifiers/ast_shared_specifier.hpp"
 #include "../symbols/ast_identifier.hpp"
 #include "../ast_direct_declarator.hpp"
 #include "../arrays/ast_array_declaration.hpp"
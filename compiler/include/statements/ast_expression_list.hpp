@@ -17,6 +17,7 @@ public:
     Type GetType(Context &context) const;
     void PushBack(NodePtr item);
     bool isPointerOp(Context &context) const override;
+    std::vector<NodePtr> const& get_nodes() const { return nodes_; }
 
     virtual void EmitElsonV(std::ostream &stream, Context &context, std::string dest_reg) const override;
     virtual void Print(std::ostream &stream) const override;
@@ -14,10 +14,20 @@ namespace ast{
 
 class Statement : public NodeList
 {
+private:
+    std::unordered_map<const Node*, int> source_lines_; // C source line each item starts on
+
+protected:
+    // Emits the items, each one behind a "# line <n>" marker when it starts a new source line
+    void EmitSourceLines(std::ostream &stream, Context &context, std::string dest_reg) const;
+
 public:
     using NodeList::NodeList; //inherits all constructors from nodelist
+    using NodeList::PushBack;
     virtual ~Statement() override = default;
 
+    void PushBack(NodePtr item, int source_line);
+
     virtual int get_offset(Context &context) const = 0;
 };
 
@@ -45,6 +55,8 @@ class DeclarationList : public Statement
 public:
     using Statement::Statement;
 
+    void EmitElsonV(std::ostream &stream, Context &context, std::string dest_reg) const override;
+
     int get_offset(Context &context) const;
 };
 
@@ -0,0 +1,73 @@
+#!/usr/bin/env python3
+
+"""
+Checks the instructions the compiler emits for the cases in compiler_tests/codegen.
+
+Each <name>.c is compiled to bin/output/codegen/<name>.s, every non-comment line of
+<name>.expected must then appear in it, in order. These cover ElsonV instructions
+(kernel code) that test.py cannot run on the RISC-V simulator.
+
+Usage: scripts/test_codegen.py [-m]
+"""
+
+import argparse
+import os
+import subprocess
+import sys
+from pathlib import Path
+
+SCRIPT_LOCATION = Path(__file__).resolve().parent
+PROJECT_LOCATION = SCRIPT_LOCATION.joinpath("..").resolve()
+CODEGEN_FOLDER = PROJECT_LOCATION.joinpath("compiler_tests/codegen").resolve()
+OUTPUT_FOLDER = PROJECT_LOCATION.joinpath("bin/output/codegen").resolve()
+COMPILER_FILE = PROJECT_LOCATION.joinpath("bin/c_compiler").resolve()
+
+RUN_TIMEOUT_SECONDS = 15
+
+
+def check(source: Path) -> bool:
+    expected_file = source.with_suffix(".expected")
+    output = OUTPUT_FOLDER.joinpath(source.stem + ".s")
+
+    # Same as test.py, leak reports of the sanitised compiler are not failures
+    env = os.environ.copy()
+    env["ASAN_OPTIONS"] = "exitcode=0"
+    result = subprocess.run([str(COMPILER_FILE), "-S", str(source), "-o", str(output)],
+                            env=env, capture_output=True, text=True, timeout=RUN_TIMEOUT_SECONDS)
+    if result.returncode != 0:
+        print(f"[FAIL] {source.name}: compiler exited with {result.returncode}")
+        return False
+
+    lines = [line.strip() for line in output.read_text().splitlines()]
+    position = 0
+    for expected in expected_file.read_text().splitlines():
+        expected = expected.strip()
+        if not expected or expected.startswith("#"):
+            continue
+        try:
+            position = lines.index(expected, position) + 1
+        except ValueError:
+            print(f"[FAIL] {source.name}: '{expected}' not found (in order) in {output}")
+            return False
+
+    print(f"[PASS] {source.name}")
+    return True
+
+
+def main() -> int:
+    parser = argparse.ArgumentParser()
+    parser.add_argument("-m", "--make", action="store_true", help="build bin/c_compiler first")
+    args = parser.parse_args()
+
+    if args.make and subprocess.run(["make", "-C", str(PROJECT_LOCATION), "bin/c_compiler"]).returncode != 0:
+        return 1
+
+    OUTPUT_FOLDER.mkdir(parents=True, exist_ok=True)
+    sources = sorted(CODEGEN_FOLDER.glob("*.c"))
+    passed = sum(check(source) for source in sources)
+    print(f"\nPassing {passed}/{len(sources)} codegen tests")
+    return 0 if passed == len(sources) else 1
+
+
+if __name__ == "__main__":
+    sys.exit(main())
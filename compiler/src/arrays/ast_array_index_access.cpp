@@ -24,6 +24,18 @@ void ArrayIndexAccess::EmitElsonV(std::ostream &stream, Context &context, std::s
 
     Type type = isPointerOp(context) ? Type::_INT : GetType(context);
 
+    // A constant index into a local array is the same address in every lane of a kernel (sp is)
+    const Identifier *array_identifier = dynamic_cast<const Identifier *>(identifier_.get());
+    const IntConstant *constant_index = dynamic_cast<const IntConstant *>(index_.get());
+    std::string uniform_load = context.uniform_load_instr(type);
+    if (!uniform_load.empty() && array_identifier != nullptr && constant_index != nullptr &&
+        variable.get_scope() == ScopeLevel::LOCAL && variable.is_array() && !variable.is_pointer())
+    {
+        int offset = variable.get_offset() - ((constant_index->get_val() + 1) << types_mem_shift.at(type));
+        stream << uniform_load << " " << dest_reg << ", " << offset << "(sp)" << std::endl;
+        return;
+    }
+
     std::string index_register = context.get_register(Type::_INT);
     get_position(stream, context, index_register, type, variable);
 
@@ -63,173 +75,75 @@ void ArrayIndexAccess::EmitElsonV(std::ostream &stream, Context &context, std::s
 
         context.deallocate_register(global_memory_register);
     }
+    else if(variable.get_scope() == ScopeLevel::SHARED){
+        // index_register holds (index + 1) * size, like for stack arrays
+        std::string shared_memory_register = context.get_register(Type::_INT);
+
+        stream << asm_prefix.at(context.get_instruction_state()) << "lui " << shared_memory_register << ", " << (context.get_shared_base() >> 12) << std::endl;
+        stream << asm_prefix.at(context.get_instruction_state()) << "add " << index_register << ", " << index_register << ", " << shared_memory_register << std::endl;
+        stream << asm_prefix.at(context.get_instruction_state()) << context.load_instr(type) << " " << dest_reg << ", " << variable.get_offset() - types_size.at(type) << "(" << index_register << ")" << std::endl;
+
+        context.deallocate_register(shared_memory_register);
+    }
 
     context.deallocate_register(index_register);
 }
 
 void ArrayIndexAccess::get_position(std::ostream &stream, Context &context, std::string dest_reg, Type type, Variable& variable) const
 {
-    // Set operation type as dealing with pointers
+    // dest_reg = (linear index + 1) << size, the arrays grow down from their offset. The linear index is row-major
+    // over the dimensions: ((i0 * dim1) + i1) * dim2 + i2 ...
     context.push_operation_type(Type::_INT);
-    std::string index_reg = context.get_register(Type::_INT);
 
-    std::vector<int> indexes = get_linear_index(stream, context, index_reg);
+    std::vector<const Node*> indexes = get_indexes();
     std::vector<int> dimension = variable.get_dim();
-    bool Operand = false;
-    bool Identbool = false;
-
-    int Opindex = 0;
-    for(auto index : indexes){
-        if(index == -1){
-            Operand = true;
-            break;
-        }
-        Opindex++;
+    if (indexes.size() > 1 && dimension.size() < indexes.size()){
+        throw std::runtime_error("Compile Internal Error: Attempted " + std::to_string(indexes.size()) + "D index access on array but the compiler only recorded " + std::to_string(dimension.size()) + " dimension(s).");
     }
 
-    int IdentIndex = 0;
-    for(auto index : indexes){
-        if(index == -2){
-            Identbool = true;
-            break;
+    bool constant = true;
+    int linear_index = 0;
+    for (size_t i = 0; i < indexes.size() && constant; i++){
+        const IntConstant *index_constant = dynamic_cast<const IntConstant *>(indexes[i]);
+        constant = index_constant != nullptr;
+        if (constant){
+            linear_index = (i == 0 ? 0 : linear_index * dimension[i]) + index_constant->get_val();
         }
-        IdentIndex++;
     }
 
-    std::string var_reg;
-
-    // if(Identbool){
-    //     const Identifier *variable = dynamic_cast<const Identifier *>(index_.get());
-    //     Variable var = context.get_variable(variable->GetId());
-    //     var_reg = var.get_reg();
-    // }
-
-    if(!Operand){
-
-        if(!Identbool){
-            int linear_index;
-
-            //only can handle up to 2d arrays
-            if(indexes.size() == 2){
-                linear_index = indexes[0] * dimension[1] + (indexes[1]);
-            }
-            else{
-                linear_index = indexes[0];
-            }
-            
-            stream << asm_prefix.at(context.get_instruction_state()) <<"li " << dest_reg << ", " << linear_index + 1 << std::endl;
-            stream << asm_prefix.at(context.get_instruction_state()) << "slli " << dest_reg << ", " << dest_reg << ", " << types_mem_shift.at(type) << std::endl;
-        }
-        else{
-
-            if(indexes.size() == 2){
-                if (dimension.size() < 2){
-                    throw std::runtime_error("Compile Internal Error: Attempted 2D index access on array but the compiler only recorded " + std::to_string(dimension.size()) + " dimension(s).");
-                }
-                int multiply = indexes[0] * dimension[1];
-                stream << asm_prefix.at(context.get_instruction_state()) <<"li " << dest_reg << ", " << multiply + 1 << std::endl;
-                stream << asm_prefix.at(context.get_instruction_state()) <<"add " << dest_reg << ", " << dest_reg << ", " << var_reg << std::endl;
-                stream << asm_prefix.at(context.get_instruction_state()) << "slli " << dest_reg << ", " << dest_reg << ", " << types_mem_shift.at(type) << std::endl;
-            }
-            else{
-                stream << asm_prefix.at(context.get_instruction_state()) <<"addi " << index_reg << ", " << var_reg <<  ", 1" << std::endl;
-                stream << asm_prefix.at(context.get_instruction_state()) << "slli " << dest_reg << ", " << index_reg << ", " << types_mem_shift.at(type) << std::endl;
-            }
-            
-        }
-
+    if (constant){
+        stream << asm_prefix.at(context.get_instruction_state()) << "li " << dest_reg << ", " << linear_index + 1 << std::endl;
     }
     else{
-        
-        if(Opindex == 0){
-            if(indexes.size() == 1){
-                stream << asm_prefix.at(context.get_instruction_state()) << "addi " << index_reg << ", " << index_reg << ", 1" << std::endl;
-                stream << asm_prefix.at(context.get_instruction_state()) << "slli " << dest_reg << ", " << index_reg << ", " << types_mem_shift.at(type) << std::endl;
-            }
-            else{
-                stream << asm_prefix.at(context.get_instruction_state()) << "muli " << index_reg << ", " <<index_reg << ", " <<  dimension[0] << std::endl;
-                stream << asm_prefix.at(context.get_instruction_state()) << "addi " << index_reg << ", " << index_reg << ", " << indexes[1] + 1 << std::endl;
-                stream << asm_prefix.at(context.get_instruction_state()) << "slli " << dest_reg << ", " << index_reg << ", " << types_mem_shift.at(type) << std::endl;
+        // Loop counters of a kernel come from the stack, thread variables from their registers
+        indexes[0]->EmitElsonV(stream, context, dest_reg);
+        if (indexes.size() > 1){
+            std::string index_reg = context.get_register(Type::_INT);
+            for (size_t i = 1; i < indexes.size(); i++){
+                stream << asm_prefix.at(context.get_instruction_state()) << "muli " << dest_reg << ", " << dest_reg << ", " << dimension[i] << std::endl;
+                indexes[i]->EmitElsonV(stream, context, index_reg);
+                stream << asm_prefix.at(context.get_instruction_state()) << "add " << dest_reg << ", " << dest_reg << ", " << index_reg << std::endl;
             }
+            context.deallocate_register(index_reg);
         }
-        else{
-            if(!Identbool){
-                int32_t multiply = indexes[0] * dimension[1];
-                stream << asm_prefix.at(context.get_instruction_state()) << "addi " << index_reg << ", " << index_reg << ", " << multiply + 1 << std::endl;
-                stream << asm_prefix.at(context.get_instruction_state()) << "slli " << dest_reg << ", " << index_reg << ", " << types_mem_shift.at(type) << std::endl;
-            }
-            else{
-                std::string intermediate_temp = context.get_register(Type::_INT);
-
-                stream << asm_prefix.at(context.get_instruction_state()) << "muli " << intermediate_temp << ", " << var_reg << ", " << dimension[0] << std::endl;
-                stream << asm_prefix.at(context.get_instruction_state()) << "addi " << index_reg << ", " << index_reg << ", 1" << std::endl;
-                stream << asm_prefix.at(context.get_instruction_state()) << "add " << index_reg << ", " << index_reg << ", " << intermediate_temp << std::endl;
-                stream << asm_prefix.at(context.get_instruction_state()) << "slli " << dest_reg << ", " << index_reg << ", " << types_mem_shift.at(type) << std::endl;
-
-                context.deallocate_register(intermediate_temp);
-            }
-            
-        }
-
+        stream << asm_prefix.at(context.get_instruction_state()) << "addi " << dest_reg << ", " << dest_reg << ", 1" << std::endl;
     }
+    stream << asm_prefix.at(context.get_instruction_state()) << "slli " << dest_reg << ", " << dest_reg << ", " << types_mem_shift.at(type) << std::endl;
 
-    context.deallocate_register(index_reg);
     context.pop_operation_type();
 }
 
-std::vector<int> ArrayIndexAccess::get_linear_index(std::ostream& stream, Context &context, std::string dest_reg) const{
-    const ArrayIndexAccess *array = this;
-
-    std::vector<int> indexes;
-
-    const Identifier *variable = dynamic_cast<const Identifier *>(index_.get());
-    const IntConstant *constant = dynamic_cast<const IntConstant*>(index_.get());
-    const BuiltInOperand *thread_id = dynamic_cast<const BuiltInOperand*>(index_.get());
-
-    while(array != nullptr){
-
-        variable = dynamic_cast<const Identifier *>(array->index_.get());
-        constant = dynamic_cast<const IntConstant*>(array->index_.get());
-        thread_id = dynamic_cast <const BuiltInOperand*>(array->index_.get());
-
-        if(variable != nullptr){
-            Variable var = context.get_variable(variable->GetId());
+// The index expressions, outermost dimension first
+std::vector<const Node*> ArrayIndexAccess::get_indexes() const{
+    std::vector<const Node*> indexes;
 
-            if(var.get_reg() != ""){
-                stream << asm_prefix.at(context.get_instruction_state()) << "add " << dest_reg << ", " << var.get_reg() << ", zero" << std::endl;
-                indexes.push_back(-2);
-            }
-            else{
-                indexes.push_back(variable->get_index(context));
-            }
-        }
-        else if(constant != nullptr){
-            indexes.push_back(constant->get_val());
-        }
-        else if(thread_id != nullptr){
-            thread_id->EmitElsonV(stream,context,dest_reg);
-            indexes.push_back(-1);
-        }
-
-        std::cout << "[DEBUG] get_linear_index processing index of type: " << typeid(*array->index_).name() << std::endl;
-
-        if(variable != nullptr){
-            Variable var = context.get_variable(variable->GetId());
-            std::cout << "[DEBUG] culprit " << variable->GetId() << ": " << var.get_reg() << std::endl;
-            std::cout << "[DEBUG] values stored in indexes: wtf is going on???" << std::endl;
-            std::cout << "[DEBUG] indexes size: " << indexes.size() << std::endl;
-            for(auto index : indexes){
-                std::cout << index << std::endl;
-            }
-        }
-
-        array = dynamic_cast<const ArrayIndexAccess *>(array->identifier_.get());
+    for (const ArrayIndexAccess *array = this; array != nullptr; array = dynamic_cast<const ArrayIndexAccess *>(array->identifier_.get())){
+        indexes.push_back(array->index_.get());
     }
 
     std::reverse(indexes.begin(),indexes.end());
 
     return indexes;
-
 }
 
 void ArrayIndexAccess::Print(std::ostream &stream) const
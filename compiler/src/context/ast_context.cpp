@@ -10,8 +10,10 @@ const std::unordered_map<Type, int> types_size = {
     {Type::_UNSIGNED_INT, 4},
     {Type::_INT, 4},
     {Type::_LONG, 8},
+    {Type::_Q16, 4},
     {Type::_FLOAT, 4},
     {Type::_DOUBLE, 8},
+    {Type::_BF16X2, 4},
     {Type::_CUSTOM_STRUCT, 8},
 };
 
@@ -22,8 +24,10 @@ const std::unordered_map<Type, std::string> assembler_directives = {
     {Type::_UNSIGNED_INT, ".word"},
     {Type::_INT, ".word"},
     {Type::_LONG, ".word"},
+    {Type::_Q16, ".word"},
     {Type::_FLOAT, ".word"},
     {Type::_DOUBLE, ".word"},
+    {Type::_BF16X2, ".word"},
 };
 
 Context::Context()
@@ -34,10 +34,12 @@ void Context::set_return_register(Type type)
     case Type::_CHAR:
     case Type::_SHORT:
     case Type::_UNSIGNED_INT:
+    case Type::_Q16:
         return_register = "s1";
         break;
     case Type::_FLOAT:
     case Type::_DOUBLE:
+    case Type::_BF16X2:
     case Type::_LONG:
         return_register = "fa0";
         break;
@@ -11,8 +11,10 @@ std::string Context::store_instr(Type type) const
     case Type::_INT:
     case Type::_UNSIGNED_INT:
     case Type::_LONG:
+    case Type::_Q16:
         return "sw";
     case Type::_FLOAT:
+    case Type::_BF16X2:
         return "fsw";
     case Type::_DOUBLE:
         return "fsd";
@@ -34,8 +36,10 @@ std::string Context::load_instr(Type type) const
     case Type::_INT:
     case Type::_UNSIGNED_INT:
     case Type::_LONG:
+    case Type::_Q16:
         return "lw";
     case Type::_FLOAT:
+    case Type::_BF16X2:
         return "flw";
     case Type::_DOUBLE:
         return "fld";
@@ -46,6 +50,22 @@ std::string Context::load_instr(Type type) const
     }
 }
 
+// Kernel load from an address that is the same in every lane: one scalar LSU access broadcast to the
+// lanes (v.lw.u / v.flw.u). Empty outside a kernel and for the types without a uniform load
+std::string Context::uniform_load_instr(Type type) const
+{
+    if (get_instruction_state() != Kernel::_VECTOR)
+    {
+        return "";
+    }
+    std::string load = load_instr(type);
+    if (load != "lw" && load != "flw")
+    {
+        return "";
+    }
+    return "v." + load + ".u";
+}
+
 std::string Context::move_instr(Type type) const
 {
     switch (type)
@@ -55,8 +75,10 @@ std::string Context::move_instr(Type type) const
     case Type::_INT:
     case Type::_UNSIGNED_INT:
     case Type::_LONG:
+    case Type::_Q16:
         return "mv";
     case Type::_FLOAT:
+    case Type::_BF16X2:
         return "fmv.s";
     case Type::_DOUBLE:
         return "fmv.d";
@@ -66,4 +88,36 @@ std::string Context::move_instr(Type type) const
         throw std::runtime_error("Context::move_instr: Invalid store type");
     }
 }
+
+// ElsonV has no mv, a copy is addi 0 (fmin.s with itself for floats). Used for the thread registers of kernel locals
+void Context::emit_move(std::ostream &stream, const std::string &dest_reg, const std::string &src_reg, Type type) const
+{
+    if (type == Type::_FLOAT || type == Type::_BF16X2)
+    {
+        stream << asm_prefix.at(get_instruction_state()) << "fmin.s " << dest_reg << ", " << src_reg << ", " << src_reg << std::endl;
+    }
+    else
+    {
+        stream << asm_prefix.at(get_instruction_state()) << "addi " << dest_reg << ", " << src_reg << ", 0" << std::endl;
+    }
+}
+
+// An integer operand of a q16 operation is a whole number, shift it by the 16 fraction bits
+void Context::promote_to_q16(std::ostream &stream, const std::string &reg, Type from) const
+{
+    switch (from)
+    {
+    case Type::_CHAR:
+    case Type::_SHORT:
+    case Type::_INT:
+    case Type::_UNSIGNED_INT:
+    case Type::_LONG:
+        stream << asm_prefix.at(get_instruction_state()) << "slli " << reg << ", " << reg << ", 16" << std::endl;
+        break;
+    case Type::_Q16:
+        break;
+    default:
+        throw std::runtime_error("Context::promote_to_q16: Only integer types convert to q16");
+    }
+}
 }//namespace ast
@@ -166,11 +166,13 @@ std::string RegisterFile::get_register(Type type){
         case Type::_SHORT:
         case Type::_UNSIGNED_INT:
         case Type::_LONG:
+        case Type::_Q16:
             start_register_file = 5;
             end_register_file = 31;
             break;
         case Type::_FLOAT:
         case Type::_DOUBLE:
+        case Type::_BF16X2:
             start_register_file = 32;
             end_register_file = 63;
             break;
@@ -187,6 +189,18 @@ std::string RegisterFile::get_register(Type type){
     throw std::runtime_error("No available register found!");
 }
 
+// Get a float register and the int register with the same number (the index register of fminidx.s)
+std::pair<std::string, std::string> RegisterFile::get_register_pair(){
+    for (int i = 6; i < 32; i++){
+        if (register_file[i].isAvailable() && register_file[32 + i].isAvailable()){
+            allocate_register(register_file[32 + i].getName(), Type::_FLOAT);
+            allocate_register(register_file[i].getName(), Type::_INT);
+            return {get_register_name(32 + i), get_register_name(i)};
+        }
+    }
+    throw std::runtime_error("No available register pair found!");
+}
+
 // Deallocate Register
 void RegisterFile::deallocate_register(const std::string &reg_name){
     if(register_name_to_int.find(reg_name) != register_name_to_int.end()){
@@ -268,6 +282,15 @@ void Context::pop_registers(std::ostream &stream)
     }
 }
 
+Warp& Context::get_active_warp() {
+    for(auto& warp : warp_file) {
+        if(warp.get_activity()) {
+            return warp;
+        }
+    }
+    return warp_file[0];
+}
+
 std::string Context::get_divergence_safe_register(Type type) {
     std::vector<Warp>& warps = get_warp_file();
     
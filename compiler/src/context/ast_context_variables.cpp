@@ -32,4 +32,18 @@ void Context::define_global(std::string name, Global &global){
     globalMap[name] = global;
 }
 
+//Reserve space in the scratchpad, returns the byte offset from the scratchpad base
+int Context::allocate_shared(int size){
+    int offset = shared_offset;
+    shared_offset += size;
+    //4 byte alignment
+    if (shared_offset % 4 != 0){
+        shared_offset += 4 - (shared_offset % 4);
+    }
+    if (shared_offset > shared_size){
+        throw std::runtime_error("Error: __shared arrays need " + std::to_string(shared_offset) + " bytes but the scratchpad only has " + std::to_string(shared_size) + ".");
+    }
+    return offset;
+}
+
 }//namespace ast
@@ -11,14 +11,28 @@ void DoWhileStatement::EmitElsonV(std::ostream& stream, Context& context, std::s
 
     body_->EmitElsonV(stream, context, dest_reg);
 
+    // Uniform condition in a kernel, evaluated in scalar code like in the while loops
+    Kernel state = context.get_instruction_state();
+    RegisterFile& thread_file = context.get_reg_manager();
+    if (state == Kernel::_VECTOR){
+        context.set_instruction_state(Kernel::_SCALAR);
+        context.assign_reg_manager(context.get_active_warp().get_warp_file());
+    }
+
     std::string condition_reg = context.get_register(Type::_INT);
     condition_->EmitElsonV(stream, context, condition_reg);
 
-    stream << "s.bnez " << condition_reg << ", " << start_label << std::endl;
+    // ElsonV only branches on zero (beqz), the loop back is a jump
+    stream << "s.beqz " << condition_reg << ", " << end_label << std::endl;
+    stream << "s.j " << start_label << std::endl;
 
     stream << end_label << ":" << std::endl;
 
     context.deallocate_register(condition_reg);
+    if (state == Kernel::_VECTOR){
+        context.set_instruction_state(Kernel::_VECTOR);
+        context.assign_reg_manager(thread_file);
+    }
 
     context.pop_start_label();
     context.pop_end_label();
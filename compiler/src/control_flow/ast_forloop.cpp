@@ -35,16 +35,11 @@ void ForStatement::EmitElsonV(std::ostream &stream, Context &context, std::strin
     }
     else{
 
+        // The body keeps the thread registers of the kernel, its thread variables are allocated there
+        RegisterFile& thread_file = context.get_reg_manager();
+
         context.set_instruction_state(Kernel::_SCALAR);
-        std::vector<Warp>& warp_file = context.get_warp_file();
-        
-        Warp& active_warp = warp_file[0];
-        for(auto& warp : warp_file){
-            if(warp.get_activity() == true){
-                active_warp = warp;
-                break;
-            }
-        }
+        Warp& active_warp = context.get_active_warp();
 
         context.assign_reg_manager(active_warp.get_warp_file());
         if (init_){
@@ -61,7 +56,7 @@ void ForStatement::EmitElsonV(std::ostream &stream, Context &context, std::strin
         }
 
         context.set_instruction_state(Kernel::_VECTOR);
-        context.assign_reg_manager(active_warp.return_thread(0).get_thread_file());
+        context.assign_reg_manager(thread_file);
 
         body_->EmitElsonV(stream, context, dest_reg);
 
@@ -78,7 +73,7 @@ void ForStatement::EmitElsonV(std::ostream &stream, Context &context, std::strin
         stream << end_label << ":" << std::endl;
 
         context.set_instruction_state(Kernel::_VECTOR);
-        context.assign_reg_manager(active_warp.return_thread(0).get_thread_file());
+        context.assign_reg_manager(thread_file);
     }
 
     context.pop_start_label();
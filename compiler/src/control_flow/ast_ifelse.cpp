@@ -1,8 +1,36 @@
 #include "../../include/control_flow/ast_ifelse.hpp"
+#include "../../include/operations/ast_relational_operation.hpp"
+#include "../../include/statements/ast_assignment.hpp"
+#include "../../include/statements/ast_statements.hpp"
+#include "../../include/statements/ast_expression_list.hpp"
 #include <iostream>
 
 namespace ast {
 
+// Looks through the single statement/expression wrappers the parser puts around a node
+static const Node* Unwrap(const Node* node) {
+    while (true) {
+        const Expression* expression = dynamic_cast<const Expression*>(node);
+        const NodeList* list = dynamic_cast<const NodeList*>(node);
+        if (expression && expression->get_nodes().size() == 1) {
+            node = expression->get_nodes()[0].get();
+        } else if (list && list->get_nodes().size() == 1) {
+            node = list->get_nodes()[0].get();
+        } else {
+            return node;
+        }
+    }
+}
+
+// Local, non array/pointer variable of the given type, the only kind the argmin lowering stores to
+static bool IsPlainLocal(Context& context, const Identifier* identifier, Type type) {
+    if (!identifier || context.is_enum(identifier->GetId())) {
+        return false;
+    }
+    const Variable& variable = context.get_variable(identifier->GetId());
+    return variable.get_scope() == ScopeLevel::LOCAL && !variable.is_pointer() && !variable.is_array() && variable.get_type() == type;
+}
+
 // void IfStatement::EmitElsonV(std::ostream& stream, Context& context, std::string dest_reg) const {
 //     std::string condition_reg = context.get_register(Type::_INT);
 //     condition_->EmitElsonV(stream, context, condition_reg);
@@ -62,7 +90,99 @@ namespace ast {
 //     context.deallocate_register(condition_reg);
 // }
 
+// Lowers the argmin update
+//     if (d < best) { best = d; idx = k; }
+// on a float best and int idx to a single fminidx.s, with d and k in a float/int register pair
+// and best and idx in another. No branch, so the lanes of a warp never diverge on it.
+bool IfStatement::EmitMinIndex(std::ostream& stream, Context& context) const {
+    if (is_ternary_ || else_branch_) {
+        return false;
+    }
+
+    const RelationExpression* relation = dynamic_cast<const RelationExpression*>(Unwrap(condition_.get()));
+    if (!relation || (relation->get_op() != RelationOp::LESS_THAN && relation->get_op() != RelationOp::GREATER_THAN)) {
+        return false;
+    }
+    // best > d is the same as d < best
+    bool less = relation->get_op() == RelationOp::LESS_THAN;
+    const Identifier* candidate = dynamic_cast<const Identifier*>(Unwrap(less ? relation->get_left() : relation->get_right()));
+    const Identifier* best = dynamic_cast<const Identifier*>(Unwrap(less ? relation->get_right() : relation->get_left()));
+
+    const StatementList* then_statements = dynamic_cast<const StatementList*>(Unwrap(then_branch_.get()));
+    if (!then_statements || then_statements->get_nodes().size() != 2) {
+        return false;
+    }
+    const Assignment* value_assignment = dynamic_cast<const Assignment*>(Unwrap(then_statements->get_nodes()[0].get()));
+    const Assignment* index_assignment = dynamic_cast<const Assignment*>(Unwrap(then_statements->get_nodes()[1].get()));
+    if (!value_assignment || !index_assignment) {
+        return false;
+    }
+
+    const Identifier* value_target = dynamic_cast<const Identifier*>(value_assignment->get_target());
+    const Identifier* value = dynamic_cast<const Identifier*>(Unwrap(value_assignment->get_value()));
+    const Identifier* index_target = dynamic_cast<const Identifier*>(index_assignment->get_target());
+    const Node* index = Unwrap(index_assignment->get_value());
+    const Identifier* index_identifier = dynamic_cast<const Identifier*>(index);
+
+    if (!candidate || !best || !value_target || !value || !index_target) {
+        return false;
+    }
+    if (value_target->GetId() != best->GetId() || value->GetId() != candidate->GetId() || candidate->GetId() == best->GetId()) {
+        return false;
+    }
+    // The index is evaluated before best is updated, so it must not read best
+    if (!dynamic_cast<const IntConstant*>(index) && !(index_identifier && index_identifier->GetId() != best->GetId())) {
+        return false;
+    }
+    if (!IsPlainLocal(context, best, Type::_FLOAT) || !IsPlainLocal(context, candidate, Type::_FLOAT) || !IsPlainLocal(context, index_target, Type::_INT)) {
+        return false;
+    }
+    if (index_identifier && !context.is_enum(index_identifier->GetId()) && !IsPlainLocal(context, index_identifier, Type::_INT)) {
+        return false;
+    }
+
+    auto [candidate_reg, candidate_index_reg] = context.get_register_pair();
+    auto [best_reg, best_index_reg] = context.get_register_pair();
+
+    context.push_operation_type(Type::_FLOAT);
+    candidate->EmitElsonV(stream, context, candidate_reg);
+    best->EmitElsonV(stream, context, best_reg);
+    context.pop_operation_type();
+
+    context.push_operation_type(Type::_INT);
+    index->EmitElsonV(stream, context, candidate_index_reg);
+    index_target->EmitElsonV(stream, context, best_index_reg);
+    context.pop_operation_type();
+
+    stream << asm_prefix.at(context.get_instruction_state()) << "fminidx.s " << best_reg << ", " << candidate_reg << ", " << best_reg << std::endl;
+
+    // Write both back the way Assignment does
+    const std::pair<const Identifier*, std::string> results[] = {{best, best_reg}, {index_target, best_index_reg}};
+    for (const auto& [target, reg] : results) {
+        Variable& variable = context.get_variable(target->GetId());
+        Type type = variable.get_type();
+        if (context.get_instruction_state() == Kernel::_SCALAR) {
+            stream << asm_prefix.at(context.get_instruction_state()) << context.store_instr(type) << " " << reg << ", " << variable.get_offset() - 4 << "(sp)" << std::endl;
+        } else {
+            if (variable.get_reg() == "") {
+                variable.set_reg(context.get_register(type));
+                context.add_thread_reg(variable.get_reg());
+            }
+            context.emit_move(stream, variable.get_reg(), reg, type);
+        }
+    }
+
+    context.deallocate_register(best_index_reg);
+    context.deallocate_register(best_reg);
+    context.deallocate_register(candidate_index_reg);
+    context.deallocate_register(candidate_reg);
+    return true;
+}
+
 void IfStatement::EmitElsonV(std::ostream& stream, Context& context, std::string dest_reg) const {
+    if (EmitMinIndex(stream, context)) {
+        return;
+    }
 
     if(context.get_instruction_state() == Kernel::_SCALAR){
         std::string condition_reg = context.get_register(Type::_INT);
@@ -11,20 +11,33 @@ void WhileStatement::EmitElsonV(std::ostream& stream, Context& context, std::str
 
     stream << start_label << ":" << std::endl;
 
+    // In a kernel the whole warp branches, like the for loops the condition is evaluated in scalar code
+    // (a uniform value: locals and arrays of the function, not thread variables)
+    Kernel state = context.get_instruction_state();
+    RegisterFile& thread_file = context.get_reg_manager();
+    if (state == Kernel::_VECTOR){
+        context.set_instruction_state(Kernel::_SCALAR);
+        context.assign_reg_manager(context.get_active_warp().get_warp_file());
+    }
+
     std::string condition_reg = context.get_register(Type::_INT);
 
     condition_->EmitElsonV(stream, context, condition_reg);
 
     stream << "s.beqz " << condition_reg << ", " << end_label << std::endl;
 
+    context.deallocate_register(condition_reg);
+    if (state == Kernel::_VECTOR){
+        context.set_instruction_state(Kernel::_VECTOR);
+        context.assign_reg_manager(thread_file);
+    }
+
     body_->EmitElsonV(stream, context, dest_reg);
 
     stream << "s.j " << start_label << std::endl;
 
     stream << end_label << ":" << std::endl;
 
-    context.deallocate_register(condition_reg);
-
     context.pop_start_label();
     context.pop_end_label();
 }
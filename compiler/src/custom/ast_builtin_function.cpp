@@ -1,4 +1,6 @@
 #include "../../include/custom/ast_builtin_function.hpp"
+#include "../../include/symbols/ast_constant.hpp"
+#include "../../include/operations/ast_arithmetic_operation.hpp"
 #include <iostream>
 
 namespace ast {
@@ -7,13 +9,37 @@ Type BuiltInFunction::GetType(Context& context) const {
     if (func_name_ == "sync") {
         return Type::_VOID;
     }
+    if (func_name_ == "bf16x2_pack") {
+        return Type::_BF16X2;
+    }
+    if (func_name_ == "bf16x2_lo" || func_name_ == "bf16x2_hi") {
+        return Type::_FLOAT;
+    }
+    if (func_name_ == "q16_from_int") {
+        return Type::_Q16;
+    }
+    if (func_name_ == "q16_to_int") {
+        return Type::_INT;
+    }
+    if (func_name_ == "fabsdiff" || func_name_ == "fsqdiff") {
+        // fsqdiff also works on both halves of packed bfloat16
+        const Operand *args = dynamic_cast<const Operand*>(argument_.get());
+        return (func_name_ == "fsqdiff" && args->GetType(context) == Type::_BF16X2) ? Type::_BF16X2 : Type::_FLOAT;
+    }
 
     const Operand *args = dynamic_cast<const Operand*>(argument_.get());
     return args->GetType(context);
 }
 
 void BuiltInFunction::EmitElsonV(std::ostream& stream, Context& context, std::string dest_reg) const {
-    if (func_name_ == "fabsf") {
+    const ArithExpression* difference = dynamic_cast<const ArithExpression*>(argument_.get());
+    if (func_name_ == "fabsf" && difference && difference->IsFloatDifference(context)) {
+        // fabsf(a - b) is a single fabsdiff.s
+        if (dest_reg == "zero") {
+            dest_reg = context.get_register(Type::_FLOAT);
+        }
+        difference->EmitFloatDifference(stream, context, dest_reg, "fabsdiff.s");
+    } else if (func_name_ == "fabsf") {
         Type type = GetType(context);
         context.push_operation_type(type);
         std::string arg_reg = context.get_register(type);
@@ -24,7 +50,104 @@ void BuiltInFunction::EmitElsonV(std::ostream& stream, Context& context, std::st
             dest_reg = context.get_register(type);
         }
 
-        stream << asm_prefix.at(context.get_instruction_state()) <<"fabs.s " << dest_reg << ", " << arg_reg << std::endl;
+        // A q16 lives in an integer register, its absolute value is the integer one
+        std::string operation = (type == Type::_Q16) ? "abs " : "fabs.s ";
+        stream << asm_prefix.at(context.get_instruction_state()) << operation << dest_reg << ", " << arg_reg << std::endl;
+
+        context.deallocate_register(arg_reg);
+        context.pop_operation_type();
+    } else if (func_name_ == "shfl_down" || func_name_ == "shfl_xor") {
+        // Lane exchange only exists across the lanes of a warp
+        if (context.get_instruction_state() != Kernel::_VECTOR) {
+            throw std::runtime_error(func_name_ + " can only be used inside a kernel");
+        }
+
+        Type type = GetType(context);
+        context.push_operation_type(type);
+        std::string value_reg = context.get_register(type);
+
+        argument_->EmitElsonV(stream, context, value_reg);
+        context.add_reg_to_set(value_reg);
+
+        if (dest_reg == "zero") {
+            dest_reg = context.get_register(type);
+        }
+
+        std::string mode = (func_name_ == "shfl_down") ? "down" : "xor";
+        const IntConstant* lane_constant = dynamic_cast<const IntConstant*>(second_argument_.get());
+
+        if (type != Type::_FLOAT && lane_constant) {
+            // Constant lane offsets fit straight into the I-type immediate
+            stream << asm_prefix.at(context.get_instruction_state()) << "shfl." << mode << "i " << dest_reg << ", " << value_reg << ", " << lane_constant->get_val() << std::endl;
+        } else {
+            context.push_operation_type(Type::_INT);
+            std::string lane_reg = context.get_register(Type::_INT);
+            second_argument_->EmitElsonV(stream, context, lane_reg);
+            context.pop_operation_type();
+
+            if (type == Type::_FLOAT) {
+                stream << asm_prefix.at(context.get_instruction_state()) << "fshfl." << mode << ".s " << dest_reg << ", " << value_reg << ", " << lane_reg << std::endl;
+            } else {
+                stream << asm_prefix.at(context.get_instruction_state()) << "shfl." << mode << " " << dest_reg << ", " << value_reg << ", " << lane_reg << std::endl;
+            }
+            context.deallocate_register(lane_reg);
+        }
+
+        context.deallocate_register(value_reg);
+        context.remove_reg_from_set(value_reg);
+        context.pop_operation_type();
+    } else if (func_name_ == "fabsdiff" || func_name_ == "fsqdiff" || func_name_ == "bf16x2_pack") {
+        // bf16x2_pack rounds two floats into one register
+        Type type = (func_name_ == "bf16x2_pack") ? Type::_FLOAT : GetType(context);
+        context.push_operation_type(type);
+        std::string op1_reg = context.get_register(type);
+        argument_->EmitElsonV(stream, context, op1_reg);
+        context.add_reg_to_set(op1_reg);
+
+        std::string op2_reg = context.get_register(type);
+        second_argument_->EmitElsonV(stream, context, op2_reg);
+
+        if (dest_reg == "zero") {
+            dest_reg = context.get_register(GetType(context));
+        }
+
+        std::string operation = (func_name_ == "bf16x2_pack") ? "fcvt.bf2.s" : func_name_ + (type == Type::_BF16X2 ? ".bf2" : ".s");
+        stream << asm_prefix.at(context.get_instruction_state()) << operation << " " << dest_reg << ", " << op1_reg << ", " << op2_reg << std::endl;
+
+        context.deallocate_register(op2_reg);
+        context.deallocate_register(op1_reg);
+        context.remove_reg_from_set(op1_reg);
+        context.pop_operation_type();
+    } else if (func_name_ == "bf16x2_lo" || func_name_ == "bf16x2_hi") {
+        // Widening one half of a packed pair is exact
+        context.push_operation_type(Type::_BF16X2);
+        std::string arg_reg = context.get_register(Type::_BF16X2);
+
+        argument_->EmitElsonV(stream, context, arg_reg);
+
+        if (dest_reg == "zero") {
+            dest_reg = context.get_register(Type::_FLOAT);
+        }
+
+        std::string half = (func_name_ == "bf16x2_lo") ? "lo" : "hi";
+        stream << asm_prefix.at(context.get_instruction_state()) << "fcvt.s.bf2." << half << " " << dest_reg << ", " << arg_reg << std::endl;
+
+        context.deallocate_register(arg_reg);
+        context.pop_operation_type();
+    } else if (func_name_ == "q16_from_int" || func_name_ == "q16_to_int") {
+        // Q16.16 <-> int is a shift by the 16 fraction bits, q16_to_int rounds towards -inf
+        Type arg_type = (func_name_ == "q16_from_int") ? Type::_INT : Type::_Q16;
+        context.push_operation_type(arg_type);
+        std::string arg_reg = context.get_register(arg_type);
+
+        argument_->EmitElsonV(stream, context, arg_reg);
+
+        if (dest_reg == "zero") {
+            dest_reg = context.get_register(GetType(context));
+        }
+
+        std::string operation = (func_name_ == "q16_from_int") ? "slli" : "srai";
+        stream << asm_prefix.at(context.get_instruction_state()) << operation << " " << dest_reg << ", " << arg_reg << ", 16" << std::endl;
 
         context.deallocate_register(arg_reg);
         context.pop_operation_type();
@@ -41,6 +164,10 @@ void BuiltInFunction::Print(std::ostream& stream) const {
     if (argument_) {
         stream << "(";
         argument_->Print(stream);
+        if (second_argument_) {
+            stream << ", ";
+            second_argument_->Print(stream);
+        }
         stream << ")";
     }
 }
@@ -44,10 +44,12 @@ void ParameterList::EmitElsonV(std::ostream &stream, Context &context, std::stri
                 case Type::_INT:
                 case Type::_UNSIGNED_INT:
                 case Type::_LONG:
+                case Type::_Q16:
                     register_num = int_register++;
                     break;
                 case Type::_FLOAT:
                 case Type::_DOUBLE:
+                case Type::_BF16X2:
                     register_num = float_register++;
                     break;
                 default:
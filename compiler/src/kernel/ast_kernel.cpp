@@ -42,6 +42,10 @@ void KernelStatement::EmitWarpSwitchLogic(std::ostream& stream, Context& context
                                         const std::string& kernel_end_label) const {
     (void)kernel_start_label;
     std::vector<Warp>& warp_file = context.get_warp_file();
+
+    // The switch is scalar code, its registers come from a warp file (the thread files name v registers)
+    ScalarRegisterFile& switch_file = warp_file[0].get_warp_file();
+    context.assign_reg_manager(switch_file);
     
     // Store current warp's state
     std::string current_warp_reg = context.get_register(Type::_INT);
@@ -67,6 +71,8 @@ void KernelStatement::EmitWarpSwitchLogic(std::ostream& stream, Context& context
         stream << warp_check_label << ":" << std::endl;
     }
     
+    context.set_instruction_state(Kernel::_SCALAR);
+    context.assign_reg_manager(switch_file);
     context.deallocate_register(current_warp_reg);
     
     // === LOAD NEXT WARP ===
@@ -130,11 +136,10 @@ void KernelStatement::EmitKernelCleanup(std::ostream& stream, Context& context)
         }
     }
     
-    // Restore original CPU context
-    if(!warp_file.empty()) {
-        Warp& first_warp = warp_file[0];
-        context.assign_reg_manager(first_warp.get_warp_file());
-    }
+    // Restore original CPU context, the next kernel of the function builds its own warps
+    warp_file.clear();
+    thread_regs.clear();
+    context.reset_reg_manager();
 }
 
 // Enhanced StoreWarpRegisters that also stores completion status
@@ -7,6 +7,12 @@ void SyncStatement::EmitElsonV(std::ostream& stream, Context& context, std::stri
     (void) context;
     (void) dest_reg;
 
+    // 'gsync' waits for the warps of every block, the dispatcher releases it. It takes no label
+    if (grid_) {
+        stream << "gsync" << std::endl;
+        return;
+    }
+
     // A 'sync' statement in the C code translates to a SINGLE 'sync' instruction
     // in the assembly. The hardware's control unit is responsible for implementing
     // the barrier logic (i.e., stalling the warp until all threads arrive).
@@ -17,7 +23,7 @@ void SyncStatement::EmitElsonV(std::ostream& stream, Context& context, std::stri
     std::string endsync_label = context.create_label("endsync");
 
     // The 'sync' instruction tells the hardware to pause this warp until all
-    // active threads in the warp have also reached this instruction.
+    // active warps in the block have also reached this instruction.
     stream << "sync " << endsync_label << std::endl;
     
     // The label marks the instruction immediately following the sync barrier.
@@ -26,7 +32,7 @@ void SyncStatement::EmitElsonV(std::ostream& stream, Context& context, std::stri
 }
 
 void SyncStatement::Print(std::ostream& stream) const {
-    stream << "sync;" <<  std::endl;
+    stream << (grid_ ? "gsync;" : "sync;") <<  std::endl;
 }
 
 }
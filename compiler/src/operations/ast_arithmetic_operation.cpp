@@ -1,4 +1,5 @@
 #include "../../include/operations/ast_arithmetic_operation.hpp"
+#include "../../include/symbols/ast_identifier.hpp"
 
 namespace ast {
 
@@ -6,18 +7,18 @@ std::string ArithExpression::GetOperation(Type type) const {
     static const std::unordered_map<ArithOp, std::unordered_map<Type, std::string>> opMap = {
         {ArithOp::ADD, {
             {Type::_INT, "add"}, {Type::_UNSIGNED_INT, "add"}, {Type::_CHAR, "add"},
-            {Type::_SHORT, "add"}, {Type::_LONG, "add"},
-            {Type::_FLOAT, "fadd.s"}, {Type::_DOUBLE, "fadd.d"}
+            {Type::_SHORT, "add"}, {Type::_LONG, "add"}, {Type::_Q16, "add"},
+            {Type::_FLOAT, "fadd.s"}, {Type::_DOUBLE, "fadd.d"}, {Type::_BF16X2, "fadd.bf2"}
         }},
         {ArithOp::SUB, {
             {Type::_INT, "sub"}, {Type::_UNSIGNED_INT, "sub"}, {Type::_CHAR, "sub"},
-            {Type::_SHORT, "sub"}, {Type::_LONG, "sub"},
-            {Type::_FLOAT, "fsub.s"}, {Type::_DOUBLE, "fsub.d"}
+            {Type::_SHORT, "sub"}, {Type::_LONG, "sub"}, {Type::_Q16, "sub"},
+            {Type::_FLOAT, "fsub.s"}, {Type::_DOUBLE, "fsub.d"}, {Type::_BF16X2, "fsub.bf2"}
         }},
         {ArithOp::MUL, {
             {Type::_INT, "mul"}, {Type::_UNSIGNED_INT, "mul"}, {Type::_CHAR, "mul"},
-            {Type::_SHORT, "mul"}, {Type::_LONG, "mul"},
-            {Type::_FLOAT, "fmul.s"}, {Type::_DOUBLE, "fmul.d"}
+            {Type::_SHORT, "mul"}, {Type::_LONG, "mul"}, {Type::_Q16, "mulq"},
+            {Type::_FLOAT, "fmul.s"}, {Type::_DOUBLE, "fmul.d"}, {Type::_BF16X2, "fmul.bf2"}
         }},
         {ArithOp::DIV, {
             {Type::_INT, "div"}, {Type::_UNSIGNED_INT, "div"}, {Type::_CHAR, "div"},
@@ -46,30 +47,57 @@ void ArithExpression::EmitElsonV(std::ostream &stream, Context &context, std::st
 {
     Type type = std::max(context.get_operation_type(), GetType(context));
     type = isPointerOp(context) ? Type::_INT : type;
+    if (type == Type::_Q16 && GetType(context) != Type::_Q16)
+    {
+        // Integer subexpressions of a q16 expression stay integer, the q16 operation promotes their result
+        type = GetType(context);
+    }
+    if (type == Type::_FLOAT && GetType(context) < Type::_Q16)
+    {
+        // Same for integer subexpressions of a float expression, the float operation converts their result
+        type = GetType(context);
+    }
+    if (type == Type::_Q16 && (op_ == ArithOp::DIV || op_ == ArithOp::MOD))
+    {
+        throw std::runtime_error("ArithExpression: q16 has no division, multiply by a q16 reciprocal instead");
+    }
     context.push_operation_type(type);
 
-    std::string left_register = context.get_register(type);
-    left_->EmitElsonV(stream, context, left_register);
-    ShiftPointerOp(stream, context, left_register, left_);
+    if (EmitFusedMultiplyAdd(stream, context, type, dest_reg) || EmitSquaredDifference(stream, context, type, dest_reg)) {
+        context.pop_operation_type();
+        return;
+    }
+
+    std::string left_register;
+    const Operand* left_operand = dynamic_cast<const Operand*>(left_.get());
+    if (type == Type::_FLOAT && left_operand && left_operand->GetType(context) < Type::_Q16) {
+        left_register = EmitIntegerAsFloat(stream, context, left_);
+    } else {
+        left_register = context.get_register(type);
+        left_->EmitElsonV(stream, context, left_register);
+        ShiftPointerOp(stream, context, left_register, left_);
+    }
     context.add_reg_to_set(left_register);
 
     std::string right_register;
     const Operand* right_operand1 = dynamic_cast<const Operand*>(right_.get());
     Type right_type = right_operand1->GetType(context);
-    if (type == Type::_FLOAT && right_type == Type::_INT) {
-        // Allocate integer register for the right int operand
-        std::string int_right_reg = context.get_register(Type::_INT);
-        right_->EmitElsonV(stream, context, int_right_reg);
-        context.add_reg_to_set(int_right_reg);
-
-        right_register = context.get_register(Type::_FLOAT);
-        stream << asm_prefix.at(context.get_instruction_state()) << "fcvt.s.w " << right_register << ", " << int_right_reg << std::endl;
+    if (type == Type::_FLOAT && right_type < Type::_Q16) {
+        right_register = EmitIntegerAsFloat(stream, context, right_);
     } else {
         right_register = context.get_register(type);
         right_->EmitElsonV(stream, context, right_register);
         ShiftPointerOp(stream, context, right_register, right_);
     }
 
+    bool integer_scale = (type == Type::_Q16 && op_ == ArithOp::MUL && IsIntegerScale(context));
+    if (type == Type::_Q16 && !integer_scale)
+    {
+        // q16 + int and q16 - int add the whole number, not its raw bits
+        context.promote_to_q16(stream, left_register, left_operand ? left_operand->GetType(context) : type);
+        context.promote_to_q16(stream, right_register, right_type);
+    }
+
     // Handle struct access (as per your existing logic)
     const StructAccess* leftStructAccess = dynamic_cast<const StructAccess*>(left_.get());
     const StructAccess* rightStructAccess = dynamic_cast<const StructAccess*>(right_.get());
@@ -84,7 +112,13 @@ void ArithExpression::EmitElsonV(std::ostream &stream, Context &context, std::st
 
 
     // Emit the final operation, adding the two operands
-    stream << asm_prefix.at(context.get_instruction_state())  << GetOperation(type) << " " << dest_reg << ", " << left_register << ", " << right_register << std::endl;
+    std::string operation = GetOperation(type);
+    if (integer_scale)
+    {
+        // Scaling by a plain integer keeps the Q16.16 format, no shift needed
+        operation = "mul";
+    }
+    stream << asm_prefix.at(context.get_instruction_state())  << operation << " " << dest_reg << ", " << left_register << ", " << right_register << std::endl;
 
     // Clean up the registers
     context.deallocate_register(right_register);
@@ -94,6 +128,19 @@ void ArithExpression::EmitElsonV(std::ostream &stream, Context &context, std::st
     context.pop_operation_type();
 }
 
+std::string ArithExpression::EmitIntegerAsFloat(std::ostream &stream, Context &context, const NodePtr& node) const
+{
+    // The integer operand is evaluated in an integer register, then converted for the float operation
+    std::string int_register = context.get_register(Type::_INT);
+    node->EmitElsonV(stream, context, int_register);
+
+    std::string float_register = context.get_register(Type::_FLOAT);
+    stream << asm_prefix.at(context.get_instruction_state()) << "fcvt.s.w " << float_register << ", " << int_register << std::endl;
+    context.deallocate_register(int_register);
+
+    return float_register;
+}
+
 void ArithExpression::Print(std::ostream &stream) const
 {
     left_->Print(stream);
@@ -181,5 +228,137 @@ Type ArithExpression::NewPointerType(Context &context) const
     return right_operand->GetType(context);
 }
 
+// q16 * int or int * q16
+bool ArithExpression::IsIntegerScale(Context &context) const
+{
+    const Operand *left_operand = dynamic_cast<const Operand *>(left_.get());
+    const Operand *right_operand = dynamic_cast<const Operand *>(right_.get());
+    return left_operand && right_operand && (left_operand->GetType(context) != Type::_Q16 || right_operand->GetType(context) != Type::_Q16);
+}
+
+// Returns node as a float multiplication of two float operands, or nullptr
+const ArithExpression* ArithExpression::AsFloatProduct(Context &context, const NodePtr& node) const
+{
+    const ArithExpression *product = dynamic_cast<const ArithExpression *>(node.get());
+    if (!product || product->op_ != ArithOp::MUL || product->isPointerOp(context))
+    {
+        return nullptr;
+    }
+
+    const Operand *left_operand = dynamic_cast<const Operand *>(product->left_.get());
+    const Operand *right_operand = dynamic_cast<const Operand *>(product->right_.get());
+    if (!left_operand || !right_operand || left_operand->GetType(context) != Type::_FLOAT || right_operand->GetType(context) != Type::_FLOAT)
+    {
+        return nullptr;
+    }
+    return product;
+}
+
+// Contracts a * b + c, c + a * b and a * b - c on floats into a single fmadd.s/fmsub.s
+bool ArithExpression::EmitFusedMultiplyAdd(std::ostream &stream, Context &context, Type type, std::string dest_reg) const
+{
+    if (type != Type::_FLOAT || (op_ != ArithOp::ADD && op_ != ArithOp::SUB))
+    {
+        return false;
+    }
+
+    const ArithExpression *product = AsFloatProduct(context, left_);
+    const NodePtr *addend = &right_;
+    if (!product && op_ == ArithOp::ADD)
+    {
+        product = AsFloatProduct(context, right_);
+        addend = &left_;
+    }
+
+    const Operand *addend_operand = dynamic_cast<const Operand *>(addend->get());
+    if (!product || !addend_operand || addend_operand->GetType(context) != Type::_FLOAT)
+    {
+        return false;
+    }
+
+    std::string op1_register = context.get_register(Type::_FLOAT);
+    product->left_->EmitElsonV(stream, context, op1_register);
+    context.add_reg_to_set(op1_register);
+
+    std::string op2_register = context.get_register(Type::_FLOAT);
+    product->right_->EmitElsonV(stream, context, op2_register);
+    context.add_reg_to_set(op2_register);
+
+    std::string addend_register = context.get_register(Type::_FLOAT);
+    (*addend)->EmitElsonV(stream, context, addend_register);
+
+    std::string operation = (op_ == ArithOp::ADD) ? "fmadd.s" : "fmsub.s";
+    stream << asm_prefix.at(context.get_instruction_state()) << operation << " " << dest_reg << ", " << op1_register << ", " << op2_register << ", " << addend_register << std::endl;
+
+    context.deallocate_register(addend_register);
+    context.deallocate_register(op2_register);
+    context.deallocate_register(op1_register);
+    context.remove_reg_from_set(op2_register);
+    context.remove_reg_from_set(op1_register);
+    return true;
+}
+
+// a - b where a and b are both float operands
+bool ArithExpression::IsFloatDifference(Context &context) const
+{
+    if (op_ != ArithOp::SUB || isPointerOp(context))
+    {
+        return false;
+    }
+
+    const Operand *left_operand = dynamic_cast<const Operand *>(left_.get());
+    const Operand *right_operand = dynamic_cast<const Operand *>(right_.get());
+    return left_operand && right_operand && left_operand->GetType(context) == Type::_FLOAT && right_operand->GetType(context) == Type::_FLOAT;
+}
+
+// Emits operation dest_reg, a, b for a float difference a - b (fabsdiff.s, fsqdiff.s)
+void ArithExpression::EmitFloatDifference(std::ostream &stream, Context &context, std::string dest_reg, const std::string &operation) const
+{
+    context.push_operation_type(Type::_FLOAT);
+
+    std::string left_register = context.get_register(Type::_FLOAT);
+    left_->EmitElsonV(stream, context, left_register);
+    context.add_reg_to_set(left_register);
+
+    std::string right_register = context.get_register(Type::_FLOAT);
+    right_->EmitElsonV(stream, context, right_register);
+
+    stream << asm_prefix.at(context.get_instruction_state()) << operation << " " << dest_reg << ", " << left_register << ", " << right_register << std::endl;
+
+    context.deallocate_register(right_register);
+    context.deallocate_register(left_register);
+    context.remove_reg_from_set(left_register);
+    context.pop_operation_type();
+}
+
+// Contracts (a - b) * (a - b) on float variables into a single fsqdiff.s
+bool ArithExpression::EmitSquaredDifference(std::ostream &stream, Context &context, Type type, std::string dest_reg) const
+{
+    if (type != Type::_FLOAT || op_ != ArithOp::MUL)
+    {
+        return false;
+    }
+
+    const ArithExpression *left_difference = dynamic_cast<const ArithExpression *>(left_.get());
+    const ArithExpression *right_difference = dynamic_cast<const ArithExpression *>(right_.get());
+    if (!left_difference || !right_difference || !left_difference->IsFloatDifference(context) || !right_difference->IsFloatDifference(context))
+    {
+        return false;
+    }
+
+    // Only plain variables, so both sides are known to be the same value
+    auto same_variable = [](const NodePtr &a, const NodePtr &b) {
+        const Identifier *a_identifier = dynamic_cast<const Identifier *>(a.get());
+        const Identifier *b_identifier = dynamic_cast<const Identifier *>(b.get());
+        return a_identifier && b_identifier && a_identifier->GetId() == b_identifier->GetId();
+    };
+    if (!same_variable(left_difference->left_, right_difference->left_) || !same_variable(left_difference->right_, right_difference->right_))
+    {
+        return false;
+    }
+
+    left_difference->EmitFloatDifference(stream, context, dest_reg, "fsqdiff.s");
+    return true;
+}
 
 }
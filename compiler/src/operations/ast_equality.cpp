@@ -6,12 +6,12 @@ std::string EqualityExpression::GetOperation(Type type) const {
     static const std::unordered_map<EqualityOp, std::unordered_map<Type, std::string>> opMap = {
         {EqualityOp::EQUAL, {
             {Type::_INT, "seqz"}, {Type::_UNSIGNED_INT, "seqz"}, {Type::_CHAR, "seqz"},
-            {Type::_SHORT, "seqz"}, {Type::_LONG, "seqz"},
+            {Type::_SHORT, "seqz"}, {Type::_LONG, "seqz"}, {Type::_Q16, "seqz"},
             {Type::_FLOAT, "feq.s"}, {Type::_DOUBLE, "feq.d"}
         }},
         {EqualityOp::NOT_EQUAL, {
             {Type::_INT, "snez"}, {Type::_UNSIGNED_INT, "snez"}, {Type::_CHAR, "snez"},
-            {Type::_SHORT, "snez"}, {Type::_LONG, "snez"},
+            {Type::_SHORT, "snez"}, {Type::_LONG, "snez"}, {Type::_Q16, "snez"},
             {Type::_FLOAT, "feq.s"}, {Type::_DOUBLE, "feq.d"}  // feq.s needs inversion for !=
         }}
     };
@@ -54,6 +54,14 @@ void EqualityExpression::EmitElsonV(std::ostream &stream, Context &context, std:
         rightStructAccess->EmitElsonV(stream, context, right_register);
     }
 
+    if (type == Type::_Q16) {
+        // q16 == int compares against the whole number
+        const Operand *left_operand = dynamic_cast<const Operand *>(left_.get());
+        const Operand *right_operand = dynamic_cast<const Operand *>(right_.get());
+        context.promote_to_q16(stream, left_register, left_operand ? left_operand->GetType(context) : type);
+        context.promote_to_q16(stream, right_register, right_operand ? right_operand->GetType(context) : type);
+    }
+
     std::string operation = GetOperation(type);
 
     std::string temp_reg = context.get_register(Type::_INT);
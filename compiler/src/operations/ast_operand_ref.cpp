@@ -0,0 +1,35 @@
+#include "../../include/operations/ast_operand_ref.hpp"
+
+namespace ast {
+
+Type OperandRef::GetType(Context& context) const {
+    const Operand* operand = dynamic_cast<const Operand*>(node_);
+    const StructAccess* struct_access = dynamic_cast<const StructAccess*>(node_);
+    if (operand) {
+        return operand->GetType(context);
+    }
+    if (struct_access) {
+        return struct_access->GetType(context);
+    }
+    throw std::runtime_error("OperandRef: Invalid operand type: " + std::string(typeid(*node_).name()));
+}
+
+void OperandRef::EmitElsonV(std::ostream& stream, Context& context, std::string dest_reg) const {
+    node_->EmitElsonV(stream, context, dest_reg);
+}
+
+void OperandRef::Print(std::ostream& stream) const {
+    node_->Print(stream);
+}
+
+bool OperandRef::isPointerOp(Context &context) const {
+    const Operand* operand = dynamic_cast<const Operand*>(node_);
+    return operand ? operand->isPointerOp(context) : false;
+}
+
+std::string OperandRef::GetId() const {
+    const Operand* operand = dynamic_cast<const Operand*>(node_);
+    return operand ? operand->GetId() : "";
+}
+
+} // namespace ast
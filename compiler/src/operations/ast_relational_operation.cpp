@@ -6,22 +6,22 @@ std::string RelationExpression::GetOperation(Type type) const {
     static const std::unordered_map<RelationOp, std::unordered_map<Type, std::string>> opMap = {
         {RelationOp::LESS_THAN, {
             {Type::_INT, "slt"}, {Type::_UNSIGNED_INT, "sltu"}, {Type::_CHAR, "slt"},
-            {Type::_SHORT, "slt"},
+            {Type::_SHORT, "slt"}, {Type::_Q16, "slt"},
             {Type::_FLOAT, "flt"}, {Type::_DOUBLE, "slt"}
         }},
         {RelationOp::GREATER_THAN, {
             {Type::_INT, "sgt"}, {Type::_UNSIGNED_INT, "sgtu"}, {Type::_CHAR, "sgt"},
-            {Type::_SHORT, "sgt"},
+            {Type::_SHORT, "sgt"}, {Type::_Q16, "sgt"},
             {Type::_FLOAT, "fgt.s"}, {Type::_DOUBLE, "fgt.d"}
         }},
         {RelationOp::LESS_THAN_OR_EQUAL, {
             {Type::_INT, "sgt"}, {Type::_UNSIGNED_INT, "sgtu"}, {Type::_CHAR, "sgt"},
-            {Type::_SHORT, "sgt"},
+            {Type::_SHORT, "sgt"}, {Type::_Q16, "sgt"},
             {Type::_FLOAT, "fgt.s"}, {Type::_DOUBLE, "fgt.d"}
         }},
         {RelationOp::GREATER_THAN_OR_EQUAL, {
             {Type::_INT, "slt"}, {Type::_UNSIGNED_INT, "sltu"}, {Type::_CHAR, "slt"},
-            {Type::_SHORT, "slt"},
+            {Type::_SHORT, "slt"}, {Type::_Q16, "slt"},
             {Type::_FLOAT, "flt"}, {Type::_DOUBLE, "flt.d"}
         }}
     };
@@ -66,7 +66,10 @@ void RelationExpression::EmitElsonV(std::ostream &stream, Context &context, std:
         rightStructAccess->EmitElsonV(stream, context, right_register);
     }
 
-    if(context.get_instruction_state() == Kernel::_SCALAR){
+    if (type == Type::_Q16) {
+        EmitSignedCompare(stream, context, dest_reg, left_register, right_register);
+    }
+    else if(context.get_instruction_state() == Kernel::_SCALAR){
         // Handle LESS_THAN or GREATER_THAN and others normally
         if (op_ == RelationOp::LESS_THAN) {
             stream << asm_prefix.at(context.get_instruction_state()) << GetOperation(type) << " " << dest_reg << ", " << left_register << ", " << right_register << std::endl;
@@ -77,12 +80,12 @@ void RelationExpression::EmitElsonV(std::ostream &stream, Context &context, std:
         // Handle LESS_THAN_OR_EQUAL: Invert the result of LESS_THAN
         else if (op_ == RelationOp::LESS_THAN_OR_EQUAL) {
             stream << asm_prefix.at(context.get_instruction_state()) << GetOperation(type) << " " << dest_reg << ", " << left_register << ", " << right_register << std::endl;
-            stream << asm_prefix.at(context.get_instruction_state()) << "xori " << dest_reg << ", " << dest_reg << ", 1" << std::endl; // Inverts the result
+            InvertResult(stream, context, dest_reg);
         }
         // Handle GREATER_THAN_OR_EQUAL: Invert the result of GREATER_THAN
         else if (op_ == RelationOp::GREATER_THAN_OR_EQUAL) {
             stream << asm_prefix.at(context.get_instruction_state()) << GetOperation(type) << " " << dest_reg << ", " << left_register << ", " << right_register << std::endl;
-            stream << asm_prefix.at(context.get_instruction_state()) << "xori " << dest_reg << ", " << dest_reg << ", 1" << std::endl; // Inverts the result
+            InvertResult(stream, context, dest_reg);
         }
     }
     else{
@@ -113,6 +116,52 @@ void RelationExpression::EmitElsonV(std::ostream &stream, Context &context, std:
     context.pop_operation_type();
 }
 
+// slt compares unsigned, q16 values are signed: adding 2^31 to both sides flips their sign bits,
+// which orders them the same way unsigned as they were signed
+void RelationExpression::EmitSignedCompare(std::ostream &stream, Context &context, std::string dest_reg, const std::string &left_register, const std::string &right_register) const
+{
+    std::string prefix = asm_prefix.at(context.get_instruction_state());
+
+    // q16 < int compares against the whole number
+    const Operand *left_operand = dynamic_cast<const Operand *>(left_.get());
+    const Operand *right_operand = dynamic_cast<const Operand *>(right_.get());
+    context.promote_to_q16(stream, left_register, left_operand ? left_operand->GetType(context) : Type::_Q16);
+    context.promote_to_q16(stream, right_register, right_operand ? right_operand->GetType(context) : Type::_Q16);
+
+    std::string sign_register = context.get_register(Type::_INT);
+    stream << prefix << "lui " << sign_register << ", 524288" << std::endl;
+    stream << prefix << "add " << left_register << ", " << left_register << ", " << sign_register << std::endl;
+    stream << prefix << "add " << right_register << ", " << right_register << ", " << sign_register << std::endl;
+    context.deallocate_register(sign_register);
+
+    // a > b is b < a, a <= b is !(b < a) and a >= b is !(a < b)
+    bool swap = (op_ == RelationOp::GREATER_THAN || op_ == RelationOp::LESS_THAN_OR_EQUAL);
+    bool invert = (op_ == RelationOp::LESS_THAN_OR_EQUAL || op_ == RelationOp::GREATER_THAN_OR_EQUAL);
+    const std::string &first = swap ? right_register : left_register;
+    const std::string &second = swap ? left_register : right_register;
+
+    if (context.get_instruction_state() == Kernel::_SCALAR) {
+        stream << prefix << "slt " << dest_reg << ", " << first << ", " << second << std::endl;
+        if (invert) {
+            InvertResult(stream, context, dest_reg);
+        }
+    }
+    else {
+        // The vector compare writes the thread mask in s26, there is no per lane inversion of it
+        if (invert) {
+            throw std::runtime_error("RelationExpression: q16 <= and >= are not supported in a kernel, use < or >");
+        }
+        stream << "sx.slt s26, " << first << ", " << second << std::endl;
+    }
+}
+
+// 1 - x flips a 0/1 compare result. There is no xori, and seqi is not waited on like the other integer ALU ops
+void RelationExpression::InvertResult(std::ostream &stream, Context &context, const std::string &dest_reg) const
+{
+    std::string prefix = asm_prefix.at(context.get_instruction_state());
+    stream << prefix << "neg " << dest_reg << ", " << dest_reg << std::endl;
+    stream << prefix << "addi " << dest_reg << ", " << dest_reg << ", 1" << std::endl;
+}
 
 void RelationExpression::Print(std::ostream &stream) const
 {
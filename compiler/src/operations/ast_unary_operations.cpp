@@ -101,7 +101,16 @@ void UnaryExpression::EmitElsonV(std::ostream& stream, Context& context, std::st
 
     //If the operand is an identifier, store the result back to memory
     const Identifier* identifier = dynamic_cast<const Identifier*>(operand_.get());
-    if (identifier){
+    if (identifier && context.get_instruction_state() == Kernel::_VECTOR && (op_ == UnaryOp::INC || op_ == UnaryOp::DEC)){
+        // In a kernel the variable is a thread register, the way Assignment keeps it
+        Variable& variable = context.get_variable(identifier->GetId());
+        if (variable.get_reg() == ""){
+            variable.set_reg(context.get_register(type));
+            context.add_thread_reg(variable.get_reg());
+        }
+        context.emit_move(stream, variable.get_reg(), dest_reg, type);
+    }
+    else if (identifier){
         Variable variable = context.get_variable(identifier->GetId());
         int offset = variable.get_offset();
         stream << asm_prefix.at(context.get_instruction_state()) << context.store_instr(type) << " " << dest_reg << ", " << offset - 4 << "(sp)" <<std::endl;
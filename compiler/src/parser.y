@@ -4,6 +4,8 @@
 // rename parser_full.y to parser.y once you're happy with
 // how this example works.
 
+%locations
+
 %code requires{
     #include "ast.hpp"
 
@@ -32,9 +34,9 @@
 %token PTR_OP INC_OP DEC_OP LEFT_OP RIGHT_OP LE_OP GE_OP EQ_OP NE_OP AND_OP OR_OP
 %token MUL_ASSIGN DIV_ASSIGN MOD_ASSIGN ADD_ASSIGN SUB_ASSIGN LEFT_ASSIGN RIGHT_ASSIGN AND_ASSIGN XOR_ASSIGN OR_ASSIGN
 %token TYPE_NAME TYPEDEF EXTERN STATIC AUTO REGISTER SIZEOF
-%token CHAR SHORT INT LONG SIGNED UNSIGNED FLOAT DOUBLE CONST VOLATILE VOID
+%token CHAR SHORT INT LONG SIGNED UNSIGNED FLOAT DOUBLE BF16X2 Q16 CONST VOLATILE VOID
 %token STRUCT UNION ENUM ELLIPSIS OUT
-%token CASE DEFAULT IF ELSE SWITCH WHILE DO FOR GOTO CONTINUE BREAK RETURN FABSF SYNC BLOCKIDX THREADIDX BLOCKSIZE KERNEL
+%token CASE DEFAULT IF ELSE SWITCH WHILE DO FOR GOTO CONTINUE BREAK RETURN FABSF FABSDIFF FSQDIFF BF16X2_PACK BF16X2_LO BF16X2_HI Q16_FROM_INT Q16_TO_INT SHFL_DOWN SHFL_XOR SYNC GSYNC BLOCKIDX THREADIDX BLOCKSIZE KERNEL SHARED
 
 %type <node> translation_unit external_declaration function_definition primary_expression postfix_expression argument_expression_list
 %type <node> unary_expression cast_expression multiplicative_expression additive_expression shift_expression relational_expression
@@ -86,12 +88,15 @@ function_definition
 declaration_specifiers
 	: type_specifier { $$ = $1; }
 	| TYPEDEF declaration_specifiers { $$ = new Typedef(NodePtr($2)); }
+	| SHARED declaration_specifiers { $$ = new SharedSpecifier(NodePtr($2)); }
 	;
 
 type_specifier
 	: INT { $$ = new TypeSpecifier(Type::_INT); }
     | DOUBLE { $$ = new TypeSpecifier(Type::_DOUBLE); }
     | FLOAT { $$ = new TypeSpecifier(Type::_FLOAT); }
+    | BF16X2 { $$ = new TypeSpecifier(Type::_BF16X2); }
+    | Q16 { $$ = new TypeSpecifier(Type::_Q16); }
 	| CHAR 		{ $$ = new TypeSpecifier(Type::_CHAR); }
 	| UNSIGNED 	{ $$ = new TypeSpecifier(Type::_UNSIGNED_INT); }
 	| SHORT 	{ $$ = new TypeSpecifier(Type::_SHORT); }
@@ -220,10 +225,13 @@ compound_statement
 	| '{' '}' 									{ $$ = new CompoundStatement(nullptr); }
 
 statement_list
-	: statement                 { $$ = new StatementList(NodePtr($1)); }
+	: statement                 {
+		StatementList *statement_list = new StatementList(nullptr);
+		statement_list->PushBack(NodePtr($1), @1.first_line);
+		$$ = statement_list; }
 	| statement_list statement  {
 		StatementList *statement_list = dynamic_cast<StatementList*>($1);
-		statement_list->PushBack(NodePtr($2));
+		statement_list->PushBack(NodePtr($2), @2.first_line);
 		$$=statement_list; }
 	;
 
@@ -253,6 +261,7 @@ labeled_statement
 
 sync_statement
 	: SYNC ';' { $$ = new SyncStatement();}
+	| GSYNC ';' { $$ = new SyncStatement(true);}
 	;
 
 kernel_statement
@@ -289,6 +298,15 @@ primary_expression
 	| CHAR_LITERAL { $$ = new CharacterLiteral($1); }
 	| STRING_LITERAL { $$ = new StringLiteral($1); }
 	| FABSF '(' expression ')'  { $$ = new BuiltInFunction("fabsf", NodePtr($3)); }
+	| FABSDIFF '(' assignment_expression ',' assignment_expression ')'  { $$ = new BuiltInFunction("fabsdiff", NodePtr($3), NodePtr($5)); }
+	| FSQDIFF '(' assignment_expression ',' assignment_expression ')'  { $$ = new BuiltInFunction("fsqdiff", NodePtr($3), NodePtr($5)); }
+	| BF16X2_PACK '(' assignment_expression ',' assignment_expression ')'  { $$ = new BuiltInFunction("bf16x2_pack", NodePtr($3), NodePtr($5)); }
+	| BF16X2_LO '(' expression ')'  { $$ = new BuiltInFunction("bf16x2_lo", NodePtr($3)); }
+	| BF16X2_HI '(' expression ')'  { $$ = new BuiltInFunction("bf16x2_hi", NodePtr($3)); }
+	| Q16_FROM_INT '(' expression ')'  { $$ = new BuiltInFunction("q16_from_int", NodePtr($3)); }
+	| Q16_TO_INT '(' expression ')'  { $$ = new BuiltInFunction("q16_to_int", NodePtr($3)); }
+	| SHFL_DOWN '(' assignment_expression ',' assignment_expression ')'  { $$ = new BuiltInFunction("shfl_down", NodePtr($3), NodePtr($5)); }
+	| SHFL_XOR '(' assignment_expression ',' assignment_expression ')'  { $$ = new BuiltInFunction("shfl_xor", NodePtr($3), NodePtr($5)); }
 	| BLOCKIDX    { $$ = new BuiltInOperand("blockId.x", 30); }
     | THREADIDX   { $$ = new BuiltInOperand("threadId.x", 26); }
     | BLOCKSIZE   { $$ = new BuiltInOperand("blocksize", 31); }
@@ -411,16 +429,16 @@ conditional_expression
 assignment_expression
 	: conditional_expression
 	| unary_expression '=' assignment_expression { $$ = new Assignment(NodePtr($1), NodePtr($3)); }
-	| unary_expression MUL_ASSIGN assignment_expression { $$ = new Assignment(NodePtr($1), NodePtr(new ArithExpression(ArithOp::MUL, NodePtr($1), NodePtr($3)))); }
-	| unary_expression DIV_ASSIGN assignment_expression { $$ = new Assignment(NodePtr($1), NodePtr(new ArithExpression(ArithOp::DIV, NodePtr($1), NodePtr($3)))); }
-	| unary_expression MOD_ASSIGN assignment_expression { $$ = new Assignment(NodePtr($1), NodePtr(new ArithExpression(ArithOp::MOD, NodePtr($1), NodePtr($3)))); }
-	| unary_expression ADD_ASSIGN assignment_expression { $$ = new Assignment(NodePtr($1), NodePtr(new ArithExpression(ArithOp::ADD, NodePtr($1), NodePtr($3)))); }
-	| unary_expression SUB_ASSIGN assignment_expression { $$ = new Assignment(NodePtr($1), NodePtr(new ArithExpression(ArithOp::SUB, NodePtr($1), NodePtr($3)))); }
-	| unary_expression LEFT_ASSIGN assignment_expression { $$ = new Assignment(NodePtr($1), NodePtr(new BitwiseExpression(BitwiseOp::LEFT_SHIFT, NodePtr($1), NodePtr($3)))); }
-	| unary_expression RIGHT_ASSIGN assignment_expression { $$ = new Assignment(NodePtr($1), NodePtr(new BitwiseExpression(BitwiseOp::RIGHT_SHIFT, NodePtr($1), NodePtr($3)))); }
-	| unary_expression AND_ASSIGN assignment_expression { $$ = new Assignment(NodePtr($1), NodePtr(new BitwiseExpression(BitwiseOp::BITWISE_AND, NodePtr($1), NodePtr($3)))); }
-	| unary_expression XOR_ASSIGN assignment_expression { $$ = new Assignment(NodePtr($1), NodePtr(new BitwiseExpression(BitwiseOp::BITWISE_XOR, NodePtr($1), NodePtr($3)))); }
-	| unary_expression OR_ASSIGN assignment_expression { $$ = new Assignment(NodePtr($1), NodePtr(new BitwiseExpression(BitwiseOp::BITWISE_OR, NodePtr($1), NodePtr($3)))); }
+	| unary_expression MUL_ASSIGN assignment_expression { $$ = new Assignment(NodePtr($1), NodePtr(new ArithExpression(ArithOp::MUL, NodePtr(new OperandRef($1)), NodePtr($3)))); }
+	| unary_expression DIV_ASSIGN assignment_expression { $$ = new Assignment(NodePtr($1), NodePtr(new ArithExpression(ArithOp::DIV, NodePtr(new OperandRef($1)), NodePtr($3)))); }
+	| unary_expression MOD_ASSIGN assignment_expression { $$ = new Assignment(NodePtr($1), NodePtr(new ArithExpression(ArithOp::MOD, NodePtr(new OperandRef($1)), NodePtr($3)))); }
+	| unary_expression ADD_ASSIGN assignment_expression { $$ = new Assignment(NodePtr($1), NodePtr(new ArithExpression(ArithOp::ADD, NodePtr(new OperandRef($1)), NodePtr($3)))); }
+	| unary_expression SUB_ASSIGN assignment_expression { $$ = new Assignment(NodePtr($1), NodePtr(new ArithExpression(ArithOp::SUB, NodePtr(new OperandRef($1)), NodePtr($3)))); }
+	| unary_expression LEFT_ASSIGN assignment_expression { $$ = new Assignment(NodePtr($1), NodePtr(new BitwiseExpression(BitwiseOp::LEFT_SHIFT, NodePtr(new OperandRef($1)), NodePtr($3)))); }
+	| unary_expression RIGHT_ASSIGN assignment_expression { $$ = new Assignment(NodePtr($1), NodePtr(new BitwiseExpression(BitwiseOp::RIGHT_SHIFT, NodePtr(new OperandRef($1)), NodePtr($3)))); }
+	| unary_expression AND_ASSIGN assignment_expression { $$ = new Assignment(NodePtr($1), NodePtr(new BitwiseExpression(BitwiseOp::BITWISE_AND, NodePtr(new OperandRef($1)), NodePtr($3)))); }
+	| unary_expression XOR_ASSIGN assignment_expression { $$ = new Assignment(NodePtr($1), NodePtr(new BitwiseExpression(BitwiseOp::BITWISE_XOR, NodePtr(new OperandRef($1)), NodePtr($3)))); }
+	| unary_expression OR_ASSIGN assignment_expression { $$ = new Assignment(NodePtr($1), NodePtr(new BitwiseExpression(BitwiseOp::BITWISE_OR, NodePtr(new OperandRef($1)), NodePtr($3)))); }
 	;
 
 expression
@@ -493,10 +511,14 @@ initializer_list
 	;
 
 declaration_list
-	: declaration					{ $$ = new DeclarationList(NodePtr($1)); }
+	: declaration					{
+		DeclarationList *declaration_list = new DeclarationList(nullptr);
+		declaration_list->PushBack(NodePtr($1), @1.first_line);
+		$$ = declaration_list;
+	}
 	| declaration_list declaration	{
 		DeclarationList *declaration_list = dynamic_cast<DeclarationList *>($1);
-		declaration_list->PushBack(NodePtr($2));
+		declaration_list->PushBack(NodePtr($2), @2.first_line);
 		$$ = declaration_list;
 	}
 	;
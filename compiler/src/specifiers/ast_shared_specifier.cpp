@@ -0,0 +1,32 @@
+#include "../../include/specifiers/ast_shared_specifier.hpp"
+namespace ast{
+void SharedSpecifier::EmitElsonV(std::ostream &stream, Context &context, std::string dest_reg) const {
+    (void)stream;
+    (void)context;
+    (void)dest_reg;
+}
+
+void SharedSpecifier::Print(std::ostream &stream) const
+{
+    stream << "__shared ";
+    type_specifier_->Print(stream);
+}
+
+Type SharedSpecifier::GetType() const
+{
+    const Specifier *specifier = dynamic_cast<const Specifier *>(type_specifier_.get());
+    if (!specifier)
+    {
+        throw std::runtime_error("SharedSpecifier::GetType: Invalid type specifier");
+    }
+    return specifier->GetType();
+}
+
+void SharedSpecifier::define_spec(Context &context) const{
+    const Specifier *specifier = dynamic_cast<const Specifier *>(type_specifier_.get());
+    if (specifier)
+    {
+        specifier->define_spec(context);
+    }
+}
+}//namespace ast
@@ -26,12 +26,18 @@ void TypeSpecifier::Print(std::ostream &stream) const
     case Type::_LONG:
         type = "long";
         break;
+    case Type::_Q16:
+        type = "q16";
+        break;
     case Type::_FLOAT:
         type = "float";
         break;
     case Type::_DOUBLE:
         type = "double";
         break;
+    case Type::_BF16X2:
+        type = "bf16x2";
+        break;
     default:
         std::runtime_error("TypeSpecifier::Print: VOID not supported");
     }
@@ -30,6 +30,13 @@ void Assignment::EmitElsonV(std::ostream &stream, Context &context, std::string
         std::string reg = context.get_register(type);
         expression_->EmitElsonV(stream, context, reg);
 
+        const Operand *value = dynamic_cast<const Operand *>(expression_.get());
+        if (type == Type::_Q16 && value != nullptr)
+        {
+            // q16 x = 1 stores 1.0
+            context.promote_to_q16(stream, reg, value->GetType(context));
+        }
+
         if (isArrayInitialization())
         {
             const ArrayInitialization *array_init = dynamic_cast<const ArrayInitialization *>(expression_.get());
@@ -67,7 +74,7 @@ void Assignment::EmitElsonV(std::ostream &stream, Context &context, std::string
                             perma_reg = variable.get_reg();
                         }
 
-                        stream << asm_prefix.at(context.get_instruction_state()) << "addi " << perma_reg << ", " << reg << ", 0" << std::endl;
+                        context.emit_move(stream, perma_reg, reg, type);
                         
                     }
                     
@@ -138,6 +145,18 @@ void Assignment::EmitElsonV(std::ostream &stream, Context &context, std::string
                     context.deallocate_register(global_memory_register);
                 }
 
+                // If shared scope, the array sits at a fixed offset in the core's scratchpad
+                else if (variable.get_scope() == ScopeLevel::SHARED)
+                {
+                    std::string shared_memory_register = context.get_register(Type::_INT);
+
+                    stream << asm_prefix.at(context.get_instruction_state()) << "lui " << shared_memory_register << ", " << (context.get_shared_base() >> 12) << std::endl;
+                    stream << asm_prefix.at(context.get_instruction_state()) << "add " << index_register << ", " << index_register << ", " << shared_memory_register << std::endl;
+                    stream << asm_prefix.at(context.get_instruction_state()) << context.store_instr(type) << " " << reg << ", " << variable.get_offset() - types_size.at(type) << "(" << index_register << ")" << std::endl;
+
+                    context.deallocate_register(shared_memory_register);
+                }
+
                 else
                 {
                     throw std::runtime_error("Assignment EmitElsonV: Invalid scope in ArrayAccess");
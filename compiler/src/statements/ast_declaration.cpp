@@ -16,6 +16,8 @@ void Declaration::EmitElsonV(std::ostream &stream, Context &context, std::string
     }
     specifier->define_spec(context);
 
+    const SharedSpecifier *shared_specifier = dynamic_cast<const SharedSpecifier *>(type_specifier_.get());
+
     const StructSpecifier *struct_specifier = dynamic_cast<const StructSpecifier *>(type_specifier_.get());
     if(struct_specifier){
         struct_specifier->define_spec(context);
@@ -40,6 +42,24 @@ void Declaration::EmitElsonV(std::ostream &stream, Context &context, std::string
         const ArrayDeclaration * array_declaration = dynamic_cast<const ArrayDeclaration *>(declarator_ptr.get());
         const PointerDeclaration *pointer_declaration = dynamic_cast<const PointerDeclaration *>(declarator_ptr.get());
 
+        // __shared arrays are placed in the scratchpad, the offset is from the scratchpad base
+        if (shared_specifier != nullptr)
+        {
+            if (array_declaration == nullptr || array_declaration->GetArraySize() == -1)
+            {
+                throw std::runtime_error("Declaration EmitElsonV: __shared is only supported on arrays of known size");
+            }
+
+            int array_size = array_declaration->GetArraySize();
+            std::vector<int> dimention = array_declaration->GetArrayDim(context);
+            int shared_offset = context.allocate_shared(type_size * array_size);
+
+            Variable variable(false, true, array_size, type, shared_offset, 0, dimention);
+            variable.set_scope(ScopeLevel::SHARED);
+            context.define_variable(array_declaration->GetId(), variable);
+            continue;
+        }
+
         int offset = context.get_stack_offset();
 
         if (assignment != nullptr)
@@ -177,6 +197,10 @@ void Declaration::DeclareGlobal(std::ostream &stream, Context &context, std::str
     if (!specifier) {
         throw std::runtime_error("Declaration::DeclareGlobal: Invalid type specifier");
     }
+    if (dynamic_cast<const SharedSpecifier *>(type_specifier_.get()))
+    {
+        throw std::runtime_error("Declaration::DeclareGlobal: __shared arrays must be declared inside a function");
+    }
     specifier->define_spec(context);
 
     if (declarator_list_ == nullptr)
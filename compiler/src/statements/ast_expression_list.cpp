@@ -54,10 +54,12 @@ void ExpressionList::GetArguments(std::ostream &stream, Context &context, std::s
             case Type::_CHAR:
             case Type::_UNSIGNED_INT:
             case Type::_INT:
+            case Type::_Q16:
                 arg_reg_num = int_reg++;
                 break;
             case Type::_FLOAT:
             case Type::_DOUBLE:
+            case Type::_BF16X2:
                 arg_reg_num = float_reg++;
                 break;
             default:
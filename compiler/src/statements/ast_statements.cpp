@@ -4,6 +4,36 @@
 
 namespace ast {
 
+void Statement::PushBack(NodePtr item, int source_line)
+{
+    if (item) {
+        source_lines_[item.get()] = source_line;
+    }
+    NodeList::PushBack(std::move(item));
+}
+
+void Statement::EmitSourceLines(std::ostream &stream, Context &context, std::string dest_reg) const
+{
+    // The enclosing statement gets its line back after a nested block, so the loop/branch code that
+    // follows the block (increment, back edge) is charged to the loop and not to the last statement
+    int enclosing_line = context.get_source_line();
+
+    for (const auto& statement : get_nodes())
+    {
+        auto line = source_lines_.find(statement.get());
+        if (line != source_lines_.end() && line->second != context.get_source_line()) {
+            context.set_source_line(line->second);
+            stream << "# line " << line->second << std::endl;
+        }
+        statement->EmitElsonV(stream, context, dest_reg);
+    }
+
+    if (enclosing_line != 0 && enclosing_line != context.get_source_line()) {
+        context.set_source_line(enclosing_line);
+        stream << "# line " << enclosing_line << std::endl;
+    }
+}
+
 void CompoundStatement::EmitElsonV(std::ostream &stream, Context &context, std::string dest_reg) const
 {
     context.create_scope();
@@ -98,12 +128,7 @@ void StatementList::GetCases(std::ostream &stream, Context &context, std::string
 
 void StatementList::EmitElsonV(std::ostream &stream, Context &context, std::string dest_reg) const
 {
-
-    for (const auto& statement : get_nodes())
-    {
-        statement->EmitElsonV(stream, context, dest_reg);
-    }
-
+    EmitSourceLines(stream, context, dest_reg);
 }
 
 int StatementList::get_offset(Context &context) const
@@ -112,6 +137,11 @@ int StatementList::get_offset(Context &context) const
     return 0;
 }
 
+void DeclarationList::EmitElsonV(std::ostream &stream, Context &context, std::string dest_reg) const
+{
+    EmitSourceLines(stream, context, dest_reg);
+}
+
 int DeclarationList::get_offset(Context &context) const
 {
     std::cout << "Entering DeclarationList::get_offset" <<std::endl;
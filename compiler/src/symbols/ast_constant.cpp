@@ -76,7 +76,8 @@ Type DoubleConstant::GetType(Context &context) const
 
 void IntConstant::SaveValue(Global &global) const
 {
-    global.push_lower(value_);
+    // A q16 global initialised with a whole number holds it in Q16.16
+    global.push_lower(global.get_type() == Type::_Q16 ? static_cast<uint32_t>(value_) << 16 : value_);
 }
 
 void FloatConstant::SaveValue(Global &global) const
@@ -10,9 +10,22 @@ void Identifier::EmitElsonV(std::ostream &stream, Context &context, std::string
         Variable variable = context.get_variable(identifier_);
         Type type = variable.is_pointer() ? Type::_INT : variable.get_type();
 
-        if (variable.get_scope() == ScopeLevel::LOCAL){
+        if (variable.get_scope() == ScopeLevel::LOCAL && context.get_instruction_state() == Kernel::_VECTOR && variable.get_reg() != ""){
+            // Assigned in the kernel, every thread holds its own value in a register
+            context.emit_move(stream, dest_reg, variable.get_reg(), type);
+        }
+        else if (variable.get_scope() == ScopeLevel::LOCAL){
             int offset = variable.get_offset();
-            stream << asm_prefix.at(context.get_instruction_state()) <<context.load_instr(type) << " " << dest_reg << ", " << offset-4 << "(sp)" << std::endl;
+            // Every lane of a kernel holds the function's sp, so a local is read from one address
+            std::string uniform_load = context.uniform_load_instr(type);
+            if (!uniform_load.empty())
+            {
+                stream << uniform_load << " " << dest_reg << ", " << offset-4 << "(sp)" << std::endl;
+            }
+            else
+            {
+                stream << asm_prefix.at(context.get_instruction_state()) <<context.load_instr(type) << " " << dest_reg << ", " << offset-4 << "(sp)" << std::endl;
+            }
         }
         else if (variable.get_scope() == ScopeLevel::GLOBAL)
         {
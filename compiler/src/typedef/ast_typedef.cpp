@@ -60,8 +60,10 @@ void Typedef::DefineTypedef(NodeList *aliases)
         case Type::_UNSIGNED_INT:
         case Type::_INT:
         case Type::_LONG:
+        case Type::_Q16:
         case Type::_FLOAT:
         case Type::_DOUBLE:
+        case Type::_BF16X2:
             typedef_spec = TypedefSpec(type, pointer, array_size);
             break;
         default:
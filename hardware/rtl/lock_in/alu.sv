@@ -4,6 +4,7 @@
 `include "common.svh"
 
 // 2-Stage Pipelined 32-bit Integer ALU
+// (also does the Q16.16 fixed point multiply MULQ)
 
 module alu (
     input   logic clk,
@@ -58,6 +59,12 @@ module alu (
     // ========================================================================
     data_t Result_next;
 
+    // Q16.16 multiply: full signed product, rounded to nearest and shifted back by the 16 fraction bits
+    logic signed [63:0] product_s1;
+    data_t mulq_s1;
+    assign product_s1 = $signed(ALUop1_s1) * $signed(ALUop2_s1);
+    assign mulq_s1 = data_t'((product_s1 + 64'sd32768) >>> 16);
+
     always_comb begin
         // The case statement is identical to your original, but it now uses the
         // registered "_s1" inputs instead of the direct module inputs.
@@ -73,11 +80,14 @@ module alu (
             SNEZ: Result_next = (ALUop1_s1 != 0) ? 32'd1 : 32'd0;
             MIN:  Result_next = (ALUop1_s1 < ALUop2_s1) ? ALUop1_s1 : ALUop2_s1;
             SLL:  Result_next = ALUop1_s1 << ALUop2_s1[4:0]; // Use only lower 5 bits for shift amount
+            SRA:  Result_next = $signed(ALUop1_s1) >>> ALUop2_s1[4:0];
+            MULQ: Result_next = mulq_s1; // Q16.16 product
 
             // --- I-Type: Control Flow ---
             ADDI: Result_next = ALUop1_s1 + IMM_s1;
             MULI: Result_next = ALUop1_s1 * IMM_s1; // This now uses registered inputs
             SLLI: Result_next = ALUop1_s1 << IMM_s1[4:0];
+            SRAI: Result_next = $signed(ALUop1_s1) >>> IMM_s1[4:0];
             SEQI: Result_next = (ALUop1_s1 == IMM_s1) ? 32'd1 : 32'd0;
 
             // --- C-Type: Control Flow ---
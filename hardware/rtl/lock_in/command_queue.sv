@@ -0,0 +1,114 @@
+
+`timescale 1ns/1ns
+
+`include "common.svh"
+
+// COMMAND QUEUE
+// > FIFO of kernel launches in front of the dispatcher, so a chain of kernels (assign, reduce, update, ...)
+//   runs back to back without the host starting every one of them
+// > The host pushes a launch (the kernel configuration registers and its flags), the queue hands launches to
+//   the dispatcher one at a time: the next one starts in the cycle after the previous one is done, so a
+//   kernel always sees every store of the kernels before it
+// > Flags per launch: FENCE stops the queue after this launch until resume (the host works on the results
+//   in between), INTERRUPT raises interrupt when it is done, until interrupt_clear
+// > Pushes into a full queue and launches of 0 blocks are dropped (the dispatcher never finishes those)
+module command_queue #(
+    parameter int DEPTH = 8 // Launches that can wait, power of two
+) (
+    input wire clk,
+    input wire reset,
+
+    // Host Interface
+    input wire push,
+    input kernel_config_t push_config,
+    input wire [`LAUNCH_FLAG_WIDTH-1:0] push_flags,
+    input wire resume,
+    input wire interrupt_clear,
+    output logic full,
+    output logic busy,              // A launch is running or waiting, drops on the edge the last one is counted
+    output logic fenced,            // Stopped after a FENCE launch
+    output logic interrupt,
+    output data_t count,            // Launches waiting
+    output data_t completed,        // Launches done since reset
+
+    // Dispatcher
+    output logic launch,            // One cycle pulse, launch_config is held until the next one
+    output kernel_config_t launch_config,
+    input wire dispatcher_done
+);
+    localparam IDLE = 1'b0,
+        RUNNING = 1'b1;
+
+    localparam int INDEX_WIDTH = (DEPTH > 1) ? $clog2(DEPTH) : 1;
+
+    reg state;
+
+    kernel_config_t configs [DEPTH];
+    logic [`LAUNCH_FLAG_WIDTH-1:0] flags [DEPTH];
+    logic [INDEX_WIDTH-1:0] head, tail;
+    logic [`LAUNCH_FLAG_WIDTH-1:0] running_flags;
+
+    // The dispatcher clears its done on the edge it sees launch, so done only counts after that
+    logic finished;
+    assign finished = (state == RUNNING) && !launch && dispatcher_done;
+
+    assign full = int'(count) == DEPTH;
+    assign busy = (state == RUNNING) || (count != 0);
+
+    always @(posedge clk) begin
+        if (reset) begin
+            state <= IDLE;
+            head <= 0;
+            tail <= 0;
+            count <= 0;
+            completed <= 0;
+            running_flags <= 0;
+            fenced <= 0;
+            interrupt <= 0;
+            launch <= 0;
+            launch_config <= '0;
+        end else begin
+            data_t level;
+            logic next_fenced;
+
+            level = count;
+            launch <= 0;
+            next_fenced = fenced && !resume;
+
+            if (interrupt_clear) begin
+                interrupt <= 0;
+            end
+
+            if (finished) begin
+                completed <= completed + 1;
+                state <= IDLE;
+                if (running_flags[`LAUNCH_FLAG_INTERRUPT]) begin
+                    interrupt <= 1;
+                end
+                if (running_flags[`LAUNCH_FLAG_FENCE]) begin
+                    next_fenced = 1;
+                end
+            end
+
+            // The next launch goes out on the same edge the previous one is seen done
+            if ((state == IDLE || finished) && level != 0 && !next_fenced) begin
+                launch <= 1;
+                launch_config <= configs[head];
+                running_flags <= flags[head];
+                head <= head + 1;
+                level = level - 1;
+                state <= RUNNING;
+            end
+
+            if (push && int'(count) < DEPTH && push_config.num_blocks != 0) begin
+                configs[tail] <= push_config;
+                flags[tail] <= push_flags;
+                tail <= tail + 1;
+                level = level + 1;
+            end
+
+            count <= level;
+            fenced <= next_fenced;
+        end
+    end
+endmodule
@@ -6,14 +6,24 @@
 
 module compute_core#(
     parameter int WARPS_PER_CORE = 4,            // Number of warps to in each core
-    parameter int THREADS_PER_WARP = 16          // Number of threads per warp (max 32)
+    parameter int THREADS_PER_WARP = 16,         // Number of threads per warp (max 32)
+    parameter int ICACHE_LINES = 64,             // Number of lines in the instruction cache shared by the warps
+    parameter int SCRATCHPAD_WORDS = 256,        // Size of the core's scratchpad (__shared) in 32-bit words
+    parameter int SCRATCHPAD_BANKS = 16,         // Number of scratchpad banks
+    parameter int WARP_SCHEDULER = 0,            // Warp scheduling policy: 0 = loose round-robin, 1 = greedy-then-oldest, 2 = two-level
+    parameter int ACTIVE_WARPS = 2               // Size of the active set of the two-level scheduler
     )(
     input   wire                            clk,
     input   wire                            reset,
+    input   wire                            icache_flush,   // Invalidate the instruction cache (new kernel), it is kept across resets
 
     input   logic                           start,
     output  logic                           done,
 
+    // Grid Barrier (gsync): the dispatcher releases it once every core of the kernel is waiting
+    output  logic                           grid_sync_waiting,  // Every warp of the block is parked at a gsync or has exited
+    input   logic                           grid_sync_release,
+
     input   data_t                          block_id,
     input   kernel_config_t                 kernel_config,
 
@@ -23,6 +33,44 @@ module compute_core#(
     output  logic   [WARPS_PER_CORE-1:0]    instruction_mem_read_valid,
     output  instruction_memory_address_t    instruction_mem_read_address    [WARPS_PER_CORE],
 
+    // Instruction Cache Counters
+    output  data_t                          icache_hits,
+    output  data_t                          icache_misses,
+
+    // Memory Coalescer Counters
+    output  data_t                          coalescer_lane_requests,
+    output  data_t                          coalescer_mem_transactions,
+
+    // Scratchpad Counters
+    output  data_t                          scratchpad_accesses,
+    output  data_t                          scratchpad_bank_conflicts,
+
+    // Warp Scheduler Counters (cycles per warp)
+    output  data_t                          warp_issue_cycles               [WARPS_PER_CORE],   // Warp was picked to issue
+    output  data_t                          warp_stall_cycles               [WARPS_PER_CORE],   // Waiting on fetch, a functional unit, memory or a barrier
+    output  data_t                          warp_idle_cycles                [WARPS_PER_CORE],   // Had an instruction ready but another warp was picked
+    output  data_t                          warp_state_cycles               [`NUM_WARP_STATES], // Cycles spent by the warps in each state
+
+    // Issue Counters
+    output  data_t                          instructions_scalar,
+    output  data_t                          instructions_vector,
+    output  data_t                          instructions_fpu,
+    output  data_t                          instructions_memory,
+    output  data_t                          active_lanes,                                       // Enabled lanes summed over the vector instructions
+    output  data_t                          lsu_wait_cycles,                                    // Cycles with an LSU request outstanding
+
+    // Warp Trace (sampled every cycle by the testbench profiler)
+    output  warp_state_t                    debug_warp_state                [WARPS_PER_CORE],
+    output  instruction_memory_address_t    debug_warp_pc                   [WARPS_PER_CORE],
+    output  logic   [THREADS_PER_WARP-1:0]  debug_warp_execution_mask       [WARPS_PER_CORE],
+
+`ifdef TRACE_RETIRE
+    // Retire Trace (simulation only, see gpu.sv)
+    input   int                             trace_fd,
+    input   data_t                          trace_cycle,
+    input   data_t                          trace_core_id,
+`endif
+
     // Data Memory
     output  logic   [NUM_LSUS-1:0]          data_mem_read_valid,
     output  data_memory_address_t           data_mem_read_address           [NUM_LSUS],
@@ -37,6 +85,12 @@ module compute_core#(
 typedef logic [THREADS_PER_WARP-1:0] warp_mask_t;
 localparam int NUM_LSUS = THREADS_PER_WARP + 1;
 localparam int WARP_INDEX_WIDTH = (WARPS_PER_CORE > 1) ? $clog2(WARPS_PER_CORE) : 1;
+localparam int LANE_INDEX_WIDTH = (THREADS_PER_WARP > 1) ? $clog2(THREADS_PER_WARP) : 1;
+
+// Warp scheduling policies (WARP_SCHEDULER)
+localparam int SCHED_LOOSE_ROUND_ROBIN = 0;     // Switch to the next ready warp after every instruction
+localparam int SCHED_GREEDY_THEN_OLDEST = 1;    // Keep issuing from one warp until it stalls, then pick the oldest ready warp
+localparam int SCHED_TWO_LEVEL = 2;             // Round-robin over a small active set, warps waiting on memory make room for pending ones
 
 // Warp State and Control
 logic [WARP_INDEX_WIDTH-1:0] current_warp;
@@ -45,6 +99,13 @@ fetcher_state_t fetcher_state [WARPS_PER_CORE];
 warp_state_t current_warp_state;
 assign current_warp_state = warp_state[current_warp];
 instruction_t fetched_instruction [WARPS_PER_CORE];
+instruction_memory_address_t fetched_instruction_address [WARPS_PER_CORE];
+
+// Fetcher <> Instruction Cache
+logic [WARPS_PER_CORE-1:0] fetcher_read_valid;
+instruction_memory_address_t fetcher_read_address [WARPS_PER_CORE];
+logic [WARPS_PER_CORE-1:0] fetcher_read_ready;
+instruction_t fetcher_read_data [WARPS_PER_CORE];
 
 instruction_memory_address_t pc [WARPS_PER_CORE];
 instruction_memory_address_t next_pc [WARPS_PER_CORE];
@@ -63,8 +124,12 @@ logic decoded_scalar_instruction [WARPS_PER_CORE];
 logic [4:0] decoded_rd_address [WARPS_PER_CORE];
 logic [4:0] decoded_rs1_address [WARPS_PER_CORE];
 logic [4:0] decoded_rs2_address [WARPS_PER_CORE];
-logic [4:0] decoded_alu_instruction [WARPS_PER_CORE];
+logic [4:0] decoded_rs3_address [WARPS_PER_CORE];
+alu_instruction_t decoded_alu_instruction [WARPS_PER_CORE];
 logic decoded_halt [WARPS_PER_CORE];
+logic decoded_sync [WARPS_PER_CORE];
+logic decoded_grid_sync [WARPS_PER_CORE];
+logic decoded_broadcast [WARPS_PER_CORE];
 logic [1:0] floatingRead_flag [WARPS_PER_CORE];
 logic floatingWrite_flag [WARPS_PER_CORE];
 
@@ -79,32 +144,61 @@ data_t scalar_int_rs1 [WARPS_PER_CORE];
 data_t scalar_int_rs2 [WARPS_PER_CORE];
 data_t scalar_float_rs1 [WARPS_PER_CORE];
 data_t scalar_float_rs2 [WARPS_PER_CORE];
+data_t scalar_float_rs3 [WARPS_PER_CORE]; // Only the float files read a third operand (fused multiply-add)
 
 data_t vector_int_rs1 [WARPS_PER_CORE][THREADS_PER_WARP];
 data_t vector_int_rs2 [WARPS_PER_CORE][THREADS_PER_WARP];
 data_t vector_float_rs1 [WARPS_PER_CORE][THREADS_PER_WARP];
 data_t vector_float_rs2 [WARPS_PER_CORE][THREADS_PER_WARP];
+data_t vector_float_rs3 [WARPS_PER_CORE][THREADS_PER_WARP];
 
 warp_mask_t warp_execution_mask [WARPS_PER_CORE];
 
 logic all_warps_done = 1'b1;
+logic sync_release;
+logic warp_grid_sync [WARPS_PER_CORE]; // The warp is parked at a gsync rather than a block sync
 
 // ALU/LSU Operands and Results
 data_t final_op1 [THREADS_PER_WARP];
 data_t final_op2 [THREADS_PER_WARP];
-data_t alu_out [THREADS_PER_WARP];
-data_t scalar_alu_out;
+data_t vector_lane_op1 [THREADS_PER_WARP];
+data_t vector_lane_op2 [THREADS_PER_WARP];
+data_t shuffle_out [THREADS_PER_WARP];
+data_t shuffle_result [THREADS_PER_WARP];
 data_t lsu_out [THREADS_PER_WARP];
+data_t lane_lsu_out [THREADS_PER_WARP];
 lsu_state_t lsu_state [THREADS_PER_WARP];
 data_t scalar_lsu_out;
 lsu_state_t scalar_lsu_state;
 data_t vector_to_scalar_data [WARPS_PER_CORE];
+
+// Functional unit results. The integer ALUs give the result of the instruction issued two cycles
+// earlier, the FPUs tag every result with the warp that issued it.
+data_t vector_int_alu_result [THREADS_PER_WARP];
+data_t vector_float_alu_result [THREADS_PER_WARP];
+logic vector_fpu_ready [THREADS_PER_WARP];
 logic vector_fpu_valid [THREADS_PER_WARP];
-logic all_vector_fpus_done;
+logic [WARP_INDEX_WIDTH-1:0] vector_fpu_tag [THREADS_PER_WARP];
+data_t scalar_int_alu_result;
+data_t scalar_float_alu_result;
+logic scalar_fpu_ready;
+logic scalar_fpu_valid;
+logic [WARP_INDEX_WIDTH-1:0] scalar_fpu_tag;
+
+// Result each warp writes back, selected by the warp's own instruction
+data_t warp_alu_out [WARPS_PER_CORE][THREADS_PER_WARP];
+data_t warp_int_alu_out [WARPS_PER_CORE][THREADS_PER_WARP];    // Index of the picked operand for FMINIDX
+data_t warp_scalar_alu_out [WARPS_PER_CORE];
+data_t warp_scalar_int_alu_out [WARPS_PER_CORE];
 
 // Operand Muxing Logic
 warp_mask_t current_warp_execution_mask;
 assign current_warp_execution_mask = warp_execution_mask[current_warp];
+
+// Warp Trace
+assign debug_warp_state = warp_state;
+assign debug_warp_pc = pc;
+assign debug_warp_execution_mask = warp_execution_mask;
 data_t scalar_op1;
 data_t scalar_op2;
 
@@ -147,9 +241,80 @@ for (genvar i = 0; i < THREADS_PER_WARP; i++) begin: g_operand_mux
 
     assign final_op1[i] = decoded_scalar_instruction[current_warp] ? scalar_op1 : vector_op1;
     assign final_op2[i] = decoded_scalar_instruction[current_warp] ? scalar_op2 : vector_op2;
+    assign vector_lane_op1[i] = vector_op1;
+    assign vector_lane_op2[i] = vector_op2;
 end
 endgenerate
 
+// Lane exchange (shuffle) network
+// Each lane picks up rs1 from another lane of the same warp, straight from the
+// register file outputs. The lane offset is the lane's own rs2 plus the immediate
+// (rs2 is x0 for the immediate forms, the immediate is 0 for the register forms).
+// Source lanes outside the warp keep the lane's own value. Reading from a lane
+// that is masked off returns whatever that lane last read.
+// The exchanged values are registered on the issue edge and written back in the next cycle.
+generate
+for (genvar i = 0; i < THREADS_PER_WARP; i++) begin: g_lane_exchange
+    data_t lane_offset;
+    data_t src_lane;
+
+    always_comb begin
+        lane_offset = vector_lane_op2[i] + decoded_immediate[current_warp];
+        if (decoded_alu_instruction[current_warp] == SHFL_XOR) begin
+            src_lane = i ^ lane_offset;
+        end else begin
+            src_lane = i + lane_offset;
+        end
+
+        if (lane_offset < THREADS_PER_WARP && src_lane < THREADS_PER_WARP) begin
+            shuffle_out[i] = vector_lane_op1[src_lane[LANE_INDEX_WIDTH-1:0]];
+        end else begin
+            shuffle_out[i] = vector_lane_op1[i];
+        end
+    end
+
+    always @(posedge clk) begin
+        shuffle_result[i] <= shuffle_out[i];
+    end
+end
+endgenerate
+
+// Argmin with index (FMINIDX)
+// Float register N is paired with integer register N, which holds the index of its value.
+// The FPU reports whether it picked rs1, the integer register files then write the index
+// paired with the picked operand to the integer register paired with rd. The warp's register
+// file outputs still hold both operands, they are only read again for its next instruction.
+logic vector_fpu_less [THREADS_PER_WARP];
+logic scalar_fpu_less;
+
+// Writeback data of every warp. Each result has a single warp writing it back: the integer ALUs
+// the warp issued two cycles earlier, the FPUs the warp in the result tag, the lane exchange the
+// warp issued in the previous cycle.
+always_comb begin
+    for (int w = 0; w < WARPS_PER_CORE; w++) begin
+        logic fpu_result;
+        logic shuffle;
+        logic minidx;
+        fpu_result = is_fpu_instruction(decoded_alu_instruction[w]);
+        shuffle = (decoded_alu_instruction[w] == SHFL_DOWN) || (decoded_alu_instruction[w] == SHFL_XOR);
+        minidx = (decoded_alu_instruction[w] == FMINIDX);
+
+        // sx.slt gathers bit 0 of every lane
+        vector_to_scalar_data[w] = {`DATA_WIDTH{1'b0}};
+        for (int i = 0; i < THREADS_PER_WARP; i++) begin
+            warp_alu_out[w][i] = shuffle ? shuffle_result[i] :
+                                 fpu_result ? vector_float_alu_result[i] : vector_int_alu_result[i];
+            warp_int_alu_out[w][i] = !minidx ? warp_alu_out[w][i] :
+                                     vector_fpu_less[i] ? vector_int_rs1[w][i] : vector_int_rs2[w][i];
+            vector_to_scalar_data[w][i] = warp_alu_out[w][i][0];
+        end
+
+        warp_scalar_alu_out[w] = fpu_result ? scalar_float_alu_result : scalar_int_alu_result;
+        warp_scalar_int_alu_out[w] = !minidx ? warp_scalar_alu_out[w] :
+                                     scalar_fpu_less ? scalar_int_rs1[w] : scalar_int_rs2[w];
+    end
+end
+
 always_comb begin
     all_warps_done = 1'b1;
     for (int i = 0; i < WARPS_PER_CORE; i = i + 1) begin
@@ -161,11 +326,245 @@ always_comb begin
     end
 end
 
+// Block barrier: release once every active warp is parked at the sync (or has exited)
+// A grid barrier also waits for the other cores: the block only reports it has arrived
+always_comb begin
+    logic any_warp_waiting;
+    logic all_warps_arrived;
+    logic any_grid_sync;
+    any_warp_waiting = 1'b0;
+    all_warps_arrived = 1'b1;
+    any_grid_sync = 1'b0;
+    for (int i = 0; i < WARPS_PER_CORE; i = i + 1) begin
+        if (i < num_warps) begin
+            if (warp_state[i] == WARP_SYNC_WAIT) begin
+                any_warp_waiting = 1'b1;
+                any_grid_sync = any_grid_sync || warp_grid_sync[i];
+            end else if (warp_state[i] != WARP_DONE) begin
+                all_warps_arrived = 1'b0;
+            end
+        end
+    end
+    grid_sync_waiting = any_warp_waiting && all_warps_arrived && any_grid_sync;
+    sync_release = any_warp_waiting && all_warps_arrived && (!any_grid_sync || grid_sync_release);
+end
+
+// Functional unit each warp's decoded instruction goes to. exit and sync keep the ALU instruction of
+// whatever was decoded before them, lui does not set one.
+logic warp_memory_op [WARPS_PER_CORE];
+logic warp_fpu_op [WARPS_PER_CORE];
+logic warp_int_op [WARPS_PER_CORE];
 always_comb begin
-    all_vector_fpus_done = 1'b1;
+    for (int i = 0; i < WARPS_PER_CORE; i++) begin
+        logic computes;
+        computes = !decoded_halt[i] && !decoded_sync[i] && decoded_reg_input_mux[i] != IMMEDIATE;
+
+        warp_memory_op[i] = decoded_mem_read_enable_per_warp[i] || decoded_mem_write_enable_per_warp[i];
+        warp_fpu_op[i] = computes && !warp_memory_op[i] && is_fpu_instruction(decoded_alu_instruction[i]);
+        warp_int_op[i] = computes && !warp_memory_op[i] && (is_int_alu_instruction(decoded_alu_instruction[i]) ||
+                         decoded_branch[i] || decoded_alu_instruction[i] == JAL);
+    end
+end
+
+// The LSUs are shared by the warps. A memory instruction claims them when it is picked and keeps them
+// until its UPDATE, so its requests carry on while other warps issue.
+logic lsu_busy;
+logic [WARP_INDEX_WIDTH-1:0] lsu_owner;
+
+logic any_lsu_waiting;
+always_comb begin
+    any_lsu_waiting = (scalar_lsu_state == LSU_REQUESTING || scalar_lsu_state == LSU_WAITING);
     for (int i = 0; i < THREADS_PER_WARP; i++) begin
-        if (current_warp_execution_mask[i] && !vector_fpu_valid[i]) begin
-            all_vector_fpus_done=1'b0;
+        if (lsu_state[i] == LSU_REQUESTING || lsu_state[i] == LSU_WAITING) begin
+            any_lsu_waiting = 1'b1;
+        end
+    end
+end
+
+// The current warp is in its issue cycle, with its operands on the functional unit inputs
+logic issuing;
+assign issuing = current_warp_state == WARP_EXECUTE || current_warp_state == WARP_REG_WAIT;
+wire fpu_issue = current_warp_state == WARP_EXECUTE && warp_fpu_op[current_warp];
+
+// A warp is ready when its decoded instruction can issue: memory instructions need free LSUs, FPU
+// instructions an FPU that takes a new instruction in the next cycle. The FPUs stop taking them while
+// they divide, which they only report once the FDIV issued in this cycle has reached them.
+logic [WARPS_PER_CORE-1:0] warp_ready;
+always_comb begin
+    for (int i = 0; i < WARPS_PER_CORE; i++) begin
+        logic fpu_ready;
+        logic dividing;
+        fpu_ready = decoded_scalar_instruction[i] ? scalar_fpu_ready : vector_fpu_ready[0];
+        dividing = fpu_issue && decoded_alu_instruction[current_warp] == FDIV &&
+                   decoded_scalar_instruction[current_warp] == decoded_scalar_instruction[i];
+
+        warp_ready[i] = (i < num_warps) && warp_state[i] == WARP_REQUEST && !(warp_memory_op[i] && lsu_busy) &&
+                        !(warp_fpu_op[i] && (!fpu_ready || dividing));
+    end
+end
+
+// Two-level scheduler: only the warps in the active set are picked
+logic [WARPS_PER_CORE-1:0] warp_active;
+
+// Greedy-then-oldest: a warp can not issue again before its result is written back, so greedy means it
+// keeps the first pick whenever it is ready again, while the cycles in between go to the other warps.
+// It loses the priority once it stalls (fetch, memory, FPU, barrier, a busy unit, done).
+logic [WARP_INDEX_WIDTH-1:0] greedy_warp;
+logic greedy_stalled;
+always_comb begin
+    case (warp_state[greedy_warp])
+        WARP_REQUEST: greedy_stalled = !warp_ready[greedy_warp];
+        WARP_DECODE, WARP_REG_WAIT, WARP_EXECUTE, WARP_INT_ALU_WAIT, WARP_UPDATE: greedy_stalled = 0;
+        default: greedy_stalled = 1;
+    endcase
+end
+
+// Warp scheduler: picks one ready warp every cycle. Its register files read the operands on this edge
+// and it issues in the next cycle as the current warp (EXECUTE, REG_WAIT for memory instructions).
+// Results come back to the warp that issued them, so the other warps keep issuing while an instruction
+// executes and a warp only waits for its own previous instruction.
+logic issue_valid;
+logic [WARP_INDEX_WIDTH-1:0] issue_warp;
+always_comb begin
+    int found_warp;
+    found_warp = -1;
+
+    case (WARP_SCHEDULER)
+        SCHED_GREEDY_THEN_OLDEST: begin
+            // The greedy warp first, otherwise the oldest ready warp. The warps of a block are all launched
+            // in the same cycle, in index order, so the oldest is the lowest index
+            if (warp_ready[greedy_warp]) begin
+                found_warp = int'(greedy_warp);
+            end else begin
+                for (int i = 0; i < WARPS_PER_CORE; i = i + 1) begin
+                    if (warp_ready[i]) begin
+                        found_warp = i;
+                        break;
+                    end
+                end
+            end
+        end
+        default: begin
+            // Loose round-robin (and two-level over its active set): the next ready warp after the current one
+            for (int k = 1; k <= WARPS_PER_CORE; k = k + 1) begin
+                if (k <= num_warps) begin
+                    int warp_index;
+                    warp_index = (int'(current_warp) + k) % num_warps;
+                    if (warp_ready[warp_index] && (WARP_SCHEDULER != SCHED_TWO_LEVEL || warp_active[warp_index])) begin
+                        found_warp = warp_index;
+                        break;
+                    end
+                end
+            end
+        end
+    endcase
+
+    issue_valid = (found_warp != -1);
+    issue_warp = issue_valid ? found_warp[WARP_INDEX_WIDTH-1:0] : current_warp;
+end
+
+// The LSUs follow the owning warp's state and decode, or the picked warp's when they are free
+// (they only start on a REQUEST, which a warp that is not picked must not look like)
+logic [WARP_INDEX_WIDTH-1:0] lsu_warp;
+warp_state_t lsu_warp_state;
+assign lsu_warp = lsu_busy ? lsu_owner : issue_warp;
+assign lsu_warp_state = (lsu_busy || issue_valid) ? warp_state[lsu_warp] : WARP_IDLE;
+
+// Writeback: a warp writes its result back and moves on to its next instruction in UPDATE, or right
+// from ALU_WAIT in the cycle its FPU result comes out. If the fetcher already holds the next
+// instruction, it is decoded on the same edge and the warp can be picked again in the next cycle.
+logic [WARPS_PER_CORE-1:0] warp_writeback;
+logic [WARPS_PER_CORE-1:0] warp_decode;
+instruction_memory_address_t resolved_pc [WARPS_PER_CORE];
+always_comb begin
+    for (int i = 0; i < WARPS_PER_CORE; i++) begin
+        logic fpu_done;
+        fpu_done = decoded_scalar_instruction[i] ? (scalar_fpu_valid && scalar_fpu_tag == i) :
+                                                   (vector_fpu_valid[0] && vector_fpu_tag[0] == i);
+        warp_writeback[i] = warp_state[i] == WARP_UPDATE || (warp_state[i] == WARP_ALU_WAIT && fpu_done);
+
+        resolved_pc[i] = pc[i] + 1;
+        if (decoded_branch[i] && (warp_scalar_alu_out[i] == 1)) begin
+            resolved_pc[i] = pc[i] + decoded_immediate[i];
+        end else if (decoded_alu_instruction[i] == JAL) begin
+            resolved_pc[i] = warp_scalar_alu_out[i];
+        end
+
+        warp_decode[i] = warp_state[i] == WARP_DECODE ||
+                         (warp_writeback[i] && !decoded_halt[i] && !decoded_sync[i] &&
+                          fetcher_state[i] == FETCHER_DONE && fetched_instruction_address[i] == resolved_pc[i]);
+    end
+end
+
+// Per warp cycle accounting
+always @(posedge clk) begin
+    if (reset) begin
+        for (int i = 0; i < WARPS_PER_CORE; i++) begin
+            warp_issue_cycles[i] <= 0;
+            warp_stall_cycles[i] <= 0;
+            warp_idle_cycles[i] <= 0;
+        end
+    end else if (start_execution) begin
+        for (int i = 0; i < WARPS_PER_CORE; i++) begin
+            if (i < num_warps && warp_state[i] != WARP_DONE && warp_state[i] != WARP_IDLE) begin
+                if (issue_valid && issue_warp == i) begin
+                    warp_issue_cycles[i] <= warp_issue_cycles[i] + 1;
+                end else if (warp_ready[i]) begin
+                    warp_idle_cycles[i] <= warp_idle_cycles[i] + 1;
+                end else begin
+                    warp_stall_cycles[i] <= warp_stall_cycles[i] + 1;
+                end
+            end
+        end
+    end
+end
+
+// Warp state occupancy, summed over the warps
+always @(posedge clk) begin
+    if (reset) begin
+        for (int s = 0; s < `NUM_WARP_STATES; s++) begin
+            warp_state_cycles[s] <= 0;
+        end
+    end else if (start_execution) begin
+        for (int s = 0; s < `NUM_WARP_STATES; s++) begin
+            data_t warps_in_state;
+            warps_in_state = 0;
+            for (int i = 0; i < WARPS_PER_CORE; i++) begin
+                if (i < num_warps && int'(warp_state[i]) == s) begin
+                    warps_in_state = warps_in_state + 1;
+                end
+            end
+            warp_state_cycles[s] <= warp_state_cycles[s] + warps_in_state;
+        end
+    end
+end
+
+// Issue accounting, every instruction has exactly one issue cycle
+always @(posedge clk) begin
+    if (reset) begin
+        instructions_scalar <= 0;
+        instructions_vector <= 0;
+        instructions_fpu <= 0;
+        instructions_memory <= 0;
+        active_lanes <= 0;
+        lsu_wait_cycles <= 0;
+    end else if (start_execution) begin
+        if (issuing) begin
+            if (decoded_scalar_instruction[current_warp]) begin
+                instructions_scalar <= instructions_scalar + 1;
+            end else begin
+                instructions_vector <= instructions_vector + 1;
+                active_lanes <= active_lanes + $countones(current_warp_execution_mask);
+            end
+            if (warp_fpu_op[current_warp]) begin
+                instructions_fpu <= instructions_fpu + 1;
+            end
+            if (warp_memory_op[current_warp]) begin
+                instructions_memory <= instructions_memory + 1;
+            end
+        end
+        if (any_lsu_waiting) begin
+            lsu_wait_cycles <= lsu_wait_cycles + 1;
         end
     end
 end
@@ -183,20 +582,27 @@ always @(posedge clk) begin
             pc[i] <= 0;
             next_pc[i] <= 0;
             current_warp <= 0;
+            warp_active[i] <= 0;
+            warp_grid_sync[i] <= 0;
         end
+        greedy_warp <= 0;
+        lsu_busy <= 0;
+        lsu_owner <= 0;
 
     end else if (!start_execution) begin
         if (start) begin
-            $display("Starting execution of block %d", block_id);
-            $display("GPU: Kernel configuration (latched):");
-            $display("     - Base instruction address: %h", kernel_config.base_instructions_address);
-            $display("     - Base data address: %h", kernel_config.base_data_address);
-            $display("     - Num %d blocks", kernel_config.num_blocks);
-            $display("     - Number of warps per block: %d", kernel_config.num_warps_per_block);
+            // $display("Starting execution of block %d", block_id);
+            // $display("GPU: Kernel configuration (latched):");
+            // $display("     - Base instruction address: %h", kernel_config.base_instructions_address);
+            // $display("     - Base data address: %h", kernel_config.base_data_address);
+            // $display("     - Num %d blocks", kernel_config.num_blocks);
+            // $display("     - Number of warps per block: %d", kernel_config.num_warps_per_block);
             // Set all warps to fetch state on start
             start_execution <= 1;
             current_warp <= 0;
+            greedy_warp <= 0;
             for (int i = 0; i < WARPS_PER_CORE; i = i + 1) begin
+                warp_active[i] <= (i < ACTIVE_WARPS);
                 if (i < num_warps) begin
                     warp_state[i] = WARP_FETCH;
                     fetcher_state[i] = FETCHER_IDLE;
@@ -206,158 +612,200 @@ always @(posedge clk) begin
             end
         end
     end else begin
-        // In parallel, check if fetchers are done, and if so, move to decode
-        for (int i = 0; i < WARPS_PER_CORE; i = i + 1) begin
-            if ( i < num_warps ) begin
-                if (warp_state[i] == WARP_FETCH && fetcher_state[i] == FETCHER_DONE) begin
-                    $display("Block: %0d: Warp %0d: Fetched instruction %h at address %h", block_id, i, fetched_instruction[i], pc[i]);
-                    warp_state[i] = WARP_DECODE;
-                end
-            end
-        end
         done <= all_warps_done;
 
-        if (current_warp_state == WARP_UPDATE || current_warp_state == WARP_DONE ||
-            current_warp_state == WARP_WAIT   || current_warp_state == WARP_ALU_WAIT ||
-            current_warp_state == WARP_INT_ALU_WAIT) begin
-
-            int next_warp = (current_warp + 1) % num_warps;
+        // The picked warp issues in the next cycle
+        if (issue_valid) begin
+            current_warp <= issue_warp;
+        end
 
-            int found_warp = -1;
-            $display("Block: %0d: Choosing next warp", block_id);
-            for (int i = 0; i < WARPS_PER_CORE; i = i + 1) begin
-                int warp_index = (next_warp + i);
-                if (num_warps > 0) begin
-                     warp_index = warp_index % num_warps;
-                end
-                if (i < num_warps) begin // Ensure we only check valid warps
-                    if ((warp_state[warp_index] != WARP_IDLE) &&
-                        (warp_state[warp_index] != WARP_FETCH) &&
-                        (warp_state[warp_index] != WARP_DONE))
-                    begin
-                        found_warp = warp_index;
-                        break;
-                    end
-                end
-            end
-            if (found_warp != -1) begin
-                current_warp <= found_warp;
-            end else begin
-                current_warp <= current_warp;
-            end
+        // A stalled greedy warp hands the priority to the warp picked in its place
+        if (WARP_SCHEDULER == SCHED_GREEDY_THEN_OLDEST && greedy_stalled && issue_valid) begin
+            greedy_warp <= issue_warp;
         end
 
-        case (current_warp_state)
-            WARP_IDLE: begin
-                $display("Block: %0d: Warp %0d: Idle", block_id, current_warp);
-            end
-            WARP_FETCH: begin
-                // not possible to choose a warp that is fetching cause
-                // fetching is done in parallel
-            end
-            WARP_DECODE: begin
-                // decoding takes one cycle
-                warp_state[current_warp] <= WARP_REQUEST;
-            end
-            WARP_REQUEST: begin
-                // takes one cycle cause we are just changing the LSU state
-                warp_state[current_warp] <= WARP_REG_WAIT;
-            end
-            WARP_REG_WAIT: begin
-                warp_state[current_warp] <= WARP_WAIT;
-            end
-            WARP_WAIT: begin
-                reg any_lsu_waiting = 1'b0;
-                for (int i = 0; i < THREADS_PER_WARP; i++) begin
-                    // Make sure no lsu_state = REQUESTING or WAITING
-                    if (lsu_state[i] == LSU_REQUESTING || lsu_state[i] == LSU_WAITING) begin
-                        any_lsu_waiting = 1'b1;
-                        break;
-                    end
-                end
+        // Two-level scheduler: warps waiting on memory, at a barrier or done leave the active set,
+        // pending warps are moved in round-robin until it is full again
+        if (WARP_SCHEDULER == SCHED_TWO_LEVEL) begin
+            logic [WARPS_PER_CORE-1:0] next_active;
+            int active_count;
+            next_active = warp_active;
+            active_count = 0;
 
-                if (scalar_lsu_state == LSU_REQUESTING || scalar_lsu_state == LSU_WAITING) begin
-                    any_lsu_waiting = 1'b1;
+            for (int i = 0; i < WARPS_PER_CORE; i = i + 1) begin
+                if (warp_state[i] == WARP_DONE || warp_state[i] == WARP_SYNC_WAIT ||
+                    warp_state[i] == WARP_WAIT || i >= num_warps) begin
+                    next_active[i] = 0;
                 end
-
-                // If no LSU is waiting for a response, move onto the next stage
-                if (!any_lsu_waiting) begin
-                    warp_state[current_warp] <= WARP_EXECUTE;
+                if (next_active[i]) begin
+                    active_count = active_count + 1;
                 end
             end
-            WARP_EXECUTE: begin
-                $display("===================================");
-                $display("Mask: %32b", warp_execution_mask[current_warp]);
-                $display("Block: %0d: Warp %0d: Executing instruction %h at address %h", block_id, current_warp, fetched_instruction[current_warp], pc[current_warp]);
-                //$display("Instruction opcode: %b", fetched_instruction[current_warp][31:29]);
-                //$display("Block: %0d: Warp %0d: Executing instruction %h", block_id, current_warp, fetched_instruction[current_warp]);
-                
-                // Determine the next state based on the instruction type
-                if (decoded_alu_instruction[current_warp] >= FADD && decoded_alu_instruction[current_warp] < BEQZ) begin
-                    // It's a Floating Point instruction, go to the FPU wait state
-                    warp_state[current_warp] <= WARP_ALU_WAIT;
-                end else if ((decoded_alu_instruction[current_warp] < FADD) || decoded_branch[current_warp] || (decoded_alu_instruction[current_warp] == JAL)) begin
-                    warp_state[current_warp] <= WARP_INT_ALU_WAIT;
-                end else begin
-                    warp_state[current_warp] <= WARP_UPDATE;
-                end
 
-                // Handle vector-to-scalar write setup
-                if (decoded_reg_input_mux[current_warp] == VECTOR_TO_SCALAR) begin
-                    data_t scalar_write_value;
-                    scalar_write_value = {`DATA_WIDTH{1'b0}};
-                    for (int i = 0; i < THREADS_PER_WARP; i++) begin
-                        scalar_write_value[i] = alu_out[i][0];
+            for (int k = 1; k <= WARPS_PER_CORE; k = k + 1) begin
+                if (k <= num_warps && active_count < ACTIVE_WARPS) begin
+                    int warp_index;
+                    warp_index = (int'(current_warp) + k) % num_warps;
+                    if (!next_active[warp_index] && warp_state[warp_index] != WARP_DONE &&
+                        warp_state[warp_index] != WARP_SYNC_WAIT && warp_state[warp_index] != WARP_WAIT) begin
+                        next_active[warp_index] = 1;
+                        active_count = active_count + 1;
                     end
-                    vector_to_scalar_data[current_warp] <= scalar_write_value;
-                end else begin
-                    vector_to_scalar_data[current_warp] <= {`DATA_WIDTH{1'b0}};
                 end
             end
 
-            WARP_INT_ALU_WAIT: begin
-                // This state is just a one-cycle delay for the 2-stage ALU.
-                warp_state[current_warp] <= WARP_UPDATE;
-            end
+            warp_active <= next_active;
+        end
 
-            WARP_ALU_WAIT: begin
-                // This state remains the same, for the FPU
-                if (decoded_scalar_instruction[current_warp]) begin
-                    if(scalar_fpu_valid) begin
-                        warp_state[current_warp] <= WARP_UPDATE;
+        // Every warp moves through its states on its own, only the issue cycle is shared. Fetched
+        // instructions are decoded in parallel, so they are ready by the time the scheduler picks the
+        // warp (a prefetched instruction for the wrong pc is refetched by the fetcher).
+        for (int i = 0; i < WARPS_PER_CORE; i = i + 1) begin
+            if (i < num_warps) begin
+                case (warp_state[i])
+                    WARP_FETCH: begin
+                        if (fetcher_state[i] == FETCHER_DONE && fetched_instruction_address[i] == pc[i]) begin
+                            // $display("Block: %0d: Warp %0d: Fetched instruction %h at address %h", block_id, i, fetched_instruction[i], pc[i]);
+                            warp_state[i] <= WARP_DECODE;
+                        end
                     end
-                end else begin
-                    if(all_vector_fpus_done) begin
-                        warp_state[current_warp] <= WARP_UPDATE;
+                    WARP_DECODE: begin
+                        // decoding takes one cycle
+                        warp_state[i] <= WARP_REQUEST;
                     end
-                end
-            end
-            
-            WARP_UPDATE: begin
-                if (decoded_halt[current_warp]) begin
-                    $display("Block: %0d: Warp %0d: Finished executing instruction %h", block_id, current_warp, fetched_instruction[current_warp]);
-                    warp_state[current_warp] <= WARP_DONE;
-                end else begin
-                    logic [`INSTRUCTION_MEMORY_ADDRESS_WIDTH-1:0] resolved_next_pc = pc[current_warp] + 1;
+                    WARP_REQUEST: begin
+                        // Picked: the operands are read on this edge
+                        if (issue_valid && issue_warp == i) begin
+                            if (warp_memory_op[i]) begin
+                                // Memory instructions claim the LSUs, which take the address in REG_WAIT
+                                lsu_busy <= 1;
+                                lsu_owner <= WARP_INDEX_WIDTH'(i);
+                                warp_state[i] <= WARP_REG_WAIT;
+                            end else begin
+                                warp_state[i] <= WARP_EXECUTE;
+                            end
+                        end
+                    end
+                    WARP_REG_WAIT: begin
+                        warp_state[i] <= WARP_WAIT;
+                    end
+                    WARP_WAIT: begin
+                        // Written back once none of this warp's LSU requests is still outstanding
+                        if (!any_lsu_waiting) begin
+                            warp_state[i] <= WARP_UPDATE;
+                        end
+                    end
+                    WARP_EXECUTE: begin
+                        // $display("===================================");
+                        // $display("Mask: %32b", warp_execution_mask[i]);
+                        // $display("Block: %0d: Warp %0d: Executing instruction %h at address %h", block_id, i, fetched_instruction[i], pc[i]);
+
+                        // Determine the next state based on the instruction type
+                        // (the lane exchange result is registered and written back in WARP_UPDATE)
+                        if (warp_fpu_op[i]) begin
+                            // Written back from ALU_WAIT when the FPU result tagged with this warp comes out
+                            warp_state[i] <= WARP_ALU_WAIT;
+                        end else if (warp_int_op[i]) begin
+                            warp_state[i] <= WARP_INT_ALU_WAIT;
+                        end else begin
+                            warp_state[i] <= WARP_UPDATE;
+                        end
+                    end
+                    WARP_INT_ALU_WAIT: begin
+                        // This state is just a one-cycle delay for the 2-stage ALU.
+                        warp_state[i] <= WARP_UPDATE;
+                    end
+                    WARP_SYNC_WAIT: begin
+                        // parked until sync_release, the scheduler skips this warp
+                        if (sync_release) begin
+                            warp_state[i] <= WARP_FETCH;
+                        end
+                    end
+                    default: begin
+                        // IDLE, DONE, and ALU_WAIT/UPDATE which are handled by the writeback below
+                    end
+                endcase
 
-                    if (decoded_branch[current_warp] && (scalar_alu_out == 1)) begin
-                        resolved_next_pc = pc[current_warp] + decoded_immediate[current_warp];
+                if (warp_writeback[i]) begin
+                    // The LSUs drop back to idle on this edge
+                    if (lsu_busy && lsu_owner == i) begin
+                        lsu_busy <= 0;
                     end
-                    else if (decoded_alu_instruction[current_warp] == JAL) begin
-                        resolved_next_pc = scalar_alu_out;
+
+                    if (decoded_halt[i]) begin
+                        // $display("Block: %0d: Warp %0d: Finished executing instruction %h", block_id, i, fetched_instruction[i]);
+                        warp_state[i] <= WARP_DONE;
+                    end else if (decoded_sync[i]) begin
+                        // Resume after the barrier once the whole block has arrived
+                        pc[i] <= pc[i] + 1;
+                        warp_state[i] <= WARP_SYNC_WAIT;
+                        warp_grid_sync[i] <= decoded_grid_sync[i];
+                    end else begin
+                        pc[i] <= resolved_pc[i];
+                        // Skip the fetch if the fetcher already holds the next instruction
+                        if (warp_decode[i]) begin
+                            warp_state[i] <= WARP_REQUEST;
+                        end else begin
+                            warp_state[i] <= WARP_FETCH;
+                        end
                     end
-                    
-                    pc[current_warp] <= resolved_next_pc;
-                    warp_state[current_warp] <= WARP_FETCH;
                 end
             end
+        end
+    end
+end
 
-            WARP_DONE: begin
-                // we chillin
+`ifdef TRACE_RETIRE
+// RETIRE TRACE
+// > Every instruction written back is written as one record of six 32-bit words (trace_format.h in
+//   hardware/tb/tools): cycle, {core, warp, flags}, block, pc, execution mask, rd value
+// > The rd value is the value written to rd, vector instructions fold their enabled lanes into one word
+//   (lane value rotated left by the lane index, xored together) so the records keep a fixed size
+// > Warps writing back in the same cycle are written in warp order
+always @(posedge clk) begin
+    if (!reset && trace_fd != 0) begin
+        for (int w = 0; w < WARPS_PER_CORE; w++) begin
+            if (warp_writeback[w]) begin
+                logic [7:0] flags;
+                data_t rd_value;
+                logic writes_rd;
+
+                writes_rd = decoded_reg_write_enable[w] && decoded_rd_address[w] != 0;
+                rd_value = 0;
+                if (decoded_scalar_instruction[w]) begin
+                    case (decoded_reg_input_mux[w])
+                        ALU_OUT:            rd_value = warp_scalar_alu_out[w];
+                        LSU_OUT:            rd_value = scalar_lsu_out;
+                        IMMEDIATE:          rd_value = decoded_immediate[w];
+                        PC_PLUS_1:          rd_value = pc[w] + 1;
+                        VECTOR_TO_SCALAR:   rd_value = vector_to_scalar_data[w];
+                        default:            rd_value = 0;
+                    endcase
+                end else if (decoded_reg_input_mux[w] == VECTOR_TO_SCALAR) begin
+                    rd_value = vector_to_scalar_data[w];
+                end else begin
+                    for (int i = 0; i < THREADS_PER_WARP; i++) begin
+                        if (warp_execution_mask[w][i]) begin
+                            data_t lane_value;
+                            case (decoded_reg_input_mux[w])
+                                ALU_OUT:    lane_value = warp_alu_out[w][i];
+                                LSU_OUT:    lane_value = lane_lsu_out[i];
+                                IMMEDIATE:  lane_value = decoded_immediate[w];
+                                default:    lane_value = 0;
+                            endcase
+                            rd_value = rd_value ^ ((lane_value << i) | (lane_value >> ((`DATA_WIDTH - i) % `DATA_WIDTH)));
+                        end
+                    end
+                end
+
+                flags = {5'b0, decoded_halt[w], writes_rd, decoded_scalar_instruction[w]};
+                $fwrite(trace_fd, "%u%u%u%u%u%u", trace_cycle, {trace_core_id[15:0], 8'(w), flags}, block_id,
+                        data_t'(pc[w]), data_t'(warp_execution_mask[w]), writes_rd ? rd_value : 0);
             end
-        endcase
+        end
     end
 end
+`endif
 
 // This block generates warp control circuitry
 generate
@@ -369,21 +817,23 @@ for (genvar i = 0; i < WARPS_PER_CORE; i = i + 1) begin : g_warp
         .warp_state(warp_state[i]),
         .pc(pc[i]),
 
-        // Instruction Memory
-        .instruction_mem_read_ready(instruction_mem_read_ready[i]),
-        .instruction_mem_read_data(instruction_mem_read_data[i]),
-        .instruction_mem_read_valid(instruction_mem_read_valid[i]),
-        .instruction_mem_read_address(instruction_mem_read_address[i]),
+        // Instruction Cache
+        .instruction_mem_read_ready(fetcher_read_ready[i]),
+        .instruction_mem_read_data(fetcher_read_data[i]),
+        .instruction_mem_read_valid(fetcher_read_valid[i]),
+        .instruction_mem_read_address(fetcher_read_address[i]),
 
         // Fetcher output
         .fetcher_state(fetcher_state[i]),
-        .instruction(fetched_instruction[i])
+        .instruction(fetched_instruction[i]),
+        .instruction_address(fetched_instruction_address[i])
     );
 
+    // Decodes in DECODE, or on the writeback edge when the next instruction is already fetched
     decoder decoder_inst(
         .clk(clk),
         .reset(reset),
-        .warp_state(warp_state[i]),
+        .warp_state(warp_decode[i] ? WARP_DECODE : warp_state[i]),
 
         .instruction(fetched_instruction[i]),
 
@@ -397,23 +847,33 @@ for (genvar i = 0; i < WARPS_PER_CORE; i = i + 1) begin : g_warp
         .decoded_rd_address(decoded_rd_address[i]),
         .decoded_rs1_address(decoded_rs1_address[i]),
         .decoded_rs2_address(decoded_rs2_address[i]),
+        .decoded_rs3_address(decoded_rs3_address[i]),
         .decoded_alu_instruction(decoded_alu_instruction[i]),
 
         .decoded_halt(decoded_halt[i]),
+        .decoded_sync(decoded_sync[i]),
+        .decoded_grid_sync(decoded_grid_sync[i]),
+        .decoded_broadcast(decoded_broadcast[i]),
         .floatingRead(floatingRead_flag[i]),
         .floatingWrite(floatingWrite_flag[i])
     );
+    // The register files read the operands on the edge the warp is picked and are written back in
+    // UPDATE, or straight from ALU_WAIT when the warp's FPU result comes out
+    wire reg_file_enable = (issue_valid && issue_warp == i) || warp_writeback[i];
+    warp_state_t warp_update_state;
+    assign warp_update_state = warp_writeback[i] ? WARP_UPDATE : warp_state[i];
+
     // Scalar float register file
     scalar_reg_file #(
         .DATA_WIDTH(32)
     ) floating_scalar_reg_file_inst (
         .clk(clk),
         .reset(reset),
-        .enable((current_warp == i)), // Enable when current_warp matches and warp is active
+        .enable(reg_file_enable), // Reads operands when the warp is picked, writes back in warp_update_state
 
         //.warp_execution_mask(warp_execution_mask[i]),
 
-        .warp_state(warp_state[i]),
+        .warp_state(warp_update_state),
 
         .decoded_reg_write_enable(decoded_reg_write_enable[i] && decoded_scalar_instruction[i] && floatingWrite_flag[i]),
         .decoded_reg_input_mux(decoded_reg_input_mux[i]),
@@ -421,14 +881,16 @@ for (genvar i = 0; i < WARPS_PER_CORE; i = i + 1) begin : g_warp
         .decoded_rd_address(decoded_rd_address[i]),
         .decoded_rs1_address(decoded_rs1_address[i]),
         .decoded_rs2_address(decoded_rs2_address[i]),
+        .decoded_rs3_address(decoded_rs3_address[i]),
 
-        .alu_out(scalar_alu_out),
+        .alu_out(warp_scalar_alu_out[i]),
         .lsu_out(scalar_lsu_out),
         .pc(pc[i]),
         .vector_to_scalar_data(vector_to_scalar_data[i]),
 
         .rs1(scalar_float_rs1[i]),
-        .rs2(scalar_float_rs2[i])
+        .rs2(scalar_float_rs2[i]),
+        .rs3(scalar_float_rs3[i])
     );
 
     always_comb begin
@@ -452,20 +914,21 @@ for (genvar i = 0; i < WARPS_PER_CORE; i = i + 1) begin : g_warp
     ) scalar_reg_file_inst (
         .clk(clk),
         .reset(reset),
-        .enable((current_warp == i)), // Enable when current_warp matches and warp is active
+        .enable(reg_file_enable), // Reads operands when the warp is picked, writes back in warp_update_state
 
         .warp_execution_mask(warp_execution_mask[i]),
 
-        .warp_state(warp_state[i]),
+        .warp_state(warp_update_state),
 
-        .decoded_reg_write_enable(decoded_reg_write_enable[i] && ((decoded_scalar_instruction[i] && !floatingWrite_flag[i]) ||(decoded_reg_input_mux[i] == VECTOR_TO_SCALAR))),
+        .decoded_reg_write_enable(decoded_reg_write_enable[i] && ((decoded_scalar_instruction[i] && (!floatingWrite_flag[i] || decoded_alu_instruction[i] == FMINIDX)) ||(decoded_reg_input_mux[i] == VECTOR_TO_SCALAR))),
         .decoded_reg_input_mux(decoded_reg_input_mux[i]),
         .decoded_immediate(decoded_immediate[i]),
         .decoded_rd_address(decoded_rd_address[i]),
         .decoded_rs1_address(decoded_rs1_address[i]),
         .decoded_rs2_address(decoded_rs2_address[i]),
+        .decoded_rs3_address(decoded_rs3_address[i]),
 
-        .alu_out(scalar_alu_out),
+        .alu_out(warp_scalar_int_alu_out[i]), // Index of the picked operand for FMINIDX
         .lsu_out(scalar_lsu_out),
         .pc(pc[i]),
         .vector_to_scalar_data(vector_to_scalar_data[i]),
@@ -479,7 +942,7 @@ for (genvar i = 0; i < WARPS_PER_CORE; i = i + 1) begin : g_warp
         ) floating_reg_file_inst (
             .clk(clk),
             .reset(reset),
-            .enable((current_warp == i)), // Enable when current_warp matches and warp is active
+            .enable(reg_file_enable), // Reads operands when the warp is picked, writes back in warp_update_state
 
             // Thread enable signals (execution mask)
             .thread_enable(warp_execution_mask[i]),
@@ -488,7 +951,7 @@ for (genvar i = 0; i < WARPS_PER_CORE; i = i + 1) begin : g_warp
             .warp_id(i),
             .block_id(block_id),
             .block_size(kernel_config.num_warps_per_block * THREADS_PER_WARP),
-            .warp_state(warp_state[i]),
+            .warp_state(warp_update_state),
 
             // Decoded instruction fields for this warp
             .decoded_reg_write_enable(decoded_reg_write_enable[i] && !decoded_scalar_instruction[i] && floatingWrite_flag[i]),
@@ -497,14 +960,16 @@ for (genvar i = 0; i < WARPS_PER_CORE; i = i + 1) begin : g_warp
             .decoded_rd_address(decoded_rd_address[i]),
             .decoded_rs1_address(decoded_rs1_address[i]),
             .decoded_rs2_address(decoded_rs2_address[i]),
+            .decoded_rs3_address(decoded_rs3_address[i]),
 
             // Inputs from ALU and LSU per thread
-            .alu_out(alu_out), // ALU outputs for all threads
-            .lsu_out(lsu_out),
+            .alu_out(warp_alu_out[i]), // ALU outputs for all threads
+            .lsu_out(lane_lsu_out),
 
             // Outputs per thread
             .rs1(vector_float_rs1[i]),
-            .rs2(vector_float_rs2[i])
+            .rs2(vector_float_rs2[i]),
+            .rs3(vector_float_rs3[i])
         );
 
 
@@ -514,7 +979,7 @@ for (genvar i = 0; i < WARPS_PER_CORE; i = i + 1) begin : g_warp
         ) reg_file_inst (
             .clk(clk),
             .reset(reset),
-            .enable((current_warp == i)), // Enable when current_warp matches and warp is active
+            .enable(reg_file_enable), // Reads operands when the warp is picked, writes back in warp_update_state
 
             // Thread enable signals (execution mask)
             .thread_enable(warp_execution_mask[i]),
@@ -523,19 +988,20 @@ for (genvar i = 0; i < WARPS_PER_CORE; i = i + 1) begin : g_warp
             .warp_id(i),
             .block_id(block_id),
             .block_size(kernel_config.num_warps_per_block * THREADS_PER_WARP),
-            .warp_state(warp_state[i]),
+            .warp_state(warp_update_state),
 
             // Decoded instruction fields for this warp
-            .decoded_reg_write_enable(decoded_reg_write_enable[i] && !decoded_scalar_instruction[i] && !floatingWrite_flag[i]),
+            .decoded_reg_write_enable(decoded_reg_write_enable[i] && !decoded_scalar_instruction[i] && (!floatingWrite_flag[i] || decoded_alu_instruction[i] == FMINIDX)),
             .decoded_reg_input_mux(decoded_reg_input_mux[i]),
             .decoded_immediate(decoded_immediate[i]),
             .decoded_rd_address(decoded_rd_address[i]),
             .decoded_rs1_address(decoded_rs1_address[i]),
             .decoded_rs2_address(decoded_rs2_address[i]),
+            .decoded_rs3_address(decoded_rs3_address[i]),
 
             // Inputs from ALU and LSU per thread
-            .alu_out(alu_out), // ALU outputs for all threads
-            .lsu_out(lsu_out),
+            .alu_out(warp_int_alu_out[i]), // ALU outputs for all threads, indices for FMINIDX
+            .lsu_out(lane_lsu_out),
 
             // Outputs per thread
             .rs1(vector_int_rs1[i]),
@@ -546,23 +1012,37 @@ end
 endgenerate
 
 
-// This block generates shared core resources (ALUs, LSUs)
+// This block generates shared core resources (instruction cache, ALUs, LSUs)
 
-//Scalar functional units
-data_t scalar_int_alu_result, scalar_float_alu_result;
-logic scalar_fpu_valid;
-wire is_scalar_float_op = decoded_scalar_instruction[current_warp] && (decoded_alu_instruction[current_warp] >= FADD);
-wire is_branch_or_jal = decoded_branch[current_warp] || (decoded_alu_instruction[current_warp] == JAL);
-wire is_regular_int_op = decoded_alu_instruction[current_warp] < FADD;
+// Instruction cache, misses go out on the missing warp's instruction memory port
+instruction_cache #(
+    .NUM_CONSUMERS(WARPS_PER_CORE),
+    .CACHE_LINES(ICACHE_LINES)
+) instruction_cache_inst (
+    .clk(clk),
+    .reset(reset),
+    .flush(icache_flush),
+
+    .consumer_read_valid(fetcher_read_valid),
+    .consumer_read_address(fetcher_read_address),
+    .consumer_read_ready(fetcher_read_ready),
+    .consumer_read_data(fetcher_read_data),
 
-// The ALU should be enabled if the current instruction is a scalar op that fits any of the above criteria.
-wire is_scalar_int_op = decoded_scalar_instruction[current_warp] && (is_regular_int_op || is_branch_or_jal);
+    .mem_read_valid(instruction_mem_read_valid),
+    .mem_read_address(instruction_mem_read_address),
+    .mem_read_ready(instruction_mem_read_ready),
+    .mem_read_data(instruction_mem_read_data),
 
-// Scalar ALU
+    .hit_count(icache_hits),
+    .miss_count(icache_misses)
+);
+
+//Scalar functional units
+// Scalar ALU (free running, the result comes out two cycles after the operands)
 alu scalar_alu_inst(
     .clk(clk),
     .rst(reset),
-    .enable(is_scalar_int_op),
+    .enable(1'b1),
     .pc(pc[current_warp]),
     .ALUop1(scalar_op1),
     .ALUop2(scalar_op2),
@@ -574,113 +1054,209 @@ alu scalar_alu_inst(
 );
 
 // Scalar Floating ALU
-floating_alu scalar_fpu_inst(
+floating_alu #(
+    .TAG_WIDTH(WARP_INDEX_WIDTH)
+) scalar_fpu_inst(
     .clk(clk),
-    .rst(rst),
+    .rst(reset),
+    .start(fpu_issue && decoded_scalar_instruction[current_warp]),
+    .tag(current_warp),
+    .ready(scalar_fpu_ready),
     .valid(scalar_fpu_valid),
+    .result_tag(scalar_fpu_tag),
     .op1(scalar_op1),
     .op2(scalar_op2),
+    .op3(scalar_float_rs3[current_warp]),
     .instruction(decoded_alu_instruction[current_warp]),
 
-    .result(scalar_float_alu_result)
+    .result(scalar_float_alu_result),
+    .less(scalar_fpu_less)
 );
 
-logic more_fadd;
-assign more_fadd = (decoded_alu_instruction[current_warp] >= FADD);
-logic less_beqz;
-assign less_beqz = (decoded_alu_instruction[current_warp] < BEQZ);
-
-assign scalar_alu_out = (more_fadd & less_beqz) ? scalar_float_alu_result : scalar_int_alu_result;
-// assign scalar_alu_out = is_scalar_float_op ? scalar_float_alu_result : scalar_int_alu_result;
-
+// Also serves uniform (broadcast) vector loads, which need a single transaction
 lsu scalar_lsu_inst(
     .clk(clk),
     .reset(reset),
-    .enable(decoded_scalar_instruction[current_warp]),
+    .enable(decoded_scalar_instruction[lsu_warp] || decoded_broadcast[lsu_warp]),
 
-    .warp_state(warp_state[current_warp]),
+    .warp_state(lsu_warp_state),
 
-    .decoded_mem_read_enable(decoded_mem_read_enable_per_warp[current_warp]),
-    .decoded_mem_write_enable(decoded_mem_write_enable_per_warp[current_warp]),
+    .decoded_mem_read_enable(decoded_mem_read_enable_per_warp[lsu_warp]),
+    .decoded_mem_write_enable(decoded_mem_write_enable_per_warp[lsu_warp]),
 
     .rs1(scalar_op1),
     .rs2(scalar_op2),
     .imm(decoded_immediate[current_warp]),
 
-    // Data Memory connections
-    .mem_read_valid(data_mem_read_valid[THREADS_PER_WARP]),
-    .mem_read_address(data_mem_read_address[THREADS_PER_WARP]),
-    .mem_read_ready(data_mem_read_ready[THREADS_PER_WARP]),
-    .mem_read_data(data_mem_read_data[THREADS_PER_WARP]),
-    .mem_write_valid(data_mem_write_valid[THREADS_PER_WARP]),
-    .mem_write_address(data_mem_write_address[THREADS_PER_WARP]),
-    .mem_write_data(data_mem_write_data[THREADS_PER_WARP]),
-    .mem_write_ready(data_mem_write_ready[THREADS_PER_WARP]),
+    // Data Memory connections (through the scratchpad)
+    .mem_read_valid(lsu_mem_read_valid[THREADS_PER_WARP]),
+    .mem_read_address(lsu_mem_read_address[THREADS_PER_WARP]),
+    .mem_read_ready(lsu_mem_read_ready[THREADS_PER_WARP]),
+    .mem_read_data(lsu_mem_read_data[THREADS_PER_WARP]),
+    .mem_write_valid(lsu_mem_write_valid[THREADS_PER_WARP]),
+    .mem_write_address(lsu_mem_write_address[THREADS_PER_WARP]),
+    .mem_write_data(lsu_mem_write_data[THREADS_PER_WARP]),
+    .mem_write_ready(lsu_mem_write_ready[THREADS_PER_WARP]),
 
     .lsu_state(scalar_lsu_state),
     .lsu_out(scalar_lsu_out)
 );
 
+// LSUs <> Scratchpad (vector lanes first, the scalar LSU last)
+logic [NUM_LSUS-1:0] lsu_mem_read_valid;
+data_memory_address_t lsu_mem_read_address [NUM_LSUS];
+logic [NUM_LSUS-1:0] lsu_mem_read_ready;
+data_t lsu_mem_read_data [NUM_LSUS];
+logic [NUM_LSUS-1:0] lsu_mem_write_valid;
+data_memory_address_t lsu_mem_write_address [NUM_LSUS];
+data_t lsu_mem_write_data [NUM_LSUS];
+logic [NUM_LSUS-1:0] lsu_mem_write_ready;
+
+// Scratchpad <> Coalescer / Data Memory (requests outside the scratchpad)
+logic [NUM_LSUS-1:0] global_mem_read_valid;
+data_memory_address_t global_mem_read_address [NUM_LSUS];
+logic [NUM_LSUS-1:0] global_mem_read_ready;
+data_t global_mem_read_data [NUM_LSUS];
+logic [NUM_LSUS-1:0] global_mem_write_valid;
+data_memory_address_t global_mem_write_address [NUM_LSUS];
+data_t global_mem_write_data [NUM_LSUS];
+logic [NUM_LSUS-1:0] global_mem_write_ready;
+
+// __shared data is answered inside the core and never reaches the memory controller
+scratchpad #(
+    .NUM_CONSUMERS(NUM_LSUS),
+    .NUM_BANKS(SCRATCHPAD_BANKS),
+    .WORDS(SCRATCHPAD_WORDS)
+) scratchpad_inst (
+    .clk(clk),
+    .reset(reset),
+
+    .consumer_read_valid(lsu_mem_read_valid),
+    .consumer_read_address(lsu_mem_read_address),
+    .consumer_read_ready(lsu_mem_read_ready),
+    .consumer_read_data(lsu_mem_read_data),
+    .consumer_write_valid(lsu_mem_write_valid),
+    .consumer_write_address(lsu_mem_write_address),
+    .consumer_write_data(lsu_mem_write_data),
+    .consumer_write_ready(lsu_mem_write_ready),
+
+    .mem_read_valid(global_mem_read_valid),
+    .mem_read_address(global_mem_read_address),
+    .mem_read_ready(global_mem_read_ready),
+    .mem_read_data(global_mem_read_data),
+    .mem_write_valid(global_mem_write_valid),
+    .mem_write_address(global_mem_write_address),
+    .mem_write_data(global_mem_write_data),
+    .mem_write_ready(global_mem_write_ready),
+
+    .accesses(scratchpad_accesses),
+    .bank_conflicts(scratchpad_bank_conflicts)
+);
+
+// The scalar LSU keeps its own data memory port
+assign data_mem_read_valid[THREADS_PER_WARP] = global_mem_read_valid[THREADS_PER_WARP];
+assign data_mem_read_address[THREADS_PER_WARP] = global_mem_read_address[THREADS_PER_WARP];
+assign global_mem_read_ready[THREADS_PER_WARP] = data_mem_read_ready[THREADS_PER_WARP];
+assign global_mem_read_data[THREADS_PER_WARP] = data_mem_read_data[THREADS_PER_WARP];
+assign data_mem_write_valid[THREADS_PER_WARP] = global_mem_write_valid[THREADS_PER_WARP];
+assign data_mem_write_address[THREADS_PER_WARP] = global_mem_write_address[THREADS_PER_WARP];
+assign data_mem_write_data[THREADS_PER_WARP] = global_mem_write_data[THREADS_PER_WARP];
+assign global_mem_write_ready[THREADS_PER_WARP] = data_mem_write_ready[THREADS_PER_WARP];
+
+// Lanes accessing the same address share one memory transaction
+lsu_coalescer #(
+    .NUM_LANES(THREADS_PER_WARP)
+) lsu_coalescer_inst (
+    .clk(clk),
+    .reset(reset),
+
+    .lane_read_valid(global_mem_read_valid[0 +: THREADS_PER_WARP]),
+    .lane_read_address(global_mem_read_address[0 +: THREADS_PER_WARP]),
+    .lane_read_ready(global_mem_read_ready[0 +: THREADS_PER_WARP]),
+    .lane_read_data(global_mem_read_data[0 +: THREADS_PER_WARP]),
+    .lane_write_valid(global_mem_write_valid[0 +: THREADS_PER_WARP]),
+    .lane_write_address(global_mem_write_address[0 +: THREADS_PER_WARP]),
+    .lane_write_data(global_mem_write_data[0 +: THREADS_PER_WARP]),
+    .lane_write_ready(global_mem_write_ready[0 +: THREADS_PER_WARP]),
+
+    .mem_read_valid(data_mem_read_valid[0 +: THREADS_PER_WARP]),
+    .mem_read_address(data_mem_read_address[0 +: THREADS_PER_WARP]),
+    .mem_read_ready(data_mem_read_ready[0 +: THREADS_PER_WARP]),
+    .mem_read_data(data_mem_read_data[0 +: THREADS_PER_WARP]),
+    .mem_write_valid(data_mem_write_valid[0 +: THREADS_PER_WARP]),
+    .mem_write_address(data_mem_write_address[0 +: THREADS_PER_WARP]),
+    .mem_write_data(data_mem_write_data[0 +: THREADS_PER_WARP]),
+    .mem_write_ready(data_mem_write_ready[0 +: THREADS_PER_WARP]),
+
+    .lane_requests(coalescer_lane_requests),
+    .mem_transactions(coalescer_mem_transactions)
+);
+
 //Vecto4r functional units
 generate
     for (genvar i = 0; i < THREADS_PER_WARP; i = i + 1) begin : g_vector_units
-        wire t_enable = current_warp_execution_mask[i] && !decoded_scalar_instruction[current_warp];
-        wire is_vector_float_op = t_enable && (decoded_alu_instruction[current_warp] >= FADD);
-        wire is_vector_int_op  = t_enable && (decoded_alu_instruction[current_warp] < FADD);
-       
-        data_t vector_int_alu_result, vector_float_alu_result;
+        wire lsu_enable = warp_execution_mask[lsu_warp][i] && !decoded_scalar_instruction[lsu_warp] && !decoded_broadcast[lsu_warp];
 
-        // Vector ALU
+        // Vector ALU (free running, the result comes out two cycles after the operands)
         alu vector_alu_inst(
             .clk(clk),
-            .rst(rst),
-            .enable(is_vector_int_op),
+            .rst(reset),
+            .enable(1'b1),
             .pc(pc[current_warp]),
             .ALUop1(final_op1[i]),
             .ALUop2(final_op2[i]),
             .IMM(decoded_immediate[current_warp]),
             .instruction(decoded_alu_instruction[current_warp]),
 
-            .Result(vector_int_alu_result)
+            .Result(vector_int_alu_result[i])
             // .EQ() // unused
         );
         // Vector Floating ALU
-        floating_alu vector_fpu_inst(
+        floating_alu #(
+            .TAG_WIDTH(WARP_INDEX_WIDTH)
+        ) vector_fpu_inst(
             .clk(clk),
-            .rst(rst),
+            .rst(reset),
+            .start(fpu_issue && !decoded_scalar_instruction[current_warp]),
+            .tag(current_warp),
+            .ready(vector_fpu_ready[i]),
             .valid(vector_fpu_valid[i]),
+            .result_tag(vector_fpu_tag[i]),
             .op1(final_op1[i]),
             .op2(final_op2[i]),
+            .op3(vector_float_rs3[current_warp][i]),
             .instruction(decoded_alu_instruction[current_warp]),
 
-            .result(vector_float_alu_result)
+            .result(vector_float_alu_result[i]),
+            .less(vector_fpu_less[i])
         );
 
-        assign alu_out[i] = (decoded_alu_instruction[current_warp] >= FADD) ? vector_float_alu_result : vector_int_alu_result;
+        // Uniform loads are done once by the scalar LSU and broadcast to every lane
+        assign lane_lsu_out[i] = decoded_broadcast[lsu_warp] ? scalar_lsu_out : lsu_out[i];
         
         lsu lsu_inst(
             .clk(clk),
             .reset(reset),
-            .enable(t_enable),
+            .enable(lsu_enable),
 
-            .warp_state(warp_state[current_warp]),
+            .warp_state(lsu_warp_state),
 
-            .decoded_mem_read_enable(decoded_mem_read_enable_per_warp[current_warp]),
-            .decoded_mem_write_enable(decoded_mem_write_enable_per_warp[current_warp]),
+            .decoded_mem_read_enable(decoded_mem_read_enable_per_warp[lsu_warp]),
+            .decoded_mem_write_enable(decoded_mem_write_enable_per_warp[lsu_warp]),
 
             .rs1(final_op1[i]),
             .rs2(final_op2[i]),
             .imm(decoded_immediate[current_warp]),
 
-            // Data Memory connections
-            .mem_read_valid(data_mem_read_valid[i]),
-            .mem_read_address(data_mem_read_address[i]),
-            .mem_read_ready(data_mem_read_ready[i]),
-            .mem_read_data(data_mem_read_data[i]),
-            .mem_write_valid(data_mem_write_valid[i]),
-            .mem_write_address(data_mem_write_address[i]),
-            .mem_write_data(data_mem_write_data[i]),
-            .mem_write_ready(data_mem_write_ready[i]),
+            // Data Memory connections (through the scratchpad and the coalescer)
+            .mem_read_valid(lsu_mem_read_valid[i]),
+            .mem_read_address(lsu_mem_read_address[i]),
+            .mem_read_ready(lsu_mem_read_ready[i]),
+            .mem_read_data(lsu_mem_read_data[i]),
+            .mem_write_valid(lsu_mem_write_valid[i]),
+            .mem_write_address(lsu_mem_write_address[i]),
+            .mem_write_data(lsu_mem_write_data[i]),
+            .mem_write_ready(lsu_mem_write_ready[i]),
 
             .lsu_state(lsu_state[i]),
             .lsu_out(lsu_out[i])
@@ -20,9 +20,13 @@ module decoder(
     output  reg [4:0]           decoded_rd_address,
     output  reg [4:0]           decoded_rs1_address,
     output  reg [4:0]           decoded_rs2_address,
+    output  reg [4:0]           decoded_rs3_address,    // Addend of the fused multiply-add (R4-type)
     output  alu_instruction_t   decoded_alu_instruction,
 
     output  reg                 decoded_halt,
+    output  reg                 decoded_sync,
+    output  reg                 decoded_grid_sync,      // With decoded_sync: the barrier spans every block of the kernel
+    output  reg                 decoded_broadcast,      // Scalar address, result written to every active lane
     output  reg [1:0]           floatingRead,
     output  reg                 floatingWrite
 );
@@ -33,6 +37,8 @@ module decoder(
     wire [4:0]   rs1        = instruction[9:5];
     wire [3:0]   funct4     = instruction[13:10];
     wire [4:0]   rs2        = instruction[18:14];
+    wire [4:0]   rs3        = instruction[23:19];
+    wire [4:0]   funct5     = instruction[23:19];  // Extended F-type (funct4 1011) sub-function
 
     wire [13:0]  imm_i      = instruction[27:14];
     wire [14:0]  imm_load   = instruction[28:14];
@@ -56,7 +62,11 @@ module decoder(
             decoded_rd_address <= 5'b0;
             decoded_rs1_address <= 5'b0;
             decoded_rs2_address <= 5'b0;
+            decoded_rs3_address <= 5'b0;
             decoded_halt <= 0;
+            decoded_sync <= 0;
+            decoded_grid_sync <= 0;
+            decoded_broadcast <= 0;
             decoded_scalar_instruction <= 0;
             floatingRead <= 2'b00;
             floatingWrite <= 1'b0;
@@ -68,10 +78,14 @@ module decoder(
             decoded_rd_address <= 5'b0;
             decoded_rs1_address <= 5'b0;
             decoded_rs2_address <= 5'b0;
+            decoded_rs3_address <= 5'b0;
             decoded_mem_read_enable <= 0;
             decoded_mem_write_enable <= 0;
             decoded_branch <= 0;
             decoded_halt <= 0;
+            decoded_sync <= 0;
+            decoded_grid_sync <= 0;
+            decoded_broadcast <= 0;
             decoded_scalar_instruction <= 0;
             floatingRead <= 2'b00;
             floatingWrite <= 1'b0;
@@ -81,7 +95,6 @@ module decoder(
                     3'b000: begin
                         // Jump instr
                         decoded_alu_instruction     <= JAL;
-                        $display("Decoding instruction 0b%32b", instruction);
                         decoded_immediate           <= sign_extend_26(imm_j);
                         decoded_scalar_instruction  <= 1;
                     end
@@ -103,6 +116,19 @@ module decoder(
                         decoded_alu_instruction     <= BEQO;
                         decoded_scalar_instruction  <= 1;
                     end
+                    3'b100: begin
+                        // Grid barrier: the warp parks until every warp of every block of the kernel arrives
+                        decoded_alu_instruction     <= SYNC;
+                        decoded_sync                <= 1;
+                        decoded_grid_sync           <= 1;
+                        decoded_scalar_instruction  <= 1;
+                    end
+                    3'b110: begin
+                        // Block barrier: the warp parks until every warp of the block arrives
+                        decoded_alu_instruction     <= SYNC;
+                        decoded_sync                <= 1;
+                        decoded_scalar_instruction  <= 1;
+                    end
                     3'b111: begin
                         // Exit instruction
                         decoded_halt <=1;
@@ -136,6 +162,11 @@ module decoder(
                             4'b0111: decoded_alu_instruction <= SNEZ;
                             4'b1000: decoded_alu_instruction <= MIN;
                             4'b1001: decoded_alu_instruction <= ABS;
+                            4'b1010: decoded_alu_instruction <= MULQ;
+                            4'b1110: decoded_alu_instruction <= SRA;
+                            // Lane exchange only makes sense across vector lanes
+                            4'b1100: begin decoded_alu_instruction <= SHFL_DOWN; decoded_scalar_instruction <= 1'b0; end
+                            4'b1101: begin decoded_alu_instruction <= SHFL_XOR; decoded_scalar_instruction <= 1'b0; end
                             default: $error("Invalid R-type instruction with funct4 %b", funct4);
                         endcase
                     end
@@ -155,6 +186,10 @@ module decoder(
                             4'b0010: decoded_alu_instruction <= MULI;
                             4'b1010: decoded_alu_instruction <= SLLI;
                             4'b1011: decoded_alu_instruction <= SEQI;
+                            4'b0100: decoded_alu_instruction <= SRAI;
+                            // rs2 stays at zero so the lane offset is just the immediate
+                            4'b1100: begin decoded_alu_instruction <= SHFL_DOWN; decoded_scalar_instruction <= 1'b0; end
+                            4'b1101: begin decoded_alu_instruction <= SHFL_XOR; decoded_scalar_instruction <= 1'b0; end
                             default: $error("Invalid I-type instruction with funct4 %b", funct4);
                         endcase
                     end
@@ -164,6 +199,7 @@ module decoder(
                         decoded_rd_address          <= rd;
                         decoded_rs1_address         <= rs1;
                         decoded_rs2_address         <= rs2;
+                        decoded_rs3_address         <= rs3;
                         decoded_reg_write_enable    <= 1;
                         decoded_reg_input_mux       <= ALU_OUT;
                         decoded_scalar_instruction  <= instruction[28];
@@ -171,13 +207,37 @@ module decoder(
                         unique case (funct4)
                             4'b0000: begin decoded_alu_instruction <= FADD; floatingRead <= 2'b11; floatingWrite <= 1'b1; end
                             4'b0001: begin decoded_alu_instruction <= FSUB; floatingRead <= 2'b11; floatingWrite <= 1'b1; end 
-                            4'b0010: begin decoded_alu_instruction <= FMUL; floatingRead <= 2'b11; floatingWrite <= 1'b1; end                            4'b0100: begin decoded_alu_instruction <= FSLT; floatingRead <= 2'b11; floatingWrite <= 1'b0; end // Write to int
+                            4'b0010: begin decoded_alu_instruction <= FMUL; floatingRead <= 2'b11; floatingWrite <= 1'b1; end
+                            4'b0011: begin decoded_alu_instruction <= FDIV; floatingRead <= 2'b11; floatingWrite <= 1'b1; end
+                            4'b0100: begin decoded_alu_instruction <= FSLT; floatingRead <= 2'b11; floatingWrite <= 1'b0; end // Write to int
                             4'b0101: begin decoded_alu_instruction <= FNEG; floatingRead <= 2'b01; floatingWrite <= 1'b1; end
                             4'b0110: begin decoded_alu_instruction <= FEQ; floatingRead <= 2'b11; floatingWrite <= 1'b0; end // Write to int
                             4'b0111: begin decoded_alu_instruction <= FMIN; floatingRead <= 2'b11; floatingWrite <= 1'b1; end
                             4'b1000: begin decoded_alu_instruction <= FABS; floatingRead <= 2'b01; floatingWrite <= 1'b1; end
                             4'b1001: begin decoded_alu_instruction <= FCVT_W_S; floatingRead <= 2'b01; floatingWrite <= 1'b0; end// float to int
                             4'b1010: begin decoded_alu_instruction <= FCVT_S_W; floatingRead <= 2'b01; floatingWrite <= 1'b1; end// int to floaat
+                            4'b1011: begin
+                                floatingRead <= 2'b11;
+                                floatingWrite <= 1'b1;
+                                unique case (funct5)
+                                    5'b00000: decoded_alu_instruction <= FABSDIFF; // rd = |rs1 - rs2|
+                                    5'b00001: decoded_alu_instruction <= FSQDIFF;  // rd = (rs1 - rs2)^2
+                                    5'b00010: decoded_alu_instruction <= FMINIDX;  // rd = rs1 < rs2 ? rs1 : rs2, index in the paired int register
+                                    5'b00011: decoded_alu_instruction <= FADD_BF2;      // rd.lo/hi = rs1.lo/hi + rs2.lo/hi (bfloat16)
+                                    5'b00100: decoded_alu_instruction <= FSUB_BF2;
+                                    5'b00101: decoded_alu_instruction <= FMUL_BF2;
+                                    5'b00110: decoded_alu_instruction <= FSQDIFF_BF2;
+                                    5'b00111: decoded_alu_instruction <= FMIN_BF2;
+                                    5'b01000: decoded_alu_instruction <= FCVT_BF2_S;    // rd = {bf16(rs2), bf16(rs1)}
+                                    5'b01001: decoded_alu_instruction <= FCVT_S_BF2_LO; // rd = float(rs1.lo)
+                                    5'b01010: decoded_alu_instruction <= FCVT_S_BF2_HI; // rd = float(rs1.hi)
+                                    default: $error("Invalid extended F-type instruction with funct5 %b", funct5);
+                                endcase
+                            end
+                            4'b1100: begin decoded_alu_instruction <= SHFL_DOWN; floatingRead <= 2'b01; floatingWrite <= 1'b1; decoded_scalar_instruction <= 1'b0; end // float data, int lane offset
+                            4'b1101: begin decoded_alu_instruction <= SHFL_XOR; floatingRead <= 2'b01; floatingWrite <= 1'b1; decoded_scalar_instruction <= 1'b0; end
+                            4'b1110: begin decoded_alu_instruction <= FMADD; floatingRead <= 2'b11; floatingWrite <= 1'b1; end // rd = rs1 * rs2 + rs3
+                            4'b1111: begin decoded_alu_instruction <= FMSUB; floatingRead <= 2'b11; floatingWrite <= 1'b1; end // rd = rs1 * rs2 - rs3
                             default: $error("Invalid F-type instruction with funct4 %b", funct4);
                         endcase
                     end
@@ -234,6 +294,21 @@ module decoder(
                                 floatingRead              <= 2'b10; // Base is INT, data is FLOAT
                                 floatingWrite               <= 1'b0;
                             end
+                            3'b100, 3'b101: begin
+                                // Uniform loads (LW.U / FLW.U): one load through the scalar LSU
+                                // using a scalar base register, broadcast to the vector rd
+                                decoded_rd_address          <= rd;
+                                decoded_rs1_address         <= rs1;
+                                decoded_reg_write_enable    <= 1;
+                                decoded_reg_input_mux       <= LSU_OUT;
+                                decoded_immediate           <= sign_extend_15(imm_load);
+                                decoded_mem_read_enable     <= 1;
+                                decoded_alu_instruction     <= ADDI; // For computing effective address
+                                decoded_scalar_instruction  <= 1'b0;
+                                decoded_broadcast           <= 1;
+                                floatingRead                <= 2'b00; // Base address is INT
+                                floatingWrite               <= funct3[0]; // FLW.U writes a float rd
+                            end
                             default: $error("Invalid M-type instruction with funct4 %b", funct4);
                         endcase
                     end
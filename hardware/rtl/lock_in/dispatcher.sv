@@ -3,6 +3,15 @@
 
 `include "common.svh"
 
+// DISPATCHER
+// > Hands the blocks of a kernel out to the cores, in order, as a queue: idle cores pick up the next block
+// > A core that finishes while blocks are left is relaunched straight away: its reset is raised in the same
+//   cycle its done is seen and the next block id is latched on that edge, so there is no idle reset cycle
+//   between two blocks on the same core
+// > Several cores can be dispatched and can complete in the same cycle, each gets its own block id
+// > The cores' instruction caches are only flushed when a new kernel starts, blocks of the same kernel run warm
+// > Grid barrier (gsync): released once every core still running a block waits at it and no block is left to
+//   dispatch, so a kernel that uses it launches at most NUM_CORES blocks (a persistent kernel)
 module dispatcher #(
     parameter int NUM_CORES
 ) (
@@ -16,8 +25,11 @@ module dispatcher #(
     // Core States
     input wire [NUM_CORES-1:0] core_done, // It's an input, so 'wire' is clearer
     output reg [NUM_CORES-1:0] core_start,
-    output reg [NUM_CORES-1:0] core_reset,
+    output logic [NUM_CORES-1:0] core_reset,
+    output reg core_icache_flush,
     output data_t core_block_id [NUM_CORES],
+    input wire [NUM_CORES-1:0] core_grid_sync_waiting,
+    output logic grid_sync_release,
 
     // Kernel Execution
     output reg done
@@ -31,6 +43,43 @@ assign total_blocks = kernel_config.num_blocks;
 data_t blocks_done;
 data_t blocks_dispatched;
 logic start_execution; // This is our internal state register
+logic [NUM_CORES-1:0] core_idle_reset; // Cores held in reset until they get a block
+
+// Cores that finished a block and get the next one without going idle, lowest core first
+logic [NUM_CORES-1:0] core_relaunch;
+
+always_comb begin
+    data_t next_block;
+    next_block = blocks_dispatched;
+
+    for (int i = 0; i < NUM_CORES; i++) begin
+        core_relaunch[i] = 0;
+        if (start_execution && core_start[i] && core_done[i] && next_block < total_blocks) begin
+            core_relaunch[i] = 1;
+            next_block = next_block + 1;
+        end
+    end
+end
+
+assign core_reset = core_idle_reset | core_relaunch;
+
+always_comb begin
+    logic any_core_waiting;
+    logic all_cores_waiting;
+    any_core_waiting = 0;
+    all_cores_waiting = 1;
+
+    for (int i = 0; i < NUM_CORES; i++) begin
+        if (core_start[i] && !core_done[i]) begin
+            if (core_grid_sync_waiting[i]) begin
+                any_core_waiting = 1;
+            end else begin
+                all_cores_waiting = 0;
+            end
+        end
+    end
+    grid_sync_release = start_execution && (blocks_dispatched == total_blocks) && any_core_waiting && all_cores_waiting;
+end
 
 always @(posedge clk) begin
     if (reset) begin
@@ -38,27 +87,38 @@ always @(posedge clk) begin
         blocks_dispatched <= 0;
         blocks_done <= 0;
         start_execution <= 0;
+        core_icache_flush <= 1;
 
         for (int i = 0; i < NUM_CORES; i++) begin
             core_start[i] <= 0;
-            core_reset[i] <= 1;
+            core_idle_reset[i] <= 1;
             core_block_id[i] <= 0;
         end
-    end else begin // <<<<<<< CHANGE 1: REMOVE 'if (start)'
+    end else begin
+        data_t dispatched;
+        data_t completed;
+        dispatched = blocks_dispatched;
+        completed = blocks_done;
 
         // This is the trigger logic. It only runs when a new kernel is requested.
         if (start && !start_execution) begin
             $display("Dispatcher: Start execution of %0d block(s)", total_blocks);
             start_execution <= 1;
+            done <= 0;
+            blocks_dispatched <= 0;
+            blocks_done <= 0;
+            core_icache_flush <= 1;
 
             // When a new kernel starts, reset all cores to get them into a ready state.
             for (int i = 0; i < NUM_CORES; i++) begin
-                core_reset[i] <= 1;
+                core_start[i] <= 0;
+                core_idle_reset[i] <= 1;
             end
         end
 
         // This is the main state machine logic. It runs as long as a kernel is active.
-        if (start_execution) begin // <<<<<<< CHANGE 2: GATE LOGIC WITH INTERNAL STATE
+        if (start_execution) begin
+            core_icache_flush <= 0;
 
             // Check for kernel completion FIRST.
             // Check for total_blocks > 0 to prevent finishing on the first cycle for a 0-block kernel.
@@ -68,29 +128,40 @@ always @(posedge clk) begin
                 start_execution <= 0; // Stop the state machine, kernel is finished.
             end
 
-            // Dispatching logic: find a ready core and give it a block.
+            // Completion logic: a finished core either takes the next block right away or goes idle.
+            // A relaunched core is reset on this edge, so its stale done is never counted twice.
             for (int i = 0; i < NUM_CORES; i++) begin
-                if (core_reset[i]) begin
-                    core_reset[i] <= 0;
-                    if (blocks_dispatched < total_blocks) begin
-                        $display("Dispatcher: Dispatching block %d to core %d", blocks_dispatched, i);
-                        core_start[i] <= 1;
-                        core_block_id[i] <= blocks_dispatched;
-                        blocks_dispatched <= blocks_dispatched + 1;
+                if (core_start[i] && core_done[i]) begin
+                    // $display("Dispatcher: Core %d finished block %d", i, core_block_id[i]);
+                    completed = completed + 1;
+
+                    if (core_relaunch[i]) begin
+                        // $display("Dispatcher: Dispatching block %d to core %d", dispatched, i);
+                        core_block_id[i] <= dispatched;
+                        dispatched = dispatched + 1;
+                    end else begin
+                        core_idle_reset[i] <= 1; // Reset the core so it's ready for another block
+                        core_start[i] <= 0;
                     end
                 end
             end
 
-            // Completion logic: check if any running cores have finished their block.
+            // Dispatching logic: give the next blocks to the idle cores.
             for (int i = 0; i < NUM_CORES; i++) begin
-                if (core_start[i] && core_done[i]) begin
-                    $display("Dispatcher: Core %d finished block %d", i, core_block_id[i]);
-                    core_reset[i] <= 1; // Reset the core so it's ready for another block
-                    core_start[i] <= 0;
-                    blocks_done <= blocks_done + 1;
+                if (core_idle_reset[i]) begin
+                    core_idle_reset[i] <= 0;
+                    if (dispatched < total_blocks) begin
+                        // $display("Dispatcher: Dispatching block %d to core %d", dispatched, i);
+                        core_start[i] <= 1;
+                        core_block_id[i] <= dispatched;
+                        dispatched = dispatched + 1;
+                    end
                 end
             end
+
+            blocks_dispatched <= dispatched;
+            blocks_done <= completed;
         end
     end
 end
-endmodule
\ No newline at end of file
+endmodule
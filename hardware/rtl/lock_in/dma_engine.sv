@@ -0,0 +1,244 @@
+
+`timescale 1ns/1ns
+
+`include "common.svh"
+
+// DMA ENGINE
+// > Copies word blocks between DDR and the data memory, next to the cores and independent of kernel execution,
+//   so the host can load the next tile while the current one is being computed
+// > Works through a chain of descriptors in DDR, each one is four words (byte addresses, see code/dma.h):
+//     0: address of the next descriptor, 0 ends the chain
+//     1: DDR address
+//     2: data memory address
+//     3: control, [23:0] number of words, [24] direction (0: DDR to data memory, 1: data memory to DDR),
+//        [25] data memory addresses step by 1 instead of 4 (word addressed data of the assembly kernels)
+// > Same control protocol as a kernel launch: start is level sensitive, the chain at descriptor_address runs
+//   once, done stays high until start is dropped
+// > Both sides use the request protocol of the memory controller channels (valid and address held until
+//   ready). The source and the sink run concurrently through a FIFO_DEPTH word buffer, one word per cycle
+//   when both memories keep up
+module dma_engine #(
+    parameter int FIFO_DEPTH = 8 // Words read ahead of the sink, power of two
+) (
+    input wire clk,
+    input wire reset,
+
+    // Control Registers
+    input wire start,
+    input data_memory_address_t descriptor_address,
+    output logic busy,
+    output logic done,
+    output data_t completed_descriptors,    // Descriptors finished since the last start
+    output data_t transferred_words,        // Words written since the last start
+
+    // DDR (descriptors and the host buffers)
+    output logic ddr_read_valid,
+    output data_memory_address_t ddr_read_address,
+    input wire ddr_read_ready,
+    input data_t ddr_read_data,
+    output logic ddr_write_valid,
+    output data_memory_address_t ddr_write_address,
+    output data_t ddr_write_data,
+    input wire ddr_write_ready,
+
+    // Data Memory
+    output logic mem_read_valid,
+    output data_memory_address_t mem_read_address,
+    input wire mem_read_ready,
+    input data_t mem_read_data,
+    output logic mem_write_valid,
+    output data_memory_address_t mem_write_address,
+    output data_t mem_write_data,
+    input wire mem_write_ready
+);
+    localparam IDLE = 2'b00,
+        FETCH = 2'b01,
+        COPY = 2'b10,
+        NEXT = 2'b11;
+
+    localparam int FIFO_INDEX_WIDTH = (FIFO_DEPTH > 1) ? $clog2(FIFO_DEPTH) : 1;
+
+    localparam int CONTROL_WORDS_WIDTH = 24;
+    localparam int CONTROL_TO_DDR = 24;
+    localparam int CONTROL_WORD_STEP = 25;
+
+    reg [1:0] state;
+
+    // Descriptor being executed
+    data_t descriptor [4];
+    reg [1:0] descriptor_word;
+    logic to_ddr;
+    data_memory_address_t mem_step;
+
+    // Source side: one read outstanding at a time, read_left words not issued yet
+    logic read_valid;
+    data_memory_address_t read_address;
+    logic [CONTROL_WORDS_WIDTH-1:0] read_left;
+
+    // Sink side: write_left words not acknowledged yet
+    logic write_valid;
+    data_memory_address_t write_address;
+    data_t write_data;
+    logic [CONTROL_WORDS_WIDTH-1:0] write_left;
+
+    data_t fifo [FIFO_DEPTH];
+    logic [FIFO_INDEX_WIDTH-1:0] fifo_head, fifo_tail;
+    logic [FIFO_INDEX_WIDTH:0] fifo_count;
+
+    // Descriptors are always read from DDR, the copy reads from the source of the descriptor
+    logic read_from_ddr;
+    logic read_ready;
+    data_t read_data;
+    logic write_ready;
+
+    assign read_from_ddr = (state == FETCH) || !to_ddr;
+    assign read_ready = read_from_ddr ? ddr_read_ready : mem_read_ready;
+    assign read_data = read_from_ddr ? ddr_read_data : mem_read_data;
+    assign write_ready = to_ddr ? ddr_write_ready : mem_write_ready;
+
+    assign ddr_read_valid = read_valid && read_from_ddr;
+    assign ddr_read_address = read_address;
+    assign mem_read_valid = read_valid && !read_from_ddr;
+    assign mem_read_address = read_address;
+
+    assign ddr_write_valid = write_valid && to_ddr;
+    assign ddr_write_address = write_address;
+    assign ddr_write_data = write_data;
+    assign mem_write_valid = write_valid && !to_ddr;
+    assign mem_write_address = write_address;
+    assign mem_write_data = write_data;
+
+    always @(posedge clk) begin
+        if (reset) begin
+            state <= IDLE;
+            busy <= 0;
+            done <= 0;
+            completed_descriptors <= 0;
+            transferred_words <= 0;
+
+            for (int i = 0; i < 4; i++) begin
+                descriptor[i] <= 0;
+            end
+            descriptor_word <= 0;
+            to_ddr <= 0;
+            mem_step <= 4;
+
+            read_valid <= 0;
+            read_address <= 0;
+            read_left <= 0;
+            write_valid <= 0;
+            write_address <= 0;
+            write_data <= 0;
+            write_left <= 0;
+
+            fifo_head <= 0;
+            fifo_tail <= 0;
+            fifo_count <= 0;
+        end else begin
+            case (state)
+                IDLE: begin
+                    if (!start) begin
+                        done <= 0;
+                    end else if (!done) begin
+                        busy <= 1;
+                        completed_descriptors <= 0;
+                        transferred_words <= 0;
+                        descriptor[0] <= descriptor_address;
+                        state <= NEXT;
+                    end
+                end
+                NEXT: begin
+                    // descriptor[0] holds the address of the next descriptor
+                    if (descriptor[0] == 0) begin
+                        busy <= 0;
+                        done <= 1;
+                        state <= IDLE;
+                    end else begin
+                        read_valid <= 1;
+                        read_address <= descriptor[0];
+                        descriptor_word <= 0;
+                        state <= FETCH;
+                    end
+                end
+                FETCH: begin
+                    if (read_valid && read_ready) begin
+                        descriptor[descriptor_word] <= read_data;
+
+                        if (descriptor_word == 3) begin
+                            logic [CONTROL_WORDS_WIDTH-1:0] words;
+                            words = read_data[CONTROL_WORDS_WIDTH-1:0];
+
+                            to_ddr <= read_data[CONTROL_TO_DDR];
+                            mem_step <= read_data[CONTROL_WORD_STEP] ? 1 : 4;
+                            read_valid <= 0;
+                            read_left <= words;
+                            write_left <= words;
+                            fifo_head <= 0;
+                            fifo_tail <= 0;
+                            fifo_count <= 0;
+
+                            // Source and sink addresses are descriptor words 1 and 2, swapped when copying to DDR
+                            read_address <= read_data[CONTROL_TO_DDR] ? descriptor[2] : descriptor[1];
+                            write_address <= read_data[CONTROL_TO_DDR] ? descriptor[1] : descriptor[2];
+
+                            if (words == 0) begin
+                                completed_descriptors <= completed_descriptors + 1;
+                                state <= NEXT;
+                            end else begin
+                                state <= COPY;
+                            end
+                        end else begin
+                            read_address <= read_address + 4;
+                            descriptor_word <= descriptor_word + 1;
+                        end
+                    end
+                end
+                COPY: begin
+                    int count;
+                    logic [CONTROL_WORDS_WIDTH-1:0] next_write_left;
+                    data_memory_address_t read_step, write_step;
+
+                    count = int'(fifo_count);
+                    next_write_left = write_left;
+                    read_step = to_ddr ? mem_step : 4;
+                    write_step = to_ddr ? 4 : mem_step;
+
+                    // Sink: the word on the port is acknowledged, the next one comes from the head of the buffer
+                    if (write_valid && write_ready) begin
+                        write_valid <= 0;
+                        write_address <= write_address + write_step;
+                        next_write_left = next_write_left - 1;
+                        transferred_words <= transferred_words + 1;
+                    end
+                    if ((!write_valid || write_ready) && fifo_count != 0) begin
+                        write_valid <= 1;
+                        write_data <= fifo[fifo_head];
+                        fifo_head <= fifo_head + 1;
+                        count = count - 1;
+                    end
+
+                    // Source: the answer goes to the tail, the next read is issued in the same cycle if it fits
+                    if (read_valid && read_ready) begin
+                        read_valid <= 0;
+                        read_address <= read_address + read_step;
+                        fifo[fifo_tail] <= read_data;
+                        fifo_tail <= fifo_tail + 1;
+                        count = count + 1;
+                    end
+                    if ((!read_valid || read_ready) && read_left != 0 && count < FIFO_DEPTH) begin
+                        read_valid <= 1;
+                        read_left <= read_left - 1;
+                    end
+
+                    fifo_count <= count[FIFO_INDEX_WIDTH:0];
+                    write_left <= next_write_left;
+
+                    if (next_write_left == 0) begin
+                        completed_descriptors <= completed_descriptors + 1;
+                        state <= NEXT;
+                    end
+                end
+            endcase
+        end
+    end
+endmodule
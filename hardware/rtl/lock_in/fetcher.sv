@@ -18,15 +18,25 @@ module fetcher (
 
     // Fetcher output
     output fetcher_state_t fetcher_state,
-    output instruction_t instruction
+    output instruction_t instruction,
+    output instruction_memory_address_t instruction_address     // Address the held instruction was fetched from
 );
 
+// Once the warp has moved past decode the fetcher prefetches the next
+// sequential instruction, so the fetch overlaps with execute. (A warp can sit
+// in request, decoded, while other warps issue, so the held instruction must
+// not change before decode, and only the instruction at pc is prefetched past.)
+// compute_core only consumes the held instruction if instruction_address
+// matches the warp's resolved pc, otherwise (taken branch / jump) it is
+// dropped and the real pc is fetched.
+
 always @(posedge clk) begin
     if (reset) begin
         fetcher_state <= FETCHER_IDLE;
         instruction_mem_read_valid <= 0;
         instruction_mem_read_address <= 0;
         instruction <= {`INSTRUCTION_WIDTH{1'b0}};
+        instruction_address <= 0;
     end else begin
         case (fetcher_state)
             FETCHER_IDLE: begin
@@ -41,11 +51,20 @@ always @(posedge clk) begin
                     fetcher_state <= FETCHER_DONE;
                     instruction_mem_read_valid <= 0;
                     instruction <= instruction_mem_read_data;
+                    instruction_address <= instruction_mem_read_address;
                 end
             end
             FETCHER_DONE: begin
-                if (warp_state == WARP_DECODE) begin
-                    fetcher_state <= FETCHER_IDLE;
+                if (warp_state == WARP_REQUEST && instruction_address == pc) begin
+                    // Prefetch the fall-through instruction
+                    fetcher_state <= FETCHER_FETCHING;
+                    instruction_mem_read_valid <= 1;
+                    instruction_mem_read_address <= instruction_address + 1;
+                end else if (warp_state == WARP_FETCH && instruction_address != pc) begin
+                    // Prefetched the wrong instruction, fetch the real pc
+                    fetcher_state <= FETCHER_FETCHING;
+                    instruction_mem_read_valid <= 1;
+                    instruction_mem_read_address <= pc;
                 end
             end
             default: begin
@@ -17,7 +17,8 @@ module fetcher_wrapper (
     output instruction_memory_address_t instruction_mem_read_address,
 
     output fetcher_state_t fetcher_state,
-    output instruction_t instruction
+    output instruction_t instruction,
+    output instruction_memory_address_t instruction_address
 );
 
     fetcher u_fetcher (
@@ -30,7 +31,8 @@ module fetcher_wrapper (
         .instruction_mem_read_valid(instruction_mem_read_valid),
         .instruction_mem_read_address(instruction_mem_read_address),
         .fetcher_state(fetcher_state),
-        .instruction(instruction)
+        .instruction(instruction),
+        .instruction_address(instruction_address)
     );
 
 endmodule
@@ -3,24 +3,42 @@
 `include "common.svh"
 // =================================================
 // A 32-bit Floating Point ALU
-// with ADD, SUB, MUL, EQ, NEQ, ABS and SLT
+// with ADD, SUB, MUL, EQ, NEQ, ABS, SLT and MIN
+// and fused MADD/MSUB (op1 * op2 +/- op3, rounded once)
+// and the distance ops ABSDIFF |op1 - op2| and SQDIFF (op1 - op2)^2, the difference rounded in Stage 2 and squared in Stage 3
+// and MINIDX, a MIN that reports which operand it picked on less
+// and DIV, correctly rounded, the significands divided by a restoring divider after Stage 2, one
+// quotient bit per cycle. The pipeline takes no new instruction (ready low) until the quotient is in Stage 3
+// and packed bfloat16 ADD, SUB, MUL, SQDIFF, MIN on two values per register, with the
+// float <-> bfloat16 conversions
+// Every instruction is issued with start and carries a tag (the issuing warp) down the
+// pipeline, valid and result_tag come out with its result
 // =================================================
-module floating_alu (
+module floating_alu #(
+    parameter int TAG_WIDTH = 2
+) (
     input   logic       clk,
     input   logic       rst,
+    input   logic       start,  // Issue op1..op3 and instruction this cycle, only while ready
+    output  logic       ready,
+    input   logic [TAG_WIDTH-1:0] tag,
     output   logic       valid,
+    output  logic [TAG_WIDTH-1:0] result_tag,
     input   logic [31:0] op1,
     input   logic [31:0] op2,
+    input   logic [31:0] op3,   // Addend, only used by FMADD/FMSUB
     input   alu_instruction_t instruction,
-    output  logic [31:0] result
+    output  logic [31:0] result,
+    output  logic        less   // op1 < op2 in the last stage, selects the index of FMINIDX
 );
 
 // =====================================================
 // STAGE 1: EXPONENT ALIGNMENT - Pipeline Registers
 // =====================================================
-logic [31:0] s1_op1, s1_op2;
+logic [31:0] s1_op1, s1_op2, s1_op3;
 alu_instruction_t s1_instruction;
 logic s1_valid;
+logic [TAG_WIDTH-1:0] s1_tag, s2_tag, s3_tag, s4_tag;
 
 // Stage 1 decoded signals
 logic s1_op1_sign_bit, s1_op2_sign_bit;
@@ -34,8 +52,8 @@ logic s1_result_sign_bit;
 // =====================================================
 // STAGE 2: MANTISSA OPERATION - Pipeline Registers
 // =====================================================
-logic [31:0] s2_op1, s2_op2;
-logic [31:0] s3_op1, s3_op2;
+logic [31:0] s2_op1, s2_op2, s2_op3;
+logic [31:0] s3_op1, s3_op2, s3_op3;
 logic [31:0] s4_op1, s4_op2;
 alu_instruction_t s2_instruction;
 logic s2_valid;
@@ -52,12 +70,26 @@ logic s2_result_sign_bit;
 // Stage 2 operation results
 logic [24:0] s2_mantissa_result;
 logic [47:0] s2_product;
-logic [47:0] s2_quotient;
 logic [31:0] s2_int_result;
 logic [31:0] s2_abs_op1;
+logic [31:0] s2_difference;         // op1 - op2, rounded, for ABSDIFF/SQDIFF
 logic [7:0] s2_final_exp;
 logic s2_final_sign;
 logic s2_overflow, s2_underflow;
+logic signed [9:0] s2_product_exp;     // Biased exponent of the fused product, can leave the 8-bit range
+logic s2_product_zero;
+
+// Iterative divider, takes an FDIV out of Stage 2 and hands its quotient to Stage 3
+localparam int DIV_STEPS = 27;      // Quotient bits, the top one set when dividend >= divisor
+logic div_busy;
+logic [4:0] div_steps_left;
+logic [24:0] div_remainder;
+logic [23:0] div_divisor;
+logic [26:0] div_quotient;
+logic [TAG_WIDTH-1:0] div_tag;
+logic signed [9:0] div_exp;
+logic div_zero, div_overflow, div_sign;
+logic div_done;
 
 // =====================================================
 // STAGE 3: NORMALIZATION - Pipeline Registers
@@ -70,10 +102,14 @@ logic [24:0] s3_mantissa_result;
 logic [47:0] s3_product;
 logic [47:0] s3_quotient;
 logic [31:0] s3_int_result;
+logic [31:0] s3_difference;         // Rounded op1 - op2, squared in this stage for SQDIFF
+logic [31:0] s3_bf16_square;        // Both rounded bfloat16 differences squared, for SQDIFF_BF2
 logic [31:0] s3_abs_op1;
 logic [7:0] s3_final_exp;
 logic s3_final_sign;
 logic s3_overflow, s3_underflow;
+logic signed [9:0] s3_product_exp;
+logic s3_product_zero;
 
 // Stage 3 normalization results
 logic [23:0] s3_normalized_mantissa;
@@ -94,9 +130,187 @@ logic [7:0] s4_normalized_exp;
 logic s4_normalized_sign;
 logic s4_guard_bit, s4_round_bit, s4_sticky_bit;
 logic s4_round_up;
+logic [31:0] s4_int_result;
 logic [31:0] shifted_mantissa;
 int shift_amount;
 
+// a < b on the raw encodings (+0 and -0 compare equal)
+function automatic logic float_less(input logic [31:0] a, input logic [31:0] b);
+    logic a_sign = a[31];
+    logic b_sign = b[31];
+    logic [30:0] a_mag = a[30:0];
+    logic [30:0] b_mag = b[30:0];
+
+    if ((a_mag == 31'd0) && (b_mag == 31'd0)) begin
+        return 1'b0;
+    end else if (a_sign != b_sign) begin
+        return a_sign;
+    end else if (!a_sign) begin // Both positive
+        return a_mag < b_mag;
+    end else begin // Both negative
+        return a_mag > b_mag;
+    end
+endfunction
+
+// a - b, rounded to nearest even with guard, round and sticky bits (zero for exp == 0, no denormals)
+function automatic logic [31:0] float_sub(input logic [31:0] a, input logic [31:0] b);
+    logic [31:0] big, small;
+    logic big_sign, small_sign;
+    logic [27:0] big_sig, small_sig, sum;   // [27] carry, [26] hidden one, [25:3] fraction, [2:0] guard, round, sticky
+    logic [23:0] mantissa;
+    logic signed [9:0] exp;
+    int shift;
+    int leading_one;
+
+    if (a[30:23] == 8'd0 && b[30:23] == 8'd0) begin
+        return 32'd0;
+    end else if (b[30:23] == 8'd0) begin
+        return a;
+    end else if (a[30:23] == 8'd0) begin
+        return {~b[31], b[30:0]};
+    end
+
+    // a + (-b), larger magnitude first
+    if (a[30:0] >= b[30:0]) begin
+        big = a;
+        big_sign = a[31];
+        small = b;
+        small_sign = ~b[31];
+    end else begin
+        big = b;
+        big_sign = ~b[31];
+        small = a;
+        small_sign = a[31];
+    end
+
+    big_sig = {2'b01, big[22:0], 3'b000};
+    small_sig = {2'b01, small[22:0], 3'b000};
+    shift = int'(big[30:23]) - int'(small[30:23]);
+    if (shift >= 28) begin
+        small_sig = 28'd1;
+    end else begin
+        small_sig = (small_sig >> shift) | {27'd0, |(small_sig << (28 - shift))};
+    end
+
+    sum = (big_sign == small_sign) ? big_sig + small_sig : big_sig - small_sig;
+    if (sum == 28'd0) begin
+        return 32'd0;
+    end
+
+    exp = $signed({2'b00, big[30:23]});
+    if (sum[27]) begin
+        sum = (sum >> 1) | {27'd0, sum[0]};
+        exp = exp + 10'sd1;
+    end else begin
+        leading_one = 0;
+        for (int i = 26; i >= 0; i--) begin
+            if (sum[i]) begin
+                leading_one = i;
+                break;
+            end
+        end
+        sum = sum << (26 - leading_one);
+        exp = exp - 10'(26 - leading_one);
+    end
+
+    mantissa = sum[26:3];
+    if (sum[2] && (sum[1] || sum[0] || sum[3])) begin
+        mantissa = mantissa + 1;
+        if (mantissa == 24'd0) begin
+            mantissa = 24'h800000;
+            exp = exp + 10'sd1;
+        end
+    end
+
+    if (exp <= 0) begin
+        return 32'd0;
+    end else if (exp >= 255) begin
+        return {big_sign, 8'hFF, 23'd0};
+    end
+    return {big_sign, exp[7:0], mantissa[22:0]};
+endfunction
+
+// bfloat16 is the upper half of a float, widening is exact
+function automatic logic [31:0] bf16_to_float(input logic [15:0] h);
+    return {h, 16'd0};
+endfunction
+
+// Rounds a float to bfloat16, to nearest even (zero for exp == 0, NaN stays NaN)
+function automatic logic [15:0] float_to_bf16(input logic [31:0] f);
+    if (f[30:23] == 8'd0) begin
+        return {f[31], 15'd0};
+    end else if (f[30:23] == 8'hFF) begin
+        return {f[31:23], f[22:16] | {f[22:0] != 23'd0, 6'd0}}; // Quiet NaN
+    end
+    // A carry out of the fraction bumps the exponent, up to infinity
+    return f[31:16] + 16'(f[15] && (f[16] || f[14:0] != 15'd0));
+endfunction
+
+// Product of two widened bfloat16 values, exact in single precision (8 x 8 bit significands)
+function automatic logic [31:0] bf16_mul(input logic [31:0] a, input logic [31:0] b);
+    logic sign;
+    logic [15:0] product;
+    logic signed [9:0] exp;
+
+    sign = a[31] ^ b[31];
+    if (a[30:23] == 8'd0 || b[30:23] == 8'd0) begin
+        return {sign, 31'd0};
+    end
+
+    product = {1'b1, a[22:16]} * {1'b1, b[22:16]};
+    exp = $signed({2'b00, a[30:23]}) + $signed({2'b00, b[30:23]}) - 10'sd127;
+    if (product[15]) begin
+        exp = exp + 10'sd1;
+        product = product << 1;
+    end else begin
+        product = product << 2;
+    end
+
+    if (exp <= 0) begin
+        return {sign, 31'd0};
+    end else if (exp >= 255) begin
+        return {sign, 8'hFF, 23'd0};
+    end
+    return {sign, exp[7:0], product, 7'd0};
+endfunction
+
+// Packed bfloat16 op on both halves. Every half is computed in single precision and rounded
+// to bfloat16 once, single precision has enough bits for that double rounding to be exact.
+function automatic logic [31:0] bf16x2(input alu_instruction_t instruction, input logic [31:0] a, input logic [31:0] b);
+    logic [31:0] packed_result;
+    packed_result = 32'd0;
+
+    for (int i = 0; i < 2; i++) begin
+        logic [31:0] x, y, r;
+        x = bf16_to_float(a[16*i +: 16]);
+        y = bf16_to_float(b[16*i +: 16]);
+
+        case (instruction)
+            FADD_BF2: r = float_sub(x, {~y[31], y[30:0]});
+            FSUB_BF2: r = float_sub(x, y);
+            FMUL_BF2: r = bf16_mul(x, y);
+            // The difference is rounded first, like fsqdiff.s, and squared in Stage 3 (bf16x2_square)
+            FSQDIFF_BF2: r = float_sub(x, y);
+            FMIN_BF2: r = float_less(y, x) ? y : x;
+            default: r = 32'd0;
+        endcase
+
+        packed_result[16*i +: 16] = float_to_bf16(r);
+    end
+    return packed_result;
+endfunction
+
+// Squares both bfloat16 halves, the second half of FSQDIFF_BF2
+function automatic logic [31:0] bf16x2_square(input logic [31:0] a);
+    logic [31:0] packed_result;
+    for (int i = 0; i < 2; i++) begin
+        logic [31:0] x;
+        x = bf16_to_float(a[16*i +: 16]);
+        packed_result[16*i +: 16] = float_to_bf16(bf16_mul(x, x));
+    end
+    return packed_result;
+endfunction
+
 // =====================================================
 // STAGE 1: EXPONENT ALIGNMENT
 // =====================================================
@@ -104,13 +318,17 @@ always_ff @(posedge clk) begin
     if (rst) begin
         s1_op1 <= 32'd0;
         s1_op2 <= 32'd0;
+        s1_op3 <= 32'd0;
         s1_instruction <= FADD;
         s1_valid <= 1'b0;
+        s1_tag <= '0;
     end else begin
         s1_op1 <= op1;
         s1_op2 <= op2;
+        s1_op3 <= op3;
         s1_instruction <= instruction;
-        s1_valid <= 1'b1;
+        s1_valid <= start && ready;
+        s1_tag <= tag;
     end
 end
 
@@ -150,8 +368,10 @@ always_ff @(posedge clk) begin
     if (rst) begin
         s2_op1 <= 32'd0;
         s2_op2 <= 32'd0;
+        s2_op3 <= 32'd0;
         s2_instruction <= FADD;
         s2_valid <= 1'b0;
+        s2_tag <= '0;
         s2_op1_sign_bit <= 1'b0;
         s2_op2_sign_bit <= 1'b0;
         s2_op1_biased_exp <= 8'd0;
@@ -165,9 +385,11 @@ always_ff @(posedge clk) begin
     end else begin
         s2_op1 <= s1_op1;
         s2_op2 <= s1_op2;
+        s2_op3 <= s1_op3;
         // $display("s2_instruction: ", s2_instruction);
         s2_instruction <= s1_instruction;
         s2_valid <= s1_valid;
+        s2_tag <= s1_tag;
         s2_op1_sign_bit <= s1_op1_sign_bit;
         s2_op2_sign_bit <= s1_op2_sign_bit;
         s2_op1_biased_exp <= s1_op1_biased_exp;
@@ -185,13 +407,15 @@ always_comb begin
     // Default values
     s2_mantissa_result = 25'd0;
     s2_product = 48'd0;
-    s2_quotient = 48'd0;
     s2_int_result = 32'd0;
     s2_abs_op1 = 32'd0;
     s2_final_exp = 8'd0;
     s2_final_sign = 1'b0;
     s2_overflow = 1'b0;
     s2_underflow = 1'b0;
+    s2_product_exp = 10'sd0;
+    s2_product_zero = 1'b0;
+    s2_difference = 32'd0;
     
     case (s2_instruction)
         FADD, FSUB: begin
@@ -240,6 +464,49 @@ always_comb begin
             s2_final_exp = s2_op1_biased_exp + s2_op2_biased_exp - 8'd127;
             s2_final_sign = s2_op1_sign_bit ^ s2_op2_sign_bit;
         end
+
+        FMADD, FMSUB: begin
+            // Full 48-bit product, kept unrounded for the fused add in Stage 3
+            s2_product = s2_op1_significand * s2_op2_significand;
+            s2_product_exp = $signed({2'b00, s2_op1_biased_exp}) + $signed({2'b00, s2_op2_biased_exp}) - 10'sd127;
+            s2_product_zero = (s2_op1_biased_exp == 8'd0) || (s2_op2_biased_exp == 8'd0);
+            s2_final_sign = s2_op1_sign_bit ^ s2_op2_sign_bit;
+        end
+
+        FDIV: begin
+            // Zero dividend gives zero, a zero divisor infinity (no NaN, like the rest of the FPU)
+            // The significands go to the divider, the exponent and sign wait there with them
+            s2_product_exp = $signed({2'b00, s2_op1_biased_exp}) - $signed({2'b00, s2_op2_biased_exp}) + 10'sd127;
+            s2_product_zero = (s2_op1_biased_exp == 8'd0);
+            s2_overflow = (s2_op2_biased_exp == 8'd0);
+            s2_final_sign = s2_op1_sign_bit ^ s2_op2_sign_bit;
+        end
+
+        FABSDIFF: begin
+            s2_difference = float_sub(s2_op1, s2_op2);
+            s2_int_result = {1'b0, s2_difference[30:0]};
+        end
+
+        FADD_BF2, FSUB_BF2, FMUL_BF2, FSQDIFF_BF2, FMIN_BF2: begin
+            s2_int_result = bf16x2(s2_instruction, s2_op1, s2_op2);
+        end
+
+        FCVT_BF2_S: begin
+            s2_int_result = {float_to_bf16(s2_op2), float_to_bf16(s2_op1)};
+        end
+
+        FCVT_S_BF2_LO: begin
+            s2_int_result = bf16_to_float(s2_op1[15:0]);
+        end
+
+        FCVT_S_BF2_HI: begin
+            s2_int_result = bf16_to_float(s2_op1[31:16]);
+        end
+
+        FSQDIFF: begin
+            // The difference is rounded first, like (op1 - op2) * (op1 - op2) in C, and squared in Stage 3
+            s2_difference = float_sub(s2_op1, s2_op2);
+        end
         
         FCVT_W_S: begin
             logic [7:0] unbiased_exp;
@@ -275,6 +542,49 @@ always_comb begin
     endcase
 end
 
+// =====================================================
+// DIVIDER
+// =====================================================
+// Restoring division of the significands (hidden one set), one quotient bit per cycle. Gives
+// dividend / divisor * 2^26 and a sticky bit for a non-zero remainder. Nothing else is issued while
+// an FDIV is in Stage 1, Stage 2 or the divider, so Stage 2 is empty when the quotient goes to Stage 3.
+assign div_done = div_busy && div_steps_left == 5'd0;
+assign ready = !div_busy && !(s1_valid && s1_instruction == FDIV) && !(s2_valid && s2_instruction == FDIV);
+
+always_ff @(posedge clk) begin
+    if (rst) begin
+        div_busy <= 1'b0;
+        div_steps_left <= 5'd0;
+        div_remainder <= 25'd0;
+        div_divisor <= 24'd0;
+        div_quotient <= 27'd0;
+        div_tag <= '0;
+        div_exp <= 10'sd0;
+        div_zero <= 1'b0;
+        div_overflow <= 1'b0;
+        div_sign <= 1'b0;
+    end else if (s2_valid && s2_instruction == FDIV) begin
+        div_busy <= 1'b1;
+        div_steps_left <= 5'(DIV_STEPS);
+        div_remainder <= {1'b0, s2_op1_significand};
+        div_divisor <= s2_op2_significand;
+        div_quotient <= 27'd0;
+        div_tag <= s2_tag;
+        div_exp <= s2_product_exp;
+        div_zero <= s2_product_zero;
+        div_overflow <= s2_overflow;
+        div_sign <= s2_final_sign;
+    end else if (div_done) begin
+        div_busy <= 1'b0;
+    end else if (div_busy) begin
+        logic quotient_bit;
+        quotient_bit = div_remainder >= {1'b0, div_divisor};
+        div_remainder <= (quotient_bit ? div_remainder - {1'b0, div_divisor} : div_remainder) << 1;
+        div_quotient <= {div_quotient[25:0], quotient_bit};
+        div_steps_left <= div_steps_left - 5'd1;
+    end
+end
+
 // =====================================================
 // STAGE 3: NORMALIZATION
 // =====================================================
@@ -282,10 +592,12 @@ always_ff @(posedge clk) begin
     if (rst) begin
         s3_instruction <= FADD;
         s3_valid <= 1'b0;
+        s3_tag <= '0;
         s3_mantissa_result <= 25'd0;
         s3_product <= 48'd0;
         s3_quotient <= 48'd0;
         s3_int_result <= 32'd0;
+        s3_difference <= 32'd0;
         s3_abs_op1 <= 32'd0;
         s3_final_exp <= 8'd0;
         s3_final_sign <= 1'b0;
@@ -293,20 +605,29 @@ always_ff @(posedge clk) begin
         s3_underflow <= 1'b0;
         s3_op1 <= 32'b0;
         s3_op2 <= 32'b0;
+        s3_op3 <= 32'b0;
+        s3_product_exp <= 10'sd0;
+        s3_product_zero <= 1'b0;
     end else begin
-        s3_instruction <= s2_instruction;
-        s3_valid <= s2_valid;
+        // An FDIV leaves Stage 2 for the divider and comes back here with its quotient
+        s3_instruction <= div_done ? FDIV : s2_instruction;
+        s3_valid <= div_done || (s2_valid && s2_instruction != FDIV);
+        s3_tag <= div_done ? div_tag : s2_tag;
         s3_mantissa_result <= s2_mantissa_result;
         s3_product <= s2_product;
-        s3_quotient <= s2_quotient;
+        s3_quotient <= {20'd0, div_quotient, div_remainder != 25'd0};
         s3_int_result <= s2_int_result;
+        s3_difference <= s2_difference;
         s3_abs_op1 <= s2_abs_op1;
         s3_final_exp <= s2_final_exp;
-        s3_final_sign <= s2_final_sign;
-        s3_overflow <= s2_overflow;
+        s3_final_sign <= div_done ? div_sign : s2_final_sign;
+        s3_overflow <= div_done ? div_overflow : s2_overflow;
         s3_underflow <= s2_underflow;
         s3_op1 <= s2_op1;
         s3_op2 <= s2_op2;
+        s3_op3 <= s2_op3;
+        s3_product_exp <= div_done ? div_exp : s2_product_exp;
+        s3_product_zero <= div_done ? div_zero : s2_product_zero;
     end
 end
 
@@ -381,6 +702,180 @@ always_comb begin
             end
             s3_normalized_sign = s3_final_sign;
         end
+
+        FSQDIFF: begin
+            logic [47:0] square;
+            logic signed [9:0] square_exp;
+            square = {1'b1, s3_difference[22:0]} * {1'b1, s3_difference[22:0]};
+            square_exp = $signed({1'b0, s3_difference[30:23], 1'b0}) - 10'sd127 + (square[47] ? 10'sd1 : 10'sd0);
+
+            if (s3_difference[30:23] == 8'd0 || square_exp <= 0) begin
+                s3_normalized_mantissa = 24'd0;
+                s3_normalized_exp = 8'd0;
+            end else if (square_exp >= 255) begin
+                s3_normalized_mantissa = 24'd0;
+                s3_normalized_exp = 8'hFF;
+            end else if (square[47]) begin
+                s3_normalized_mantissa = square[47:24];
+                s3_normalized_exp = square_exp[7:0];
+                s3_guard_bit = square[23];
+                s3_round_bit = square[22];
+                s3_sticky_bit = |square[21:0];
+            end else begin
+                s3_normalized_mantissa = square[46:23];
+                s3_normalized_exp = square_exp[7:0];
+                s3_guard_bit = square[22];
+                s3_round_bit = square[21];
+                s3_sticky_bit = |square[20:0];
+            end
+            s3_normalized_sign = 1'b0;
+        end
+
+        FDIV: begin
+            logic [26:0] quotient;
+            logic signed [9:0] quotient_exp;
+
+            // The quotient of two significands is in (0.5, 2), one bit lower exponent below 1
+            quotient = s3_quotient[27:1];
+            quotient_exp = s3_product_exp - (quotient[26] ? 10'sd0 : 10'sd1);
+            s3_normalized_sign = s3_final_sign;
+
+            if (s3_product_zero || (!s3_overflow && quotient_exp <= 0)) begin
+                s3_normalized_mantissa = 24'd0;
+                s3_normalized_exp = 8'd0;
+            end else if (s3_overflow || quotient_exp >= 255) begin
+                s3_normalized_mantissa = 24'd0;
+                s3_normalized_exp = 8'hFF;
+            end else if (quotient[26]) begin
+                s3_normalized_mantissa = quotient[26:3];
+                s3_normalized_exp = quotient_exp[7:0];
+                s3_guard_bit = quotient[2];
+                s3_round_bit = quotient[1];
+                s3_sticky_bit = quotient[0] | s3_quotient[0];
+            end else begin
+                s3_normalized_mantissa = quotient[25:2];
+                s3_normalized_exp = quotient_exp[7:0];
+                s3_guard_bit = quotient[1];
+                s3_round_bit = quotient[0];
+                s3_sticky_bit = s3_quotient[0];
+            end
+        end
+
+        FMADD, FMSUB: begin
+            // Fused add of the exact product and the addend, both as 75-bit fixed point
+            // numbers with the binary point at bit 72. The operand with the smaller exponent
+            // is shifted right, the bits shifted out are folded into its LSB (sticky) so that
+            // subtraction and rounding see them.
+            logic addend_sign;
+            logic [74:0] product_aligned, addend_aligned, sum;
+            logic signed [9:0] addend_exp, exp_diff, sum_exp, result_exp;
+            logic sum_sign;
+            logic shifted_sticky;
+            int shift;
+            int leading_one;
+
+            addend_sign = s3_op3[31] ^ (s3_instruction == FMSUB);
+            addend_exp = $signed({2'b00, s3_op3[30:23]});
+            product_aligned = {1'b0, s3_product, 26'd0};
+            addend_aligned = {2'b00, 1'b1, s3_op3[22:0], 49'd0};
+            shifted_sticky = 1'b0;
+            exp_diff = 10'sd0;
+            sum_exp = 10'sd0;
+            result_exp = 10'sd0;
+            sum = 75'd0;
+            sum_sign = 1'b0;
+            shift = 0;
+            leading_one = 0;
+
+            if (s3_product_zero && s3_op3[30:23] == 8'd0) begin
+                s3_normalized_mantissa = 24'd0;
+                s3_normalized_exp = 8'd0;
+                s3_normalized_sign = 1'b0;
+            end else if (s3_product_zero) begin
+                // 0 * x +/- c is exactly +/- c
+                s3_normalized_mantissa = {1'b1, s3_op3[22:0]};
+                s3_normalized_exp = s3_op3[30:23];
+                s3_normalized_sign = addend_sign;
+            end else begin
+                if (s3_op3[30:23] == 8'd0) begin
+                    addend_aligned = 75'd0;
+                    sum_exp = s3_product_exp;
+                end else begin
+                    exp_diff = s3_product_exp - addend_exp;
+                    if (exp_diff >= 0) begin
+                        sum_exp = s3_product_exp;
+                        shift = int'(exp_diff);
+                        if (shift >= 75) begin
+                            shifted_sticky = 1'b1;
+                            addend_aligned = 75'd0;
+                        end else begin
+                            shifted_sticky = |(addend_aligned << (75 - shift));
+                            addend_aligned = addend_aligned >> shift;
+                        end
+                        addend_aligned[0] = addend_aligned[0] | shifted_sticky;
+                    end else begin
+                        sum_exp = addend_exp;
+                        shift = int'(-exp_diff);
+                        if (shift >= 75) begin
+                            shifted_sticky = 1'b1;
+                            product_aligned = 75'd0;
+                        end else begin
+                            shifted_sticky = |(product_aligned << (75 - shift));
+                            product_aligned = product_aligned >> shift;
+                        end
+                        product_aligned[0] = product_aligned[0] | shifted_sticky;
+                    end
+                end
+
+                if (s3_final_sign == addend_sign) begin
+                    sum = product_aligned + addend_aligned;
+                    sum_sign = s3_final_sign;
+                end else if (product_aligned >= addend_aligned) begin
+                    sum = product_aligned - addend_aligned;
+                    sum_sign = s3_final_sign;
+                end else begin
+                    sum = addend_aligned - product_aligned;
+                    sum_sign = addend_sign;
+                end
+
+                if (sum == 75'd0) begin
+                    // Exact cancellation
+                    s3_normalized_mantissa = 24'd0;
+                    s3_normalized_exp = 8'd0;
+                    s3_normalized_sign = 1'b0;
+                end else begin
+                    for (int i = 74; i >= 0; i--) begin
+                        if (sum[i]) begin
+                            leading_one = i;
+                            break;
+                        end
+                    end
+
+                    // Leading one to bit 74: mantissa, guard and round sit right below it
+                    sum = sum << (74 - leading_one);
+                    result_exp = sum_exp + 10'(leading_one - 72);
+
+                    if (result_exp <= 0) begin
+                        // Underflow, no denormals
+                        s3_normalized_mantissa = 24'd0;
+                        s3_normalized_exp = 8'd0;
+                        s3_normalized_sign = 1'b0;
+                    end else if (result_exp >= 255) begin
+                        // Overflow, composed as infinity in Stage 4
+                        s3_normalized_mantissa = 24'd0;
+                        s3_normalized_exp = 8'hFF;
+                        s3_normalized_sign = sum_sign;
+                    end else begin
+                        s3_normalized_mantissa = sum[74:51];
+                        s3_normalized_exp = result_exp[7:0];
+                        s3_normalized_sign = sum_sign;
+                        s3_guard_bit = sum[50];
+                        s3_round_bit = sum[49];
+                        s3_sticky_bit = |sum[48:0];
+                    end
+                end
+            end
+        end
         
         FCVT_S_W: begin
             if (s3_abs_op1 == 32'd0) begin
@@ -430,6 +925,8 @@ always_comb begin
     s3_round_up = s3_guard_bit & (s3_round_bit | s3_sticky_bit | s3_normalized_mantissa[0]);
 end
 
+assign s3_bf16_square = bf16x2_square(s3_int_result);
+
 // =====================================================
 // STAGE 4: RESULT COMPOSITION
 // =====================================================
@@ -437,6 +934,7 @@ always_ff @(posedge clk) begin
     if (rst) begin
         s4_instruction <= FADD;
         s4_valid <= 1'b0;
+        s4_tag <= '0;
         s4_normalized_mantissa <= 24'd0;
         s4_normalized_exp <= 8'd0;
         s4_normalized_sign <= 1'b0;
@@ -446,9 +944,11 @@ always_ff @(posedge clk) begin
         s4_round_up <= 1'b0;
         s4_op1 <= 32'b0;
         s4_op2 <= 32'b0;
+        s4_int_result <= 32'd0;
     end else begin
         s4_instruction <= s3_instruction;
         s4_valid <= s3_valid;
+        s4_tag <= s3_tag;
         s4_normalized_mantissa <= s3_normalized_mantissa;
         s4_normalized_exp <= s3_normalized_exp;
         s4_normalized_sign <= s3_normalized_sign;
@@ -458,6 +958,7 @@ always_ff @(posedge clk) begin
         s4_round_up <= s3_round_up;
         s4_op1 <= s3_op1;
         s4_op2 <= s3_op2;
+        s4_int_result <= (s3_instruction == FSQDIFF_BF2) ? s3_bf16_square : s3_int_result;
     end
 end
 
@@ -465,7 +966,7 @@ end
 always_comb begin
     result = 32'd0;    
     case (s4_instruction)
-        FADD, FSUB, FMUL, FCVT_S_W: begin
+        FADD, FSUB, FMUL, FDIV, FMADD, FMSUB, FSQDIFF, FCVT_S_W: begin
             logic [23:0] final_mantissa;
             logic [7:0] final_exp;
             
@@ -475,8 +976,9 @@ always_comb begin
             // Apply rounding
             if (s4_round_up) begin
                 final_mantissa = final_mantissa + 1;
-                if (final_mantissa[23]) begin
-                    final_mantissa = final_mantissa >> 1;
+                if (final_mantissa == 24'd0) begin
+                    // Carried out of the implicit bit: 1.111..1 rounds up to 10.0
+                    final_mantissa = 24'h800000;
                     final_exp = final_exp + 1;
                 end
             end
@@ -493,8 +995,9 @@ always_comb begin
             //$display("final_exp: %b", final_exp);
         end
         
-        FCVT_W_S: begin
-            result = s3_int_result; // Pass through from stage 3
+        FCVT_W_S, FABSDIFF, FADD_BF2, FSUB_BF2, FMUL_BF2, FSQDIFF_BF2, FMIN_BF2,
+        FCVT_BF2_S, FCVT_S_BF2_LO, FCVT_S_BF2_HI: begin
+            result = s4_int_result; // Computed in stage 2 (SQDIFF_BF2 squared in stage 3)
         end
         
         FNEG: begin
@@ -517,27 +1020,17 @@ always_comb begin
 
         FSLT: begin
             // Compare original operands from stage 2
-            logic a_sign = s4_op1[31];
-            logic b_sign = s4_op2[31];
-            logic [30:0] a_mag = s4_op1[30:0];
-            logic [30:0] b_mag = s4_op2[30:0];
-
-            logic is_less;
-            if (a_sign != b_sign) begin
-                is_less = a_sign; 
-            end else begin
-                if (!a_sign) begin // Both positive
-                    is_less = (a_mag < b_mag);
-                end else begin // Both negative
-                    is_less = (a_mag > b_mag);
-                end
-            end
-            
-            if ((a_mag == 31'd0) && (b_mag == 31'd0)) begin
-                result = 32'd0;
-            end else begin
-                result = is_less ? 32'd1 : 32'd0;
-            end
+            result = float_less(s4_op1, s4_op2) ? 32'd1 : 32'd0;
+        end
+
+        FMIN: begin
+            // op1 unless op2 is strictly smaller
+            result = float_less(s4_op2, s4_op1) ? s4_op2 : s4_op1;
+        end
+
+        FMINIDX: begin
+            // op1 (the candidate) only if strictly smaller, ties keep op2 (the best so far)
+            result = less ? s4_op1 : s4_op2;
         end
         
         default: begin
@@ -547,7 +1040,10 @@ always_comb begin
     //$display("result: %h", result);
 end
 
-// Valid signal follows the pipeline
+assign less = float_less(s4_op1, s4_op2);
+
+// Valid signal follows the pipeline, only issued instructions come out valid
 assign valid = s4_valid;
+assign result_tag = s4_tag;
 
 endmodule
@@ -4,11 +4,15 @@
 `include "common.svh"
 
 module gpu #(
-    parameter int DATA_MEM_NUM_CHANNELS /*verilator public*/ = 8,     // Number of concurrent channels for sending requests to data memory
+    parameter int DATA_MEM_NUM_CHANNELS /*verilator public*/ = 8,     // Number of concurrent channels for sending requests to data memory (split evenly between the cores)
     parameter int INSTRUCTION_MEM_NUM_CHANNELS /*verilator public*/ = 8,     // Number of concurrent channels for sending requests to data memory
     parameter int NUM_CORES /*verilator public*/ = 1,                 // Number of cores to include in this GPU
     parameter int WARPS_PER_CORE /*verilator public*/ = 1,            // Number of warps to in each core
-    parameter int THREADS_PER_WARP /*verilator public*/ = 16          // Number of threads per warp (max 32)
+    parameter int THREADS_PER_WARP /*verilator public*/ = 16,         // Number of threads per warp (max 32)
+    parameter int ICACHE_LINES /*verilator public*/ = 64,             // Number of lines in each core's instruction cache
+    parameter int SCRATCHPAD_WORDS /*verilator public*/ = 256,        // Size of each core's scratchpad in 32-bit words
+    parameter int SCRATCHPAD_BANKS /*verilator public*/ = 16,         // Number of banks in each core's scratchpad
+    parameter int WARP_SCHEDULER /*verilator public*/ = 0             // Warp scheduling policy: 0 = loose round-robin, 1 = greedy-then-oldest, 2 = two-level
 ) (
     input wire clk,
     input wire reset,
@@ -20,6 +24,35 @@ module gpu #(
     input wire execution_start,
     output wire execution_done,
 
+    // Command Queue (launches of the configuration inputs, back to back, see command_queue.sv and code/command_queue.h)
+    input wire queue_push,
+    input wire [`LAUNCH_FLAG_WIDTH-1:0] queue_push_flags,
+    input wire queue_resume,
+    input wire queue_interrupt_clear,
+    output wire queue_full,
+    output wire queue_busy,
+    output wire queue_fenced,
+    output wire queue_interrupt,
+    output data_t queue_count,
+    output data_t queue_completed,
+
+    // Performance Counters (snapshot of the last kernel, indexed by perf_counter_t)
+    input logic [`PERF_COUNTER_ADDRESS_WIDTH-1:0] perf_read_address,
+    output data_t perf_read_data,
+
+    // DMA Engine (control registers, see dma_engine.sv and code/dma.h)
+    input wire dma_start,
+    input data_memory_address_t dma_descriptor_address,
+    output wire dma_busy,
+    output wire dma_done,
+    output data_t dma_completed_descriptors,
+    output data_t dma_transferred_words,
+
+    // Warp Trace (state, PC and execution mask of every warp, core major, for the testbench profiler)
+    output warp_state_t debug_warp_state [NUM_CORES * WARPS_PER_CORE],
+    output instruction_memory_address_t debug_warp_pc [NUM_CORES * WARPS_PER_CORE],
+    output logic [THREADS_PER_WARP-1:0] debug_warp_execution_mask [NUM_CORES * WARPS_PER_CORE],
+
     // kernel configuration
     //input kernel_config_t kernel_config,
 
@@ -37,56 +70,111 @@ module gpu #(
     output wire [DATA_MEM_NUM_CHANNELS-1:0] data_mem_write_valid,
     output data_memory_address_t data_mem_write_address [DATA_MEM_NUM_CHANNELS],
     output data_t data_mem_write_data [DATA_MEM_NUM_CHANNELS],
-    input wire [DATA_MEM_NUM_CHANNELS-1:0] data_mem_write_ready
+    input wire [DATA_MEM_NUM_CHANNELS-1:0] data_mem_write_ready,
+
+    // DDR (DMA descriptors and host buffers)
+    output wire ddr_read_valid,
+    output data_memory_address_t ddr_read_address,
+    input wire ddr_read_ready,
+    input data_t ddr_read_data,
+    output wire ddr_write_valid,
+    output data_memory_address_t ddr_write_address,
+    output data_t ddr_write_data,
+    input wire ddr_write_ready,
+
+    // Data Memory port of the DMA engine (second port of the data memory, runs alongside the cores' channels)
+    output wire dma_mem_read_valid,
+    output data_memory_address_t dma_mem_read_address,
+    input wire dma_mem_read_ready,
+    input data_t dma_mem_read_data,
+    output wire dma_mem_write_valid,
+    output data_memory_address_t dma_mem_write_address,
+    output data_t dma_mem_write_data,
+    input wire dma_mem_write_ready
 );
 
-kernel_config_t kernel_config_reg;
-
-logic start_execution; // EDA: Unimportant hack used because of EDA tooling
+kernel_config_t kernel_config_reg; // Configuration of the running kernel, held by the command queue until the next launch
+
+logic start_execution; // Launch pulse of the command queue, the dispatcher and the counters start on it
+logic dispatcher_done;
+logic queue_busy_internal;
+logic execution_start_seen;
+kernel_config_t push_config;
+
+// A rising edge of execution_start pushes the configuration inputs as one launch without flags, so a host
+// that only knows the start/done registers behaves like before. execution_done waits for the whole queue,
+// it rises on the edge after the last kernel is done, when the queue has counted it
+assign execution_done = dispatcher_done && !queue_busy_internal;
+assign queue_busy = queue_busy_internal;
+
+always_comb begin
+    push_config.base_instructions_address = base_instr;
+    push_config.base_data_address = base_data;
+    push_config.num_blocks = num_blocks;
+    push_config.num_warps_per_block = warps_per_block;
+end
 
-// save kernel config on execution start to avoid losing data when the kernel is running
 always @(posedge clk) begin
     if (reset) begin
-        start_execution <= 1'b0;
-        kernel_config_reg <= '0; // IMPORTANT: Reset the register!
+        execution_start_seen <= 1'b0;
     end else begin
-        // Always latch the inputs into the register on every cycle.
-        // This ensures kernel_config_reg is always up-to-date one cycle after the inputs change.
-        kernel_config_reg.base_instructions_address <= base_instr;
-        kernel_config_reg.base_data_address      <= base_data;
-        kernel_config_reg.num_blocks             <= num_blocks;
-        kernel_config_reg.num_warps_per_block    <= warps_per_block;
-
-        if (execution_start && !start_execution) begin
-            start_execution <= 1'b1;
-            // Now, we display the REGISTERED values, which is what the dispatcher actually sees.
-            $display("GPU: Kernel configuration (latched):");
-            $display("     - Base instruction address: %h", kernel_config_reg.base_instructions_address);
-            $display("     - Base data address: %h", kernel_config_reg.base_data_address);
-            $display("     - Num %d blocks", kernel_config_reg.num_blocks);
-            $display("     - Number of warps per block: %d", kernel_config_reg.num_warps_per_block);
-        end
+        execution_start_seen <= execution_start;
     end
-    //$display("Checking dispatch:", kernel_config_reg.num_blocks);
 end
 
+command_queue #(
+    .DEPTH(8)
+) command_queue_inst (
+    .clk(clk),
+    .reset(reset),
+
+    .push(queue_push || (execution_start && !execution_start_seen)),
+    .push_config(push_config),
+    .push_flags(queue_push ? queue_push_flags : '0),
+    .resume(queue_resume),
+    .interrupt_clear(queue_interrupt_clear),
+    .full(queue_full),
+    .busy(queue_busy_internal),
+    .fenced(queue_fenced),
+    .interrupt(queue_interrupt),
+    .count(queue_count),
+    .completed(queue_completed),
+
+    .launch(start_execution),
+    .launch_config(kernel_config_reg),
+    .dispatcher_done(dispatcher_done)
+);
+
+// always @(posedge clk) begin
+//     if (!reset && start_execution) begin
+//         $display("GPU: Kernel configuration (launched):");
+//         $display("     - Base instruction address: %h", kernel_config_reg.base_instructions_address);
+//         $display("     - Base data address: %h", kernel_config_reg.base_data_address);
+//         $display("     - Num %d blocks", kernel_config_reg.num_blocks);
+//         $display("     - Number of warps per block: %d", kernel_config_reg.num_warps_per_block);
+//     end
+// end
+
 logic [NUM_CORES-1:0] core_done;
 logic [NUM_CORES-1:0] core_start;
 logic [NUM_CORES-1:0] core_reset;
+logic core_icache_flush;
 data_t core_block_id [NUM_CORES];
+logic [NUM_CORES-1:0] core_grid_sync_waiting;
+logic grid_sync_release;
 
 // LSU <> Data Memory Controller Channels
+// Every core has its own data memory controller and an equal share of the DATA_MEM_NUM_CHANNELS channels.
+// The total is fixed, so adding cores splits the same bandwidth: it only saves the LSUs of one core from
+// arbitrating against the other cores. Raise DATA_MEM_NUM_CHANNELS with NUM_CORES for more bandwidth
 localparam int NUM_LSUS_PER_CORE = THREADS_PER_WARP + 1;
-localparam int NUM_LSUS = NUM_CORES * NUM_LSUS_PER_CORE;
-typedef logic [NUM_LSUS-1:0] lsu_size_t;
-lsu_size_t lsu_read_valid;
-lsu_size_t lsu_read_ready;
-lsu_size_t lsu_write_valid;
-lsu_size_t lsu_write_ready;
-data_memory_address_t lsu_read_address [NUM_LSUS];
-data_memory_address_t lsu_write_address [NUM_LSUS];
-data_t lsu_read_data [NUM_LSUS];
-data_t lsu_write_data [NUM_LSUS];
+localparam int DATA_CHANNELS_PER_CORE = DATA_MEM_NUM_CHANNELS / NUM_CORES;
+
+initial begin
+    if (DATA_CHANNELS_PER_CORE * NUM_CORES != DATA_MEM_NUM_CHANNELS || DATA_CHANNELS_PER_CORE == 0) begin
+        $error("DATA_MEM_NUM_CHANNELS (%0d) must be a non-zero multiple of NUM_CORES (%0d)", DATA_MEM_NUM_CHANNELS, NUM_CORES);
+    end
+end
 
 // Fetcher <> Program Memory Controller Channels
 localparam NUM_FETCHERS = NUM_CORES * WARPS_PER_CORE;
@@ -108,44 +196,14 @@ dispatcher #(
     .core_done(core_done),
     .core_start(core_start),
     .core_reset(core_reset),
+    .core_icache_flush(core_icache_flush),
     .core_block_id(core_block_id),
+    .core_grid_sync_waiting(core_grid_sync_waiting),
+    .grid_sync_release(grid_sync_release),
 
-    .done(execution_done)
+    .done(dispatcher_done)
 );
 
-// Data Memory Controller
-mem_controller #(
-    .DATA_WIDTH(`DATA_WIDTH),
-    .ADDRESS_WIDTH(`DATA_MEMORY_ADDRESS_WIDTH),
-    .NUM_CONSUMERS(NUM_LSUS),
-    .NUM_CHANNELS(DATA_MEM_NUM_CHANNELS)
-    ) data_memory_controller (
-        .clk(clk),
-        .reset(reset),
-
-        .consumer_read_valid(lsu_read_valid),
-        .consumer_read_address(lsu_read_address),
-        .consumer_read_ready(lsu_read_ready),
-        .consumer_read_data(lsu_read_data),
-
-        .consumer_write_valid(lsu_write_valid),
-        .consumer_write_address(lsu_write_address),
-        .consumer_write_data(lsu_write_data),
-        .consumer_write_ready(lsu_write_ready),
-
-        .mem_read_valid(data_mem_read_valid),
-        .mem_read_address(data_mem_read_address),
-        .mem_read_ready(data_mem_read_ready),
-        .mem_read_data(data_mem_read_data),
-
-        .mem_write_valid(data_mem_write_valid),
-        .mem_write_address(data_mem_write_address),
-        .mem_write_data(data_mem_write_data),
-        .mem_write_ready(data_mem_write_ready)
-    );
-
-
-
 // Instruction Memory Controller
 
 // Disconnected write wires
@@ -194,6 +252,89 @@ initial begin
     $display("Hello, World!");
 end
 
+// Performance Counters
+data_t core_counters [NUM_CORES][`PERF_NUM_COUNTERS];
+
+perf_counters #(
+    .NUM_CORES(NUM_CORES)
+) perf_counters_inst (
+    .clk(clk),
+    .reset(reset),
+
+    .start(start_execution),
+    .done(dispatcher_done),
+
+    .mem_busy((|data_mem_read_valid) || (|data_mem_write_valid)),
+    .core_block_done(core_start & core_done),
+    .core_counters(core_counters),
+
+    .read_address(perf_read_address),
+    .read_data(perf_read_data)
+);
+
+// DMA Engine
+// > Not tied to the dispatcher: a chain can run while a kernel executes, to load the next tile of data
+dma_engine dma_engine_inst (
+    .clk(clk),
+    .reset(reset),
+
+    .start(dma_start),
+    .descriptor_address(dma_descriptor_address),
+    .busy(dma_busy),
+    .done(dma_done),
+    .completed_descriptors(dma_completed_descriptors),
+    .transferred_words(dma_transferred_words),
+
+    .ddr_read_valid(ddr_read_valid),
+    .ddr_read_address(ddr_read_address),
+    .ddr_read_ready(ddr_read_ready),
+    .ddr_read_data(ddr_read_data),
+    .ddr_write_valid(ddr_write_valid),
+    .ddr_write_address(ddr_write_address),
+    .ddr_write_data(ddr_write_data),
+    .ddr_write_ready(ddr_write_ready),
+
+    .mem_read_valid(dma_mem_read_valid),
+    .mem_read_address(dma_mem_read_address),
+    .mem_read_ready(dma_mem_read_ready),
+    .mem_read_data(dma_mem_read_data),
+    .mem_write_valid(dma_mem_write_valid),
+    .mem_write_address(dma_mem_write_address),
+    .mem_write_data(dma_mem_write_data),
+    .mem_write_ready(dma_mem_write_ready)
+);
+
+`ifdef TRACE_RETIRE
+// RETIRE TRACE
+// > Simulation only: build with verilator +define+TRACE_RETIRE and run with +trace=<file>, every core appends
+//   its retired instructions to the same binary file (format in hardware/tb/tools/trace_format.h)
+// > The cycle count starts at reset and is shared by the cores, so the records of all cores line up
+int trace_fd;
+data_t trace_cycle;
+string trace_file;
+
+initial begin
+    trace_fd = 0;
+    if ($value$plusargs("trace=%s", trace_file)) begin
+        trace_fd = $fopen(trace_file, "wb");
+    end
+end
+
+final begin
+    if (trace_fd != 0) begin
+        $fclose(trace_fd);
+    end
+end
+
+always @(posedge clk) begin
+    if (reset) begin
+        trace_cycle <= 0;
+    end else begin
+        trace_cycle <= trace_cycle + 1;
+    end
+end
+`endif
+
 // Compute Cores
 generate
     for (genvar i = 0; i < NUM_CORES; i = i + 1) begin : g_cores
@@ -208,36 +349,125 @@ generate
         data_t core_lsu_write_data [NUM_LSUS_PER_CORE];
         logic [NUM_LSUS_PER_CORE-1:0] core_lsu_write_ready;
 
+        // LSU side of this core's data memory controller
+        logic [NUM_LSUS_PER_CORE-1:0] lsu_read_valid;
+        data_memory_address_t lsu_read_address [NUM_LSUS_PER_CORE];
+        logic [NUM_LSUS_PER_CORE-1:0] lsu_read_ready;
+        data_t lsu_read_data [NUM_LSUS_PER_CORE];
+        logic [NUM_LSUS_PER_CORE-1:0] lsu_write_valid;
+        data_memory_address_t lsu_write_address [NUM_LSUS_PER_CORE];
+        data_t lsu_write_data [NUM_LSUS_PER_CORE];
+        logic [NUM_LSUS_PER_CORE-1:0] lsu_write_ready;
+
         // Pass through signals between LSUs and data memory controller
         genvar j;
         for (j = 0; j < NUM_LSUS_PER_CORE; j = j + 1) begin : g_lsu_connect
-            localparam lsu_index = i * NUM_LSUS_PER_CORE + j;
             always @(posedge clk) begin
-                lsu_read_valid[lsu_index] <= core_lsu_read_valid[j];
-                lsu_read_address[lsu_index] <= core_lsu_read_address[j];
+                lsu_read_valid[j] <= core_lsu_read_valid[j];
+                lsu_read_address[j] <= core_lsu_read_address[j];
 
-                lsu_write_valid[lsu_index] <= core_lsu_write_valid[j];
-                lsu_write_address[lsu_index] <= core_lsu_write_address[j];
-                lsu_write_data[lsu_index] <= core_lsu_write_data[j];
+                lsu_write_valid[j] <= core_lsu_write_valid[j];
+                lsu_write_address[j] <= core_lsu_write_address[j];
+                lsu_write_data[j] <= core_lsu_write_data[j];
 
-                core_lsu_read_ready[j] <= lsu_read_ready[lsu_index];
-                core_lsu_read_data[j] <= lsu_read_data[lsu_index];
-                core_lsu_write_ready[j] <= lsu_write_ready[lsu_index];
+                core_lsu_read_ready[j] <= lsu_read_ready[j];
+                core_lsu_read_data[j] <= lsu_read_data[j];
+                core_lsu_write_ready[j] <= lsu_write_ready[j];
             end
         end
 
+        localparam data_channel_index = i * DATA_CHANNELS_PER_CORE;
+
+        // Data Memory Controller (private to this core)
+        mem_controller #(
+            .DATA_WIDTH(`DATA_WIDTH),
+            .ADDRESS_WIDTH(`DATA_MEMORY_ADDRESS_WIDTH),
+            .NUM_CONSUMERS(NUM_LSUS_PER_CORE),
+            .NUM_CHANNELS(DATA_CHANNELS_PER_CORE)
+        ) data_memory_controller (
+            .clk(clk),
+            .reset(reset),
+
+            .consumer_read_valid(lsu_read_valid),
+            .consumer_read_address(lsu_read_address),
+            .consumer_read_ready(lsu_read_ready),
+            .consumer_read_data(lsu_read_data),
+
+            .consumer_write_valid(lsu_write_valid),
+            .consumer_write_address(lsu_write_address),
+            .consumer_write_data(lsu_write_data),
+            .consumer_write_ready(lsu_write_ready),
+
+            .mem_read_valid(data_mem_read_valid[data_channel_index +: DATA_CHANNELS_PER_CORE]),
+            .mem_read_address(data_mem_read_address[data_channel_index +: DATA_CHANNELS_PER_CORE]),
+            .mem_read_ready(data_mem_read_ready[data_channel_index +: DATA_CHANNELS_PER_CORE]),
+            .mem_read_data(data_mem_read_data[data_channel_index +: DATA_CHANNELS_PER_CORE]),
+
+            .mem_write_valid(data_mem_write_valid[data_channel_index +: DATA_CHANNELS_PER_CORE]),
+            .mem_write_address(data_mem_write_address[data_channel_index +: DATA_CHANNELS_PER_CORE]),
+            .mem_write_data(data_mem_write_data[data_channel_index +: DATA_CHANNELS_PER_CORE]),
+            .mem_write_ready(data_mem_write_ready[data_channel_index +: DATA_CHANNELS_PER_CORE])
+        );
+
         localparam fetcher_index = i * WARPS_PER_CORE;
 
+        // Core counters, gathered in the counter block's layout
+        data_t icache_hits, icache_misses;
+        data_t coalescer_lane_requests, coalescer_mem_transactions;
+        data_t scratchpad_accesses, scratchpad_bank_conflicts;
+        data_t warp_issue_cycles [WARPS_PER_CORE];
+        data_t warp_stall_cycles [WARPS_PER_CORE];
+        data_t warp_idle_cycles [WARPS_PER_CORE];
+        data_t warp_state_cycles [`NUM_WARP_STATES];
+        data_t instructions_scalar, instructions_vector, instructions_fpu, instructions_memory;
+        data_t active_lanes, lsu_wait_cycles;
+        data_t counters [`PERF_NUM_COUNTERS];
+
+        always_comb begin
+            for (int k = 0; k < `PERF_NUM_COUNTERS; k++) begin
+                counters[k] = 0;
+            end
+            counters[PERF_INSTRUCTIONS_SCALAR] = instructions_scalar;
+            counters[PERF_INSTRUCTIONS_VECTOR] = instructions_vector;
+            counters[PERF_INSTRUCTIONS_FPU] = instructions_fpu;
+            counters[PERF_INSTRUCTIONS_MEMORY] = instructions_memory;
+            counters[PERF_ACTIVE_LANES] = active_lanes;
+            counters[PERF_LSU_WAIT_CYCLES] = lsu_wait_cycles;
+            counters[PERF_ICACHE_HITS] = icache_hits;
+            counters[PERF_ICACHE_MISSES] = icache_misses;
+            counters[PERF_COALESCER_LANE_REQUESTS] = coalescer_lane_requests;
+            counters[PERF_COALESCER_MEM_TRANSACTIONS] = coalescer_mem_transactions;
+            counters[PERF_SCRATCHPAD_ACCESSES] = scratchpad_accesses;
+            counters[PERF_SCRATCHPAD_BANK_CONFLICTS] = scratchpad_bank_conflicts;
+            for (int w = 0; w < WARPS_PER_CORE; w++) begin
+                counters[PERF_WARP_ISSUE_CYCLES] = counters[PERF_WARP_ISSUE_CYCLES] + warp_issue_cycles[w];
+                counters[PERF_WARP_STALL_CYCLES] = counters[PERF_WARP_STALL_CYCLES] + warp_stall_cycles[w];
+                counters[PERF_WARP_IDLE_CYCLES] = counters[PERF_WARP_IDLE_CYCLES] + warp_idle_cycles[w];
+            end
+            for (int s = 0; s < `NUM_WARP_STATES; s++) begin
+                counters[int'(PERF_WARP_STATE_CYCLES) + s] = warp_state_cycles[s];
+            end
+        end
+
+        assign core_counters[i] = counters;
+
         // Compute Core
         compute_core #(
             .WARPS_PER_CORE(WARPS_PER_CORE),
-            .THREADS_PER_WARP(THREADS_PER_WARP)
+            .THREADS_PER_WARP(THREADS_PER_WARP),
+            .ICACHE_LINES(ICACHE_LINES),
+            .SCRATCHPAD_WORDS(SCRATCHPAD_WORDS),
+            .SCRATCHPAD_BANKS(SCRATCHPAD_BANKS),
+            .WARP_SCHEDULER(WARP_SCHEDULER)
         ) core_instance (
             .clk(clk),
             .reset(core_reset[i]),
+            .icache_flush(core_icache_flush),
 
             .start(core_start[i]),
             .done(core_done[i]),
+            .grid_sync_waiting(core_grid_sync_waiting[i]),
+            .grid_sync_release(grid_sync_release),
 
             .block_id(core_block_id[i]),
             .kernel_config(kernel_config_reg),
@@ -247,6 +477,32 @@ generate
             .instruction_mem_read_ready(fetcher_read_ready[fetcher_index +: WARPS_PER_CORE]),
             .instruction_mem_read_data(fetcher_read_data[fetcher_index +: WARPS_PER_CORE]),
 
+            .icache_hits(icache_hits),
+            .icache_misses(icache_misses),
+            .coalescer_lane_requests(coalescer_lane_requests),
+            .coalescer_mem_transactions(coalescer_mem_transactions),
+            .scratchpad_accesses(scratchpad_accesses),
+            .scratchpad_bank_conflicts(scratchpad_bank_conflicts),
+            .warp_issue_cycles(warp_issue_cycles),
+            .warp_stall_cycles(warp_stall_cycles),
+            .warp_idle_cycles(warp_idle_cycles),
+            .warp_state_cycles(warp_state_cycles),
+            .instructions_scalar(instructions_scalar),
+            .instructions_vector(instructions_vector),
+            .instructions_fpu(instructions_fpu),
+            .instructions_memory(instructions_memory),
+            .active_lanes(active_lanes),
+            .lsu_wait_cycles(lsu_wait_cycles),
+
+            .debug_warp_state(debug_warp_state[fetcher_index +: WARPS_PER_CORE]),
+            .debug_warp_pc(debug_warp_pc[fetcher_index +: WARPS_PER_CORE]),
+            .debug_warp_execution_mask(debug_warp_execution_mask[fetcher_index +: WARPS_PER_CORE]),
+`ifdef TRACE_RETIRE
+            .trace_fd(trace_fd),
+            .trace_cycle(trace_cycle),
+            .trace_core_id(i),
+`endif
+
             .data_mem_read_valid(core_lsu_read_valid),
             .data_mem_read_address(core_lsu_read_address),
             .data_mem_read_ready(core_lsu_read_ready),
@@ -0,0 +1,125 @@
+
+`timescale 1ns/1ns
+
+`include "common.svh"
+
+// Direct mapped instruction cache shared by the fetchers of one core.
+// Every warp of a block runs the same kernel, so once one warp has missed on a
+// pc the others hit on it. Hits are answered from the core, misses are sent out
+// on the requesting fetcher's own memory port and the returned instruction is
+// written into the cache.
+// The lines survive a reset so the blocks of one kernel run warm on the same
+// core, flush invalidates them when a new kernel is launched.
+
+module instruction_cache #(
+    parameter int NUM_CONSUMERS = 4,    // Number of fetchers sharing the cache (one per warp)
+    parameter int CACHE_LINES = 64      // Number of lines, one instruction per line (power of 2)
+) (
+    input wire clk,
+    input wire reset,
+    input wire flush,                   // Invalidate every line (new kernel)
+
+    // Consumer Interface (Fetchers)
+    input logic [NUM_CONSUMERS-1:0] consumer_read_valid,
+    input instruction_memory_address_t consumer_read_address [NUM_CONSUMERS],
+    output logic [NUM_CONSUMERS-1:0] consumer_read_ready,
+    output instruction_t consumer_read_data [NUM_CONSUMERS],
+
+    // Memory Interface (Program), only used on a miss
+    output logic [NUM_CONSUMERS-1:0] mem_read_valid,
+    output instruction_memory_address_t mem_read_address [NUM_CONSUMERS],
+    input logic [NUM_CONSUMERS-1:0] mem_read_ready,
+    input instruction_t mem_read_data [NUM_CONSUMERS],
+
+    // Performance counters
+    output data_t hit_count,
+    output data_t miss_count
+);
+    localparam IDLE = 2'b00,
+        MISS_WAITING = 2'b01,
+        RELAYING = 2'b10;
+
+    instruction_t cache_data [CACHE_LINES];
+    instruction_memory_address_t cache_tag [CACHE_LINES];
+    logic [CACHE_LINES-1:0] cache_valid;
+
+    reg [1:0] cache_state [NUM_CONSUMERS];
+
+    always @(posedge clk) begin
+        if (reset) begin
+            for (int i = 0; i < NUM_CONSUMERS; i++) begin
+                consumer_read_ready[i] <= 0;
+                consumer_read_data[i] <= 0;
+                mem_read_valid[i] <= 0;
+                mem_read_address[i] <= 0;
+                cache_state[i] <= IDLE;
+            end
+            hit_count <= 0;
+            miss_count <= 0;
+        end else begin
+            int hits;
+            int misses;
+            hits = 0;
+            misses = 0;
+
+            // Each fetcher is served independently, they only share the cache lines
+            for (int i = 0; i < NUM_CONSUMERS; i = i + 1) begin
+                case (cache_state[i])
+                    IDLE: begin
+                        if (consumer_read_valid[i]) begin
+                            int line;
+                            line = consumer_read_address[i] % CACHE_LINES;
+
+                            if (cache_valid[line] && cache_tag[line] == consumer_read_address[i] / CACHE_LINES) begin
+                                consumer_read_ready[i] <= 1;
+                                consumer_read_data[i] <= cache_data[line];
+                                cache_state[i] <= RELAYING;
+                                hits = hits + 1;
+                            end else begin
+                                mem_read_valid[i] <= 1;
+                                mem_read_address[i] <= consumer_read_address[i];
+                                cache_state[i] <= MISS_WAITING;
+                                misses = misses + 1;
+                            end
+                        end
+                    end
+                    MISS_WAITING: begin
+                        // Wait for the refill, then fill the line and pass it on
+                        if (mem_read_ready[i]) begin
+                            int line;
+                            line = mem_read_address[i] % CACHE_LINES;
+
+                            mem_read_valid[i] <= 0;
+                            cache_data[line] <= mem_read_data[i];
+                            cache_tag[line] <= mem_read_address[i] / CACHE_LINES;
+                            cache_valid[line] <= 1;
+
+                            consumer_read_ready[i] <= 1;
+                            consumer_read_data[i] <= mem_read_data[i];
+                            cache_state[i] <= RELAYING;
+                        end
+                    end
+                    // Wait until the fetcher acknowledges it received the instruction, then reset
+                    RELAYING: begin
+                        if (!consumer_read_valid[i]) begin
+                            consumer_read_ready[i] <= 0;
+                            cache_state[i] <= IDLE;
+                        end
+                    end
+                    default: begin
+                        // Should never reach this state
+                        $error("Invalid state %d for fetcher %d", cache_state[i], i);
+                        cache_state[i] <= IDLE;
+                    end
+                endcase
+            end
+
+            hit_count <= hit_count + hits;
+            miss_count <= miss_count + misses;
+        end
+
+        if (flush) begin
+            cache_valid <= 0;
+        end
+    end
+endmodule
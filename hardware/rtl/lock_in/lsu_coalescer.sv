@@ -0,0 +1,116 @@
+
+`timescale 1ns/1ns
+
+`include "common.svh"
+
+// LSU COALESCER
+// > Sits between the vector LSUs of a core and the data memory controller
+// > All lanes of a warp issue their request in the same cycle, lanes of the same
+//   instruction that hit the same address are merged into a single transaction
+// > Loads: the lowest lane issues the read, the other lanes get its ready/data
+// > Stores: the highest lane issues the write (same result as the lanes writing in order)
+// > The memory interface is one word per channel, so lanes at contiguous (but
+//   different) addresses still go out as separate transactions on their own ports
+module lsu_coalescer #(
+    parameter int NUM_LANES = 16
+) (
+    input wire clk,
+    input wire reset,
+
+    // Lane Interface (vector LSUs)
+    input logic [NUM_LANES-1:0] lane_read_valid,
+    input data_memory_address_t lane_read_address [NUM_LANES],
+    output logic [NUM_LANES-1:0] lane_read_ready,
+    output data_t lane_read_data [NUM_LANES],
+    input logic [NUM_LANES-1:0] lane_write_valid,
+    input data_memory_address_t lane_write_address [NUM_LANES],
+    input data_t lane_write_data [NUM_LANES],
+    output logic [NUM_LANES-1:0] lane_write_ready,
+
+    // Memory Interface (one port per lane, only the merged requests are issued)
+    output logic [NUM_LANES-1:0] mem_read_valid,
+    output data_memory_address_t mem_read_address [NUM_LANES],
+    input logic [NUM_LANES-1:0] mem_read_ready,
+    input data_t mem_read_data [NUM_LANES],
+    output logic [NUM_LANES-1:0] mem_write_valid,
+    output data_memory_address_t mem_write_address [NUM_LANES],
+    output data_t mem_write_data [NUM_LANES],
+    input logic [NUM_LANES-1:0] mem_write_ready,
+
+    // Coalescing efficiency = lane_requests / mem_transactions
+    output data_t lane_requests,
+    output data_t mem_transactions
+);
+    localparam int LANE_INDEX_WIDTH = (NUM_LANES > 1) ? $clog2(NUM_LANES) : 1;
+
+    // Lane whose transaction each lane shares (itself if it issues its own)
+    logic [LANE_INDEX_WIDTH-1:0] read_leader [NUM_LANES];
+    logic [LANE_INDEX_WIDTH-1:0] write_leader [NUM_LANES];
+
+    always_comb begin
+        for (int i = 0; i < NUM_LANES; i++) begin
+            read_leader[i] = i[LANE_INDEX_WIDTH-1:0];
+            for (int j = 0; j < i; j++) begin
+                if (lane_read_valid[j] && lane_read_address[j] == lane_read_address[i]) begin
+                    read_leader[i] = j[LANE_INDEX_WIDTH-1:0];
+                    break;
+                end
+            end
+
+            write_leader[i] = i[LANE_INDEX_WIDTH-1:0];
+            for (int j = NUM_LANES - 1; j > i; j--) begin
+                if (lane_write_valid[j] && lane_write_address[j] == lane_write_address[i]) begin
+                    write_leader[i] = j[LANE_INDEX_WIDTH-1:0];
+                    break;
+                end
+            end
+        end
+    end
+
+    generate
+    for (genvar i = 0; i < NUM_LANES; i++) begin: g_lane
+        assign mem_read_valid[i] = lane_read_valid[i] && (read_leader[i] == i);
+        assign mem_read_address[i] = lane_read_address[i];
+        assign lane_read_ready[i] = mem_read_ready[read_leader[i]];
+        assign lane_read_data[i] = mem_read_data[read_leader[i]];
+
+        assign mem_write_valid[i] = lane_write_valid[i] && (write_leader[i] == i);
+        assign mem_write_address[i] = lane_write_address[i];
+        assign mem_write_data[i] = lane_write_data[i];
+        assign lane_write_ready[i] = mem_write_ready[write_leader[i]];
+    end
+    endgenerate
+
+    // Count requests as they are raised
+    logic [NUM_LANES-1:0] prev_lane_read_valid;
+    logic [NUM_LANES-1:0] prev_lane_write_valid;
+
+    always @(posedge clk) begin
+        if (reset) begin
+            prev_lane_read_valid <= 0;
+            prev_lane_write_valid <= 0;
+            lane_requests <= 0;
+            mem_transactions <= 0;
+        end else begin
+            int requests;
+            int transactions;
+            requests = 0;
+            transactions = 0;
+            for (int i = 0; i < NUM_LANES; i++) begin
+                if (lane_read_valid[i] && !prev_lane_read_valid[i]) begin
+                    requests = requests + 1;
+                    if (mem_read_valid[i]) transactions = transactions + 1;
+                end
+                if (lane_write_valid[i] && !prev_lane_write_valid[i]) begin
+                    requests = requests + 1;
+                    if (mem_write_valid[i]) transactions = transactions + 1;
+                end
+            end
+            lane_requests <= lane_requests + requests;
+            mem_transactions <= mem_transactions + transactions;
+
+            prev_lane_read_valid <= lane_read_valid;
+            prev_lane_write_valid <= lane_write_valid;
+        end
+    end
+endmodule
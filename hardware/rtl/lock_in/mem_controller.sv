@@ -1,12 +1,20 @@
 
 `timescale 1ns/1ns
 
+// MEMORY CONTROLLER
+// > Arbitrates the requests of many consumers onto a smaller number of memory channels
+// > Consumers are picked round-robin, so no consumer can be starved by a lower index
+// > A channel is freed as soon as memory answers: the response is tagged with the consumer
+//   it belongs to and held on that consumer's ready/data until it drops valid, while the
+//   channel issues the next pending request in the same cycle
+// > Per-consumer latency histograms (cycles from valid to ready, log2 buckets) for simulation
 module mem_controller #(
     parameter int DATA_WIDTH = 32,
     parameter int ADDRESS_WIDTH = 16,
     parameter int NUM_CONSUMERS = 4, // The number of consumers accessing memory through this controller
     parameter int NUM_CHANNELS = 2,  // The number of concurrent channels available to send requests to global memory
-    parameter int WRITE_ENABLE = 1   // Whether this memory controller can write to memory (program memory is read-only)
+    parameter int WRITE_ENABLE = 1,  // Whether this memory controller can write to memory (program memory is read-only)
+    parameter int LATENCY_BUCKETS = 8 // Bucket i counts requests that took [2^i, 2^(i+1)) cycles, the last bucket saturates
 ) (
     input wire clk,
     input wire reset,
@@ -29,18 +37,28 @@ module mem_controller #(
     output reg [NUM_CHANNELS-1:0] mem_write_valid,
     output reg [ADDRESS_WIDTH-1:0] mem_write_address [NUM_CHANNELS],
     output reg [DATA_WIDTH-1:0] mem_write_data [NUM_CHANNELS],
-    input reg [NUM_CHANNELS-1:0] mem_write_ready
+    input reg [NUM_CHANNELS-1:0] mem_write_ready,
+
+    // Latency histograms
+    output reg [31:0] latency_histogram [NUM_CONSUMERS][LATENCY_BUCKETS]
 );
     localparam IDLE = 3'b000,
         READ_WAITING = 3'b010,
-        WRITE_WAITING = 3'b011,
-        READ_RELAYING = 3'b100,
-        WRITE_RELAYING = 3'b101;
+        WRITE_WAITING = 3'b011;
+
+    localparam int CONSUMER_INDEX_WIDTH = (NUM_CONSUMERS > 1) ? $clog2(NUM_CONSUMERS) : 1;
 
-    // Keep track of state for each channel and which jobs each channel is handling
+    // Keep track of state for each channel and which consumer (tag) its outstanding request belongs to
     reg [2:0] controller_state [NUM_CHANNELS];
-    reg [$clog2(NUM_CONSUMERS)-1:0] current_consumer [NUM_CHANNELS]; // Which consumer is each channel currently serving
-    reg [NUM_CONSUMERS-1:0] channel_serving_consumer; // Which channels are being served? Prevents many workers from picking up the same request.
+    reg [CONSUMER_INDEX_WIDTH-1:0] current_consumer [NUM_CHANNELS];
+
+    // Which consumer requests have been picked up and not yet acknowledged? Prevents many channels from picking up the same request.
+    // Reads and writes are tracked separately so one channel never blocks the other direction of the same consumer.
+    reg [NUM_CONSUMERS-1:0] read_claimed;
+    reg [NUM_CONSUMERS-1:0] write_claimed;
+
+    // Round-robin pointer: the consumer after the last one granted is looked at first
+    reg [CONSUMER_INDEX_WIDTH-1:0] arbiter_priority;
 
     always @(posedge clk) begin
         if (reset) begin
@@ -48,83 +66,69 @@ module mem_controller #(
             for (int i = 0; i < NUM_CONSUMERS; i++) begin
                 consumer_read_ready[i] <= 0;
                 consumer_write_ready[i] <= 0;
-                consumer_read_data[i] = 0;
+                consumer_read_data[i] <= 0;
             end
 
             for (int i = 0; i < NUM_CHANNELS; i++) begin
                 mem_read_valid[i] <= 0;
-
                 mem_write_valid[i] <= 0;
 
                 current_consumer[i] <= 0;
-                controller_state[i] <= 0;
+                controller_state[i] <= IDLE;
                 mem_read_address[i] <= 0;
-                mem_write_address[i] = 0;
-                mem_write_data[i] = 0;
+                mem_write_address[i] <= 0;
+                mem_write_data[i] <= 0;
             end
 
-            channel_serving_consumer <= 0;
+            read_claimed <= 0;
+            write_claimed <= 0;
+            arbiter_priority <= 0;
         end else begin
+            reg [NUM_CONSUMERS-1:0] next_read_claimed;
+            reg [NUM_CONSUMERS-1:0] next_write_claimed;
+            int next_priority;
+
+            next_read_claimed = read_claimed;
+            next_write_claimed = write_claimed;
+            next_priority = int'(arbiter_priority);
+
+            // Consumers acknowledge their response by dropping valid, which frees the request slot
+            for (int j = 0; j < NUM_CONSUMERS; j = j + 1) begin
+                if (consumer_read_ready[j] && !consumer_read_valid[j]) begin
+                    consumer_read_ready[j] <= 0;
+                    next_read_claimed[j] = 0;
+                end
+                if (consumer_write_ready[j] && !consumer_write_valid[j]) begin
+                    consumer_write_ready[j] <= 0;
+                    next_write_claimed[j] = 0;
+                end
+            end
+
             // For each channel, we handle processing concurrently
             for (int i = 0; i < NUM_CHANNELS; i = i + 1) begin
+                logic channel_free;
+                channel_free = 0;
+
                 case (controller_state[i])
                     IDLE: begin
-                        // While this channel is idle, cycle through consumers looking for one with a pending request
-                        for (int j = 0; j < NUM_CONSUMERS; j = j + 1) begin
-                            if (consumer_read_valid[j] && !channel_serving_consumer[j]) begin
-                                channel_serving_consumer[j] <= 1;
-                                current_consumer[i] = j[$clog2(NUM_CONSUMERS)-1:0];
-
-                                mem_read_valid[i] <= 1;
-                                mem_read_address[i] = consumer_read_address[j];
-                                controller_state[i] = READ_WAITING;
-
-                                // Once we find a pending request, pick it up with this channel and stop looking for requests
-                                break;
-                            end else if ((WRITE_ENABLE == 1) && consumer_write_valid[j] && !channel_serving_consumer[j]) begin
-                                channel_serving_consumer[j] <= 1;
-                                current_consumer[i] = j[$clog2(NUM_CONSUMERS)-1:0];
-
-                                mem_write_valid[i] <= 1;
-                                mem_write_address[i] = consumer_write_address[j];
-                                mem_write_data[i] = consumer_write_data[j];
-                                controller_state[i] = WRITE_WAITING;
-
-                                // Once we find a pending request, pick it up with this channel and stop looking for requests
-                                break;
-                            end
-                        end
+                        channel_free = 1;
                     end
                     READ_WAITING: begin
-                        // Wait for response from memory for pending read request
+                        // Route the response to the consumer this request is tagged with
                         if (mem_read_ready[i]) begin
                             mem_read_valid[i] <= 0;
                             consumer_read_ready[current_consumer[i]] <= 1;
                             consumer_read_data[current_consumer[i]] <= mem_read_data[i];
-                            controller_state[i] <= READ_RELAYING;
+                            controller_state[i] <= IDLE;
+                            channel_free = 1;
                         end
                     end
                     WRITE_WAITING: begin
-                        // Wait for response from memory for pending write request
                         if (mem_write_ready[i]) begin
                             mem_write_valid[i] <= 0;
                             consumer_write_ready[current_consumer[i]] <= 1;
-                            controller_state[i] <= WRITE_RELAYING;
-                        end
-                    end
-                    // Wait until consumer acknowledges it received response, then reset
-                    READ_RELAYING: begin
-                        if (!consumer_read_valid[current_consumer[i]]) begin
-                            channel_serving_consumer[current_consumer[i]] <= 0;
-                            consumer_read_ready[current_consumer[i]] <= 0;
-                            controller_state[i] <= IDLE;
-                        end
-                    end
-                    WRITE_RELAYING: begin
-                        if (!consumer_write_valid[current_consumer[i]]) begin
-                            channel_serving_consumer[current_consumer[i]] <= 0;
-                            consumer_write_ready[current_consumer[i]] <= 0;
                             controller_state[i] <= IDLE;
+                            channel_free = 1;
                         end
                     end
                     default: begin
@@ -133,7 +137,80 @@ module mem_controller #(
                         controller_state[i] <= IDLE;
                     end
                 endcase
+
+                // A free channel picks up the next pending request, starting from the round-robin pointer
+                if (channel_free) begin
+                    for (int k = 0; k < NUM_CONSUMERS; k = k + 1) begin
+                        int j;
+                        j = (next_priority + k) % NUM_CONSUMERS;
+
+                        if (consumer_read_valid[j] && !next_read_claimed[j]) begin
+                            next_read_claimed[j] = 1;
+                            current_consumer[i] <= j[CONSUMER_INDEX_WIDTH-1:0];
+
+                            mem_read_valid[i] <= 1;
+                            mem_read_address[i] <= consumer_read_address[j];
+                            controller_state[i] <= READ_WAITING;
+
+                            next_priority = (j + 1) % NUM_CONSUMERS;
+                            break;
+                        end else if ((WRITE_ENABLE == 1) && consumer_write_valid[j] && !next_write_claimed[j]) begin
+                            next_write_claimed[j] = 1;
+                            current_consumer[i] <= j[CONSUMER_INDEX_WIDTH-1:0];
+
+                            mem_write_valid[i] <= 1;
+                            mem_write_address[i] <= consumer_write_address[j];
+                            mem_write_data[i] <= consumer_write_data[j];
+                            controller_state[i] <= WRITE_WAITING;
+
+                            next_priority = (j + 1) % NUM_CONSUMERS;
+                            break;
+                        end
+                    end
+                end
             end
+
+            read_claimed <= next_read_claimed;
+            write_claimed <= next_write_claimed;
+            arbiter_priority <= next_priority[CONSUMER_INDEX_WIDTH-1:0];
+        end
+    end
+
+    // Latency histograms: count cycles while a consumer waits, bin the count when ready is raised
+    reg [31:0] request_age [NUM_CONSUMERS];
+    reg [NUM_CONSUMERS-1:0] prev_consumer_read_ready;
+    reg [NUM_CONSUMERS-1:0] prev_consumer_write_ready;
+
+    always @(posedge clk) begin
+        if (reset) begin
+            for (int j = 0; j < NUM_CONSUMERS; j++) begin
+                request_age[j] <= 0;
+                for (int b = 0; b < LATENCY_BUCKETS; b++) begin
+                    latency_histogram[j][b] <= 0;
+                end
+            end
+            prev_consumer_read_ready <= 0;
+            prev_consumer_write_ready <= 0;
+        end else begin
+            for (int j = 0; j < NUM_CONSUMERS; j++) begin
+                if ((consumer_read_valid[j] && !consumer_read_ready[j]) || (consumer_write_valid[j] && !consumer_write_ready[j])) begin
+                    request_age[j] <= request_age[j] + 1;
+                end else begin
+                    request_age[j] <= 0;
+                end
+
+                if ((consumer_read_ready[j] && !prev_consumer_read_ready[j]) || (consumer_write_ready[j] && !prev_consumer_write_ready[j])) begin
+                    int bucket;
+                    bucket = 0;
+                    for (int b = 1; b < LATENCY_BUCKETS; b++) begin
+                        if (request_age[j] >= (32'd1 << b)) bucket = b;
+                    end
+                    latency_histogram[j][bucket] <= latency_histogram[j][bucket] + 1;
+                end
+            end
+
+            prev_consumer_read_ready <= consumer_read_ready;
+            prev_consumer_write_ready <= consumer_write_ready;
         end
     end
 endmodule
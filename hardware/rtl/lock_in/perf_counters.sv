@@ -0,0 +1,85 @@
+
+`timescale 1ns/1ns
+
+`include "common.svh"
+
+// PERFORMANCE COUNTERS
+// > Counts over one kernel, from the launch to execution_done, the counters are cleared at every launch
+// > The cores reset their own counters with every block, so their counts are added in whenever a core
+//   finishes a block (same edge the dispatcher relaunches it on, before the reset takes effect)
+// > Everything is copied into a snapshot when the kernel is done, reads only ever see the snapshot so the
+//   host gets consistent values while the next kernel runs
+// > Read port is combinational: read_data is the counter at word index read_address (see perf_counter_t)
+module perf_counters #(
+    parameter int NUM_CORES = 1
+) (
+    input wire clk,
+    input wire reset,
+
+    // Kernel Execution
+    input wire start,
+    input wire done,
+
+    // Events
+    input wire mem_busy,                                                // A data memory channel has a request this cycle
+    input wire [NUM_CORES-1:0] core_block_done,                         // Core finished its block this cycle
+    input data_t core_counters [NUM_CORES][`PERF_NUM_COUNTERS],        // Per core counts, indexed like perf_counter_t
+
+    // Read Port
+    input logic [`PERF_COUNTER_ADDRESS_WIDTH-1:0] read_address,
+    output data_t read_data
+);
+
+data_t counters [`PERF_NUM_COUNTERS];
+data_t snapshot [`PERF_NUM_COUNTERS];
+logic running;
+
+assign read_data = (int'(read_address) < `PERF_NUM_COUNTERS) ? snapshot[read_address] : 0;
+
+always @(posedge clk) begin
+    if (reset) begin
+        running <= 0;
+        for (int i = 0; i < `PERF_NUM_COUNTERS; i++) begin
+            counters[i] <= 0;
+            snapshot[i] <= 0;
+        end
+    end else if (!running) begin
+        // Same trigger as the dispatcher
+        if (start) begin
+            running <= 1;
+            for (int i = 0; i < `PERF_NUM_COUNTERS; i++) begin
+                counters[i] <= 0;
+            end
+        end
+    end else begin
+        for (int i = 0; i < `PERF_NUM_COUNTERS; i++) begin
+            data_t total;
+            total = counters[i];
+
+            if (i == int'(PERF_CYCLES)) begin
+                total = total + 1;
+            end else if (i == int'(PERF_MEM_BUSY_CYCLES)) begin
+                total = total + {31'd0, mem_busy};
+            end else if (i == int'(PERF_BLOCKS)) begin
+                total = total + data_t'($countones(core_block_done));
+            end else begin
+                for (int c = 0; c < NUM_CORES; c++) begin
+                    if (core_block_done[c]) begin
+                        total = total + core_counters[c][i];
+                    end
+                end
+            end
+
+            counters[i] <= total;
+            if (done) begin
+                snapshot[i] <= total;
+            end
+        end
+
+        if (done) begin
+            running <= 0;
+        end
+    end
+end
+
+endmodule
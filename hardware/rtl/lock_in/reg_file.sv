@@ -26,6 +26,7 @@ module reg_file #(
     input   logic   [4:0]                   decoded_rd_address,           // Destination register index
     input   logic   [4:0]                   decoded_rs1_address,          // Source register 1 index
     input   logic   [4:0]                   decoded_rs2_address,          // Source register 2 index
+    input   logic   [4:0]                   decoded_rs3_address,          // Source register 3 index (fused multiply-add)
 
     // Inputs from ALU and LSU per thread
     input   data_t                          alu_out [THREADS_PER_WARP],
@@ -33,7 +34,8 @@ module reg_file #(
 
     // Outputs per thread
     output  data_t                          rs1     [THREADS_PER_WARP],
-    output  data_t                          rs2     [THREADS_PER_WARP]
+    output  data_t                          rs2     [THREADS_PER_WARP],
+    output  data_t                          rs3     [THREADS_PER_WARP]
 );
 
 // Special-purpose register indices
@@ -67,6 +69,7 @@ always @(posedge clk) begin
             end
             rs1[i] <= {DATA_WIDTH{1'b0}};
             rs2[i] <= {DATA_WIDTH{1'b0}};
+            rs3[i] <= {DATA_WIDTH{1'b0}};
         end
     end else if (enable) begin
         for (int i = 0; i < THREADS_PER_WARP; i++) begin
@@ -80,6 +83,7 @@ always @(posedge clk) begin
             if (thread_enable[i]) begin
                 rs1[i] <= (decoded_rs1_address == ZERO_REG) ? {DATA_WIDTH{1'b0}} : registers[i][decoded_rs1_address];
                 rs2[i] <= (decoded_rs2_address == ZERO_REG) ? {DATA_WIDTH{1'b0}} : registers[i][decoded_rs2_address];
+                rs3[i] <= (decoded_rs3_address == ZERO_REG) ? {DATA_WIDTH{1'b0}} : registers[i][decoded_rs3_address];
 
                 if (warp_state == WARP_UPDATE) begin
                     // Prevent writes to read-only registers
@@ -21,6 +21,7 @@ module scalar_reg_file #(
     input   logic [4:0]                     decoded_rd_address,           // Destination register index
     input   logic [4:0]                     decoded_rs1_address,          // Source register 1 index
     input   logic [4:0]                     decoded_rs2_address,          // Source register 2 index
+    input   logic [4:0]                     decoded_rs3_address,          // Source register 3 index (fused multiply-add)
 
     input   data_t                          alu_out,
     input   data_t                          lsu_out,
@@ -28,7 +29,8 @@ module scalar_reg_file #(
     input   data_t                          vector_to_scalar_data,
 
     output  data_t                          rs1,
-    output  data_t                          rs2
+    output  data_t                          rs2,
+    output  data_t                          rs3
 );
 
 /* verilator lint_off UNUSED */
@@ -53,20 +55,22 @@ always @(posedge clk) begin
         registers[EXECUTION_MASK_REG] <= {DATA_WIDTH{1'b1}};
         rs1 <= 32'b0;
         rs2 <= 32'b0;
+        rs3 <= 32'b0;
     end else if (enable) begin
         rs1 <= (decoded_rs1_address == ZERO_REG) ? {DATA_WIDTH{1'b0}} : registers[decoded_rs1_address];
         rs2 <= (decoded_rs2_address == ZERO_REG) ? {DATA_WIDTH{1'b0}} : registers[decoded_rs2_address];
+        rs3 <= (decoded_rs3_address == ZERO_REG) ? {DATA_WIDTH{1'b0}} : registers[decoded_rs3_address];
 
         if (warp_state == WARP_UPDATE) begin
             if (decoded_reg_write_enable && decoded_rd_address > 0) begin
-                $display("Scalar Reg File: Writing to register %d", decoded_rd_address);
+                // $display("Scalar Reg File: Writing to register %d", decoded_rd_address);
                 case (decoded_reg_input_mux)
                     ALU_OUT:    registers[decoded_rd_address] <= alu_out;
                     LSU_OUT:    registers[decoded_rd_address] <= lsu_out;
                     IMMEDIATE:  registers[decoded_rd_address] <= decoded_immediate;
                     PC_PLUS_1:  registers[decoded_rd_address] <= pc + 1;
                     VECTOR_TO_SCALAR: begin
-                        $display("Scalar Reg File: Writing vector_to_scalar_data to register %d", decoded_rd_address);
+                        // $display("Scalar Reg File: Writing vector_to_scalar_data to register %d", decoded_rd_address);
                         // $display("vector_to_scalar_data: ", vector_to_scalar_data);
                         registers[decoded_rd_address] <= vector_to_scalar_data;
                     end
@@ -0,0 +1,157 @@
+
+`timescale 1ns/1ns
+
+`include "common.svh"
+
+// SCRATCHPAD (SHARED MEMORY)
+// > Banked on-chip memory private to one core, sits between the LSUs and the data memory path
+// > Addresses in [SCRATCHPAD_BASE_ADDRESS, SCRATCHPAD_BASE_ADDRESS + 4 * WORDS) are answered here
+//   the cycle after the request, everything else passes through to the global memory ports
+// > Addresses are byte addresses of 32-bit words (as emitted by the compiler), consecutive words
+//   sit in consecutive banks
+// > Every bank serves one address per cycle: lanes reading the same word share the access, other
+//   lanes hitting a busy bank wait for the next cycle (counted as bank conflicts)
+module scratchpad #(
+    parameter int NUM_CONSUMERS = 17,   // Number of LSUs of the core
+    parameter int NUM_BANKS = 16,       // Number of banks, one access per bank per cycle
+    parameter int WORDS = 256           // Total number of 32-bit words (multiple of NUM_BANKS)
+) (
+    input wire clk,
+    input wire reset,
+
+    // Consumer Interface (LSUs)
+    input logic [NUM_CONSUMERS-1:0] consumer_read_valid,
+    input data_memory_address_t consumer_read_address [NUM_CONSUMERS],
+    output logic [NUM_CONSUMERS-1:0] consumer_read_ready,
+    output data_t consumer_read_data [NUM_CONSUMERS],
+    input logic [NUM_CONSUMERS-1:0] consumer_write_valid,
+    input data_memory_address_t consumer_write_address [NUM_CONSUMERS],
+    input data_t consumer_write_data [NUM_CONSUMERS],
+    output logic [NUM_CONSUMERS-1:0] consumer_write_ready,
+
+    // Memory Interface (global data memory, only used outside the scratchpad window)
+    output logic [NUM_CONSUMERS-1:0] mem_read_valid,
+    output data_memory_address_t mem_read_address [NUM_CONSUMERS],
+    input logic [NUM_CONSUMERS-1:0] mem_read_ready,
+    input data_t mem_read_data [NUM_CONSUMERS],
+    output logic [NUM_CONSUMERS-1:0] mem_write_valid,
+    output data_memory_address_t mem_write_address [NUM_CONSUMERS],
+    output data_t mem_write_data [NUM_CONSUMERS],
+    input logic [NUM_CONSUMERS-1:0] mem_write_ready,
+
+    // Performance counters
+    output data_t accesses,         // Requests served by the scratchpad
+    output data_t bank_conflicts    // Cycles requests spent waiting for a busy bank
+);
+    localparam int ROWS = WORDS / NUM_BANKS;
+
+    data_t banks [NUM_BANKS][ROWS];
+
+    function automatic logic in_scratchpad(input data_memory_address_t address);
+        return address >= `SCRATCHPAD_BASE_ADDRESS && address < `SCRATCHPAD_BASE_ADDRESS + 4 * WORDS;
+    endfunction
+
+    function automatic int word_index(input data_memory_address_t address);
+        return int'((address - `SCRATCHPAD_BASE_ADDRESS) >> 2);
+    endfunction
+
+    logic [NUM_CONSUMERS-1:0] read_local;
+    logic [NUM_CONSUMERS-1:0] write_local;
+    logic [NUM_CONSUMERS-1:0] local_read_ready;
+    logic [NUM_CONSUMERS-1:0] local_write_ready;
+    data_t local_read_data [NUM_CONSUMERS];
+
+    // Route each request either to the banks or out to global memory
+    generate
+    for (genvar i = 0; i < NUM_CONSUMERS; i++) begin: g_route
+        assign read_local[i] = in_scratchpad(consumer_read_address[i]);
+        assign write_local[i] = in_scratchpad(consumer_write_address[i]);
+
+        assign mem_read_valid[i] = consumer_read_valid[i] && !read_local[i];
+        assign mem_read_address[i] = consumer_read_address[i];
+        assign consumer_read_ready[i] = read_local[i] ? local_read_ready[i] : mem_read_ready[i];
+        assign consumer_read_data[i] = read_local[i] ? local_read_data[i] : mem_read_data[i];
+
+        assign mem_write_valid[i] = consumer_write_valid[i] && !write_local[i];
+        assign mem_write_address[i] = consumer_write_address[i];
+        assign mem_write_data[i] = consumer_write_data[i];
+        assign consumer_write_ready[i] = write_local[i] ? local_write_ready[i] : mem_write_ready[i];
+    end
+    endgenerate
+
+    always @(posedge clk) begin
+        if (reset) begin
+            for (int i = 0; i < NUM_CONSUMERS; i++) begin
+                local_read_ready[i] <= 0;
+                local_write_ready[i] <= 0;
+                local_read_data[i] <= 0;
+            end
+            accesses <= 0;
+            bank_conflicts <= 0;
+        end else begin
+            logic [NUM_BANKS-1:0] bank_busy;
+            logic [NUM_BANKS-1:0] bank_reading;
+            data_memory_address_t bank_address [NUM_BANKS];
+            int served;
+            int conflicts;
+
+            bank_busy = 0;
+            bank_reading = 0;
+            served = 0;
+            conflicts = 0;
+            for (int b = 0; b < NUM_BANKS; b++) begin
+                bank_address[b] = 0;
+            end
+
+            for (int i = 0; i < NUM_CONSUMERS; i++) begin
+                // LSUs acknowledge the response by dropping valid
+                if (local_read_ready[i] && !consumer_read_valid[i]) begin
+                    local_read_ready[i] <= 0;
+                end
+                if (local_write_ready[i] && !consumer_write_valid[i]) begin
+                    local_write_ready[i] <= 0;
+                end
+
+                // Lower consumers get the bank first, a read of the word a bank is already reading shares the access
+                if (consumer_read_valid[i] && read_local[i] && !local_read_ready[i]) begin
+                    int word;
+                    int bank;
+                    word = word_index(consumer_read_address[i]);
+                    bank = word % NUM_BANKS;
+
+                    if (!bank_busy[bank] || (bank_reading[bank] && bank_address[bank] == consumer_read_address[i])) begin
+                        bank_busy[bank] = 1;
+                        bank_reading[bank] = 1;
+                        bank_address[bank] = consumer_read_address[i];
+
+                        local_read_ready[i] <= 1;
+                        local_read_data[i] <= banks[bank][word / NUM_BANKS];
+                        served = served + 1;
+                    end else begin
+                        conflicts = conflicts + 1;
+                    end
+                end else if (consumer_write_valid[i] && write_local[i] && !local_write_ready[i]) begin
+                    int word;
+                    int bank;
+                    word = word_index(consumer_write_address[i]);
+                    bank = word % NUM_BANKS;
+
+                    // Writes to the same word go in lane order, so the highest lane wins like in global memory
+                    if (!bank_busy[bank]) begin
+                        bank_busy[bank] = 1;
+                        bank_address[bank] = consumer_write_address[i];
+
+                        banks[bank][word / NUM_BANKS] <= consumer_write_data[i];
+                        local_write_ready[i] <= 1;
+                        served = served + 1;
+                    end else begin
+                        conflicts = conflicts + 1;
+                    end
+                end
+            end
+
+            accesses <= accesses + served;
+            bank_conflicts <= bank_conflicts + conflicts;
+        end
+    end
+endmodule
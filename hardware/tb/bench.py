@@ -0,0 +1,280 @@
+#!/usr/bin/env python3
+
+"""
+Kernel benchmark suite with recorded baselines.
+
+Compiles every benchmark of code/benchmarks/ through the full toolchain
+(cpp for the size defines, bin/c_compiler, the assembler), runs them all on
+the Verilator model of gpu.sv in one build (CompiledBenchmarks in
+test/gpu-bench_tb.cpp) and compares the cycles, instructions and memory
+transactions of every kernel against bench_baseline.json.
+
+A kernel fails when one of those numbers grows by more than the threshold
+over its baseline, or when its output hash changes (different results).
+A kernel without a baseline (or a missing baseline file) is an error, add
+it with --record.
+
+Usage: bench.py [-h] [--threshold PERCENT] [--record] [--only NAME,..]
+                [--mem-model SPEC]
+
+Example usage: ./bench.py                # compare against the baseline
+               ./bench.py --record       # accept the current numbers
+               ./bench.py --mem-model ddr
+
+--mem-model picks the data memory timing of the testbench (memory_model.h),
+each model other than ideal keeps its own baseline file,
+bench_baseline_<model>.json.
+
+No baseline is checked in yet, none has been recorded on a Verilator
+build. Commit the files of a first ./bench.py --record (and one
+--record --mem-model <model> per timing model) with their numbers. Until
+then the suite fails, also as the last test of a full ./doit.sh run.
+
+The suite runs on the GpuKernelTestbench fixture (gpu_kernel_testbench.h),
+which loads compiled programs and reads the performance counters, and not on
+GpuTestbench of test/gpu_tb.cpp, whose tests drive hand-written programs.
+
+Record the baseline again after a change that is meant to move the numbers
+(scheduler, compiler output), in the same commit, so the diff shows the
+effect. Extra Verilator flags go through VERILATOR_FLAGS as for doit.sh.
+"""
+
+
+import os
+import sys
+import json
+import shutil
+import argparse
+import subprocess
+from pathlib import Path
+from dataclasses import dataclass
+from typing import Dict, List, Optional
+
+from sweep import parse_bench_line
+
+
+SCRIPT_LOCATION = Path(__file__).resolve().parent
+PROJECT_LOCATION = SCRIPT_LOCATION.joinpath("../..").resolve()
+BENCHMARK_FOLDER = PROJECT_LOCATION.joinpath("code/benchmarks").resolve()
+COMPILER_LOCATION = PROJECT_LOCATION.joinpath("compiler").resolve()
+COMPILER_FILE = COMPILER_LOCATION.joinpath("bin/c_compiler").resolve()
+ASSEMBLER_SOURCE = PROJECT_LOCATION.joinpath("assembler/assembler.cpp").resolve()
+OUTPUT_FOLDER = SCRIPT_LOCATION.joinpath("logs/bench").resolve()
+BASELINE_FILE = SCRIPT_LOCATION.joinpath("bench_baseline.json").resolve()
+
+TESTBENCH = "test/gpu-bench_tb.cpp"
+GTEST_FILTER = "GpuKernelTestbench.CompiledBenchmarks"
+
+BUILD_TIMEOUT_SECONDS = 300
+RUN_TIMEOUT_SECONDS = 3600
+DEFAULT_THRESHOLD_PERCENT = 5.0
+
+# Lower is better for all of them
+COMPARED_METRICS = ["cycles", "instructions", "mem_transactions"]
+
+RED = "\033[31m"
+GREEN = "\033[32m"
+RESET = "\033[0m"
+
+if not sys.stdout.isatty():
+    RED, GREEN, RESET = "", "", ""
+
+
+@dataclass
+class Benchmark:
+    name: str
+    source: str
+    defines: Dict[str, int]
+
+
+# K-means at several sizes (points, centroids, dimensions) plus the building blocks of other kernels
+BENCHMARKS = [
+    Benchmark("kmeans_assign_n64_k3_d2", "kmeans_assign.c", {"N": 64, "K": 3, "D": 2}),
+    Benchmark("kmeans_assign_n256_k3_d2", "kmeans_assign.c", {"N": 256, "K": 3, "D": 2}),
+    Benchmark("kmeans_assign_n64_k8_d2", "kmeans_assign.c", {"N": 64, "K": 8, "D": 2}),
+    Benchmark("kmeans_assign_n64_k3_d8", "kmeans_assign.c", {"N": 64, "K": 3, "D": 8}),
+    Benchmark("reduce_n256", "reduce.c", {"N": 256, "HALF": 128}),
+    Benchmark("vector_add_n256", "vector_add.c", {"N": 256}),
+    Benchmark("dot_product_n256", "dot_product.c", {"N": 256, "HALF": 128}),
+    Benchmark("matvec_32x32", "matvec.c", {"ROWS": 32, "COLS": 32}),
+]
+
+
+def run(cmd: List[str], cwd: Path, timeout: int, log_path: Path, env: Optional[dict] = None) -> Optional[str]:
+    """Runs cmd with its output in log_path, returns the output or None when it fails"""
+    try:
+        process = subprocess.run(cmd, cwd=cwd, env=env, capture_output=True, text=True, timeout=timeout)
+        output = process.stdout + process.stderr
+        returncode = process.returncode
+    except subprocess.TimeoutExpired:
+        output = f"{cmd} took more than {timeout} seconds"
+        returncode = -1
+
+    log_path.write_text(output)
+    if returncode != 0:
+        print(f"{RED}{' '.join(str(c) for c in cmd)} failed, see {log_path}{RESET}")
+        return None
+    return output
+
+
+def build_tools() -> Optional[Path]:
+    """Builds the compiler and an assembler for the suite, returns the assembler"""
+    OUTPUT_FOLDER.mkdir(parents=True, exist_ok=True)
+    if run(["make", "-C", str(COMPILER_LOCATION), "bin/c_compiler"], PROJECT_LOCATION,
+           BUILD_TIMEOUT_SECONDS, OUTPUT_FOLDER.joinpath("compiler.build.log")) is None:
+        return None
+
+    assembler = OUTPUT_FOLDER.joinpath("assembler")
+    if run(["g++", "-std=c++17", "-O2", "-o", str(assembler), str(ASSEMBLER_SOURCE)], PROJECT_LOCATION,
+           BUILD_TIMEOUT_SECONDS, OUTPUT_FOLDER.joinpath("assembler.build.log")) is None:
+        return None
+    return assembler
+
+
+def compile_benchmark(benchmark: Benchmark, assembler: Path) -> Optional[List[Path]]:
+    """C -> ElsonV -> hex, returns [instr.hex, data.hex]"""
+    folder = OUTPUT_FOLDER.joinpath(benchmark.name)
+    shutil.rmtree(folder, ignore_errors=True)
+
+    # The assembler reads and writes assembler/compiler_output/ under its working directory
+    compiler_output = folder.joinpath("assembler/compiler_output")
+    compiler_output.mkdir(parents=True)
+
+    source = folder.joinpath(benchmark.name + ".c")
+    defines = [f"-D{name}={value}" for name, value in benchmark.defines.items()]
+    preprocessed = run(["cpp", "-P", *defines, str(BENCHMARK_FOLDER.joinpath(benchmark.source))], folder,
+                       BUILD_TIMEOUT_SECONDS, folder.joinpath("cpp.log"))
+    if preprocessed is None:
+        return None
+    source.write_text(preprocessed)
+
+    # Same as test.py, leak reports of the sanitised compiler are not failures
+    env = dict(os.environ)
+    env["ASAN_OPTIONS"] = "exitcode=0"
+    if run([str(COMPILER_FILE), "-S", str(source), "-o", str(compiler_output.joinpath("kernel.asm"))], folder,
+           BUILD_TIMEOUT_SECONDS, folder.joinpath("compiler.log"), env) is None:
+        return None
+
+    if run([str(assembler)], folder, BUILD_TIMEOUT_SECONDS, folder.joinpath("assembler.log")) is None:
+        return None
+    return [compiler_output.joinpath("kernel.instr.hex"), compiler_output.joinpath("kernel.data.hex")]
+
+
+def baseline_file(mem_model: str) -> Path:
+    if mem_model == "ideal":
+        return BASELINE_FILE
+    suffix = "".join(c if c.isalnum() else "-" for c in mem_model)
+    return BASELINE_FILE.with_name(f"{BASELINE_FILE.stem}_{suffix}.json")
+
+
+def run_suite(programs: Dict[str, List[Path]], mem_model: str) -> Dict[str, Dict[str, float]]:
+    list_file = OUTPUT_FOLDER.joinpath("bench_list.txt")
+    list_file.write_text("".join(f"{name} {instr} {data}\n" for name, (instr, data) in programs.items()))
+
+    env = dict(os.environ)
+    env["SIM_ARGS"] = f"--gtest_filter={GTEST_FILTER} +bench_list={list_file} +mem_model={mem_model}"
+    output = run(["./doit.sh", TESTBENCH], SCRIPT_LOCATION, RUN_TIMEOUT_SECONDS,
+                 OUTPUT_FOLDER.joinpath("simulation.log"), env)
+    if output is None:
+        return {}
+
+    results = {}
+    for line in output.splitlines():
+        if "BENCH:" in line:
+            result = parse_bench_line(line)
+            results[result.pop("kernel")] = result
+    return results
+
+
+def compare(results: Dict[str, Dict[str, float]], baseline: Dict[str, Dict[str, float]],
+            threshold: float) -> bool:
+    passed = True
+    print()
+    print(f"{'kernel':<28} {'metric':<18} {'baseline':>10} {'current':>10} {'change':>9}")
+    for name, result in results.items():
+        if name not in baseline:
+            print(f"{RED}{name:<28} {'no baseline':<18} {'':>10} {result['cycles']:>10}  run with --record{RESET}")
+            passed = False
+            continue
+
+        reference = baseline[name]
+        if result.get("output_hash") != reference.get("output_hash"):
+            print(f"{RED}{name:<28} {'output_hash':<18} {reference.get('output_hash'):>10} "
+                  f"{result.get('output_hash'):>10}  results changed{RESET}")
+            passed = False
+
+        for metric in COMPARED_METRICS:
+            old, new = reference[metric], result[metric]
+            change = 100.0 * (new - old) / old if old else 0.0
+            regressed = change > threshold
+            colour = RED if regressed else (GREEN if change < -threshold else "")
+            print(f"{colour}{name:<28} {metric:<18} {old:>10} {new:>10} {change:>+8.1f}%"
+                  f"{'  regression' if regressed else ''}{RESET if colour else ''}")
+            passed = passed and not regressed
+
+    for name in baseline:
+        if name not in results:
+            print(f"{RED}{name:<28} in the baseline but did not run{RESET}")
+            passed = False
+    return passed
+
+
+def main() -> int:
+    parser = argparse.ArgumentParser(description="Kernel benchmark suite")
+    parser.add_argument("--threshold", type=float, default=DEFAULT_THRESHOLD_PERCENT,
+                        help="allowed growth of cycles, instructions and memory transactions, in percent")
+    parser.add_argument("--record", action="store_true",
+                        help="write the results to the baseline file instead of comparing")
+    parser.add_argument("--only", type=lambda text: text.split(","), default=None,
+                        help="comma separated benchmark names")
+    parser.add_argument("--mem-model", default="ideal",
+                        help="data memory timing model, e.g. ideal, fixed:latency=4, banked, ddr")
+    args = parser.parse_args()
+
+    benchmarks = [b for b in BENCHMARKS if args.only is None or b.name in args.only]
+    if not benchmarks:
+        print(f"No benchmark named {args.only}")
+        return 2
+
+    baseline_path = baseline_file(args.mem_model)
+    if not baseline_path.exists() and not args.record:
+        print(f"{RED}No baseline {baseline_path}, record one with --record{RESET}")
+        return 2
+
+    assembler = build_tools()
+    if assembler is None:
+        return 2
+
+    programs = {}
+    for benchmark in benchmarks:
+        print(f"Compiling {benchmark.name}", flush=True)
+        hex_files = compile_benchmark(benchmark, assembler)
+        if hex_files is None:
+            return 2
+        programs[benchmark.name] = hex_files
+
+    print(f"Running {len(programs)} benchmarks", flush=True)
+    results = run_suite(programs, args.mem_model)
+    missing = [name for name in programs if name not in results]
+    if missing:
+        print(f"{RED}No results for {', '.join(missing)}, see {OUTPUT_FOLDER.joinpath('simulation.log')}{RESET}")
+        return 2
+
+    baseline = json.loads(baseline_path.read_text()) if baseline_path.exists() else {}
+    if args.record:
+        # --only keeps the baseline of the kernels that did not run
+        baseline.update(results)
+        baseline_path.write_text(json.dumps(baseline, indent=2, sort_keys=True) + "\n")
+        print(f"Recorded {len(results)} benchmarks in {baseline_path}")
+        return 0
+
+    if args.only is not None:
+        baseline = {name: value for name, value in baseline.items() if name in results}
+    passed = compare(results, baseline, args.threshold)
+    print()
+    print(f"{GREEN}No regression over {args.threshold}%{RESET}" if passed else f"{RED}Benchmarks regressed{RESET}")
+    return 0 if passed else 1
+
+
+if __name__ == "__main__":
+    sys.exit(main())
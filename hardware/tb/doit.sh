@@ -2,6 +2,18 @@
 
 # This script runs the testbench
 # Usage: ./doit.sh <file1.cpp> <file2.cpp>
+# Extra Verilator flags can be passed through VERILATOR_FLAGS, e.g. to sweep
+# the instruction cache size:
+#   VERILATOR_FLAGS="-GICACHE_LINES=8 -CFLAGS -DICACHE_LINES=8" ./doit.sh test/tmp_test/compute_core_tb.cpp
+# or the warp scheduling policy:
+#   VERILATOR_FLAGS="-GWARP_SCHEDULER=1 -CFLAGS -DWARP_SCHEDULER=1" ./doit.sh test/tmp_test/compute_core_tb.cpp
+# Arguments for the simulation itself (plusargs, gtest filters) go through SIM_ARGS, e.g. a retire trace:
+#   VERILATOR_FLAGS="+define+TRACE_RETIRE" SIM_ARGS="+trace=logs/trace.bin" ./doit.sh test/gpu-scaling_tb.cpp
+# or a data memory timing model other than the ideal one (test/memory_model.h):
+#   SIM_ARGS="+mem_model=ddr:tcl=8" ./doit.sh test/gpu-scaling_tb.cpp
+# Without arguments the kernel benchmark suite (bench.py) runs after the tests and counts as one more
+# test: it fails on a regression over bench_baseline.json, or while no baseline is recorded. Skip it with
+#   SKIP_BENCH=1 ./doit.sh
 
 # Constants
 SCRIPT_DIR=$(dirname "$(realpath "$0")")
@@ -47,13 +59,14 @@ for file in "${files[@]}"; do
                 -o Vdut \
                 -CFLAGS "-isystem /opt/homebrew/Cellar/googletest/1.15.2/include"\
                 -LDFLAGS "-L/opt/homebrew/Cellar/googletest/1.15.2/lib -lgtest -lgtest_main -lpthread" \
-                --coverage
+                --coverage \
+                ${VERILATOR_FLAGS}
 
     # Build C++ project with automatically generated Makefile
     make -j -C obj_dir/ -f Vdut.mk
     
     # Run executable simulation file
-    ./obj_dir/Vdut
+    ./obj_dir/Vdut ${SIM_ARGS}
     
     # Check if the test succeeded or not
     if [ $? -eq 0 ]; then
@@ -63,6 +76,15 @@ for file in "${files[@]}"; do
     fi
 done
 
+# Kernel benchmarks against their recorded baseline, only for a run of the whole suite
+if [[ $# -eq 0 && -z "${SKIP_BENCH}" ]]; then
+    if ./bench.py; then
+        ((passes++))
+    else
+        ((fails++))
+    fi
+fi
+
 # Exit as a pass or fail (for CI purposes)
 if [ $fails -eq 0 ]; then
     echo "${GREEN}Success! All ${passes} test(s) passed!${RESET}"
@@ -0,0 +1,68 @@
+#!/bin/bash
+
+# Multi-core scaling benchmark
+# Runs the k-means assignment kernel (test/gpu-scaling_tb.cpp) on 1, 2 and 4 cores and reports the
+# speedup over 1 core for two memory configurations:
+#   fixed    - the 8 data memory channels of top.sv, split between the cores (what ships)
+#   per-core - 8 data memory channels for every core, the total grows with the cores
+# Usage: ./scaling.sh [core counts...]   e.g. ./scaling.sh 1 2 4 8
+
+SCRIPT_DIR=$(dirname "$(realpath "$0")")
+cd "$SCRIPT_DIR" || exit
+
+if [[ $# -eq 0 ]]; then
+    core_counts=(1 2 4)
+else
+    core_counts=("$@")
+fi
+
+FIXED_CHANNELS=8
+CHANNELS_PER_CORE=8
+
+declare -A base_cycles
+results=()
+
+for cores in "${core_counts[@]}"; do
+    cycles=""
+    for memory in fixed per-core; do
+        if [[ "$memory" == "fixed" ]]; then
+            channels=$FIXED_CHANNELS
+        else
+            channels=$((CHANNELS_PER_CORE * cores))
+        fi
+        if (( channels % cores != 0 )); then
+            echo "Skipping ${cores} core(s) on ${memory} memory: ${channels} channels do not split between them"
+            continue
+        fi
+
+        # 1 core gets the same build on both memories
+        if [[ "$memory" == "per-core" && "$channels" -eq "$FIXED_CHANNELS" && -n "$cycles" ]]; then
+            results+=("${memory} ${cores} ${channels} ${cycles}")
+            base_cycles[$memory]=${base_cycles[$memory]:-$cycles}
+            continue
+        fi
+
+        output=$(VERILATOR_FLAGS="-GNUM_CORES=${cores} -GDATA_MEM_NUM_CHANNELS=${channels} -CFLAGS -DNUM_CORES=${cores} -CFLAGS -DDATA_MEM_NUM_CHANNELS=${channels}" \
+                 ./doit.sh test/gpu-scaling_tb.cpp)
+        cycles=$(echo "$output" | grep "SCALING:" | sed 's/.*cycles=\([0-9]*\).*/\1/')
+
+        if [[ -z "$cycles" ]]; then
+            echo "$output" | tail -n 20
+            echo "Benchmark failed for ${cores} core(s) on ${memory} memory"
+            exit 1
+        fi
+
+        if [[ -z "${base_cycles[$memory]}" ]]; then
+            base_cycles[$memory]=$cycles
+        fi
+        results+=("${memory} ${cores} ${channels} ${cycles}")
+    done
+done
+
+echo
+printf "%-9s %-6s %-9s %-10s %-8s\n" "memory" "cores" "channels" "cycles" "speedup"
+for result in "${results[@]}"; do
+    read -r memory cores channels cycles <<< "$result"
+    speedup=$(awk "BEGIN { printf \"%.2f\", ${base_cycles[$memory]} / ${cycles} }")
+    printf "%-9s %-6s %-9s %-10s %-8s\n" "$memory" "$cores" "$channels" "$cycles" "${speedup}x"
+done
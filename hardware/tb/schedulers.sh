@@ -0,0 +1,50 @@
+#!/bin/bash
+
+# Warp scheduler comparison
+# Runs WarpSchedulerTest (test/tmp_test/compute_core_tb.cpp) once for every warp scheduling policy of
+# compute_core.sv and reports its cycles against loose round-robin:
+#   0 - loose round-robin
+#   1 - greedy-then-oldest
+#   2 - two-level
+# Every run also checks its picks against the rule of the policy.
+# Usage: ./schedulers.sh [policies...]   e.g. ./schedulers.sh 0 1
+
+SCRIPT_DIR=$(dirname "$(realpath "$0")")
+cd "$SCRIPT_DIR" || exit
+
+if [[ $# -eq 0 ]]; then
+    policies=(0 1 2)
+else
+    policies=("$@")
+fi
+
+NAMES=("round-robin" "greedy-then-oldest" "two-level")
+
+base_cycles=""
+results=()
+
+for policy in "${policies[@]}"; do
+    output=$(VERILATOR_FLAGS="-GWARP_SCHEDULER=${policy} -CFLAGS -DWARP_SCHEDULER=${policy}" \
+             SIM_ARGS="--gtest_filter=*WarpSchedulerTest" \
+             ./doit.sh test/tmp_test/compute_core_tb.cpp)
+    cycles=$(echo "$output" | grep "SCHEDULER:" | sed 's/.*cycles=\([0-9]*\).*/\1/')
+
+    if [[ -z "$cycles" ]] || echo "$output" | grep -q "FAILED"; then
+        echo "$output" | tail -n 20
+        echo "Scheduler test failed for policy ${policy}"
+        exit 1
+    fi
+
+    if [[ -z "$base_cycles" ]]; then
+        base_cycles=$cycles
+    fi
+    results+=("${policy} ${cycles}")
+done
+
+echo
+printf "%-7s %-20s %-8s %-8s\n" "policy" "name" "cycles" "speedup"
+for result in "${results[@]}"; do
+    read -r policy cycles <<< "$result"
+    speedup=$(awk "BEGIN { printf \"%.2f\", ${base_cycles} / ${cycles} }")
+    printf "%-7s %-20s %-8s %-8s\n" "$policy" "${NAMES[$policy]}" "$cycles" "${speedup}x"
+done
@@ -0,0 +1,322 @@
+#!/usr/bin/env python3
+
+"""
+Design space sweep of the GPU parameters.
+
+Builds the Verilator model of gpu.sv (through doit.sh) for every point of a
+parameter grid, runs the fixed benchmark set of test/gpu-sweep_tb.cpp
+(KMeansBenchmarks) on it and collects the cycles, IPC, lane utilisation and
+memory traffic of every kernel. Every configuration also gets a parametric
+LUT, FF, BRAM and DSP estimate, and the configurations on the cycles /
+estimated LUTs Pareto frontier are marked, to pick the next bitstream.
+
+The estimate is not a measurement. LUTs, FFs and BRAM scale the placed
+utilisation report (docs/vivado_reports/fdga_utilization_placed.rpt), which is
+flat, so how the baseline splits between lanes, warps, cores and channels
+(RESOURCE_SHARES) is a guess by module. DSPs count the multipliers of the RTL
+(DSP_PER_ALU, DSP_PER_FPU) as if each mapped to DSP48E1 slices, an upper bound:
+the placed baseline reports none. Replace the shares with the numbers of a
+hierarchical report (report_utilization -hierarchical) once one is checked in,
+and place a candidate before trusting its numbers.
+
+Usage: sweep.py [-h] [--cores N,..] [--warps N,..] [--threads N,..]
+                [--data-channels-per-core N,..] [--instr-channels N,..]
+                [--mem-model SPEC ..] [--out PREFIX] [--estimate-only]
+
+Example usage: ./sweep.py --cores 1,2 --warps 1,2 --threads 16
+               ./sweep.py --cores 1,2,4 --mem-model ideal ddr ddr:bus=1
+
+--mem-model picks the data memory timing of the testbench (memory_model.h,
++mem_model=), every model is one more point of the grid. The frontier is
+marked per model, as the ideal memory hides the cost of extra channels. A
+build is shared by the models of one hardware configuration.
+
+This writes logs/sweep.csv (one row per configuration and kernel) and
+logs/sweep.json (configurations with their estimate, results and frontier
+flag), and prints a summary per configuration. The build log of every
+configuration is kept in logs/sweep/.
+
+The testbench takes its parameters from -D defines and gpu.sv from -G
+overrides, the sweep always passes both so they cannot disagree (the old
+gpu_tb.cpp had to be edited by hand to match). gpu_wrapper.sv is not swept,
+carry the chosen values over to its parameters before synthesis.
+"""
+
+
+import os
+import sys
+import csv
+import json
+import argparse
+import subprocess
+from pathlib import Path
+from dataclasses import dataclass, field, asdict
+from typing import Dict, List
+
+
+SCRIPT_LOCATION = Path(__file__).resolve().parent
+LOG_FOLDER = SCRIPT_LOCATION.joinpath("logs").resolve()
+TESTBENCH = "test/gpu-sweep_tb.cpp"
+GTEST_FILTER = "GpuKernelTestbench.KMeansBenchmarks"
+
+BUILD_TIMEOUT_SECONDS = 1800
+
+# docs/vivado_reports/fdga_utilization_placed.rpt: gpu_wrapper placed on the
+# xc7z020 with 1 core, 2 warps, 16 threads, 8 data and 8 instruction channels
+BASELINE_CONFIG = {"cores": 1, "warps": 2, "threads": 16, "data_channels": 8, "instr_channels": 8}
+BASELINE_UTILISATION = {"lut": 5328, "ff": 5957, "bram": 15}
+DEVICE_RESOURCES = {"lut": 53200, "ff": 106400, "bram": 140, "dsp": 220}
+
+# Share of the baseline utilisation that scales with each term, the rest is fixed
+# (dispatcher, counter block, AXI interface). These are guesses by module, the
+# placed report has no per module breakdown.
+# > lanes: ALUs and FPUs, one per thread of a core
+# > warp_lanes: vector register files, one per thread of every warp
+# > warps: scheduler, fetcher and scalar register file state per warp
+# > cores: decoder, LSU arbitration and instruction cache per core
+# > data_channels / instr_channels: memory controller arbitration per channel
+RESOURCE_SHARES = {
+    "lut":  {"lanes": 0.50, "warp_lanes": 0.08, "warps": 0.08, "cores": 0.12,
+             "data_channels": 0.12, "instr_channels": 0.04},
+    "ff":   {"lanes": 0.40, "warp_lanes": 0.15, "warps": 0.10, "cores": 0.12,
+             "data_channels": 0.12, "instr_channels": 0.05},
+    "bram": {"warp_lanes": 0.25, "cores": 0.10},
+}
+
+# DSP48E1 slices (25x18 multipliers) per unit if Vivado maps every multiplier of the RTL to them
+# > alu.sv: the MULQ product (32x32 to 64 bits, 4) and MUL, MULI (32x32 to 32 bits, 3 each)
+# > floating_alu.sv: the FMUL/FMADD significand product and the distance square (24x24, 2 each)
+# A core has one ALU and one FPU per thread and a scalar pair. Multipliers left in the fabric cost
+# LUTs instead, which the LUT estimate does not add
+DSP_PER_ALU = 10
+DSP_PER_FPU = 4
+
+
+def terms(config: Dict[str, int]) -> Dict[str, int]:
+    return {
+        "lanes": config["cores"] * config["threads"],
+        "warp_lanes": config["cores"] * config["warps"] * config["threads"],
+        "warps": config["cores"] * config["warps"],
+        "cores": config["cores"],
+        "data_channels": config["data_channels"],
+        "instr_channels": config["instr_channels"],
+    }
+
+
+def estimate_resources(config: Dict[str, int]) -> Dict[str, int]:
+    """Linear scaling of the baseline share by share, and the DSP count of the multipliers. An estimate"""
+    config_terms = terms(config)
+    baseline_terms = terms(BASELINE_CONFIG)
+
+    estimate = {}
+    for resource, shares in RESOURCE_SHARES.items():
+        fixed = 1.0 - sum(shares.values())
+        scale = fixed + sum(share * config_terms[term] / baseline_terms[term] for term, share in shares.items())
+        estimate[resource] = round(BASELINE_UTILISATION[resource] * scale)
+    estimate["dsp"] = config["cores"] * (config["threads"] + 1) * (DSP_PER_ALU + DSP_PER_FPU)
+    return estimate
+
+@dataclass
+class Configuration:
+    cores: int
+    warps: int
+    threads: int
+    data_channels: int
+    instr_channels: int
+    mem_model: str = "ideal"
+    estimate: Dict[str, int] = field(default_factory=dict)
+    fits: bool = True
+    results: List[Dict[str, float]] = field(default_factory=list)
+    total_cycles: int = 0
+    pareto: bool = False
+    error: str = ""
+
+    def name(self) -> str:
+        name = (f"c{self.cores}_w{self.warps}_t{self.threads}"
+                f"_d{self.data_channels}_i{self.instr_channels}")
+        if self.mem_model != "ideal":
+            name += "_" + "".join(c if c.isalnum() else "-" for c in self.mem_model)
+        return name
+
+    def parameters(self) -> Dict[str, int]:
+        return {"cores": self.cores, "warps": self.warps, "threads": self.threads,
+                "data_channels": self.data_channels, "instr_channels": self.instr_channels}
+
+    def verilator_flags(self) -> str:
+        overrides = {
+            "NUM_CORES": self.cores,
+            "WARPS_PER_CORE": self.warps,
+            "THREADS_PER_WARP": self.threads,
+            "DATA_MEM_NUM_CHANNELS": self.data_channels,
+            "INSTRUCTION_MEM_NUM_CHANNELS": self.instr_channels,
+        }
+        flags = [f"-G{name}={value}" for name, value in overrides.items()]
+        flags += [f"-CFLAGS -D{name}={value}" for name, value in overrides.items()]
+        return " ".join(flags)
+
+
+def parse_list(text: str) -> List[int]:
+    return [int(value) for value in text.split(",") if value]
+
+
+def parse_bench_line(line: str) -> Dict[str, float]:
+    """BENCH: kernel=<name> key=value ..."""
+    result = {}
+    for pair in line.split("BENCH:", 1)[1].split():
+        key, value = pair.split("=", 1)
+        try:
+            result[key] = int(value)
+        except ValueError:
+            try:
+                result[key] = float(value)
+            except ValueError:
+                result[key] = value
+    return result
+
+
+def run_configuration(config: Configuration, rebuild: bool = True) -> None:
+    """rebuild=False runs the model left in obj_dir by the previous configuration"""
+    env = dict(os.environ)
+    env["VERILATOR_FLAGS"] = config.verilator_flags()
+    env["SIM_ARGS"] = f"--gtest_filter={GTEST_FILTER} +mem_model={config.mem_model}"
+    command = ["./doit.sh", TESTBENCH] if rebuild else \
+        ["./obj_dir/Vdut", f"--gtest_filter={GTEST_FILTER}", f"+mem_model={config.mem_model}"]
+
+    try:
+        process = subprocess.run(
+            command,
+            cwd=SCRIPT_LOCATION, env=env, capture_output=True, text=True,
+            timeout=BUILD_TIMEOUT_SECONDS,
+        )
+        output = process.stdout + process.stderr
+    except subprocess.TimeoutExpired:
+        output = ""
+        config.error = "timeout"
+
+    log_file = LOG_FOLDER.joinpath("sweep", config.name() + ".log")
+    log_file.parent.mkdir(parents=True, exist_ok=True)
+    log_file.write_text(output)
+
+    config.results = [parse_bench_line(line) for line in output.splitlines() if "BENCH:" in line]
+    config.total_cycles = sum(int(result["cycles"]) for result in config.results)
+    if not config.results and not config.error:
+        config.error = f"no BENCH output, see {log_file}"
+
+
+def mark_pareto(configs: List[Configuration]) -> None:
+    """Frontier of total cycles against estimated LUTs, over the configurations that ran and fit, per memory model"""
+    candidates = [c for c in configs if c.fits and c.results and not c.error]
+    for config in candidates:
+        config.pareto = not any(
+            other.mem_model == config.mem_model
+            and other.estimate["lut"] <= config.estimate["lut"] and other.total_cycles <= config.total_cycles
+            and (other.estimate["lut"] < config.estimate["lut"] or other.total_cycles < config.total_cycles)
+            for other in candidates
+        )
+
+
+def write_csv(path: Path, configs: List[Configuration]) -> None:
+    columns = ["cores", "warps", "threads", "data_channels", "instr_channels", "mem_model",
+               "kernel", "cycles", "instructions", "ipc", "lane_utilisation",
+               "mem_busy_cycles", "mem_transactions", "mem_avg_latency", "mem_bank_stall_cycles",
+               "est_lut", "est_ff", "est_bram", "est_dsp", "est_fits", "pareto"]
+    with open(path, "w", newline="") as file:
+        writer = csv.writer(file)
+        writer.writerow(columns)
+        for config in configs:
+            estimate = [config.estimate[r] for r in ("lut", "ff", "bram", "dsp")]
+            flags = [int(config.fits), int(config.pareto)]
+            for result in config.results or [{}]:
+                row = list(config.parameters().values()) + [config.mem_model]
+                row += [result.get(key, "") for key in columns[6:15]]
+                writer.writerow(row + estimate + flags)
+
+
+def print_summary(configs: List[Configuration]) -> None:
+    print()
+    print(f"{'configuration':<34} {'cycles':>10} {'ipc':>6} {'lanes':>6} "
+          f"{'~LUTs':>7} {'~FFs':>7} {'~BRAM':>5} {'~DSP':>5}")
+    for config in sorted(configs, key=lambda c: (c.mem_model, c.estimate["lut"], c.total_cycles)):
+        if config.results:
+            ipc = sum(r["ipc"] for r in config.results) / len(config.results)
+            lanes = sum(r["lane_utilisation"] for r in config.results) / len(config.results)
+            numbers = f"{config.total_cycles:>10} {ipc:>6.2f} {lanes:>6.2f}"
+        else:
+            numbers = f"{'-':>10} {'-':>6} {'-':>6}"
+        note = "*" if config.pareto else ""
+        if not config.fits:
+            note = "estimated not to fit"
+        elif config.error:
+            note = config.error
+        print(f"{config.name():<34} {numbers} {config.estimate['lut']:>7} {config.estimate['ff']:>7} "
+              f"{config.estimate['bram']:>5} {config.estimate['dsp']:>5}  {note}".rstrip())
+    print()
+    print("cycles summed over the benchmark set, ipc and lanes averaged over it")
+    print("* on the cycles / estimated LUTs Pareto frontier of its memory model")
+    print(f"~ Estimates, not placed: LUTs, FFs and BRAM scaled from the placed {BASELINE_CONFIG} build with "
+          f"guessed shares per module, DSPs an upper bound from the RTL multipliers. Device {DEVICE_RESOURCES}")
+
+
+def main() -> int:
+    parser = argparse.ArgumentParser(description="GPU design space sweep")
+    parser.add_argument("--cores", type=parse_list, default=[1, 2, 4])
+    parser.add_argument("--warps", type=parse_list, default=[1, 2])
+    parser.add_argument("--threads", type=parse_list, default=[16, 32])
+    parser.add_argument("--data-channels-per-core", type=parse_list, default=[8],
+                        help="the testbench serves at most 64 data channels")
+    parser.add_argument("--instr-channels", type=parse_list, default=[8])
+    parser.add_argument("--mem-model", nargs="+", default=["ideal"],
+                        help="data memory timing models, e.g. ideal fixed:latency=4 banked ddr")
+    parser.add_argument("--out", default=str(LOG_FOLDER.joinpath("sweep")),
+                        help="writes <out>.csv and <out>.json")
+    parser.add_argument("--estimate-only", action="store_true",
+                        help="only print the resource estimates, without building anything")
+    args = parser.parse_args()
+
+    configs = []
+    for cores in args.cores:
+        for warps in args.warps:
+            for threads in args.threads:
+                for channels_per_core in args.data_channels_per_core:
+                    for instr_channels in args.instr_channels:
+                        for mem_model in args.mem_model:
+                            config = Configuration(cores, warps, threads, cores * channels_per_core,
+                                                   instr_channels, mem_model)
+                            config.estimate = estimate_resources(config.parameters())
+                            # DSPs do not decide the fit, multipliers without one go to the fabric
+                            config.fits = all(config.estimate[r] <= DEVICE_RESOURCES[r] for r in BASELINE_UTILISATION)
+                            configs.append(config)
+
+    if not args.estimate_only:
+        built = None
+        for i, config in enumerate(configs):
+            print(f"[{i + 1}/{len(configs)}] {config.name()}", flush=True)
+            if config.data_channels > 64:
+                config.error = "more than 64 data channels"
+                continue
+            # The memory models are the innermost loop, only the first one of a configuration builds
+            run_configuration(config, rebuild=config.parameters() != built)
+            built = config.parameters() if config.results else None
+
+        mark_pareto(configs)
+
+        LOG_FOLDER.mkdir(parents=True, exist_ok=True)
+        write_csv(Path(args.out + ".csv"), configs)
+        with open(args.out + ".json", "w") as file:
+            json.dump({
+                "baseline": {"config": BASELINE_CONFIG, "utilisation": BASELINE_UTILISATION},
+                "estimate_shares": RESOURCE_SHARES,
+                "dsp_per_unit": {"alu": DSP_PER_ALU, "fpu": DSP_PER_FPU},
+                "device": DEVICE_RESOURCES,
+                "configurations": [asdict(config) for config in configs],
+            }, file, indent=2)
+
+    print_summary(configs)
+    if not args.estimate_only:
+        print(f"Results in {args.out}.csv and {args.out}.json")
+
+    return 1 if any(config.error for config in configs) else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
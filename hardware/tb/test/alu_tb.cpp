@@ -21,6 +21,9 @@
 #define JAL        24
 #define BEQ0        26
 #define NOP         29
+#define MULQ        45
+#define SRA         46
+#define SRAI        47
 
 // Base class for testing the sequential ALU
 class ALUTestbench : public BaseTestbench {
@@ -261,3 +264,25 @@ TEST_F(ALUTestbench, NegTest) {
     run_operation(NEG, op1, op2);
     EXPECT_EQ(top->Result, -op1);
 }
+
+TEST_F(ALUTestbench, MulqTest) {
+    resetDUT();
+    // Q16.16: 1.5 * -2.25 = -3.375
+    run_operation(MULQ, 0x00018000, -0x00024000);
+    EXPECT_EQ((int32_t)top->Result, -0x00036000);
+
+    // 3 * 2^-16 * 0.5 rounds half up to 2 * 2^-16
+    resetDUT();
+    run_operation(MULQ, 3, 0x00008000);
+    EXPECT_EQ(top->Result, 2);
+}
+
+TEST_F(ALUTestbench, ShiftRightArithmeticTest) {
+    resetDUT();
+    run_operation(SRA, -64, 3);
+    EXPECT_EQ((int32_t)top->Result, -8);
+
+    resetDUT();
+    run_operation(SRAI, 0x40000000, 0, 16);
+    EXPECT_EQ(top->Result, 0x4000);
+}
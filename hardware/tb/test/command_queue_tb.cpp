@@ -0,0 +1,264 @@
+#include "base_testbench.h"
+#include "../../../code/command_queue.h"
+#include <verilated_cov.h>
+#include <cstdint>
+#include <iostream>
+#include <vector>
+
+#define NAME "command_queue"
+
+#define DEPTH 8
+#define MAX_CYCLES 10000
+
+// kernel_config_t is packed, its first field is the most significant word
+struct Launch {
+    uint32_t base_instr;
+    uint32_t base_data;
+    uint32_t num_blocks;
+    uint32_t warps_per_block;
+};
+
+class CommandQueueTestbench : public BaseTestbench {
+protected:
+    // Stand-in for the dispatcher: done drops on the edge it sees launch and rises kernel_cycles later
+    int kernel_cycles = 20;
+    int remaining = 0;
+    bool dispatcher_done = false;
+    std::vector<Launch> launched;
+    std::vector<int> launch_cycles;
+    int cycle = 0;
+
+    void initializeInputs() override {
+        top->clk = 0;
+        top->reset = 0;
+        top->push = 0;
+        top->push_flags = 0;
+        top->resume = 0;
+        top->interrupt_clear = 0;
+        top->dispatcher_done = 0;
+        setPushConfig({0, 0, 0, 0});
+    }
+
+    void setPushConfig(const Launch& launch) {
+        top->push_config[3] = launch.base_instr;
+        top->push_config[2] = launch.base_data;
+        top->push_config[1] = launch.num_blocks;
+        top->push_config[0] = launch.warps_per_block;
+    }
+
+    void reset() {
+        top->reset = 1;
+        tick();
+        top->reset = 0;
+        remaining = 0;
+        dispatcher_done = false;
+        top->dispatcher_done = 0;
+        launched.clear();
+        launch_cycles.clear();
+        cycle = 0;
+        tick();
+    }
+
+    void tick() {
+        bool launch = top->launch;
+        top->clk = 0;
+        top->eval();
+        top->clk = 1;
+        top->eval();
+        cycle++;
+
+        // --- After the clock edge ---
+        if (launch) {
+            launched.push_back({top->launch_config[3], top->launch_config[2], top->launch_config[1], top->launch_config[0]});
+            launch_cycles.push_back(cycle);
+            dispatcher_done = false;
+            remaining = kernel_cycles;
+        } else if (remaining > 0 && --remaining == 0) {
+            dispatcher_done = true;
+        }
+        top->dispatcher_done = dispatcher_done;
+    }
+
+    // Pushes for one cycle
+    void push(const Launch& launch, uint32_t flags = 0) {
+        setPushConfig(launch);
+        top->push_flags = flags;
+        top->push = 1;
+        tick();
+        top->push = 0;
+        top->push_flags = 0;
+    }
+
+    // Ticks until the queue is idle, returns the cycles it took
+    int waitIdle(int max_cycles = MAX_CYCLES) {
+        int cycles = 0;
+        while (top->busy && cycles < max_cycles) {
+            tick();
+            cycles++;
+        }
+        EXPECT_FALSE(top->busy) << "Queue still busy after " << max_cycles << " cycles";
+        return cycles;
+    }
+
+    static Launch kernel(uint32_t index) { return {0x100 * index, 0x1000 + index, index + 1, 2}; }
+};
+
+// ------------------ RESET TEST ------------------
+TEST_F(CommandQueueTestbench, ResetBehavior) {
+    reset();
+
+    EXPECT_EQ(top->busy, 0);
+    EXPECT_EQ(top->full, 0);
+    EXPECT_EQ(top->fenced, 0);
+    EXPECT_EQ(top->interrupt, 0);
+    EXPECT_EQ(top->count, 0);
+    EXPECT_EQ(top->completed, 0);
+    EXPECT_EQ(top->launch, 0);
+}
+
+// ------------------ ORDER TEST ------------------
+TEST_F(CommandQueueTestbench, RunsLaunchesInOrder) {
+    reset();
+
+    for (uint32_t i = 0; i < 5; i++) {
+        push(kernel(i));
+    }
+    EXPECT_EQ(top->busy, 1);
+    waitIdle();
+
+    ASSERT_EQ(launched.size(), 5u);
+    for (uint32_t i = 0; i < 5; i++) {
+        Launch expected = kernel(i);
+        EXPECT_EQ(launched[i].base_instr, expected.base_instr) << "Launch " << i;
+        EXPECT_EQ(launched[i].base_data, expected.base_data) << "Launch " << i;
+        EXPECT_EQ(launched[i].num_blocks, expected.num_blocks) << "Launch " << i;
+        EXPECT_EQ(launched[i].warps_per_block, expected.warps_per_block) << "Launch " << i;
+    }
+    EXPECT_EQ(top->completed, 5);
+    EXPECT_EQ(top->count, 0);
+}
+
+// ------------------ BACK TO BACK TEST ------------------
+TEST_F(CommandQueueTestbench, LaunchesBackToBack) {
+    reset();
+
+    for (uint32_t i = 0; i < 4; i++) {
+        push(kernel(i));
+    }
+    waitIdle();
+
+    // The only dead cycle is the edge the queue sees done on, the next launch goes out on that same edge
+    ASSERT_EQ(launch_cycles.size(), 4u);
+    for (size_t i = 1; i < launch_cycles.size(); i++) {
+        EXPECT_EQ(launch_cycles[i] - launch_cycles[i - 1], kernel_cycles + 2) << "Gap before launch " << i;
+    }
+}
+
+// ------------------ BUSY TEST ------------------
+TEST_F(CommandQueueTestbench, BusyUntilCounted) {
+    reset();
+
+    push(kernel(0));
+    while (!dispatcher_done) {
+        EXPECT_EQ(top->busy, 1);
+        tick();
+    }
+    // Busy drops on the edge the launch is counted, a host that sees it idle reads the final count
+    EXPECT_EQ(top->busy, 1);
+    tick();
+    EXPECT_EQ(top->busy, 0);
+    EXPECT_EQ(top->completed, 1);
+    EXPECT_EQ(top->launch, 0) << "Nothing left to launch";
+}
+
+// ------------------ FULL QUEUE TEST ------------------
+TEST_F(CommandQueueTestbench, DropsWhenFullOrEmpty) {
+    kernel_cycles = 200;
+    reset();
+
+    // Launches of 0 blocks never finish in the dispatcher, they are not queued
+    push({0x40, 0, 0, 1});
+    EXPECT_EQ(top->count, 0);
+    EXPECT_EQ(top->busy, 0);
+
+    // The first push launches straight away, DEPTH more fill the queue and the last one is dropped
+    for (uint32_t i = 0; i < DEPTH + 2; i++) {
+        push(kernel(i));
+    }
+    EXPECT_EQ(top->full, 1);
+    EXPECT_EQ(top->count, DEPTH);
+
+    waitIdle(MAX_CYCLES * 10);
+    EXPECT_EQ(top->completed, DEPTH + 1);
+    ASSERT_EQ(launched.size(), size_t(DEPTH + 1));
+    EXPECT_EQ(launched[DEPTH].base_instr, kernel(DEPTH).base_instr);
+}
+
+// ------------------ FENCE TEST ------------------
+TEST_F(CommandQueueTestbench, FenceStopsUntilResume) {
+    reset();
+
+    push(kernel(0), LAUNCH_FENCE);
+    push(kernel(1));
+    push(kernel(2));
+
+    int cycles = 0;
+    while (!top->fenced && cycles < MAX_CYCLES) {
+        tick();
+        cycles++;
+    }
+    ASSERT_EQ(top->fenced, 1);
+    EXPECT_EQ(top->completed, 1);
+    EXPECT_EQ(top->count, 2);
+
+    // Nothing runs while fenced, the queue stays busy
+    for (int i = 0; i < 100; i++) tick();
+    EXPECT_EQ(launched.size(), 1u);
+    EXPECT_EQ(top->busy, 1);
+
+    top->resume = 1;
+    tick();
+    top->resume = 0;
+    EXPECT_EQ(top->fenced, 0);
+
+    waitIdle();
+    EXPECT_EQ(top->completed, 3);
+    EXPECT_EQ(top->fenced, 0) << "Only the first launch was fenced";
+    ASSERT_EQ(launched.size(), 3u);
+    EXPECT_EQ(launched[2].base_instr, kernel(2).base_instr);
+}
+
+// ------------------ INTERRUPT TEST ------------------
+TEST_F(CommandQueueTestbench, InterruptOnFlaggedLaunch) {
+    reset();
+
+    push(kernel(0));
+    push(kernel(1), LAUNCH_INTERRUPT);
+    push(kernel(2));
+
+    // Not after the first launch
+    while (top->completed < 1) tick();
+    EXPECT_EQ(top->interrupt, 0);
+
+    while (top->completed < 2) tick();
+    EXPECT_EQ(top->interrupt, 1);
+
+    // Held while the rest of the queue runs, until cleared
+    waitIdle();
+    EXPECT_EQ(top->interrupt, 1);
+    top->interrupt_clear = 1;
+    tick();
+    top->interrupt_clear = 0;
+    EXPECT_EQ(top->interrupt, 0);
+    EXPECT_EQ(top->completed, 3);
+}
+
+// ------------------ MAIN ------------------
+int main(int argc, char **argv) {
+    Verilated::commandArgs(argc, argv);
+    testing::InitGoogleTest(&argc, argv);
+    Verilated::mkdir("logs");
+    auto res = RUN_ALL_TESTS();
+    VerilatedCov::write(("logs/coverage_" + std::string(NAME) + ".dat").c_str());
+    return res;
+}
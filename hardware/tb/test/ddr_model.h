@@ -0,0 +1,76 @@
+#pragma once
+
+#include "memory_model.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// DDR MODEL
+// > Backing store for the DDR port of the DMA engine (dma_engine.sv, gpu.sv), byte addresses of 32-bit words in
+//   [base, base + 4 * words), the region the host reserves for descriptors and buffers
+// > Reads and writes are separate channels (AXI read and write) timed by a MemoryTimingModel, ddr by default
+// > serve() is called after every clock edge, like the data memory loops of the testbenches. Accesses outside
+//   the region read 0xDEADBEEF, are dropped and counted in errors
+// > pointer() hands out host pointers into the store, so code/dma.h can build descriptor chains in it directly
+
+class DdrModel {
+public:
+    DdrModel(uint32_t base, uint32_t words) : base(base), store(words, 0) {
+        std::string error;
+        timing.configure("ddr", error);
+    }
+
+    bool configure(const std::string& spec, std::string& error) { return timing.configure(spec, error); }
+    const MemoryTimingModel& timingModel() const { return timing; }
+
+    void reset() {
+        timing.reset();
+        errors = 0;
+    }
+
+    void tick() { timing.tick(); }
+
+    bool contains(uint32_t address) const {
+        return address >= base && address - base < 4 * store.size() && address % 4 == 0;
+    }
+
+    uint32_t read(uint32_t address) const { return contains(address) ? store[(address - base) / 4] : 0xDEADBEEF; }
+
+    void write(uint32_t address, uint32_t value) {
+        if (contains(address)) store[(address - base) / 4] = value;
+    }
+
+    uint32_t* pointer(uint32_t address) { return contains(address) ? &store[(address - base) / 4] : nullptr; }
+
+    uint64_t errorCount() const { return errors; }
+
+    template <typename Dut>
+    void serve(Dut* top) {
+        top->ddr_read_ready = 0;
+        top->ddr_write_ready = 0;
+
+        uint32_t read_address = top->ddr_read_address;
+        if (timing.respond(READ_CHANNEL, top->ddr_read_valid, read_address / 4)) {
+            if (!contains(read_address)) errors++;
+            top->ddr_read_data = read(read_address);
+            top->ddr_read_ready = 1;
+        }
+
+        uint32_t write_address = top->ddr_write_address;
+        if (timing.respond(WRITE_CHANNEL, top->ddr_write_valid, write_address / 4)) {
+            if (!contains(write_address)) errors++;
+            write(write_address, top->ddr_write_data);
+            top->ddr_write_ready = 1;
+        }
+    }
+
+private:
+    static constexpr int READ_CHANNEL = 0;
+    static constexpr int WRITE_CHANNEL = 1;
+
+    uint32_t base;
+    std::vector<uint32_t> store;
+    MemoryTimingModel timing;
+    uint64_t errors = 0;
+};
@@ -39,7 +39,9 @@
 #define FCVT_S_W 21
 #define BEQZ     22
 #define JAL      23
-#define SYNC     26 // Assuming SYNC has its own ALU code if needed
+#define SYNC     27
+#define SHFL_DOWN 30
+#define SHFL_XOR  31
 
 // Reg input mux encodings
 #define ALU_OUT         0
@@ -90,7 +92,7 @@ protected:
         } else if (opcode == OPCODE_M) {
             uint8_t funct3 = funct4_or_funct3;
             instr |= (funct3 & 0x7) << 10;
-            if (funct3 == 0b000 || funct3 == 0b010) { // Load format
+            if (funct3 == 0b000 || funct3 == 0b010 || funct3 == 0b100 || funct3 == 0b101) { // Load format
                 instr |= (immediate & 0x7FFF) << 14;
             } else { // Store format
                 instr &= ~(0x1F); // Clear rd field
@@ -248,6 +250,33 @@ TEST_F(DecoderTestbench, FTypeInstructions) {
     }
 }
 
+// ------------------ LANE EXCHANGE TESTS ------------------
+TEST_F(DecoderTestbench, LaneExchange) {
+    // shfl.down (R-type): the scalar bit is ignored, lane exchange is vector only
+    resetDecoder();
+    decodeInstruction(makeInstr(OPCODE_R, 0b1100, 5, 10, 15, 0, true));
+    EXPECT_EQ(top->decoded_alu_instruction, SHFL_DOWN);
+    EXPECT_EQ(top->decoded_rs2_address, 15);
+    EXPECT_EQ(top->decoded_scalar_instruction, 0);
+    EXPECT_EQ(top->decoded_reg_input_mux, ALU_OUT);
+
+    // shfl.xori (I-type): lane offset comes from the immediate, rs2 stays x0
+    resetDecoder();
+    decodeInstruction(makeInstr(OPCODE_I, 0b1101, 7, 12, 0, 8, false));
+    EXPECT_EQ(top->decoded_alu_instruction, SHFL_XOR);
+    EXPECT_EQ(top->decoded_rs2_address, 0);
+    EXPECT_EQ(top->decoded_immediate, 8);
+    EXPECT_EQ(top->decoded_scalar_instruction, 0);
+
+    // fshfl.down.s (F-type): float data, int lane offset, float destination
+    resetDecoder();
+    decodeInstruction(makeInstr(OPCODE_F, 0b1100, 3, 8, 13, 0, false));
+    EXPECT_EQ(top->decoded_alu_instruction, SHFL_DOWN);
+    EXPECT_EQ(top->floatingRead, 0b01);
+    EXPECT_EQ(top->floatingWrite, 1);
+    EXPECT_EQ(top->decoded_reg_write_enable, 1);
+}
+
 // ------------------ M-TYPE LOAD/STORE TESTS ------------------
 TEST_F(DecoderTestbench, MTypeLoadStore) {
     // LW: funct3=0b000
@@ -284,6 +313,31 @@ TEST_F(DecoderTestbench, MTypeLoadStore) {
     EXPECT_EQ(top->decoded_reg_write_enable, 0);
 }
 
+// ------------------ UNIFORM (BROADCAST) LOADS ------------------
+TEST_F(DecoderTestbench, UniformLoad) {
+    // LW.U: funct3=0b100, vector instruction with a scalar base register
+    resetDecoder();
+    decodeInstruction(makeInstr(OPCODE_M, 0b100, 4, 6, 0, 0x10, false));
+    EXPECT_EQ(top->decoded_broadcast, 1);
+    EXPECT_EQ(top->decoded_mem_read_enable, 1);
+    EXPECT_EQ(top->decoded_scalar_instruction, 0);
+    EXPECT_EQ(top->decoded_reg_input_mux, LSU_OUT);
+    EXPECT_EQ(top->decoded_rd_address, 4);
+    EXPECT_EQ(top->decoded_rs1_address, 6);
+    EXPECT_EQ(top->floatingWrite, 0);
+
+    // FLW.U: funct3=0b101
+    resetDecoder();
+    decodeInstruction(makeInstr(OPCODE_M, 0b101, 4, 6, 0, 0x10, false));
+    EXPECT_EQ(top->decoded_broadcast, 1);
+    EXPECT_EQ(top->floatingRead, 0b00);
+    EXPECT_EQ(top->floatingWrite, 1);
+
+    // Ordinary vector loads are not broadcast
+    decodeInstruction(makeInstr(OPCODE_M, 0b000, 4, 6, 0, 0x10, false));
+    EXPECT_EQ(top->decoded_broadcast, 0);
+}
+
 // ------------------ UPPER IMMEDIATE TEST ------------------
 TEST_F(DecoderTestbench, UpperImmediate) {
     resetDecoder();
@@ -319,6 +373,40 @@ TEST_F(DecoderTestbench, Branch) {
     EXPECT_EQ(top->decoded_rs1_address, 7);
 }
 
+// ------------------ SYNC (BLOCK BARRIER) TEST ------------------
+TEST_F(DecoderTestbench, SyncBarrier) {
+    resetDecoder();
+    uint32_t instr = makeInstr(OPCODE_J, 0b110, 0, 0, 0, 0, false);
+    decodeInstruction(instr);
+
+    EXPECT_EQ(top->decoded_sync, 1);
+    EXPECT_EQ(top->decoded_grid_sync, 0);
+    EXPECT_EQ(top->decoded_alu_instruction, SYNC);
+    EXPECT_EQ(top->decoded_scalar_instruction, 1);
+    EXPECT_EQ(top->decoded_reg_write_enable, 0);
+    EXPECT_EQ(top->decoded_halt, 0);
+
+    // The flag must not stick to the next instruction
+    decodeInstruction(makeInstr(OPCODE_UP, 0, 6, 0, 0, 0x12345, false));
+    EXPECT_EQ(top->decoded_sync, 0);
+}
+
+// ------------------ GSYNC (GRID BARRIER) TEST ------------------
+TEST_F(DecoderTestbench, GridSyncBarrier) {
+    resetDecoder();
+    decodeInstruction(makeInstr(OPCODE_J, 0b100, 0, 0, 0, 0, false));
+
+    EXPECT_EQ(top->decoded_sync, 1);
+    EXPECT_EQ(top->decoded_grid_sync, 1);
+    EXPECT_EQ(top->decoded_alu_instruction, SYNC);
+    EXPECT_EQ(top->decoded_scalar_instruction, 1);
+    EXPECT_EQ(top->decoded_reg_write_enable, 0);
+
+    decodeInstruction(makeInstr(OPCODE_J, 0b110, 0, 0, 0, 0, false));
+    EXPECT_EQ(top->decoded_sync, 1);
+    EXPECT_EQ(top->decoded_grid_sync, 0);
+}
+
 // ------------------ JUMP AND LINK TEST ------------------
 TEST_F(DecoderTestbench, Jump) {
     resetDecoder();
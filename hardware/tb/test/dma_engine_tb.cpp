@@ -0,0 +1,249 @@
+#include "base_testbench.h"
+#include "ddr_model.h"
+#include "memory_model.h"
+#include "../../../code/dma.h"
+#include <verilated_cov.h>
+#include <cstdint>
+#include <iostream>
+#include <map>
+#include <string>
+
+#define NAME "dma_engine"
+
+// DDR region of the tests, descriptors first and the buffers after them
+#define DDR_BASE 0x1F000000u
+#define DDR_WORDS 4096
+#define DESCRIPTORS_BASE DDR_BASE
+#define BUFFERS_BASE (DDR_BASE + 0x1000)
+#define MAX_DESCRIPTORS 16
+#define MAX_CYCLES 100000
+
+class DmaEngineTestbench : public BaseTestbench {
+protected:
+    DdrModel ddr{DDR_BASE, DDR_WORDS};
+    std::map<uint32_t, uint32_t> data_mem;
+    MemoryTimingModel memory;
+    dma_chain_t chain;
+
+    void initializeInputs() override {
+        top->clk = 0;
+        top->reset = 0;
+        top->start = 0;
+        top->descriptor_address = 0;
+        top->ddr_read_ready = 0;
+        top->ddr_write_ready = 0;
+        top->mem_read_ready = 0;
+        top->mem_write_ready = 0;
+
+        std::string error;
+        memory.configure("ideal", error);
+        dma_chain_init(&chain, ddr.pointer(DESCRIPTORS_BASE), DESCRIPTORS_BASE, MAX_DESCRIPTORS);
+    }
+
+    void reset() {
+        top->reset = 1;
+        tick();
+        top->reset = 0;
+        ddr.reset();
+        memory.reset();
+        tick();
+    }
+
+    void tick() {
+        top->clk = 0;
+        top->eval();
+        top->clk = 1;
+        top->eval();
+        ddr.tick();
+        memory.tick();
+
+        // --- After the clock edge ---
+        ddr.serve(top.get());
+
+        top->mem_read_ready = 0;
+        top->mem_write_ready = 0;
+        if (memory.respond(0, top->mem_read_valid, top->mem_read_address)) {
+            uint32_t addr = top->mem_read_address;
+            top->mem_read_data = data_mem.count(addr) ? data_mem[addr] : 0xDEADBEEF;
+            top->mem_read_ready = 1;
+        }
+        if (memory.respond(1, top->mem_write_valid, top->mem_write_address)) {
+            data_mem[top->mem_write_address] = top->mem_write_data;
+            top->mem_write_ready = 1;
+        }
+    }
+
+    // Starts the chain and returns the cycles until done, start stays high
+    int runChain(int max_cycles = MAX_CYCLES) {
+        top->descriptor_address = dma_chain_head(&chain);
+        top->start = 1;
+        int cycles = 0;
+        while (!top->done && cycles < max_cycles) {
+            tick();
+            cycles++;
+        }
+        EXPECT_TRUE(top->done) << "DMA did not finish within " << max_cycles << " cycles";
+        return cycles;
+    }
+
+    void finish() {
+        top->start = 0;
+        tick();
+    }
+};
+
+// ------------------ RESET TEST ------------------
+TEST_F(DmaEngineTestbench, ResetBehavior) {
+    reset();
+
+    EXPECT_EQ(top->busy, 0);
+    EXPECT_EQ(top->done, 0);
+    EXPECT_EQ(top->ddr_read_valid, 0);
+    EXPECT_EQ(top->ddr_write_valid, 0);
+    EXPECT_EQ(top->mem_read_valid, 0);
+    EXPECT_EQ(top->mem_write_valid, 0);
+    EXPECT_EQ(top->completed_descriptors, 0);
+}
+
+// ------------------ EMPTY CHAIN TEST ------------------
+TEST_F(DmaEngineTestbench, EmptyChainIsDone) {
+    reset();
+
+    runChain(10);
+    EXPECT_EQ(top->completed_descriptors, 0);
+    EXPECT_EQ(top->transferred_words, 0);
+    EXPECT_EQ(top->ddr_read_valid, 0) << "No descriptor should be fetched";
+}
+
+// ------------------ DDR TO DATA MEMORY TEST ------------------
+TEST_F(DmaEngineTestbench, ChainLoadsDataMemory) {
+    // Three arrays into three places of the data memory, the last one word addressed
+    const uint32_t sizes[3] = {20, 7, 33};
+    const uint32_t destinations[3] = {0x100, 0x400, 2048};
+    uint32_t source = BUFFERS_BASE;
+    for (int d = 0; d < 3; d++) {
+        for (uint32_t i = 0; i < sizes[d]; i++) {
+            ddr.write(source + 4 * i, 1000 * d + i);
+        }
+        ASSERT_EQ(dma_chain_add(&chain, source, destinations[d], sizes[d], d == 2 ? DMA_MEM_WORD_STEP : 0), 0);
+        source += 4 * sizes[d];
+    }
+    reset();
+
+    runChain();
+
+    EXPECT_EQ(top->busy, 0);
+    EXPECT_EQ(top->completed_descriptors, 3);
+    EXPECT_EQ(top->transferred_words, 20 + 7 + 33);
+    for (int d = 0; d < 3; d++) {
+        uint32_t step = d == 2 ? 1 : 4;
+        for (uint32_t i = 0; i < sizes[d]; i++) {
+            EXPECT_EQ(data_mem[destinations[d] + step * i], 1000 * d + i) << "Descriptor " << d << ", word " << i;
+        }
+        EXPECT_EQ(data_mem.count(destinations[d] + step * sizes[d]), 0) << "Descriptor " << d << " wrote past its end";
+    }
+    EXPECT_EQ(ddr.errorCount(), 0);
+}
+
+// ------------------ DATA MEMORY TO DDR TEST ------------------
+TEST_F(DmaEngineTestbench, ChainStoresToDdr) {
+    for (uint32_t i = 0; i < 50; i++) {
+        data_mem[0x800 + 4 * i] = 0xA0000000 | i;
+        data_mem[3072 + i] = 0xB0000000 | i;
+    }
+    ASSERT_EQ(dma_chain_add(&chain, BUFFERS_BASE, 0x800, 50, DMA_TO_DDR), 0);
+    ASSERT_EQ(dma_chain_add(&chain, BUFFERS_BASE + 0x400, 3072, 50, DMA_TO_DDR | DMA_MEM_WORD_STEP), 0);
+    reset();
+
+    runChain();
+
+    EXPECT_EQ(top->completed_descriptors, 2);
+    for (uint32_t i = 0; i < 50; i++) {
+        EXPECT_EQ(ddr.read(BUFFERS_BASE + 4 * i), 0xA0000000 | i);
+        EXPECT_EQ(ddr.read(BUFFERS_BASE + 0x400 + 4 * i), 0xB0000000 | i);
+    }
+    EXPECT_EQ(ddr.read(BUFFERS_BASE + 4 * 50), 0) << "Wrote past the end of the buffer";
+    EXPECT_EQ(ddr.errorCount(), 0);
+}
+
+// ------------------ THROUGHPUT TEST ------------------
+TEST_F(DmaEngineTestbench, StreamsOneWordPerCycle) {
+    std::string error;
+    ASSERT_TRUE(ddr.configure("ideal", error)) << error;
+
+    const uint32_t words = 1000;
+    for (uint32_t i = 0; i < words; i++) {
+        ddr.write(BUFFERS_BASE + 4 * i, i * 7);
+    }
+    ASSERT_EQ(dma_chain_add(&chain, BUFFERS_BASE, 0, words, 0), 0);
+    reset();
+
+    int cycles = runChain();
+
+    // Descriptor fetch and the FIFO fill are a fixed cost, the copy itself overlaps reads and writes
+    EXPECT_LE(cycles, int(words) + 20);
+    for (uint32_t i = 0; i < words; i++) {
+        ASSERT_EQ(data_mem[4 * i], i * 7) << "Word " << i;
+    }
+}
+
+// ------------------ SLOW MEMORY TEST ------------------
+TEST_F(DmaEngineTestbench, SlowMemoriesKeepOrder) {
+    std::string error;
+    ASSERT_TRUE(ddr.configure("ddr:bus=0.5", error)) << error;
+    ASSERT_TRUE(memory.configure("banked:latency=5", error)) << error;
+
+    for (uint32_t i = 0; i < 200; i++) {
+        ddr.write(BUFFERS_BASE + 4 * i, 0x5000 + i);
+    }
+    ASSERT_EQ(dma_chain_add(&chain, BUFFERS_BASE, 0x200, 200, 0), 0);
+    ASSERT_EQ(dma_chain_add(&chain, BUFFERS_BASE + 0x1000, 0x200, 200, DMA_TO_DDR), 0);
+    reset();
+
+    runChain();
+
+    EXPECT_EQ(top->completed_descriptors, 2);
+    EXPECT_EQ(top->transferred_words, 400);
+    for (uint32_t i = 0; i < 200; i++) {
+        EXPECT_EQ(data_mem[0x200 + 4 * i], 0x5000 + i);
+        EXPECT_EQ(ddr.read(BUFFERS_BASE + 0x1000 + 4 * i), 0x5000 + i);
+    }
+}
+
+// ------------------ CONTROL PROTOCOL TEST ------------------
+TEST_F(DmaEngineTestbench, DoneHeldUntilStartDropped) {
+    ddr.write(BUFFERS_BASE, 42);
+    ASSERT_EQ(dma_chain_add(&chain, BUFFERS_BASE, 0x10, 1, 0), 0);
+    reset();
+
+    runChain();
+
+    // Start still high: the chain does not run again
+    data_mem.clear();
+    for (int i = 0; i < 50; i++) tick();
+    EXPECT_EQ(top->done, 1);
+    EXPECT_EQ(top->busy, 0);
+    EXPECT_EQ(data_mem.count(0x10), 0);
+
+    finish();
+    EXPECT_EQ(top->done, 0);
+    EXPECT_EQ(top->completed_descriptors, 1) << "Counts stay readable until the next start";
+
+    // A new chain in the same descriptor area
+    dma_chain_clear(&chain);
+    ddr.write(BUFFERS_BASE + 4, 43);
+    ASSERT_EQ(dma_chain_add(&chain, BUFFERS_BASE + 4, 0x20, 1, 0), 0);
+    runChain();
+    EXPECT_EQ(data_mem[0x20], 43);
+    EXPECT_EQ(top->completed_descriptors, 1);
+}
+
+// ------------------ MAIN ------------------
+int main(int argc, char **argv) {
+    Verilated::commandArgs(argc, argv);
+    testing::InitGoogleTest(&argc, argv);
+    Verilated::mkdir("logs");
+    auto res = RUN_ALL_TESTS();
+    VerilatedCov::write(("logs/coverage_" + std::string(NAME) + ".dat").c_str());
+    return res;
+}
@@ -43,10 +43,58 @@ TEST_F(FetcherWrapperTestbench, FetchInstructionTest) {
     EXPECT_EQ(top->instruction_mem_read_valid, 0);
     EXPECT_EQ(top->fetcher_state, 2); // FETCHER_DONE
 
-    // Signal decode phase so it returns to IDLE
+    EXPECT_EQ(top->instruction_address, 0x10);
+
+    // Instruction is held while the warp decodes
+    top->instruction_mem_read_ready = 0;
     top->warp_state = 2; // WARP_DECODE
     runSimulation(1);
-    EXPECT_EQ(top->fetcher_state, 0); // Back to IDLE
+    EXPECT_EQ(top->fetcher_state, 2); // Still FETCHER_DONE
+    EXPECT_EQ(top->instruction, 0x12345678);
+
+    // Once the warp moves on, prefetch the next instruction
+    top->warp_state = 3; // WARP_REQUEST
+    runSimulation(1);
+    EXPECT_EQ(top->fetcher_state, 1); // FETCHER_FETCHING
+    EXPECT_EQ(top->instruction_mem_read_valid, 1);
+    EXPECT_EQ(top->instruction_mem_read_address, 0x11);
+}
+
+// Test: Prefetched instruction doesn't match the pc after a taken branch
+TEST_F(FetcherWrapperTestbench, PrefetchMismatchTest) {
+    top->reset = 0;
+    top->warp_state = 1; // WARP_FETCH
+    top->pc = 0x10;
+    top->instruction_mem_read_ready = 1;
+    top->instruction_mem_read_data = 0x12345678;
+    runSimulation(2);
+    EXPECT_EQ(top->fetcher_state, 2); // FETCHER_DONE
+
+    top->warp_state = 3; // WARP_REQUEST
+    top->instruction_mem_read_data = 0x0badf00d;
+    runSimulation(2);
+    EXPECT_EQ(top->fetcher_state, 2);
+    EXPECT_EQ(top->instruction_address, 0x11);
+    EXPECT_EQ(top->instruction, 0x0badf00d);
+
+    // The warp is still waiting to issue the instruction at pc, nothing past the held one is prefetched
+    runSimulation(1);
+    EXPECT_EQ(top->fetcher_state, 2);
+    EXPECT_EQ(top->instruction_mem_read_valid, 0);
+    EXPECT_EQ(top->instruction_address, 0x11);
+
+    // Branch taken to 0x20: the held instruction is stale and the pc is fetched
+    top->warp_state = 1; // WARP_FETCH
+    top->pc = 0x20;
+    runSimulation(1);
+    EXPECT_EQ(top->fetcher_state, 1); // FETCHER_FETCHING
+    EXPECT_EQ(top->instruction_mem_read_address, 0x20);
+
+    top->instruction_mem_read_data = 0xcafef00d;
+    runSimulation(1);
+    EXPECT_EQ(top->fetcher_state, 2);
+    EXPECT_EQ(top->instruction_address, 0x20);
+    EXPECT_EQ(top->instruction, 0xcafef00d);
 }
 
 // test illegal state - this will cause error which is expected 
@@ -2,25 +2,44 @@
 #include <verilated_cov.h>
 #include <gtest/gtest.h>
 #include <bit>
-
-// Floating ALU Ops
-#define FALU_ADD    12
-#define FALU_SUB    13
-#define FALU_MUL    14
-#define FALU_SLT    15
-#define FALU_NEG    16
-#define FALU_EQ     17
-#define FALU_ABS    19
-#define FALU_FCVT_WS 20
-#define FALU_FCVT_SW 21
+#include <cmath>
+#include <vector>
+
+// Floating ALU Ops (alu_instruction_t values)
+#define FALU_ADD    13
+#define FALU_SUB    14
+#define FALU_MUL    15
+#define FALU_SLT    16
+#define FALU_NEG    17
+#define FALU_EQ     18
+#define FALU_ABS    20
+#define FALU_FCVT_WS 21
+#define FALU_FCVT_SW 22
+#define FALU_MADD   32
+#define FALU_MSUB   33
+#define FALU_ABSDIFF 34
+#define FALU_SQDIFF 35
+#define FALU_MINIDX 36
+#define FALU_ADD_BF2 37
+#define FALU_SUB_BF2 38
+#define FALU_MUL_BF2 39
+#define FALU_SQDIFF_BF2 40
+#define FALU_MIN_BF2 41
+#define FALU_CVT_BF2_S 42
+#define FALU_CVT_S_BF2_LO 43
+#define FALU_CVT_S_BF2_HI 44
+#define FALU_DIV    48
 
 
 class FloatingALUTestbench : public SyncTestbench {
 protected:
     void initializeInputs() override {
+        top->start = 1;     // Every test issues its operands each cycle
+        top->tag = 0;
         top->instruction = 0;
         top->op1 = 0;
         top->op2 = 0;
+        top->op3 = 0;
     }
 
     static uint32_t float_to_bits(float f) {
@@ -30,6 +49,40 @@ protected:
     static float bits_to_float(uint32_t bits) {
         return *reinterpret_cast<float*>(&bits);
     }
+
+    // Round to nearest even bfloat16 (normal values only)
+    static uint16_t to_bf16(float f) {
+        uint32_t bits = float_to_bits(f);
+        return (bits + 0x7FFF + ((bits >> 16) & 1)) >> 16;
+    }
+
+    static float from_bf16(uint16_t h) {
+        return bits_to_float(uint32_t(h) << 16);
+    }
+
+    static uint32_t pack(float lo, float hi) {
+        return (uint32_t(to_bf16(hi)) << 16) | to_bf16(lo);
+    }
+
+    // FDIV holds the FPU while it divides: drain the pipeline, issue once and wait for the result
+    bool issueAndWait(int max_cycles = 64) {
+        top->start = 0;
+        runSimulation(5);
+        if (!top->ready) return false;
+
+        top->start = 1;
+        runSimulation(1);
+        top->start = 0;
+        return waitForValid(max_cycles);
+    }
+
+    bool waitForValid(int max_cycles = 64) {
+        for (int i = 0; i < max_cycles; ++i) {
+            if (top->valid) return true;
+            runSimulation(1);
+        }
+        return false;
+    }
 };
 
 TEST_F(FloatingALUTestbench, AddTest) {
@@ -74,6 +127,228 @@ TEST_F(FloatingALUTestbench, MulTest) {
     EXPECT_FLOAT_EQ(bits_to_float(top->result), expected);
 }
 
+TEST_F(FloatingALUTestbench, DivTest) {
+    struct TestCase {
+        float op1, op2;
+    };
+
+    // Inexact quotients round to nearest even like the C division, centroid means first
+    std::vector<TestCase> test_cases = {
+        {6.0f, 3.0f},
+        {1.0f, 3.0f},
+        {32256.0f, 511.0f},
+        {-5.0f, 2.0f},
+        {2.0f, 3.0f},           // quotient below 1
+        {0.1f, 0.7f},
+        {1e30f, 1e-5f},
+        {-7.5f, -0.25f},
+        {0.0f, 4.0f},
+    };
+
+    for (const auto& tc : test_cases) {
+        top->instruction = FALU_DIV;
+        top->op1 = float_to_bits(tc.op1);
+        top->op2 = float_to_bits(tc.op2);
+
+        ASSERT_TRUE(issueAndWait()) << "div of " << tc.op1 << " / " << tc.op2 << " never finished";
+
+        EXPECT_EQ(top->result, float_to_bits(tc.op1 / tc.op2))
+            << "div failed for " << tc.op1 << " / " << tc.op2;
+    }
+
+    // Overflow and division by zero give infinity, no NaN
+    top->op1 = float_to_bits(1e30f);
+    top->op2 = float_to_bits(1e-30f);
+    ASSERT_TRUE(issueAndWait());
+    EXPECT_EQ(top->result, 0x7F800000u);
+
+    top->op1 = float_to_bits(-3.0f);
+    top->op2 = 0;
+    ASSERT_TRUE(issueAndWait());
+    EXPECT_EQ(top->result, 0xFF800000u);
+
+    // The divider takes one cycle per quotient bit and the FPU takes nothing else meanwhile
+    top->op1 = float_to_bits(1.0f);
+    top->op2 = float_to_bits(3.0f);
+    top->start = 0;
+    runSimulation(5);
+    top->start = 1;
+    runSimulation(1);
+    top->start = 0;
+    for (int i = 0; i < 27; ++i) {
+        EXPECT_EQ(top->ready, 0) << "FPU took an instruction while dividing";
+        EXPECT_EQ(top->valid, 0) << "Quotient out after " << i << " cycles";
+        runSimulation(1);
+    }
+    ASSERT_TRUE(waitForValid());
+    EXPECT_EQ(top->result, float_to_bits(1.0f / 3.0f));
+}
+
+TEST_F(FloatingALUTestbench, FusedMultiplyAddTest) {
+    struct TestCase {
+        float op1, op2, op3;
+    };
+
+    // Inexact products and near-cancellation, the result must be rounded only once
+    std::vector<TestCase> test_cases = {
+        {1.5f, -2.0f, 4.0f},
+        {0.1f, 3.0f, 1.0f},
+        {1.1f, 1.1f, -1.21f},
+        {3.3f, 7.7f, 1e-6f},
+        {2.0f, 8.0f, -16.0f},   // exact cancellation
+        {0.0f, 5.0f, -2.5f},    // zero product
+        {1e-3f, 1e-3f, 1e6f},   // addend dominates
+    };
+
+    for (const auto& tc : test_cases) {
+        top->instruction = FALU_MADD;
+        top->op1 = float_to_bits(tc.op1);
+        top->op2 = float_to_bits(tc.op2);
+        top->op3 = float_to_bits(tc.op3);
+
+        runSimulation(5);
+
+        EXPECT_EQ(top->result, float_to_bits(std::fmaf(tc.op1, tc.op2, tc.op3)))
+            << "fmadd failed for " << tc.op1 << " * " << tc.op2 << " + " << tc.op3;
+
+        top->instruction = FALU_MSUB;
+
+        runSimulation(5);
+
+        EXPECT_EQ(top->result, float_to_bits(std::fmaf(tc.op1, tc.op2, -tc.op3)))
+            << "fmsub failed for " << tc.op1 << " * " << tc.op2 << " - " << tc.op3;
+    }
+}
+
+TEST_F(FloatingALUTestbench, DistanceTest) {
+    struct TestCase {
+        float op1, op2;
+    };
+
+    std::vector<TestCase> test_cases = {
+        {3.0f, 5.5f},
+        {10.3f, 0.7f},
+        {-1.25f, 2.5f},
+        {1.0f, 1.0f},           // zero difference
+        {1.0000001f, 1.0f},     // cancellation
+        {1e6f, 3.3f},           // small operand mostly shifted out
+        {0.0f, -7.1f},
+    };
+
+    for (const auto& tc : test_cases) {
+        float diff = tc.op1 - tc.op2;
+
+        top->instruction = FALU_ABSDIFF;
+        top->op1 = float_to_bits(tc.op1);
+        top->op2 = float_to_bits(tc.op2);
+
+        runSimulation(5);
+
+        EXPECT_EQ(top->result, float_to_bits(std::fabs(diff)))
+            << "absdiff failed for " << tc.op1 << ", " << tc.op2;
+
+        top->instruction = FALU_SQDIFF;
+
+        runSimulation(5);
+
+        EXPECT_EQ(top->result, float_to_bits(diff * diff))
+            << "sqdiff failed for " << tc.op1 << ", " << tc.op2;
+    }
+}
+
+TEST_F(FloatingALUTestbench, MinIndexTest) {
+    struct TestCase {
+        float candidate, best;
+        bool less;
+    };
+
+    std::vector<TestCase> test_cases = {
+        {2.0f, 5.0f, true},
+        {5.0f, 2.0f, false},
+        {3.0f, 3.0f, false},    // ties keep the best so far
+        {-1.5f, 0.5f, true},
+        {-0.0f, 0.0f, false},   // +0 and -0 are equal
+        {-4.0f, -2.0f, true},
+    };
+
+    for (const auto& tc : test_cases) {
+        top->instruction = FALU_MINIDX;
+        top->op1 = float_to_bits(tc.candidate);
+        top->op2 = float_to_bits(tc.best);
+
+        runSimulation(5);
+
+        EXPECT_EQ(top->less, tc.less) << "minidx failed for " << tc.candidate << ", " << tc.best;
+        EXPECT_EQ(top->result, float_to_bits(tc.less ? tc.candidate : tc.best))
+            << "minidx failed for " << tc.candidate << ", " << tc.best;
+    }
+}
+
+TEST_F(FloatingALUTestbench, PackedBf16Test) {
+    struct TestCase {
+        float a_lo, a_hi, b_lo, b_hi;
+    };
+
+    std::vector<TestCase> test_cases = {
+        {3.0f, 5.5f, 1.25f, -2.0f},
+        {10.3f, 0.7f, 0.7f, 10.3f},
+        {-1.25f, 2.5f, 100.0f, 2.5f},   // zero difference in the high half
+        {1.0f, 1.0078125f, 1.0f, 1.0f}, // one ulp apart
+        {33.3f, 17.0f, 12.9f, 60.1f},
+    };
+
+    for (const auto& tc : test_cases) {
+        uint32_t a = pack(tc.a_lo, tc.a_hi);
+        uint32_t b = pack(tc.b_lo, tc.b_hi);
+        float a_lo = from_bf16(a & 0xFFFF), a_hi = from_bf16(a >> 16);
+        float b_lo = from_bf16(b & 0xFFFF), b_hi = from_bf16(b >> 16);
+        float d_lo = from_bf16(to_bf16(a_lo - b_lo)), d_hi = from_bf16(to_bf16(a_hi - b_hi));
+
+        // Single precision results rounded once more are correctly rounded bfloat16
+        struct { int instruction; uint32_t expected; const char* name; } ops[] = {
+            {FALU_ADD_BF2, pack(a_lo + b_lo, a_hi + b_hi), "fadd.bf2"},
+            {FALU_SUB_BF2, pack(a_lo - b_lo, a_hi - b_hi), "fsub.bf2"},
+            {FALU_MUL_BF2, pack(a_lo * b_lo, a_hi * b_hi), "fmul.bf2"},
+            {FALU_SQDIFF_BF2, pack(d_lo * d_lo, d_hi * d_hi), "fsqdiff.bf2"},
+            {FALU_MIN_BF2, pack(std::fmin(a_lo, b_lo), std::fmin(a_hi, b_hi)), "fmin.bf2"},
+        };
+
+        top->op1 = a;
+        top->op2 = b;
+        for (const auto& op : ops) {
+            top->instruction = op.instruction;
+
+            runSimulation(5);
+
+            EXPECT_EQ(top->result, op.expected) << op.name << " failed for " << tc.a_lo << ", " << tc.a_hi << ", " << tc.b_lo << ", " << tc.b_hi;
+        }
+    }
+}
+
+TEST_F(FloatingALUTestbench, Bf16ConvertTest) {
+    top->instruction = FALU_CVT_BF2_S;
+    top->op1 = float_to_bits(3.14159f);
+    top->op2 = float_to_bits(-1234.5678f);
+
+    runSimulation(5);
+
+    uint32_t packed = top->result;
+    EXPECT_EQ(packed, pack(3.14159f, -1234.5678f));
+
+    top->instruction = FALU_CVT_S_BF2_LO;
+    top->op1 = packed;
+
+    runSimulation(5);
+
+    EXPECT_EQ(top->result, float_to_bits(from_bf16(packed & 0xFFFF)));
+
+    top->instruction = FALU_CVT_S_BF2_HI;
+
+    runSimulation(5);
+
+    EXPECT_EQ(top->result, float_to_bits(from_bf16(packed >> 16)));
+}
+
 TEST_F(FloatingALUTestbench, NegTest) {
     float op1 = 7.25f;
     float expected = -7.25f;
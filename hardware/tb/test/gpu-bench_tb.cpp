@@ -0,0 +1,63 @@
+#include "gpu_kernel_testbench.h"
+#include <verilated_cov.h>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+#define NAME "gpu-bench"
+
+// ------------------ COMPILED BENCHMARKS ------------------
+// Programs compiled from code/benchmarks/*.c by bench.py, listed one per line as "<name> <instr.hex> <data.hex>"
+// in the file given with +bench_list=<file>. Skipped without it
+TEST_F(GpuKernelTestbench, CompiledBenchmarks) {
+    std::string list_arg = Verilated::commandArgsPlusMatch("bench_list=");
+    if (list_arg.empty()) {
+        GTEST_SKIP() << "No +bench_list=<file>, run through bench.py";
+    }
+    std::ifstream list(list_arg.substr(std::string("+bench_list=").size()));
+    ASSERT_TRUE(list.is_open()) << "Could not open " << list_arg;
+
+    std::string name, instr_hex, data_hex;
+    while (list >> name >> instr_hex >> data_hex) {
+        data_mem.clear();
+        instr_mem.clear();
+        loadProgramFromHex(instr_hex);
+        loadDataFromHex(data_hex);
+        reset();
+
+        // The compiler runs the kernel's warps itself, the program is a single warp
+        runKernel(1, BENCH_MAX_CYCLES, 1);
+        ASSERT_TRUE(top->execution_done) << name << " did not finish";
+
+        // FNV-1a over the output words, a changed result shows up even when the cycles do not move
+        uint32_t output_hash = 2166136261u;
+        for (const auto& [address, word] : data_mem) {
+            if (address >= COMPILER_OUT_END) break;
+            for (uint32_t value : {address, word}) {
+                for (int b = 0; b < 4; b++) {
+                    output_hash = (output_hash ^ ((value >> (8 * b)) & 0xFF)) * 16777619u;
+                }
+            }
+        }
+
+        uint32_t cycles = readPerfCounter(PERF_CYCLES);
+        uint32_t vector = readPerfCounter(PERF_INSTRUCTIONS_VECTOR);
+        uint32_t instructions = readPerfCounter(PERF_INSTRUCTIONS_SCALAR) + vector;
+        std::cout << "BENCH: kernel=" << name << " cycles=" << cycles << " instructions=" << instructions
+                  << " ipc=" << (cycles ? double(instructions) / cycles : 0.0)
+                  << " lane_utilisation=" << (vector ? double(readPerfCounter(PERF_ACTIVE_LANES)) / (vector * THREADS_PER_WARP) : 0.0)
+                  << " mem_busy_cycles=" << readPerfCounter(PERF_MEM_BUSY_CYCLES)
+                  << " mem_transactions=" << readPerfCounter(PERF_COALESCER_MEM_TRANSACTIONS)
+                  << " output_hash=" << output_hash << " " << memory.summary() << std::endl;
+    }
+}
+
+// ------------------ MAIN ------------------
+int main(int argc, char **argv) {
+    Verilated::commandArgs(argc, argv);
+    testing::InitGoogleTest(&argc, argv);
+    Verilated::mkdir("logs");
+    auto res = RUN_ALL_TESTS();
+    VerilatedCov::write(("logs/coverage_" + std::string(NAME) + ".dat").c_str());
+    return res;
+}
@@ -0,0 +1,99 @@
+#include "gpu_kernel_testbench.h"
+#include <verilated_cov.h>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#define NAME "gpu-dma"
+
+// ------------------ DMA OVERLAP TEST ------------------
+// The DMA engine loads the next tile from DDR while kmeans_assign.asm computes the current one, then copies the
+// labels back to DDR. The kernel has to give the same labels, and in the same time with the ideal memory
+TEST_F(GpuKernelTestbench, DmaOverlapsKernel) {
+    std::vector<float> xs, ys;
+    generatePoints(xs, ys);
+    const uint32_t num_blocks = NUM_POINTS / POINTS_PER_BLOCK;
+
+    loadKMeansDataset(xs, ys, centroids);
+    loadProgramFromHex("../../assembler/tests/expected_output/kmeans_assign.instr.hex");
+
+    // --- Kernel alone ---
+    reset();
+    int alone_cycles = runKernel(num_blocks);
+    std::vector<uint32_t> labels(NUM_POINTS);
+    for (int i = 0; i < NUM_POINTS; i++) {
+        labels[i] = data_mem[LABELS_BASE + i];
+        data_mem.erase(LABELS_BASE + i);
+    }
+
+    // --- Kernel with the next tile loading ---
+    // Tile 1 is the same points mirrored, x then y
+    for (int i = 0; i < NUM_POINTS; i++) {
+        ddr.write(DDR_TILE_BASE + 4 * i, float_to_bits(63.0f - xs[i]));
+        ddr.write(DDR_TILE_BASE + 4 * (NUM_POINTS + i), float_to_bits(63.0f - ys[i]));
+    }
+    dma_chain_t chain;
+    dma_chain_init(&chain, ddr.pointer(DDR_DESCRIPTORS), DDR_DESCRIPTORS, 4);
+    ASSERT_EQ(dma_chain_add(&chain, DDR_TILE_BASE, NEXT_TILE_X_BASE, NUM_POINTS, DMA_MEM_WORD_STEP), 0);
+    ASSERT_EQ(dma_chain_add(&chain, DDR_TILE_BASE + 4 * NUM_POINTS, NEXT_TILE_Y_BASE, NUM_POINTS, DMA_MEM_WORD_STEP), 0);
+
+    reset();
+    top->dma_descriptor_address = dma_chain_head(&chain);
+    top->dma_start = 1;
+    int overlapped_cycles = runKernel(num_blocks);
+    bool dma_done_first = top->dma_done;
+    int dma_extra_cycles = 0;
+    while (!top->dma_done && dma_extra_cycles < 100000) {
+        clockCycle();
+        dma_extra_cycles++;
+    }
+    ASSERT_TRUE(top->dma_done);
+    EXPECT_EQ(top->dma_completed_descriptors, 2u);
+    EXPECT_EQ(top->dma_transferred_words, 2u * NUM_POINTS);
+    top->dma_start = 0;
+    clockCycle();
+
+    for (int i = 0; i < NUM_POINTS; i++) {
+        ASSERT_EQ(data_mem[LABELS_BASE + i], labels[i]) << "Wrong label for point " << i;
+        ASSERT_EQ(data_mem[NEXT_TILE_X_BASE + i], float_to_bits(63.0f - xs[i])) << "Tile x " << i;
+        ASSERT_EQ(data_mem[NEXT_TILE_Y_BASE + i], float_to_bits(63.0f - ys[i])) << "Tile y " << i;
+    }
+
+    // The DMA port is a second port of the data memory, it only slows the cores down through shared timing
+    if (memory.spec() == "ideal") {
+        EXPECT_EQ(overlapped_cycles, alone_cycles);
+    }
+
+    // --- Labels back to DDR ---
+    dma_chain_clear(&chain);
+    ASSERT_EQ(dma_chain_add(&chain, DDR_LABELS_BASE, LABELS_BASE, NUM_POINTS, DMA_TO_DDR | DMA_MEM_WORD_STEP), 0);
+    top->dma_descriptor_address = dma_chain_head(&chain);
+    top->dma_start = 1;
+    int store_cycles = 0;
+    while (!top->dma_done && store_cycles < 100000) {
+        clockCycle();
+        store_cycles++;
+    }
+    ASSERT_TRUE(top->dma_done);
+    top->dma_start = 0;
+    clockCycle();
+
+    for (int i = 0; i < NUM_POINTS; i++) {
+        ASSERT_EQ(ddr.read(DDR_LABELS_BASE + 4 * i), labels[i]) << "Label " << i << " in DDR";
+    }
+    EXPECT_EQ(ddr.errorCount(), 0u);
+
+    std::cout << "DMA: kernel_cycles=" << alone_cycles << " overlapped_cycles=" << overlapped_cycles
+              << " dma_hidden=" << (dma_done_first ? 1 : 0) << " dma_extra_cycles=" << dma_extra_cycles
+              << " store_cycles=" << store_cycles << " " << memory.summary() << std::endl;
+}
+
+// ------------------ MAIN ------------------
+int main(int argc, char **argv) {
+    Verilated::commandArgs(argc, argv);
+    testing::InitGoogleTest(&argc, argv);
+    Verilated::mkdir("logs");
+    auto res = RUN_ALL_TESTS();
+    VerilatedCov::write(("logs/coverage_" + std::string(NAME) + ".dat").c_str());
+    return res;
+}
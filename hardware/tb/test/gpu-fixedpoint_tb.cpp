@@ -0,0 +1,80 @@
+#include "gpu_kernel_testbench.h"
+#include <verilated_cov.h>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#define NAME "gpu-fixedpoint"
+
+// ------------------ FIXED POINT VS FLOAT TEST ------------------
+// Same dataset through kmeans_assign.asm (FPU) and kmeans_assign_q16.asm (integer ALU, Q16.16)
+TEST_F(GpuKernelTestbench, KMeansAssignFixedPointVsFloat) {
+    const uint32_t num_blocks = NUM_POINTS / POINTS_PER_BLOCK;
+
+    // Runs one kernel on the dataset written through convert, returns its cycles and labels
+    auto run = [&](const std::vector<float>& xs, const std::vector<float>& ys, uint32_t (*convert)(float),
+                   const char* program, std::vector<uint32_t>& labels) {
+        data_mem.clear();
+        instr_mem.clear();
+        loadKMeansDataset(xs, ys, centroids, convert);
+        loadProgramFromHex(program);
+        reset();
+        int cycles = runKernel(num_blocks);
+        labels.resize(NUM_POINTS);
+        for (int i = 0; i < NUM_POINTS; i++) {
+            labels[i] = data_mem[LABELS_BASE + i];
+        }
+        return cycles;
+    };
+    const char* float_program = "../../assembler/tests/expected_output/kmeans_assign.instr.hex";
+    const char* q16_program = "../../assembler/tests/expected_output/kmeans_assign_q16.instr.hex";
+
+    // --- Integer coordinates: exact in both formats, so both kernels have to agree on every label ---
+    std::vector<float> xs, ys;
+    std::vector<uint32_t> float_labels, q16_labels;
+    generatePoints(xs, ys);
+    int float_cycles = run(xs, ys, float_to_bits, float_program, float_labels);
+    int q16_cycles = run(xs, ys, float_to_q16, q16_program, q16_labels);
+
+    int mismatches = 0;
+    for (int i = 0; i < NUM_POINTS; i++) {
+        if (q16_labels[i] != float_labels[i]) mismatches++;
+    }
+    EXPECT_EQ(mismatches, 0);
+
+    // --- Fractional coordinates: Q16.16 rounds every coordinate by up to 2^-17 and every mulq by up to 2^-16,
+    // a squared distance of coordinates below 64 is then off by well under 0.01. Away from ties both kernels
+    // have to give the label of the double precision reference
+    const double tie_tolerance = 0.01;
+    generatePoints(xs, ys, true);
+    run(xs, ys, float_to_bits, float_program, float_labels);
+    run(xs, ys, float_to_q16, q16_program, q16_labels);
+
+    int fractional_mismatches = 0;
+    int near_ties = 0;
+    for (int i = 0; i < NUM_POINTS; i++) {
+        if (secondBestGap(xs[i], ys[i], centroids) < tie_tolerance) {
+            near_ties++;
+            continue;
+        }
+        uint32_t expected = referenceLabel(xs[i], ys[i], centroids);
+        EXPECT_EQ(float_labels[i], expected) << "Float kernel, point " << i;
+        EXPECT_EQ(q16_labels[i], expected) << "Q16 kernel, point " << i;
+        if (q16_labels[i] != float_labels[i]) fractional_mismatches++;
+    }
+    EXPECT_LT(near_ties, NUM_POINTS / 16) << "Too many near ties for the check to mean anything";
+
+    std::cout << "FIXEDPOINT: points=" << NUM_POINTS << " float_cycles=" << float_cycles
+              << " q16_cycles=" << q16_cycles << " label_mismatches=" << mismatches
+              << " fractional_label_mismatches=" << fractional_mismatches << " near_ties=" << near_ties << std::endl;
+}
+
+// ------------------ MAIN ------------------
+int main(int argc, char **argv) {
+    Verilated::commandArgs(argc, argv);
+    testing::InitGoogleTest(&argc, argv);
+    Verilated::mkdir("logs");
+    auto res = RUN_ALL_TESTS();
+    VerilatedCov::write(("logs/coverage_" + std::string(NAME) + ".dat").c_str());
+    return res;
+}
@@ -0,0 +1,142 @@
+#include "gpu_kernel_testbench.h"
+#include <verilated_cov.h>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#define NAME "gpu-kmeans"
+
+// ------------------ ON DEVICE K-MEANS TEST ------------------
+// Whole k-means iterations on the GPU: kmeans_assign.asm then kmeans_update.asm, which sums the points of every
+// cluster, divides the sums by the counts with fdiv.s, writes the centroids back in place and counts the points
+// that changed cluster. The host only reads that one word per iteration, at the fence after the update.
+// Written against the RTL but not yet run on a Verilator build, the multi-cycle fdiv.s has its own DivideTest
+// in compute_core_tb.cpp
+TEST_F(GpuKernelTestbench, KMeansOnDevice) {
+    if (THREADS_PER_WARP != 16) {
+        GTEST_SKIP() << "kmeans_update.asm reduces across 16 lanes";
+    }
+    std::vector<float> xs, ys;
+    generatePoints(xs, ys);
+    const uint32_t num_blocks = NUM_POINTS / POINTS_PER_BLOCK;
+
+    loadKMeansDataset(xs, ys, centroids);
+    for (int i = 0; i < NUM_POINTS; i++) {
+        data_mem[PREV_LABELS_BASE + i] = 0xFFFFFFFF; // Every point counts as changed in the first iteration
+    }
+    float cents[NUM_CENTROIDS][2];
+    std::memcpy(cents, centroids, sizeof(cents));
+    data_mem[NUM_POINTS_ADDR] = NUM_POINTS;
+    loadProgramFromHex("../../assembler/tests/expected_output/kmeans_assign.instr.hex");
+    loadProgramFromHex("../../assembler/tests/expected_output/kmeans_update.instr.hex", UPDATE_BASE_INSTR);
+    reset();
+
+    std::vector<uint32_t> labels(NUM_POINTS, 0xFFFFFFFF);
+    int iterations = 0;
+    int cycles = 0;
+    uint32_t changed = 0;
+    do {
+        uint32_t expected_changed = referenceIteration(xs, ys, cents, labels);
+
+        pushKernel(num_blocks);
+        pushKernel(1, LAUNCH_FENCE, UPDATE_BASE_INSTR, 1);
+        if (top->queue_fenced) {
+            top->queue_resume = 1;
+            clockCycle();
+            top->queue_resume = 0;
+        }
+        cycles += 2 + runQueue();
+        ASSERT_TRUE(top->queue_fenced) << "Iteration " << iterations;
+        iterations++;
+
+        changed = data_mem[CHANGED_ADDR];
+        ASSERT_EQ(changed, expected_changed) << "Changed points in iteration " << iterations;
+        for (int i = 0; i < NUM_POINTS; i++) {
+            ASSERT_EQ(data_mem[LABELS_BASE + i], labels[i]) << "Label " << i << " in iteration " << iterations;
+            ASSERT_EQ(data_mem[PREV_LABELS_BASE + i], labels[i]) << "Previous label " << i << " in iteration " << iterations;
+        }
+        for (int k = 0; k < NUM_CENTROIDS; k++) {
+            ASSERT_EQ(data_mem[CENTROIDS_BASE + 2 * k], float_to_bits(cents[k][0])) << "Centroid " << k << " x, iteration " << iterations;
+            ASSERT_EQ(data_mem[CENTROIDS_BASE + 2 * k + 1], float_to_bits(cents[k][1])) << "Centroid " << k << " y, iteration " << iterations;
+        }
+    } while (changed != 0 && iterations < MAX_KMEANS_ITERATIONS);
+
+    EXPECT_EQ(changed, 0u) << "No convergence in " << MAX_KMEANS_ITERATIONS << " iterations";
+    EXPECT_EQ(top->queue_completed, uint32_t(2 * iterations));
+    EXPECT_EQ(top->queue_count, 0u);
+
+    std::cout << "KMEANS: points=" << NUM_POINTS << " iterations=" << iterations << " cycles=" << cycles
+              << " " << memory.summary() << std::endl;
+}
+
+// ------------------ PERSISTENT K-MEANS TEST ------------------
+// kmeans_persistent.asm runs the whole clustering job in one launch: one block per core, every warp assigns a
+// grid-strided share of the points and adds up its partial sums, a gsync, warp 0 reduces the partials and updates
+// the centroids, another gsync and every warp reads whether to go on. It stops at the maximum iteration count or
+// once no more than the threshold of points changed cluster. Not yet run on a Verilator build: until it passes, the
+// grid barrier (grid_sync_release in dispatcher.sv) and the single-launch flow of ps_driver.c are unverified
+TEST_F(GpuKernelTestbench, KMeansPersistent) {
+    if (THREADS_PER_WARP != 16) {
+        GTEST_SKIP() << "kmeans_persistent.asm reduces across 16 lanes";
+    }
+    std::vector<float> xs, ys;
+    generatePoints(xs, ys);
+    loadProgramFromHex("../../assembler/tests/expected_output/kmeans_persistent.instr.hex");
+
+    struct Job {
+        uint32_t max_iterations;
+        uint32_t threshold;
+    };
+    const Job jobs[] = {{MAX_KMEANS_ITERATIONS, 0}, {2, 0}, {MAX_KMEANS_ITERATIONS, NUM_POINTS / 8}};
+
+    for (const Job& job : jobs) {
+        loadKMeansDataset(xs, ys, centroids);
+        for (int i = 0; i < NUM_POINTS; i++) {
+            data_mem[LABELS_BASE + i] = 0xFFFFFFFF; // Every point counts as changed in the first iteration
+        }
+        float cents[NUM_CENTROIDS][2];
+        std::memcpy(cents, centroids, sizeof(cents));
+        data_mem[NUM_POINTS_ADDR] = NUM_POINTS;
+        data_mem[MAX_ITERATIONS_ADDR] = job.max_iterations;
+        data_mem[THRESHOLD_ADDR] = job.threshold;
+        data_mem[GRID_WARPS_ADDR] = NUM_CORES * WARPS_PER_CORE;
+
+        std::vector<uint32_t> labels(NUM_POINTS, 0xFFFFFFFF);
+        uint32_t iterations = 0;
+        uint32_t changed;
+        do {
+            changed = referenceIteration(xs, ys, cents, labels);
+            iterations++;
+        } while (changed > job.threshold && iterations < job.max_iterations);
+
+        // One launch, one wait
+        reset();
+        int cycles = runKernel(NUM_CORES, BENCH_MAX_CYCLES);
+
+        EXPECT_EQ(data_mem[ITERATIONS_ADDR], iterations) << "max_iterations=" << job.max_iterations << " threshold=" << job.threshold;
+        EXPECT_EQ(data_mem[CHANGED_ADDR], changed) << "Changed points in the last iteration";
+        for (int k = 0; k < NUM_CENTROIDS; k++) {
+            EXPECT_EQ(data_mem[CENTROIDS_BASE + 2 * k], float_to_bits(cents[k][0])) << "Centroid " << k << " x";
+            EXPECT_EQ(data_mem[CENTROIDS_BASE + 2 * k + 1], float_to_bits(cents[k][1])) << "Centroid " << k << " y";
+        }
+        for (int i = 0; i < NUM_POINTS; i++) {
+            ASSERT_EQ(data_mem[LABELS_BASE + i], labels[i]) << "Label " << i;
+        }
+        EXPECT_EQ(top->queue_completed, 1u);
+
+        std::cout << "PERSISTENT: cores=" << NUM_CORES << " points=" << NUM_POINTS << " max_iterations=" << job.max_iterations
+                  << " threshold=" << job.threshold << " iterations=" << iterations << " cycles=" << cycles
+                  << " " << memory.summary() << std::endl;
+    }
+}
+
+// ------------------ MAIN ------------------
+int main(int argc, char **argv) {
+    Verilated::commandArgs(argc, argv);
+    testing::InitGoogleTest(&argc, argv);
+    Verilated::mkdir("logs");
+    auto res = RUN_ALL_TESTS();
+    VerilatedCov::write(("logs/coverage_" + std::string(NAME) + ".dat").c_str());
+    return res;
+}
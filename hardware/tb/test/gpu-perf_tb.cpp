@@ -0,0 +1,62 @@
+#include "gpu_kernel_testbench.h"
+#include <verilated_cov.h>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#define NAME "gpu-perf"
+
+// ------------------ PERFORMANCE COUNTER TEST ------------------
+TEST_F(GpuKernelTestbench, KMeansAssignPerfCounters) {
+    std::vector<float> xs, ys;
+    generatePoints(xs, ys);
+    loadKMeansDataset(xs, ys, centroids);
+    loadProgramFromHex("../../assembler/tests/expected_output/kmeans_assign.instr.hex");
+    reset();
+
+    const uint32_t num_blocks = NUM_POINTS / POINTS_PER_BLOCK;
+    int cycles = runKernel(num_blocks);
+
+    // kmeans_assign.asm: 27 instructions (exit included) per warp, 9 of them loads/stores and 11 on the FPU
+    const uint32_t num_warps = num_blocks * WARPS_PER_CORE;
+    uint32_t scalar = readPerfCounter(PERF_INSTRUCTIONS_SCALAR);
+    uint32_t vector = readPerfCounter(PERF_INSTRUCTIONS_VECTOR);
+    EXPECT_EQ(readPerfCounter(PERF_BLOCKS), num_blocks);
+    EXPECT_EQ(scalar + vector, 27 * num_warps);
+    EXPECT_EQ(readPerfCounter(PERF_INSTRUCTIONS_MEMORY), 9 * num_warps);
+    EXPECT_EQ(readPerfCounter(PERF_INSTRUCTIONS_FPU), 11 * num_warps);
+    EXPECT_EQ(readPerfCounter(PERF_ACTIVE_LANES), vector * THREADS_PER_WARP);
+
+    // The counters stop at execution_done, the testbench counts from the start pulse
+    uint32_t perf_cycles = readPerfCounter(PERF_CYCLES);
+    EXPECT_GT(perf_cycles, 0u);
+    EXPECT_LE(perf_cycles, (uint32_t)cycles);
+    EXPECT_GT(readPerfCounter(PERF_MEM_BUSY_CYCLES), 0u);
+    EXPECT_LE(readPerfCounter(PERF_MEM_BUSY_CYCLES), perf_cycles);
+    EXPECT_GT(readPerfCounter(PERF_LSU_WAIT_CYCLES), 0u);
+
+    uint32_t warp_cycles = 0;
+    for (int s = 0; s < NUM_WARP_STATES; s++) {
+        warp_cycles += readPerfCounter(PERF_WARP_STATE_CYCLES + s);
+    }
+    EXPECT_GT(warp_cycles, 0u);
+
+    // The snapshot holds until the next kernel is done
+    for (int i = 0; i < 10; i++) clockCycle();
+    EXPECT_EQ(readPerfCounter(PERF_BLOCKS), num_blocks);
+
+    std::cout << "PERF: cycles=" << perf_cycles << " instructions=" << scalar + vector
+              << " lane_utilisation=" << double(readPerfCounter(PERF_ACTIVE_LANES)) / (vector * THREADS_PER_WARP)
+              << " mem_busy_cycles=" << readPerfCounter(PERF_MEM_BUSY_CYCLES)
+              << " lsu_wait_cycles=" << readPerfCounter(PERF_LSU_WAIT_CYCLES) << std::endl;
+}
+
+// ------------------ MAIN ------------------
+int main(int argc, char **argv) {
+    Verilated::commandArgs(argc, argv);
+    testing::InitGoogleTest(&argc, argv);
+    Verilated::mkdir("logs");
+    auto res = RUN_ALL_TESTS();
+    VerilatedCov::write(("logs/coverage_" + std::string(NAME) + ".dat").c_str());
+    return res;
+}
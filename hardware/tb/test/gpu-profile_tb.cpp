@@ -0,0 +1,65 @@
+#include "gpu_kernel_testbench.h"
+#include <verilated_cov.h>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#define NAME "gpu-profile"
+
+// ------------------ PROFILER TEST ------------------
+// Cycle accounting of kmeans_assign.asm, mapped back to its lines through the assembler's line map
+TEST_F(GpuKernelTestbench, KMeansAssignProfile) {
+    std::vector<float> xs, ys;
+    generatePoints(xs, ys);
+    loadKMeansDataset(xs, ys, centroids);
+    loadProgramFromHex("../../assembler/tests/expected_output/kmeans_assign.instr.hex");
+    ASSERT_TRUE(profiler.loadLineMap("../../assembler/tests/expected_output/kmeans_assign.lines"));
+    reset();
+
+    const uint32_t num_blocks = NUM_POINTS / POINTS_PER_BLOCK;
+    profiling = true;
+    int cycles = runKernel(num_blocks);
+    profiling = false;
+
+    // Straight line kernel: all 27 instructions (exit included) are charged in every block and nothing else is
+    EXPECT_EQ(profiler.profiles().size(), 27u);
+    for (uint32_t pc = 0; pc < 27; pc++) {
+        EXPECT_GE(profiler.pcCycles(pc), num_blocks) << "PC " << pc;
+    }
+
+    // Every sampled warp cycle lands on exactly one PC and one state
+    uint64_t state_cycles = 0;
+    for (int s = 0; s < PROFILER_NUM_WARP_STATES; s++) {
+        state_cycles += profiler.stateCycles(s);
+    }
+    EXPECT_EQ(state_cycles, profiler.totalCycles());
+    EXPECT_GT(profiler.totalCycles(), 0u);
+    EXPECT_LE(profiler.totalCycles(), uint64_t(cycles) * NUM_CORES * WARPS_PER_CORE);
+
+    // No divergence, every cycle runs with all lanes enabled
+    for (const auto& [pc, profile] : profiler.profiles()) {
+        EXPECT_EQ(profile.lane_cycles, profile.cycles * THREADS_PER_WARP) << "PC " << pc;
+    }
+
+    const std::string asm_path = "../../assembler/tests/asm_files/kmeans_assign.asm";
+    ASSERT_TRUE(profiler.writeListing("logs/profile_kmeans_assign.txt", asm_path));
+    ASSERT_TRUE(profiler.writeFoldedStacks("logs/profile_kmeans_assign.folded", asm_path));
+
+    uint32_t hottest = 0;
+    for (const auto& [pc, profile] : profiler.profiles()) {
+        if (profile.cycles > profiler.pcCycles(hottest)) hottest = pc;
+    }
+    std::cout << "PROFILE: warp_cycles=" << profiler.totalCycles() << " hottest_pc=" << hottest
+              << " hottest_cycles=" << profiler.pcCycles(hottest)
+              << " listing=logs/profile_kmeans_assign.txt folded=logs/profile_kmeans_assign.folded" << std::endl;
+}
+
+// ------------------ MAIN ------------------
+int main(int argc, char **argv) {
+    Verilated::commandArgs(argc, argv);
+    testing::InitGoogleTest(&argc, argv);
+    Verilated::mkdir("logs");
+    auto res = RUN_ALL_TESTS();
+    VerilatedCov::write(("logs/coverage_" + std::string(NAME) + ".dat").c_str());
+    return res;
+}
@@ -0,0 +1,89 @@
+#include "gpu_kernel_testbench.h"
+#include <verilated_cov.h>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#define NAME "gpu-queue"
+
+// ------------------ COMMAND QUEUE TEST ------------------
+// Several kmeans_assign.asm launches pushed at once run back to back, without a start/done handshake in between.
+// A fenced launch stops the queue so the host can move the centroids before the next one
+TEST_F(GpuKernelTestbench, CommandQueueBackToBack) {
+    std::vector<float> xs, ys;
+    generatePoints(xs, ys);
+    const uint32_t num_blocks = NUM_POINTS / POINTS_PER_BLOCK;
+    const int launches = 3;
+
+    loadKMeansDataset(xs, ys, centroids);
+    loadProgramFromHex("../../assembler/tests/expected_output/kmeans_assign.instr.hex");
+
+    // --- One launch through execution_start ---
+    reset();
+    int single_cycles = runKernel(num_blocks);
+    EXPECT_EQ(top->queue_completed, 1u);
+
+    // --- Back to back ---
+    reset();
+    for (int l = 0; l < launches; l++) {
+        pushKernel(num_blocks, l == launches - 1 ? LAUNCH_INTERRUPT : 0);
+    }
+    EXPECT_TRUE(top->queue_busy);
+    EXPECT_FALSE(top->execution_done) << "execution_done waits for the whole queue";
+    int queued_cycles = launches + runQueue();
+
+    EXPECT_FALSE(top->queue_busy);
+    EXPECT_TRUE(top->execution_done);
+    EXPECT_EQ(top->queue_completed, uint32_t(launches));
+    EXPECT_EQ(top->queue_count, 0u);
+    EXPECT_EQ(readPerfCounter(PERF_BLOCKS), num_blocks) << "Counters are per kernel";
+    EXPECT_TRUE(top->queue_interrupt);
+    top->queue_interrupt_clear = 1;
+    clockCycle();
+    top->queue_interrupt_clear = 0;
+    EXPECT_FALSE(top->queue_interrupt);
+
+    for (int i = 0; i < NUM_POINTS; i++) {
+        ASSERT_EQ(data_mem[LABELS_BASE + i], referenceLabel(xs[i], ys[i], centroids)) << "Wrong label for point " << i;
+    }
+
+    // One dead cycle per launch at most, where separate launches pay the host round trip on top
+    EXPECT_LE(queued_cycles, launches * (single_cycles + 1));
+
+    // --- Fence: the host moves the centroids between two launches ---
+    static const float moved[NUM_CENTROIDS][2] = {{60.0f, 60.0f}, {5.0f, 40.0f}, {40.0f, 5.0f}};
+    reset();
+    pushKernel(num_blocks, LAUNCH_FENCE);
+    pushKernel(num_blocks);
+    runQueue();
+    ASSERT_TRUE(top->queue_fenced);
+    EXPECT_EQ(top->queue_completed, 1u);
+    EXPECT_EQ(top->queue_count, 1u);
+
+    for (int i = 0; i < 100; i++) clockCycle();
+    EXPECT_EQ(top->queue_completed, 1u) << "Nothing runs past the fence";
+    writeCentroids(moved);
+    top->queue_resume = 1;
+    clockCycle();
+    top->queue_resume = 0;
+    runQueue();
+
+    EXPECT_FALSE(top->queue_fenced);
+    EXPECT_EQ(top->queue_completed, 2u);
+    for (int i = 0; i < NUM_POINTS; i++) {
+        ASSERT_EQ(data_mem[LABELS_BASE + i], referenceLabel(xs[i], ys[i], moved)) << "Wrong label after the fence, point " << i;
+    }
+
+    std::cout << "QUEUE: launches=" << launches << " single_cycles=" << single_cycles
+              << " queued_cycles=" << queued_cycles << " " << memory.summary() << std::endl;
+}
+
+// ------------------ MAIN ------------------
+int main(int argc, char **argv) {
+    Verilated::commandArgs(argc, argv);
+    testing::InitGoogleTest(&argc, argv);
+    Verilated::mkdir("logs");
+    auto res = RUN_ALL_TESTS();
+    VerilatedCov::write(("logs/coverage_" + std::string(NAME) + ".dat").c_str());
+    return res;
+}
@@ -0,0 +1,37 @@
+#include "gpu_kernel_testbench.h"
+#include <verilated_cov.h>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#define NAME "gpu-scaling"
+
+// ------------------ K-MEANS ASSIGNMENT SCALING TEST ------------------
+TEST_F(GpuKernelTestbench, KMeansAssignScaling) {
+    std::vector<float> xs, ys;
+    generatePoints(xs, ys);
+    loadKMeansDataset(xs, ys, centroids);
+
+    loadProgramFromHex("../../assembler/tests/expected_output/kmeans_assign.instr.hex");
+    reset();
+
+    int cycles = runKernel(NUM_POINTS / POINTS_PER_BLOCK);
+
+    for (int i = 0; i < NUM_POINTS; i++) {
+        ASSERT_EQ(data_mem[LABELS_BASE + i], referenceLabel(xs[i], ys[i], centroids)) << "Wrong label for point " << i;
+    }
+
+    // Picked up by scaling.sh to compute the speedup
+    std::cout << "SCALING: cores=" << NUM_CORES << " channels=" << DATA_MEM_NUM_CHANNELS
+              << " points=" << NUM_POINTS << " cycles=" << cycles << std::endl;
+}
+
+// ------------------ MAIN ------------------
+int main(int argc, char **argv) {
+    Verilated::commandArgs(argc, argv);
+    testing::InitGoogleTest(&argc, argv);
+    Verilated::mkdir("logs");
+    auto res = RUN_ALL_TESTS();
+    VerilatedCov::write(("logs/coverage_" + std::string(NAME) + ".dat").c_str());
+    return res;
+}
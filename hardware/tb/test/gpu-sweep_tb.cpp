@@ -0,0 +1,66 @@
+#include "gpu_kernel_testbench.h"
+#include <verilated_cov.h>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#define NAME "gpu-sweep"
+
+// ------------------ BENCHMARK SET ------------------
+// Fixed kernel set of the design space sweep (sweep.py), one BENCH line per kernel for the configuration
+// the testbench was built with
+TEST_F(GpuKernelTestbench, KMeansBenchmarks) {
+    struct Benchmark {
+        const char* name;
+        const char* hex;
+        uint32_t (*to_word)(float);
+    };
+    const Benchmark benchmarks[] = {
+        {"kmeans_assign", "../../assembler/tests/expected_output/kmeans_assign.instr.hex", float_to_bits},
+        {"kmeans_assign_q16", "../../assembler/tests/expected_output/kmeans_assign_q16.instr.hex", float_to_q16},
+    };
+
+    std::vector<float> xs, ys;
+    generatePoints(xs, ys);
+    const uint32_t num_blocks = NUM_POINTS / POINTS_PER_BLOCK;
+
+    for (const Benchmark& benchmark : benchmarks) {
+        data_mem.clear();
+        instr_mem.clear();
+        loadKMeansDataset(xs, ys, centroids, benchmark.to_word);
+        loadProgramFromHex(benchmark.hex);
+        reset();
+        runKernel(num_blocks);
+
+        // A configuration that computes the wrong labels is not a candidate, whatever its cycles
+        for (int i = 0; i < NUM_POINTS; i++) {
+            ASSERT_LT(data_mem[LABELS_BASE + i], uint32_t(NUM_CENTROIDS)) << benchmark.name << ": point " << i;
+        }
+
+        uint32_t cycles = readPerfCounter(PERF_CYCLES);
+        uint32_t instructions = readPerfCounter(PERF_INSTRUCTIONS_SCALAR) + readPerfCounter(PERF_INSTRUCTIONS_VECTOR);
+        uint32_t vector = readPerfCounter(PERF_INSTRUCTIONS_VECTOR);
+        ASSERT_GT(cycles, 0u);
+
+        // IPC in warp instructions over the whole GPU, lane utilisation over the vector instructions
+        std::cout << "BENCH: kernel=" << benchmark.name << " cores=" << NUM_CORES << " warps=" << WARPS_PER_CORE
+                  << " threads=" << THREADS_PER_WARP << " data_channels=" << DATA_MEM_NUM_CHANNELS
+                  << " instr_channels=" << INSTRUCTION_MEM_NUM_CHANNELS << " points=" << NUM_POINTS
+                  << " cycles=" << cycles << " instructions=" << instructions
+                  << " ipc=" << double(instructions) / cycles
+                  << " lane_utilisation=" << (vector ? double(readPerfCounter(PERF_ACTIVE_LANES)) / (vector * THREADS_PER_WARP) : 0.0)
+                  << " mem_busy_cycles=" << readPerfCounter(PERF_MEM_BUSY_CYCLES)
+                  << " mem_transactions=" << readPerfCounter(PERF_COALESCER_MEM_TRANSACTIONS)
+                  << " " << memory.summary() << std::endl;
+    }
+}
+
+// ------------------ MAIN ------------------
+int main(int argc, char **argv) {
+    Verilated::commandArgs(argc, argv);
+    testing::InitGoogleTest(&argc, argv);
+    Verilated::mkdir("logs");
+    auto res = RUN_ALL_TESTS();
+    VerilatedCov::write(("logs/coverage_" + std::string(NAME) + ".dat").c_str());
+    return res;
+}
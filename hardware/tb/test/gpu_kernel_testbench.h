@@ -0,0 +1,384 @@
+#pragma once
+
+// Fixture of the testbenches that run whole kernels on gpu.sv (test/gpu-*_tb.cpp): data memory behind a timing
+// model, DDR and the DMA engine, instruction memory, kernel launches through execution_start or the command
+// queue, the counter block, and the host side k-means reference the kernels are checked against
+
+#include "base_testbench.h"
+#include "ddr_model.h"
+#include "memory_model.h"
+#include "profiler.h"
+#include "../../../code/dma.h"
+#include "../../../code/command_queue.h"
+#include "../../../code/perf_counters.h"
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// GPU Parameters, override together with the module parameters (see scaling.sh and sweep.py):
+//   VERILATOR_FLAGS="-GNUM_CORES=4 -GDATA_MEM_NUM_CHANNELS=32 -CFLAGS -DNUM_CORES=4 -CFLAGS -DDATA_MEM_NUM_CHANNELS=32"
+#ifndef NUM_CORES
+#define NUM_CORES 1
+#endif
+#ifndef DATA_MEM_NUM_CHANNELS
+#define DATA_MEM_NUM_CHANNELS 8 // Shared by all the cores, as in top.sv
+#endif
+#ifndef INSTRUCTION_MEM_NUM_CHANNELS
+#define INSTRUCTION_MEM_NUM_CHANNELS 8
+#endif
+#ifndef WARPS_PER_CORE
+#define WARPS_PER_CORE 1
+#endif
+#ifndef THREADS_PER_WARP
+#define THREADS_PER_WARP 16
+#endif
+
+// Every block runs WARPS_PER_CORE warps, so it handles POINTS_PER_BLOCK points
+#define POINTS_PER_BLOCK (THREADS_PER_WARP * WARPS_PER_CORE)
+
+// K-means assignment step (kmeans_assign.asm), word addresses
+#define NUM_POINTS 512
+#define NUM_CENTROIDS 3
+#define POINTS_X_BASE 1024
+#define POINTS_Y_BASE 2048
+#define CENTROIDS_BASE 600
+#define LABELS_BASE 3072
+
+// K-means update step (kmeans_update.asm): one warp, loaded behind kmeans_assign.asm in instruction memory
+#define UPDATE_BASE_INSTR 256
+#define NUM_POINTS_ADDR 606
+#define CHANGED_ADDR 607
+#define PREV_LABELS_BASE 3584
+#define MAX_KMEANS_ITERATIONS 20
+
+// Persistent k-means (kmeans_persistent.asm): one launch of NUM_CORES blocks loops over the iterations itself,
+// the labels of the last iteration count as the previous ones
+#define MAX_ITERATIONS_ADDR 608
+#define THRESHOLD_ADDR 609
+#define GRID_WARPS_ADDR 610
+#define ITERATIONS_ADDR 611
+
+// Compiled C benchmarks (bench.py): the compiler copies OUT arrays down from this byte address
+// (Context::out_offset) and the assembler's data section starts at 0, so the words below it are the output
+#define COMPILER_OUT_END 2500
+#define BENCH_MAX_CYCLES 10000000
+
+// DMA engine: DDR region the host reserves (descriptors, then its buffers) and where the next tile lands,
+// word addresses above the kmeans_assign.asm layout
+#define DDR_BASE 0x1F000000u
+#define DDR_WORDS 0x10000
+#define DDR_DESCRIPTORS DDR_BASE
+#define DDR_TILE_BASE (DDR_BASE + 0x1000)
+#define DDR_LABELS_BASE (DDR_BASE + 0x3000)
+#define NEXT_TILE_X_BASE 4096
+#define NEXT_TILE_Y_BASE 5120
+
+class GpuKernelTestbench : public BaseTestbench {
+protected:
+    std::map<uint32_t, uint32_t> instr_mem;
+    std::map<uint32_t, uint32_t> data_mem;
+
+    MemoryTimingModel memory;
+    DdrModel ddr{DDR_BASE, DDR_WORDS};
+
+    // Sampled after every clock edge while set
+    CycleProfiler profiler;
+    bool profiling = false;
+
+    void initializeInputs() override {
+        top->clk = 0;
+        top->reset = 1;
+        top->execution_start = 0;
+
+        top->base_instr = 0;
+        top->base_data = 0;
+        top->num_blocks = 1;
+        top->warps_per_block = WARPS_PER_CORE;
+
+        // Data memory answers when the timing model says so (+mem_model=<spec>, ideal by default),
+        // instruction memory is on-chip and answers every channel in the cycle after the request
+        top->data_mem_read_ready = 0;
+        top->data_mem_write_ready = 0;
+        top->instruction_mem_read_ready = -1;
+
+        std::string model_arg = Verilated::commandArgsPlusMatch("mem_model=");
+        std::string spec = model_arg.empty() ? "ideal" : model_arg.substr(std::string("+mem_model=").size());
+        std::string error;
+        ASSERT_TRUE(memory.configure(spec, error)) << error;
+
+        // DMA engine idle, DDR behind its own timing model (+ddr_model=<spec>, ddr by default)
+        top->dma_start = 0;
+        top->dma_descriptor_address = 0;
+        top->ddr_read_ready = 0;
+        top->ddr_write_ready = 0;
+        top->dma_mem_read_ready = 0;
+        top->dma_mem_write_ready = 0;
+
+        // Command queue only used through execution_start unless a test pushes
+        top->queue_push = 0;
+        top->queue_push_flags = 0;
+        top->queue_resume = 0;
+        top->queue_interrupt_clear = 0;
+
+        std::string ddr_arg = Verilated::commandArgsPlusMatch("ddr_model=");
+        if (!ddr_arg.empty()) {
+            ASSERT_TRUE(ddr.configure(ddr_arg.substr(std::string("+ddr_model=").size()), error)) << error;
+        }
+    }
+
+    void reset() {
+        top->reset = 1;
+        clockCycle();
+        clockCycle();
+        top->reset = 0;
+        memory.reset();
+        ddr.reset();
+        clockCycle();
+    }
+
+    void clockCycle() {
+        top->clk = 0;
+        top->eval();
+        top->clk = 1;
+        top->eval();
+        memory.tick();
+        ddr.tick();
+
+        // --- After the clock edge ---
+        uint64_t read_ready = 0, write_ready = 0;
+        for (int i = 0; i < DATA_MEM_NUM_CHANNELS; i++) {
+            bool read = (top->data_mem_read_valid >> i) & 1;
+            bool write = (top->data_mem_write_valid >> i) & 1;
+            uint32_t addr = write ? top->data_mem_write_address[i] : top->data_mem_read_address[i];
+            if (!memory.respond(i, read || write, addr)) continue;
+
+            if (read) {
+                top->data_mem_read_data[i] = data_mem.count(addr) ? data_mem[addr] : 0xDEADBEEF;
+                read_ready |= uint64_t(1) << i;
+            }
+            if (write) {
+                data_mem[addr] = top->data_mem_write_data[i];
+                write_ready |= uint64_t(1) << i;
+            }
+        }
+        top->data_mem_read_ready = read_ready;
+        top->data_mem_write_ready = write_ready;
+
+        // The DMA engine's port is one more channel of the same data memory, it reads or writes, never both
+        ddr.serve(top.get());
+        top->dma_mem_read_ready = 0;
+        top->dma_mem_write_ready = 0;
+        uint32_t dma_addr = top->dma_mem_write_valid ? top->dma_mem_write_address : top->dma_mem_read_address;
+        if (memory.respond(DATA_MEM_NUM_CHANNELS, top->dma_mem_read_valid || top->dma_mem_write_valid, dma_addr)) {
+            if (top->dma_mem_read_valid) {
+                top->dma_mem_read_data = data_mem.count(dma_addr) ? data_mem[dma_addr] : 0xDEADBEEF;
+                top->dma_mem_read_ready = 1;
+            }
+            if (top->dma_mem_write_valid) {
+                data_mem[dma_addr] = top->dma_mem_write_data;
+                top->dma_mem_write_ready = 1;
+            }
+        }
+        for (int i = 0; i < INSTRUCTION_MEM_NUM_CHANNELS; i++) {
+            if ((top->instruction_mem_read_valid >> i) & 1) {
+                uint32_t addr = top->instruction_mem_read_address[i];
+                top->instruction_mem_read_data[i] = instr_mem.count(addr) ? instr_mem[addr] : 0;
+            }
+        }
+
+        if (profiling) {
+            for (int w = 0; w < NUM_CORES * WARPS_PER_CORE; w++) {
+                profiler.sample(top->debug_warp_state[w], top->debug_warp_pc[w], top->debug_warp_execution_mask[w]);
+            }
+        }
+    }
+
+    // Loads a kernel at a word address of instruction memory, jumps and branches are PC relative
+    void loadProgramFromHex(const std::string& hex_filepath, uint32_t base_address = 0) {
+        std::ifstream hex_file(hex_filepath);
+        ASSERT_TRUE(hex_file.is_open()) << "Could not open hex file: " << hex_filepath;
+
+        std::string line;
+        uint32_t address = base_address;
+        while (std::getline(hex_file, line)) {
+            if (line.empty()) continue;
+            std::stringstream ss;
+            ss << std::hex << line;
+            ss >> instr_mem[address++];
+        }
+    }
+
+    // Data section of the assembler (.data.hex), one word per line at byte addresses from 0
+    void loadDataFromHex(const std::string& hex_filepath) {
+        std::ifstream hex_file(hex_filepath);
+        ASSERT_TRUE(hex_file.is_open()) << "Could not open data hex file: " << hex_filepath;
+
+        std::string line;
+        uint32_t address = 0;
+        while (std::getline(hex_file, line)) {
+            if (line.empty()) continue;
+            std::stringstream ss;
+            ss << std::hex << line;
+            ss >> data_mem[address];
+            address += 4;
+        }
+    }
+
+    // Runs the kernel and returns the number of cycles from launch to execution_done
+    int runKernel(uint32_t num_blocks, int max_cycles = 500000, uint32_t warps_per_block = WARPS_PER_CORE) {
+        top->base_instr = 0;
+        top->base_data = 0;
+        top->num_blocks = num_blocks;
+        top->warps_per_block = warps_per_block;
+        for (int i = 0; i < 4; i++) clockCycle();
+
+        top->execution_start = 1;
+        clockCycle();
+        top->execution_start = 0;
+
+        int cycles = 1;
+        while (!top->execution_done && cycles < max_cycles) {
+            clockCycle();
+            cycles++;
+        }
+        EXPECT_TRUE(top->execution_done) << "GPU did not finish within " << max_cycles << " cycles";
+        return cycles;
+    }
+
+    // Pushes a launch into the command queue (kmeans_assign.asm by default), like command_queue_push() does on the host
+    void pushKernel(uint32_t num_blocks, uint32_t flags = 0, uint32_t base_instr = 0,
+                    uint32_t warps_per_block = WARPS_PER_CORE) {
+        top->base_instr = base_instr;
+        top->base_data = 0;
+        top->num_blocks = num_blocks;
+        top->warps_per_block = warps_per_block;
+        top->queue_push_flags = flags;
+        top->queue_push = 1;
+        clockCycle();
+        top->queue_push = 0;
+        top->queue_push_flags = 0;
+    }
+
+    // Runs the queue until it is idle or stopped at a fence, returns the cycles it took
+    int runQueue(int max_cycles = 2000000) {
+        int cycles = 0;
+        while (top->queue_busy && !top->queue_fenced && cycles < max_cycles) {
+            clockCycle();
+            cycles++;
+        }
+        EXPECT_TRUE(!top->queue_busy || top->queue_fenced) << "Queue did not finish within " << max_cycles << " cycles";
+        return cycles;
+    }
+
+    // Reads the counter block the same way the host does, through its word index
+    uint32_t readPerfCounter(int index) {
+        top->perf_read_address = index;
+        top->eval();
+        return top->perf_read_data;
+    }
+
+    // Label kmeans_assign.asm gives a point, ties keep the lower centroid like the strict compare of fminidx.s
+    static uint32_t referenceLabel(float x, float y, const float (*cents)[2]) {
+        uint32_t best = 0;
+        float best_distance = 0;
+        for (int k = 0; k < NUM_CENTROIDS; k++) {
+            float dx = x - cents[k][0];
+            float dy = y - cents[k][1];
+            float distance = dx * dx + dy * dy;
+            if (k == 0 || distance < best_distance) {
+                best = k;
+                best_distance = distance;
+            }
+        }
+        return best;
+    }
+
+    // One k-means iteration on the host: labels with the current centroids, then the means of the clusters.
+    // Integer coordinates keep every sum exact, so only the division rounds. Returns the points that changed cluster
+    static uint32_t referenceIteration(const std::vector<float>& xs, const std::vector<float>& ys,
+                                       float (*cents)[2], std::vector<uint32_t>& labels) {
+        uint32_t changed = 0;
+        int sums[NUM_CENTROIDS][2] = {};
+        int counts[NUM_CENTROIDS] = {};
+        for (int i = 0; i < NUM_POINTS; i++) {
+            uint32_t label = referenceLabel(xs[i], ys[i], cents);
+            changed += (label != labels[i]);
+            labels[i] = label;
+            sums[label][0] += int(xs[i]);
+            sums[label][1] += int(ys[i]);
+            counts[label]++;
+        }
+        for (int k = 0; k < NUM_CENTROIDS; k++) {
+            if (counts[k] == 0) continue; // An empty cluster keeps its centroid
+            cents[k][0] = float(sums[k][0]) / float(counts[k]);
+            cents[k][1] = float(sums[k][1]) / float(counts[k]);
+        }
+        return changed;
+    }
+
+    static uint32_t float_to_bits(float f) {
+        uint32_t bits;
+        std::memcpy(&bits, &f, sizeof(bits));
+        return bits;
+    }
+
+    // Host side conversion for the Q16.16 kernels, same as to_value() in code/ps_driver.c
+    static uint32_t float_to_q16(float f) {
+        return uint32_t(int32_t(f * 65536.0f + (f < 0 ? -0.5f : 0.5f)));
+    }
+
+    // Small integer coordinates so every squared distance is exact in single precision and in Q16.16.
+    // With fractional set every coordinate gets a fraction in thousandths, which neither format holds exactly
+    static void generatePoints(std::vector<float>& xs, std::vector<float>& ys, bool fractional = false) {
+        xs.resize(NUM_POINTS);
+        ys.resize(NUM_POINTS);
+        uint32_t seed = 12345;
+        for (int i = 0; i < NUM_POINTS; i++) {
+            seed = seed * 1103515245 + 12345;
+            xs[i] = float((seed >> 16) % 64);
+            if (fractional) xs[i] += float(seed % 1000) / 1000.0f;
+            seed = seed * 1103515245 + 12345;
+            ys[i] = float((seed >> 16) % 64);
+            if (fractional) ys[i] += float(seed % 1000) / 1000.0f;
+        }
+    }
+
+    // Gap between the two nearest centroids of a point in double, a label closer to a tie than the rounding
+    // of the kernel's format can go either way
+    static double secondBestGap(float x, float y, const float (*cents)[2]) {
+        double d[NUM_CENTROIDS];
+        for (int k = 0; k < NUM_CENTROIDS; k++) {
+            double dx = double(x) - cents[k][0];
+            double dy = double(y) - cents[k][1];
+            d[k] = dx * dx + dy * dy;
+        }
+        std::sort(d, d + NUM_CENTROIDS);
+        return d[1] - d[0];
+    }
+
+    // Writes the centroids the way the kernels read them, x and y interleaved from CENTROIDS_BASE
+    void writeCentroids(const float (*cents)[2], uint32_t (*to_word)(float) = float_to_bits) {
+        for (int k = 0; k < NUM_CENTROIDS; k++) {
+            data_mem[CENTROIDS_BASE + 2 * k] = to_word(cents[k][0]);
+            data_mem[CENTROIDS_BASE + 2 * k + 1] = to_word(cents[k][1]);
+        }
+    }
+
+    // The points and centroids of every k-means test, as float bits or through another format like float_to_q16
+    void loadKMeansDataset(const std::vector<float>& xs, const std::vector<float>& ys, const float (*cents)[2],
+                           uint32_t (*to_word)(float) = float_to_bits) {
+        for (int i = 0; i < NUM_POINTS; i++) {
+            data_mem[POINTS_X_BASE + i] = to_word(xs[i]);
+            data_mem[POINTS_Y_BASE + i] = to_word(ys[i]);
+        }
+        writeCentroids(cents, to_word);
+    }
+};
+
+static const float centroids[NUM_CENTROIDS][2] = {{10.0f, 10.0f}, {50.0f, 20.0f}, {30.0f, 55.0f}};
@@ -18,8 +18,7 @@
 #define IDLE 0b000
 #define READ_WAITING 0b010
 #define WRITE_WAITING 0b011
-#define READ_RELAYING 0b100
-#define WRITE_RELAYING 0b101
+#define LATENCY_BUCKETS 8
 
 class MemControllerTestbench : public BaseTestbench {
 protected:
@@ -212,14 +211,14 @@ TEST_F(MemControllerTestbench, MultipleConsumers) {
     
     tick();
     
-    // Check that at least some consumers get responses
+    // Both channels serve different consumers, so both get their response
     int ready_consumers = 0;
     for (int i = 0; i < NUM_CONSUMERS; i++) {
         if (((top->consumer_read_ready >> i) & 1) || ((top->consumer_write_ready >> i) & 1)) {
             ready_consumers++;
         }
     }
-    EXPECT_EQ(ready_consumers, 1);
+    EXPECT_EQ(ready_consumers, 2);
 }
 
 // ------------------ CHANNEL ARBITRATION TEST ------------------
@@ -269,7 +268,7 @@ TEST_F(MemControllerTestbench, ChannelArbitration) {
             active_mem_requests++;
         }
     }
-    EXPECT_EQ(active_mem_requests, 0); // Should pick up remaining requests
+    EXPECT_EQ(active_mem_requests, NUM_CHANNELS); // Should pick up remaining requests
 }
 
 // ------------------ READ/WRITE PRIORITY TEST ------------------
@@ -358,14 +357,135 @@ TEST_F(MemControllerTestbench, StressTest) {
         
         tick();
     }
-    
-    // Final state should be idle
+
+    // Drain the requests that are still pending
+    for (int cycle = 0; cycle < 4 * NUM_CONSUMERS; cycle++) {
+        for (int i = 0; i < NUM_CHANNELS; i++) {
+            if ((top->mem_read_valid >> i) & 1) setMemoryResponse(i, 0, true);
+            if ((top->mem_write_valid >> i) & 1) setMemoryResponse(i, 0, false);
+        }
+        tick();
+        for (int i = 0; i < NUM_CHANNELS; i++) {
+            clearMemoryResponse(i, true);
+            clearMemoryResponse(i, false);
+        }
+        for (int i = 0; i < NUM_CONSUMERS; i++) {
+            if ((top->consumer_read_ready >> i) & 1) clearConsumerRequest(i, true);
+            if ((top->consumer_write_ready >> i) & 1) clearConsumerRequest(i, false);
+        }
+    }
+    tick();
+
+    // Every request has been served and the final state should be idle
+    EXPECT_EQ(top->consumer_read_valid, 0);
+    EXPECT_EQ(top->consumer_write_valid, 0);
     for (int i = 0; i < NUM_CHANNELS; i++) {
         EXPECT_EQ((top->mem_read_valid >> i) & 1, 0);
         EXPECT_EQ((top->mem_write_valid >> i) & 1, 0);
     }
 }
 
+// ------------------ ROUND ROBIN FAIRNESS TEST ------------------
+TEST_F(MemControllerTestbench, RoundRobinFairness) {
+    reset();
+
+    // Every consumer requests again as soon as it has been served, memory answers immediately
+    int served[NUM_CONSUMERS] = {0};
+    for (int cycle = 0; cycle < 40; cycle++) {
+        for (int i = 0; i < NUM_CONSUMERS; i++) {
+            if ((top->consumer_read_ready >> i) & 1) {
+                clearConsumerRequest(i, true);
+            } else {
+                setConsumerReadRequest(i, 0x1000 + i);
+            }
+        }
+        top->mem_read_ready = top->mem_read_valid;
+
+        uint32_t prev_ready = top->consumer_read_ready;
+        tick();
+        for (int i = 0; i < NUM_CONSUMERS; i++) {
+            if (((top->consumer_read_ready >> i) & 1) && !((prev_ready >> i) & 1)) {
+                served[i]++;
+            }
+        }
+    }
+
+    // No consumer is starved by the lower indexed ones
+    for (int i = 1; i < NUM_CONSUMERS; i++) {
+        EXPECT_EQ(served[i], served[0]) << "Consumer " << i;
+    }
+    EXPECT_GT(served[0], 0);
+}
+
+// ------------------ BACK TO BACK ISSUE TEST ------------------
+TEST_F(MemControllerTestbench, BackToBackIssue) {
+    reset();
+
+    // Three consumers compete for two channels
+    setConsumerReadRequest(0, 0x1000);
+    setConsumerReadRequest(1, 0x1001);
+    setConsumerReadRequest(2, 0x1002);
+    tick();
+
+    // The channel that gets its response issues the waiting request in the same cycle,
+    // without waiting for consumer 0 to acknowledge
+    setMemoryResponse(0, 0xAAAA0000, true);
+    tick();
+    clearMemoryResponse(0, true);
+
+    EXPECT_EQ((top->consumer_read_ready >> 0) & 1, 1);
+    EXPECT_EQ(top->consumer_read_data[0], 0xAAAA0000);
+    EXPECT_EQ((top->mem_read_valid >> 0) & 1, 1);
+    EXPECT_EQ(top->mem_read_address[0], 0x1002);
+
+    // The response for consumer 0 is held until it drops valid
+    tick();
+    EXPECT_EQ((top->consumer_read_ready >> 0) & 1, 1);
+    clearConsumerRequest(0, true);
+    tick();
+    EXPECT_EQ((top->consumer_read_ready >> 0) & 1, 0);
+
+    // Responses are routed to the consumer the channel is serving
+    setMemoryResponse(0, 0xCCCC0002, true);
+    tick();
+    clearMemoryResponse(0, true);
+    EXPECT_EQ((top->consumer_read_ready >> 2) & 1, 1);
+    EXPECT_EQ(top->consumer_read_data[2], 0xCCCC0002);
+    EXPECT_EQ((top->consumer_read_ready >> 1) & 1, 0);
+}
+
+// ------------------ LATENCY HISTOGRAM TEST ------------------
+TEST_F(MemControllerTestbench, LatencyHistogram) {
+    reset();
+
+    // Memory answers the cycle after the request is issued: 2 cycles from valid to ready
+    setConsumerReadRequest(1, 0x1000);
+    tick();
+    setMemoryResponse(0, 0x1234, true);
+    tick();
+    clearMemoryResponse(0, true);
+    clearConsumerRequest(1, true);
+    tick();
+
+    // Memory takes 5 more cycles: 7 cycles from valid to ready
+    setConsumerWriteRequest(1, 0x2000, 0x5678);
+    tick();
+    for (int i = 0; i < 5; i++) {
+        tick();
+    }
+    setMemoryResponse(0, 0, false);
+    tick();
+    clearMemoryResponse(0, false);
+    clearConsumerRequest(1, false);
+    tick();
+
+    EXPECT_EQ(top->latency_histogram[1][1], 1); // [2, 4)
+    EXPECT_EQ(top->latency_histogram[1][2], 1); // [4, 8)
+    for (int b = 0; b < LATENCY_BUCKETS; b++) {
+        EXPECT_EQ(top->latency_histogram[0][b], 0);
+    }
+}
+
 // ------------------ MAIN ------------------
 int main(int argc, char **argv) {
     Verilated::commandArgs(argc, argv);
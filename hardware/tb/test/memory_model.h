@@ -0,0 +1,217 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// MEMORY TIMING MODEL
+// > Decides in which cycle each data memory channel answers, the testbenches drive ready from it instead of
+//   answering every request in the next cycle
+// > respond() is called once per cycle between two clock edges for every channel, it returns true when ready
+//   (and the read data) should be presented for the next edge. tick() advances the model at the clock edge
+// > A channel has one request at a time, as the memory controllers and LSUs issue them: a request is accepted
+//   the first cycle its valid is seen and is over once it has been answered
+// > Selected with +mem_model=<model>[:key=value,...], e.g. +mem_model=ddr:tcl=8,bus=1
+//   ideal   answers in the next cycle, the old testbench behaviour (default)
+//   fixed   every request takes latency cycles                          (BRAM behind an AXI interconnect)
+//   banked  fixed, plus banks interleaved by address, a bank is busy bank_busy cycles per access
+//   ddr     banked with one open row per bank on top of the controller latency: row hit tcl,
+//           closed row trcd + tcl, row conflict trp + trcd + tcl
+//   Every model also takes interval (cycles between two requests of a channel) and bus (words per cycle
+//   over all channels, 0 for no limit)
+// > Addresses are used as the channels present them, row_words is in those units. Writes are timed like reads
+
+struct MemoryTiming {
+    std::string model = "ideal";
+    int latency = 1;
+    int interval = 1;
+    double bus = 0;
+    int banks = 1;
+    int bank_busy = 0;
+    int row_words = 0;
+    int tcl = 0;
+    int trcd = 0;
+    int trp = 0;
+
+    // Defaults of each model, keys of the spec override them
+    static bool parse(const std::string& spec, MemoryTiming& timing, std::string& error) {
+        std::string name = spec.substr(0, spec.find(':'));
+        timing = MemoryTiming();
+        timing.model = name;
+
+        if (name == "ideal") {
+        } else if (name == "fixed") {
+            timing.latency = 8;
+        } else if (name == "banked") {
+            timing.latency = 8;
+            timing.banks = 8;
+            timing.bank_busy = 4;
+        } else if (name == "ddr") {
+            // DDR3 behind the Zynq HP port, in fabric cycles at 100 MHz
+            timing.latency = 12;
+            timing.banks = 8;
+            timing.bank_busy = 2;
+            timing.row_words = 512;
+            timing.tcl = 6;
+            timing.trcd = 6;
+            timing.trp = 6;
+            timing.bus = 2;
+        } else {
+            error = "unknown memory model '" + name + "' (ideal, fixed, banked, ddr)";
+            return false;
+        }
+
+        if (spec.find(':') == std::string::npos) return true;
+
+        std::stringstream options(spec.substr(spec.find(':') + 1));
+        std::string option;
+        while (std::getline(options, option, ',')) {
+            size_t equals = option.find('=');
+            if (equals == std::string::npos) {
+                error = "expected key=value, got '" + option + "'";
+                return false;
+            }
+            std::string key = option.substr(0, equals);
+            double value = std::atof(option.substr(equals + 1).c_str());
+
+            if (key == "latency") timing.latency = std::max(1, int(value));
+            else if (key == "interval") timing.interval = std::max(1, int(value));
+            else if (key == "bus") timing.bus = value;
+            else if (key == "banks") timing.banks = std::max(1, int(value));
+            else if (key == "bank_busy") timing.bank_busy = int(value);
+            else if (key == "row_words") timing.row_words = int(value);
+            else if (key == "tcl") timing.tcl = int(value);
+            else if (key == "trcd") timing.trcd = int(value);
+            else if (key == "trp") timing.trp = int(value);
+            else {
+                error = "unknown memory model option '" + key + "'";
+                return false;
+            }
+        }
+        return true;
+    }
+};
+
+class MemoryTimingModel {
+public:
+    bool configure(const std::string& spec, std::string& error) {
+        if (!MemoryTiming::parse(spec, timing, error)) return false;
+        name = spec;
+        reset();
+        return true;
+    }
+
+    const std::string& spec() const { return name; }
+
+    void reset() {
+        now = 0;
+        bus_free = 0;
+        channels.clear();
+        bank_free.assign(timing.banks, 0);
+        open_row.assign(timing.banks, NO_ROW);
+        requests = latency_cycles = bank_stall_cycles = 0;
+        row_hits = row_empties = row_conflicts = 0;
+    }
+
+    void tick() { now++; }
+
+    bool respond(int channel, bool valid, uint32_t address) {
+        Channel& state = channels[channel];
+        if (!valid) {
+            state.busy = false;
+            return false;
+        }
+        if (!state.busy) {
+            accept(state, address);
+        }
+        if (now + 1 >= state.ready_at) {
+            state.busy = false;
+            return true;
+        }
+        return false;
+    }
+
+    uint64_t requestCount() const { return requests; }
+    double averageLatency() const { return requests ? double(latency_cycles) / requests : 0.0; }
+
+    // "key=value" fields for the BENCH lines
+    std::string summary() const {
+        char buffer[256];
+        uint64_t row_accesses = row_hits + row_empties + row_conflicts;
+        std::snprintf(buffer, sizeof(buffer),
+                      "mem_model=%s mem_requests=%llu mem_avg_latency=%.2f mem_bank_stall_cycles=%llu mem_row_hit_rate=%.3f",
+                      timing.model.c_str(), (unsigned long long)requests, averageLatency(),
+                      (unsigned long long)bank_stall_cycles, row_accesses ? double(row_hits) / row_accesses : 0.0);
+        return buffer;
+    }
+
+private:
+    static constexpr uint64_t NO_ROW = ~0ull;
+
+    struct Channel {
+        bool busy = false;
+        uint64_t ready_at = 0;
+        uint64_t next_issue = 0;
+    };
+
+    MemoryTiming timing;
+    std::string name = "ideal";
+    uint64_t now = 0;
+    double bus_free = 0;
+    std::map<int, Channel> channels;
+    std::vector<uint64_t> bank_free = std::vector<uint64_t>(1, 0);
+    std::vector<uint64_t> open_row = std::vector<uint64_t>(1, NO_ROW);
+
+    uint64_t requests = 0;
+    uint64_t latency_cycles = 0;
+    uint64_t bank_stall_cycles = 0;
+    uint64_t row_hits = 0, row_empties = 0, row_conflicts = 0;
+
+    void accept(Channel& state, uint32_t address) {
+        uint64_t start = std::max(now, state.next_issue);
+        state.next_issue = start + timing.interval;
+
+        // SRAM banks interleave words, DDR keeps a row's words in one bank (row:bank:column)
+        size_t bank = timing.row_words > 0 ? (address / timing.row_words) % timing.banks : address % timing.banks;
+        if (timing.bank_busy > 0 || timing.row_words > 0) {
+            if (bank_free[bank] > start) bank_stall_cycles += bank_free[bank] - start;
+            start = std::max(start, bank_free[bank]);
+        }
+
+        // Row commands before the access, DDR only
+        uint64_t row_cycles = 0, access_cycles = 0;
+        if (timing.row_words > 0) {
+            uint64_t row = address / (uint64_t(timing.row_words) * timing.banks);
+            if (open_row[bank] == row) {
+                row_hits++;
+            } else if (open_row[bank] == NO_ROW) {
+                row_empties++;
+                row_cycles = timing.trcd;
+            } else {
+                row_conflicts++;
+                row_cycles = timing.trp + timing.trcd;
+            }
+            open_row[bank] = row;
+            access_cycles = timing.tcl;
+        }
+        bank_free[bank] = start + row_cycles + timing.bank_busy;
+
+        // The answer is ready latency cycles after the request in the ideal case: presented for the next edge
+        double done = double(start + timing.latency + row_cycles + access_cycles);
+        if (timing.bus > 0) {
+            done = std::max(done, bus_free);
+            bus_free = done + 1.0 / timing.bus;
+        }
+        state.ready_at = uint64_t(std::ceil(done));
+        state.busy = true;
+
+        requests++;
+        latency_cycles += state.ready_at - now;
+    }
+};
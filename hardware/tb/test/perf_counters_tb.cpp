@@ -0,0 +1,150 @@
+#include "base_testbench.h"
+#include "../../../code/perf_counters.h"
+#include <verilated_cov.h>
+#include <iostream>
+
+#define NAME "perf_counters"
+
+class PerfCountersTestbench : public BaseTestbench {
+protected:
+    void initializeInputs() override {
+        top->clk = 0;
+        top->reset = 0;
+        top->start = 0;
+        top->done = 0;
+        top->mem_busy = 0;
+        top->core_block_done = 0;
+        top->read_address = 0;
+        for (int i = 0; i < PERF_NUM_COUNTERS; i++) {
+            top->core_counters[0][i] = 0;
+        }
+    }
+
+    void reset() {
+        top->reset = 1;
+        tick();
+        top->reset = 0;
+        tick();
+    }
+
+    void tick() {
+        top->clk = 0;
+        top->eval();
+        top->clk = 1;
+        top->eval();
+    }
+
+    uint32_t read(int index) {
+        top->read_address = index;
+        top->eval();
+        return top->read_data;
+    }
+
+    // Launch, run for the given cycles and finish with the core handing in one block
+    void runKernel(int cycles, uint32_t instructions) {
+        top->start = 1;
+        tick();
+        for (int i = 0; i < cycles - 1; i++) {
+            tick();
+        }
+
+        top->core_counters[0][PERF_INSTRUCTIONS_SCALAR] = instructions;
+        top->core_block_done = 1;
+        tick();
+        top->core_block_done = 0;
+        top->core_counters[0][PERF_INSTRUCTIONS_SCALAR] = 0;
+
+        top->done = 1;
+        tick();
+        top->done = 0;
+    }
+};
+
+// ------------------ RESET TEST ------------------
+TEST_F(PerfCountersTestbench, ResetBehavior) {
+    reset();
+
+    for (int i = 0; i < PERF_NUM_COUNTERS; i++) {
+        EXPECT_EQ(read(i), 0) << "Counter " << i;
+    }
+    EXPECT_EQ(read(31), 0); // Past the last counter
+}
+
+// ------------------ SNAPSHOT TEST ------------------
+TEST_F(PerfCountersTestbench, SnapshotAtKernelEnd) {
+    reset();
+
+    top->mem_busy = 1;
+    runKernel(10, 42);
+    top->mem_busy = 0;
+
+    // 10 cycles of the kernel plus the cycle done is seen on
+    EXPECT_EQ(read(PERF_CYCLES), 11);
+    EXPECT_EQ(read(PERF_MEM_BUSY_CYCLES), 11);
+    EXPECT_EQ(read(PERF_BLOCKS), 1);
+    EXPECT_EQ(read(PERF_INSTRUCTIONS_SCALAR), 42);
+    EXPECT_EQ(read(PERF_ICACHE_HITS), 0);
+}
+
+// ------------------ BLOCK ACCUMULATION TEST ------------------
+TEST_F(PerfCountersTestbench, BlocksAddUp) {
+    reset();
+
+    top->start = 1;
+    tick();
+
+    // The core resets its own counters between blocks, every block is added in when it finishes
+    for (int block = 0; block < 3; block++) {
+        top->core_counters[0][PERF_ICACHE_HITS] = 5 + block;
+        top->core_counters[0][PERF_WARP_STATE_CYCLES + 1] = 100;
+        top->core_block_done = 1;
+        tick();
+        top->core_block_done = 0;
+        tick();
+    }
+
+    // Nothing is visible before the kernel is done
+    EXPECT_EQ(read(PERF_BLOCKS), 0);
+
+    top->done = 1;
+    tick();
+    top->done = 0;
+
+    EXPECT_EQ(read(PERF_BLOCKS), 3);
+    EXPECT_EQ(read(PERF_ICACHE_HITS), 5 + 6 + 7);
+    EXPECT_EQ(read(PERF_WARP_STATE_CYCLES + 1), 300);
+}
+
+// ------------------ RELAUNCH TEST ------------------
+TEST_F(PerfCountersTestbench, RelaunchKeepsSnapshot) {
+    reset();
+
+    runKernel(10, 42);
+    EXPECT_EQ(read(PERF_INSTRUCTIONS_SCALAR), 42);
+
+    // The next kernel starts from zero, the previous snapshot stays readable until it is done
+    top->start = 1;
+    for (int i = 0; i < 5; i++) tick();
+    EXPECT_EQ(read(PERF_INSTRUCTIONS_SCALAR), 42);
+
+    top->core_counters[0][PERF_INSTRUCTIONS_SCALAR] = 7;
+    top->core_block_done = 1;
+    tick();
+    top->core_block_done = 0;
+    top->done = 1;
+    tick();
+    top->done = 0;
+
+    EXPECT_EQ(read(PERF_INSTRUCTIONS_SCALAR), 7);
+    EXPECT_EQ(read(PERF_BLOCKS), 1);
+}
+
+// ------------------ MAIN ------------------
+int main(int argc, char **argv) {
+    Verilated::commandArgs(argc, argv);
+    testing::InitGoogleTest(&argc, argv);
+    Verilated::mkdir("logs");
+    auto res = RUN_ALL_TESTS();
+    VerilatedCov::write(("logs/coverage_" + std::string(NAME) + ".dat").c_str());
+    return res;
+}
@@ -0,0 +1,254 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// CYCLE ACCOUNTING PROFILER
+// > sample() is called once per cycle for every warp with its state, PC and execution mask (debug_warp_* ports
+//   of gpu.sv), cycles are aggregated per PC and per warp state. Idle and finished warps are not charged
+// > The line map written by the assembler ("<pc> <asm line> <c line>" per instruction) takes the PCs back to the
+//   assembly and, for compiled kernels, to the C source through the compiler's "# line <n>" markers
+// > writeListing() annotates the source with the cycles of every line and, under each line, of its instructions
+//   writeFoldedStacks() writes "kernel;source line;instruction;state cycles" rows for flamegraph.pl / speedscope
+
+// Names of warp_state_t (common.svh), in enum order
+static const char* const WARP_STATE_NAMES[] = {
+    "IDLE", "FETCH", "DECODE", "REQUEST", "REG_WAIT", "WAIT",
+    "EXECUTE", "ALU_WAIT", "INT_ALU_WAIT", "UPDATE", "SYNC_WAIT", "DONE"
+};
+#define PROFILER_NUM_WARP_STATES 12
+#define PROFILER_WARP_IDLE 0
+#define PROFILER_WARP_DONE 11
+
+class CycleProfiler {
+public:
+    struct PcProfile {
+        uint64_t cycles = 0;
+        uint64_t lane_cycles = 0; // Enabled lanes summed over the cycles
+        uint64_t state_cycles[PROFILER_NUM_WARP_STATES] = {};
+    };
+
+    void sample(uint8_t state, uint32_t pc, uint32_t execution_mask) {
+        if (state == PROFILER_WARP_IDLE || state == PROFILER_WARP_DONE || state >= PROFILER_NUM_WARP_STATES) return;
+
+        PcProfile& profile = pcs[pc];
+        profile.cycles++;
+        profile.lane_cycles += __builtin_popcount(execution_mask);
+        profile.state_cycles[state]++;
+        total_cycles++;
+        state_totals[state]++;
+    }
+
+    void clear() {
+        pcs.clear();
+        total_cycles = 0;
+        std::fill(std::begin(state_totals), std::end(state_totals), 0);
+    }
+
+    uint64_t totalCycles() const { return total_cycles; }
+    uint64_t stateCycles(int state) const { return state_totals[state]; }
+    uint64_t pcCycles(uint32_t pc) const { return pcs.count(pc) ? pcs.at(pc).cycles : 0; }
+    const std::map<uint32_t, PcProfile>& profiles() const { return pcs; }
+
+    bool loadLineMap(const std::string& path) {
+        std::ifstream file(path);
+        if (!file.is_open()) return false;
+
+        uint32_t pc;
+        int asm_line, c_line;
+        while (file >> pc >> asm_line >> c_line) {
+            asm_lines[pc] = asm_line;
+            c_lines[pc] = c_line;
+        }
+        return true;
+    }
+
+    // Annotated listing of the C source when the line map has C lines, of the assembly otherwise
+    bool writeListing(const std::string& path, const std::string& asm_path, const std::string& c_path = "") const {
+        std::ofstream out(path);
+        if (!out.is_open()) return false;
+
+        std::vector<std::string> asm_text = readLines(asm_path);
+        std::vector<std::string> c_text = readLines(c_path);
+        bool use_c = !c_text.empty() && hasCLines();
+
+        // Group the PCs by the line they are listed under
+        std::map<int, std::vector<uint32_t>> line_pcs;
+        std::vector<uint32_t> unmapped;
+        for (const auto& [pc, profile] : pcs) {
+            int line = use_c ? lookup(c_lines, pc) : lookup(asm_lines, pc);
+            if (line > 0) line_pcs[line].push_back(pc);
+            else unmapped.push_back(pc);
+        }
+
+        out << "# " << (use_c ? c_path : asm_path) << ": " << total_cycles << " warp cycles\n";
+        out << "#   cycles       %  lanes   line\n";
+
+        const std::vector<std::string>& source = use_c ? c_text : asm_text;
+        for (size_t i = 0; i < source.size(); i++) {
+            int line = int(i) + 1;
+            auto it = line_pcs.find(line);
+            uint64_t cycles = 0, lane_cycles = 0;
+            if (it != line_pcs.end()) {
+                for (uint32_t pc : it->second) {
+                    cycles += pcs.at(pc).cycles;
+                    lane_cycles += pcs.at(pc).lane_cycles;
+                }
+            }
+
+            out << formatCycles(cycles, lane_cycles) << " " << pad(line, 5) << " | " << source[i] << "\n";
+
+            // The instructions of a C line, with their asm line and where their cycles went
+            if (use_c && it != line_pcs.end()) {
+                for (uint32_t pc : it->second) {
+                    out << formatCycles(pcs.at(pc).cycles, pcs.at(pc).lane_cycles) << "       |     "
+                        << formatPc(pc) << " " << instructionText(asm_text, pc) << "  [" << stateBreakdown(pcs.at(pc)) << "]\n";
+                }
+            } else if (it != line_pcs.end()) {
+                for (uint32_t pc : it->second) {
+                    out << std::string(31, ' ') << "|     " << formatPc(pc) << "  [" << stateBreakdown(pcs.at(pc)) << "]\n";
+                }
+            }
+        }
+
+        for (uint32_t pc : unmapped) {
+            out << formatCycles(pcs.at(pc).cycles, pcs.at(pc).lane_cycles) << "     ? |     "
+                << formatPc(pc) << " (not in the line map)  [" << stateBreakdown(pcs.at(pc)) << "]\n";
+        }
+
+        out << "#\n# warp states\n";
+        for (int s = 0; s < PROFILER_NUM_WARP_STATES; s++) {
+            if (state_totals[s] == 0) continue;
+            out << "#   " << WARP_STATE_NAMES[s] << ": " << state_totals[s] << " (" << percent(state_totals[s]) << "%)\n";
+        }
+        return true;
+    }
+
+    // One "kernel;source line;instruction;state cycles" row per PC and state
+    bool writeFoldedStacks(const std::string& path, const std::string& asm_path, const std::string& c_path = "") const {
+        std::ofstream out(path);
+        if (!out.is_open()) return false;
+
+        std::vector<std::string> asm_text = readLines(asm_path);
+        std::vector<std::string> c_text = readLines(c_path);
+        std::string kernel = baseName(c_text.empty() ? asm_path : c_path);
+
+        for (const auto& [pc, profile] : pcs) {
+            std::string stack = kernel;
+            int c_line = lookup(c_lines, pc);
+            if (!c_text.empty() && c_line > 0) {
+                stack += ";" + frame(kernel + ":" + std::to_string(c_line) + " " + lineText(c_text, c_line));
+            }
+            stack += ";" + frame(formatPc(pc) + " " + instructionText(asm_text, pc));
+
+            for (int s = 0; s < PROFILER_NUM_WARP_STATES; s++) {
+                if (profile.state_cycles[s] == 0) continue;
+                out << stack << ";" << WARP_STATE_NAMES[s] << " " << profile.state_cycles[s] << "\n";
+            }
+        }
+        return true;
+    }
+
+private:
+    std::map<uint32_t, PcProfile> pcs;
+    uint64_t total_cycles = 0;
+    uint64_t state_totals[PROFILER_NUM_WARP_STATES] = {};
+
+    std::map<uint32_t, int> asm_lines;
+    std::map<uint32_t, int> c_lines;
+
+    bool hasCLines() const {
+        for (const auto& [pc, line] : c_lines) {
+            if (line > 0) return true;
+        }
+        return false;
+    }
+
+    static int lookup(const std::map<uint32_t, int>& lines, uint32_t pc) {
+        auto it = lines.find(pc);
+        return it == lines.end() ? 0 : it->second;
+    }
+
+    static std::vector<std::string> readLines(const std::string& path) {
+        std::vector<std::string> lines;
+        if (path.empty()) return lines;
+
+        std::ifstream file(path);
+        std::string line;
+        while (std::getline(file, line)) {
+            lines.push_back(line);
+        }
+        return lines;
+    }
+
+    static std::string lineText(const std::vector<std::string>& lines, int line) {
+        if (line <= 0 || line > int(lines.size())) return "";
+        std::string text = lines[line - 1];
+        text.erase(0, text.find_first_not_of(" \t"));
+        return text;
+    }
+
+    std::string instructionText(const std::vector<std::string>& asm_text, uint32_t pc) const {
+        return lineText(asm_text, lookup(asm_lines, pc));
+    }
+
+    // Flame graph frames are separated by ';' and the count follows the last space
+    static std::string frame(std::string text) {
+        text.erase(text.find_last_not_of(" ;") + 1);
+        std::replace(text.begin(), text.end(), ';', ',');
+        std::replace(text.begin(), text.end(), '\t', ' ');
+        return text;
+    }
+
+    static std::string baseName(const std::string& path) {
+        size_t slash = path.find_last_of('/');
+        return slash == std::string::npos ? path : path.substr(slash + 1);
+    }
+
+    static std::string formatPc(uint32_t pc) {
+        char buffer[16];
+        std::snprintf(buffer, sizeof(buffer), "0x%04x", pc);
+        return buffer;
+    }
+
+    static std::string pad(int value, int width) {
+        std::string text = std::to_string(value);
+        return std::string(std::max(0, width - int(text.size())), ' ') + text;
+    }
+
+    std::string percent(uint64_t cycles) const {
+        char buffer[16];
+        std::snprintf(buffer, sizeof(buffer), "%.2f", total_cycles ? 100.0 * cycles / total_cycles : 0.0);
+        return buffer;
+    }
+
+    // "cycles  percent  average enabled lanes", blank for lines that never ran
+    std::string formatCycles(uint64_t cycles, uint64_t lane_cycles) const {
+        if (cycles == 0) return std::string(24, ' ');
+        char buffer[48];
+        std::snprintf(buffer, sizeof(buffer), "%10llu %6s%% %5.1f", (unsigned long long)cycles,
+                      percent(cycles).c_str(), double(lane_cycles) / cycles);
+        return buffer;
+    }
+
+    std::string stateBreakdown(const PcProfile& profile) const {
+        std::vector<std::pair<uint64_t, int>> states;
+        for (int s = 0; s < PROFILER_NUM_WARP_STATES; s++) {
+            if (profile.state_cycles[s] > 0) states.push_back({profile.state_cycles[s], s});
+        }
+        std::sort(states.rbegin(), states.rend());
+
+        std::ostringstream text;
+        for (size_t i = 0; i < states.size(); i++) {
+            if (i > 0) text << " ";
+            text << WARP_STATE_NAMES[states[i].second] << " " << states[i].first;
+        }
+        return text.str();
+    }
+};
@@ -1,7 +1,10 @@
 #include "base_testbench.h"
+#include "../memory_model.h"
+#include "../profiler.h"
 #include <verilated_cov.h>
 #include <gtest/gtest.h>
 #include <cstdint>
+#include <cmath>
 #include <map>
 #include <functional>
 #include <iostream>
@@ -13,6 +16,12 @@ using namespace std;
 #define WARPS_PER_CORE 4
 #define THREADS_PER_WARP 16
 #define NUM_LSUS (THREADS_PER_WARP + 1)
+#ifndef ICACHE_LINES
+#define ICACHE_LINES 64 // must match the compute_core parameter (see doit.sh)
+#endif
+#ifndef WARP_SCHEDULER
+#define WARP_SCHEDULER 0 // must match the compute_core parameter: 0 = loose round-robin, 1 = greedy-then-oldest, 2 = two-level
+#endif
 
 // Opcode definitions
 #define OPCODE_R    0b000
@@ -27,6 +36,8 @@ protected:
     vluint64_t sim_time = 0;
     std::map<uint32_t, uint32_t> instr_mem;
     std::map<uint32_t, uint32_t> data_mem;
+    int cycles_taken = 0;
+    MemoryTimingModel memory; // Data memory timing, +mem_model=<spec> (memory_model.h)
 
     void loadProgramFromHex(const std::string& hex_filepath) {
         instr_mem.clear(); // Clear any previous program
@@ -86,6 +97,7 @@ protected:
         top->eval();
         top->clk = 1;
         top->eval();
+        memory.tick();
         // if (tfp){
         //     tfp->dump(sim_time++);
         // }
@@ -100,46 +112,58 @@ protected:
                     top->instruction_mem_read_data[w] = instr_mem.count(addr) ? instr_mem[addr] : 0;
                 }
             }
+            uint64_t read_ready = 0, write_ready = 0;
             for (int t = 0; t < NUM_LSUS; ++t) {
-                if (top->data_mem_read_valid & (1ULL << t)) {
-                    uint32_t addr = top->data_mem_read_address[t];
+                bool read = top->data_mem_read_valid & (1ULL << t);
+                bool write = top->data_mem_write_valid & (1ULL << t);
+                uint32_t addr = write ? top->data_mem_write_address[t] : top->data_mem_read_address[t];
+                if (!memory.respond(t, read || write, addr)) continue;
+
+                if (read) {
                     top->data_mem_read_data[t] = data_mem.count(addr) ? data_mem[addr] : 0xDEADBEEF;
+                    read_ready |= 1ULL << t;
+                }
+                if (write) {
+                    data_mem[addr] = top->data_mem_write_data[t];
+                    write_ready |= 1ULL << t;
                 }
             }
+            top->data_mem_read_ready = read_ready;
+            top->data_mem_write_ready = write_ready;
 
             // --- Clock Tick ---
             top->clk = 0;
             top->eval();
             top->clk = 1;
             top->eval();
+            memory.tick();
 
             // --- VCD Dump ---
             // if (tfp){
             //     tfp->dump(sim_time++);
             // }
-
-            // --- After the clock edge ---
-            for (int t = 0; t < NUM_LSUS; ++t) {
-                if (top->data_mem_write_valid & (1ULL << t)) {
-                    data_mem[top->data_mem_write_address[t]] = top->data_mem_write_data[t];
-                }
-            }
         }
     }
 
     void initializeInputs() override {
         top->clk = 1; top->reset = 1; top->start = 0; top->block_id = 0;
+        top->icache_flush = 1;
         top->kernel_config[3] = 0; // base instruction address
         top->kernel_config[2] = 0; // base data memory address
         top->kernel_config[0] = 2;  // num_warps_per_block
         top->kernel_config[1] = 1; // num_blocks
 
         top->instruction_mem_read_ready = -1;
-        top->data_mem_read_ready = -1;
-        top->data_mem_write_ready = -1;
-        
+        top->data_mem_read_ready = 0;
+        top->data_mem_write_ready = 0;
+
+        std::string model_arg = Verilated::commandArgsPlusMatch("mem_model=");
+        std::string error;
+        ASSERT_TRUE(memory.configure(model_arg.empty() ? "ideal" : model_arg.substr(std::string("+mem_model=").size()), error)) << error;
+
         runSimulation(2);
         top->reset = 0;
+        top->icache_flush = 0;
     }
 
     void loadAndRun(const std::map<uint32_t, uint32_t>& program) {
@@ -153,6 +177,7 @@ protected:
         for (int i = 0; i < max_cycles; ++i) {
             if (top->done) {
                 std::cout << "Core finished in " << i << " cycles." << std::endl;
+                cycles_taken = i;
                 return;
             }
             runSimulation(1);
@@ -322,6 +347,446 @@ protected:
 //     EXPECT_EQ(data_mem[53], 1) << "Vector FCVT.W.S (float to int) failed";
 // }
 
+TEST_F(ComputeCoreTestbench, ShuffleReductionTest) {
+    data_mem.clear();
+
+    loadProgramFromHex("../../assembler/tests/expected_output/shuffle.instr.hex");
+    loadAndRun(instr_mem);
+
+    // Each warp reduces its own 16 thread ids: 0..15 = 120, 16..31 = 376
+    for (int tid = 0; tid < 2 * THREADS_PER_WARP; ++tid) {
+        uint32_t warp_sum = (tid < THREADS_PER_WARP) ? 120 : 376;
+        int lane = tid % THREADS_PER_WARP;
+
+        // shfl.xori butterfly leaves the sum in every lane
+        EXPECT_EQ(data_mem[42 + tid], warp_sum) << "shfl.xori reduction failed for thread " << tid;
+
+        // shfl.down by 8: the top half keeps its own value
+        uint32_t expected_down = (lane < 8) ? tid + 8 : tid;
+        EXPECT_EQ(data_mem[100 + tid], expected_down) << "shfl.down failed for thread " << tid;
+    }
+
+    // fshfl.down.s tree reduction leaves the sum in lane 0 of each warp
+    EXPECT_FLOAT_EQ(bits_to_float(data_mem[200]), 120.0f) << "fshfl.down.s reduction failed for warp 0";
+    EXPECT_FLOAT_EQ(bits_to_float(data_mem[200 + THREADS_PER_WARP]), 376.0f) << "fshfl.down.s reduction failed for warp 1";
+}
+
+TEST_F(ComputeCoreTestbench, SyncBarrierTest) {
+    data_mem.clear();
+
+    // Every thread stores its id, syncs, then reads back the mirrored thread
+    // (block_size - 1 - tid), which always lives in the other warp.
+    loadProgramFromHex("../../assembler/tests/expected_output/sync.instr.hex");
+    loadAndRun(instr_mem);
+
+    for (int tid = 0; tid < 2 * THREADS_PER_WARP; ++tid) {
+        EXPECT_EQ(data_mem[400 + tid], 2 * THREADS_PER_WARP - 1 - tid) << "Thread " << tid << " read past the barrier before the other warp stored";
+    }
+}
+
+TEST_F(ComputeCoreTestbench, AluThroughputTest) {
+    data_mem.clear();
+
+    // 16 iterations of a 7 instruction ALU-only loop on every warp of the core:
+    // every instruction after the first comes out of the prefetch buffer and
+    // skips the LSU handshake.
+    top->kernel_config[0] = WARPS_PER_CORE;
+    loadProgramFromHex("../../assembler/tests/expected_output/pipeline.instr.hex");
+    loadAndRun(instr_mem);
+
+    for (int tid = 0; tid < WARPS_PER_CORE * THREADS_PER_WARP; ++tid) {
+        EXPECT_EQ(data_mem[500 + tid], 16 * (tid + 3)) << "ALU loop result wrong for thread " << tid;
+    }
+
+    // 117 instructions per warp. Bound taken from the warp state machine, not yet from a run:
+    // a warp spends 4 cycles per instruction (REQUEST, EXECUTE, INT_ALU_WAIT, UPDATE) when the
+    // next one is prefetched and about 5 more to refetch after each of its 15 taken branches,
+    // ~600 cycles for one warp. The other warps issue in those gaps, so all of them together
+    // should stay near 1.3 CPI; 2 CPI leaves room for the cold misses and issue collisions.
+    // Tighten it from the printed CPI of a Verilator run.
+    const int retired_instructions = WARPS_PER_CORE * 117;
+    std::cout << "Cycles per instruction: " << (double)cycles_taken / retired_instructions << std::endl;
+    EXPECT_LE(cycles_taken, 2 * retired_instructions) << "ALU instructions are not overlapping across warps";
+}
+
+TEST_F(ComputeCoreTestbench, InstructionCacheTest) {
+    data_mem.clear();
+
+    loadProgramFromHex("../../assembler/tests/expected_output/pipeline.instr.hex");
+    loadAndRun(instr_mem);
+
+    uint32_t hits = top->icache_hits;
+    uint32_t misses = top->icache_misses;
+    std::cout << "ICACHE_LINES=" << ICACHE_LINES << " hits: " << hits << " misses: " << misses
+              << " hit rate: " << (double)hits / (hits + misses) << std::endl;
+
+    // Every retired instruction was fetched at least once, and pcs 0..12
+    // (including the prefetch past exit) miss at least once
+    EXPECT_GE(hits + misses, 2 * 117);
+    EXPECT_GE(misses, 13);
+
+    // Once the whole kernel fits, only the first touch of each line misses
+    // (both warps can miss on the same line while it is being filled)
+    if (ICACHE_LINES >= 16) {
+        EXPECT_LE(misses, 2 * 13) << "Warps are not sharing the instruction cache";
+    }
+}
+
+TEST_F(ComputeCoreTestbench, CoalescingTest) {
+    data_mem.clear();
+    data_mem[600] = 1000;
+    for (int tid = 0; tid < 2 * THREADS_PER_WARP; ++tid) {
+        data_mem[610 + tid] = 3 * tid;
+    }
+
+    loadProgramFromHex("../../assembler/tests/expected_output/coalesce.instr.hex");
+    loadAndRun(instr_mem);
+
+    for (int tid = 0; tid < 2 * THREADS_PER_WARP; ++tid) {
+        EXPECT_EQ(data_mem[700 + tid], 1000 + 3 * tid) << "Coalesced load returned the wrong value for thread " << tid;
+    }
+    // Each warp's merged store is issued by its highest lane
+    EXPECT_TRUE(data_mem[650] == 15 || data_mem[650] == 31) << "Merged store wrote " << data_mem[650];
+
+    // Per warp: 4 vector memory instructions x 16 lanes, the two uniform ones
+    // need a single transaction each
+    uint32_t requests = top->coalescer_lane_requests;
+    uint32_t transactions = top->coalescer_mem_transactions;
+    std::cout << "Coalescing efficiency: " << (double)requests / transactions << " lanes per transaction" << std::endl;
+    EXPECT_EQ(requests, 2 * 4 * THREADS_PER_WARP);
+    EXPECT_EQ(transactions, 2 * (2 * THREADS_PER_WARP + 2));
+}
+
+TEST_F(ComputeCoreTestbench, WarpSchedulerTest) {
+    // Memory-bound kernel: while one warp waits on its loads the other one gets the core.
+    // Every cycle the picked warp and the ready ones come from the per-warp counters (picked: issue went up,
+    // ready: issue or idle went up) and the pick is checked against the rule of the built policy.
+    // Run it once per policy through schedulers.sh to compare their cycles
+    data_mem.clear();
+    data_mem[600] = 1000;
+    for (int tid = 0; tid < 2 * THREADS_PER_WARP; ++tid) {
+        data_mem[610 + tid] = 3 * tid;
+    }
+    const int num_warps = 2;
+    top->kernel_config[0] = num_warps;
+    loadProgramFromHex("../../assembler/tests/expected_output/coalesce.instr.hex");
+
+    auto stateIs = [](uint32_t state, const char* name) {
+        return std::string(WARP_STATE_NAMES[state]) == name;
+    };
+
+    top->start = 1;
+    tick();
+    top->start = 0;
+
+    int last_picked = 0; // current_warp starts at 0
+    int greedy = 0;
+    int picks = 0;
+    int cycles = 0;
+    for (; cycles < 15000 && !top->done; cycles++) {
+        uint32_t state[WARPS_PER_CORE], issue[WARPS_PER_CORE], idle[WARPS_PER_CORE];
+        for (int w = 0; w < WARPS_PER_CORE; ++w) {
+            state[w] = top->debug_warp_state[w];
+            issue[w] = top->warp_issue_cycles[w];
+            idle[w] = top->warp_idle_cycles[w];
+        }
+        runSimulation(1);
+
+        int picked = -1;
+        bool ready[WARPS_PER_CORE] = {};
+        for (int w = 0; w < WARPS_PER_CORE; ++w) {
+            if (top->warp_issue_cycles[w] != issue[w]) {
+                ASSERT_EQ(picked, -1) << "Two warps picked in cycle " << cycles;
+                picked = w;
+                ready[w] = true;
+            }
+            if (top->warp_idle_cycles[w] != idle[w]) ready[w] = true;
+        }
+        int any_ready = -1;
+        for (int w = num_warps - 1; w >= 0; --w) {
+            if (ready[w]) any_ready = w;
+        }
+
+        if (WARP_SCHEDULER == 0) {
+            // Loose round-robin: the first ready warp after the last one picked
+            int expected = -1;
+            for (int k = 1; k <= num_warps && expected == -1; ++k) {
+                if (ready[(last_picked + k) % num_warps]) expected = (last_picked + k) % num_warps;
+            }
+            ASSERT_EQ(picked, expected) << "Cycle " << cycles;
+        } else if (WARP_SCHEDULER == 1) {
+            // Greedy-then-oldest: the greedy warp whenever it is ready, the oldest (lowest) ready warp otherwise.
+            // The greedy warp only changes once it stalls, its own issue states do not count
+            ASSERT_EQ(picked, ready[greedy] ? greedy : any_ready) << "Cycle " << cycles << ", greedy warp " << greedy;
+            bool in_pipeline = stateIs(state[greedy], "DECODE") || stateIs(state[greedy], "REG_WAIT") ||
+                               stateIs(state[greedy], "EXECUTE") || stateIs(state[greedy], "INT_ALU_WAIT") ||
+                               stateIs(state[greedy], "UPDATE");
+            bool stalled = stateIs(state[greedy], "REQUEST") ? !ready[greedy] : !in_pipeline;
+            if (stalled && picked != -1) greedy = picked;
+        } else {
+            // Two-level: only warps of the active set are picked, a ready warp can wait outside of it
+            if (picked != -1) EXPECT_TRUE(ready[picked]);
+        }
+        if (picked != -1) {
+            last_picked = picked;
+            picks++;
+        }
+    }
+    ASSERT_TRUE(top->done) << "Core did not finish";
+
+    for (int tid = 0; tid < 2 * THREADS_PER_WARP; ++tid) {
+        EXPECT_EQ(data_mem[700 + tid], 1000 + 3 * tid) << "Wrong result for thread " << tid;
+    }
+
+    uint32_t total_issue = 0;
+    for (int w = 0; w < WARPS_PER_CORE; ++w) {
+        uint32_t issue = top->warp_issue_cycles[w];
+        uint32_t stall = top->warp_stall_cycles[w];
+        uint32_t idle = top->warp_idle_cycles[w];
+        std::cout << "WARP_SCHEDULER=" << WARP_SCHEDULER << " warp " << w << " issue: " << issue
+                  << " stall: " << stall << " idle: " << idle << std::endl;
+
+        if (w < num_warps) {
+            EXPECT_GT(issue, 0u) << "Warp " << w << " never issued";
+            EXPECT_LE(issue + stall + idle, (uint32_t)cycles + 2) << "Warp " << w << " counted more cycles than it ran";
+        } else {
+            EXPECT_EQ(issue + stall + idle, 0u);
+        }
+        total_issue += issue;
+    }
+    EXPECT_EQ(total_issue, uint32_t(picks));
+
+    // Picked up by schedulers.sh
+    std::cout << "SCHEDULER: policy=" << WARP_SCHEDULER << " cycles=" << cycles << " issued=" << total_issue << std::endl;
+}
+
+TEST_F(ComputeCoreTestbench, LatencyHidingTest) {
+    // The same ALU loop on every warp, then on one warp: the other warps issue while
+    // a warp waits on its ALU results and refetches after its taken branches
+    loadProgramFromHex("../../assembler/tests/expected_output/pipeline.instr.hex");
+
+    data_mem.clear();
+    top->kernel_config[0] = WARPS_PER_CORE;
+    loadAndRun(instr_mem);
+    const int all_warps_cycles = cycles_taken;
+
+    // Second run on the warm instruction cache, which only favours the single warp
+    top->reset = 1;
+    runSimulation(2);
+    top->reset = 0;
+    data_mem.clear();
+    top->kernel_config[0] = 1;
+    loadAndRun(instr_mem);
+    const int one_warp_cycles = cycles_taken;
+
+    for (int tid = 0; tid < THREADS_PER_WARP; ++tid) {
+        EXPECT_EQ(data_mem[500 + tid], 16 * (tid + 3)) << "ALU loop result wrong for thread " << tid;
+    }
+
+    // Bound taken from the warp state machine, not yet from a run: one warp spends 4 cycles on every ALU
+    // instruction (REQUEST, EXECUTE, INT_ALU_WAIT, UPDATE) and the scheduler can pick a warp every cycle, so
+    // 4 warps fill those cycles and ideally finish in the time of one. 2x leaves room for the shared fetch
+    // after the taken branches. Tighten it from the printed cycles of a Verilator run
+    std::cout << "Cycles, 1 warp: " << one_warp_cycles << " " << WARPS_PER_CORE << " warps: " << all_warps_cycles << std::endl;
+    EXPECT_LE(all_warps_cycles, 2 * one_warp_cycles) << "Warps do not overlap their ALU latency";
+}
+
+TEST_F(ComputeCoreTestbench, BroadcastLoadTest) {
+    data_mem.clear();
+    data_mem[600] = 1000;
+    data_mem[601] = float_to_bits(2.5f);
+
+    loadProgramFromHex("../../assembler/tests/expected_output/broadcast.instr.hex");
+    loadAndRun(instr_mem);
+
+    for (int tid = 0; tid < 2 * THREADS_PER_WARP; ++tid) {
+        EXPECT_EQ(data_mem[700 + tid], 1000 + tid) << "v.lw.u broadcast failed for thread " << tid;
+        EXPECT_FLOAT_EQ(bits_to_float(data_mem[750 + tid]), 2.5f) << "v.flw.u broadcast failed for thread " << tid;
+    }
+
+    // The uniform loads never reach the vector LSUs, only the two stores do
+    EXPECT_EQ(top->coalescer_lane_requests, 2 * 2 * THREADS_PER_WARP);
+}
+
+TEST_F(ComputeCoreTestbench, FusedMultiplyAddTest) {
+    // Inexact operands, so a separate fmul.s + fadd.s would round twice
+    const float a = 0.1f;
+    const float c = 3.0f;
+    data_mem.clear();
+    data_mem[600] = float_to_bits(a);
+    data_mem[601] = float_to_bits(c);
+    for (int tid = 0; tid < 2 * THREADS_PER_WARP; ++tid) {
+        data_mem[610 + tid] = float_to_bits(1.1f * (tid + 1));
+    }
+
+    loadProgramFromHex("../../assembler/tests/expected_output/fma.instr.hex");
+    loadAndRun(instr_mem);
+
+    for (int tid = 0; tid < 2 * THREADS_PER_WARP; ++tid) {
+        float x = 1.1f * (tid + 1);
+        EXPECT_EQ(data_mem[900 + tid], float_to_bits(std::fmaf(x, a, c))) << "v.fmadd.s not rounded once for thread " << tid;
+        EXPECT_EQ(data_mem[950 + tid], float_to_bits(std::fmaf(x, x, -c))) << "v.fmsub.s not rounded once for thread " << tid;
+    }
+    EXPECT_EQ(data_mem[1000], float_to_bits(std::fmaf(a, c, c))) << "s.fmadd.s failed";
+}
+
+TEST_F(ComputeCoreTestbench, DivideTest) {
+    // fdiv.s against a twin program with fmul.s in its place: same instructions and fetches,
+    // so the difference in cycles is what the divider adds
+    const float d = 3.0f;
+    data_mem.clear();
+    data_mem[600] = float_to_bits(d);
+    data_mem[601] = float_to_bits(1.0f);
+    data_mem[602] = float_to_bits(0.0f);
+    for (int tid = 0; tid < THREADS_PER_WARP; ++tid) {
+        data_mem[610 + tid] = float_to_bits(1.1f * (tid + 1));
+    }
+    top->kernel_config[0] = 1;
+
+    loadProgramFromHex("../../assembler/tests/expected_output/fdiv_ref.instr.hex");
+    loadAndRun(instr_mem);
+    const int multiply_cycles = cycles_taken;
+
+    top->reset = 1;
+    runSimulation(2);
+    top->reset = 0;
+    loadProgramFromHex("../../assembler/tests/expected_output/fdiv.instr.hex");
+    loadAndRun(instr_mem);
+    const int divide_cycles = cycles_taken;
+
+    // Correctly rounded, like the C division
+    for (int tid = 0; tid < THREADS_PER_WARP; ++tid) {
+        EXPECT_EQ(data_mem[900 + tid], float_to_bits(1.1f * (tid + 1) / d)) << "v.fdiv.s failed for thread " << tid;
+    }
+    float chain = 1.0f;
+    for (int i = 0; i < 8; ++i) {
+        chain = chain / d;
+    }
+    EXPECT_EQ(data_mem[1000], float_to_bits(chain)) << "s.fdiv.s chain failed";
+    EXPECT_EQ(data_mem[1001], float_to_bits(0.0f)) << "0 / x is not 0";
+    EXPECT_EQ(data_mem[1002], float_to_bits(INFINITY)) << "x / 0 is not infinity";
+
+    // Bound taken from floating_alu.sv, not yet from a run: an FDIV leaves Stage 2 for the divider and
+    // reaches Stage 3 after its 27 quotient bits and the done cycle, 28 cycles after an FMUL would. The warp
+    // waits for each of the 11 results, and ISA.md gives 32 cycles per division as the upper end.
+    // Tighten it from the printed cycles of a Verilator run
+    const int divisions = 11;
+    std::cout << "Cycles, fmul.s: " << multiply_cycles << " fdiv.s: " << divide_cycles << std::endl;
+    EXPECT_GE(divide_cycles - multiply_cycles, divisions * 28) << "FDIV returned before the divider finished";
+    EXPECT_LE(divide_cycles - multiply_cycles, divisions * 32) << "FDIV slower than ISA.md's 32 cycles";
+}
+
+TEST_F(ComputeCoreTestbench, DistanceInstructionsTest) {
+    const float c = 10.3f;
+    const float d = 0.7f;
+    data_mem.clear();
+    data_mem[600] = float_to_bits(c);
+    data_mem[601] = float_to_bits(d);
+    for (int tid = 0; tid < 2 * THREADS_PER_WARP; ++tid) {
+        data_mem[610 + tid] = float_to_bits(1.1f * (tid + 1));
+    }
+
+    loadProgramFromHex("../../assembler/tests/expected_output/distance.instr.hex");
+    loadAndRun(instr_mem);
+
+    // Same results as the fsub.s + fabs.s / fmul.s sequences they replace
+    for (int tid = 0; tid < 2 * THREADS_PER_WARP; ++tid) {
+        float diff = 1.1f * (tid + 1) - c;
+        EXPECT_EQ(data_mem[900 + tid], float_to_bits(std::fabs(diff))) << "v.fabsdiff.s failed for thread " << tid;
+        EXPECT_EQ(data_mem[950 + tid], float_to_bits(diff * diff)) << "v.fsqdiff.s failed for thread " << tid;
+    }
+    EXPECT_EQ(data_mem[1000], float_to_bits((c - d) * (c - d))) << "s.fsqdiff.s failed";
+    EXPECT_EQ(data_mem[1001], float_to_bits(std::fabs(d - c))) << "s.fabsdiff.s failed";
+}
+
+TEST_F(ComputeCoreTestbench, MinIndexTest) {
+    // Three candidates per thread, picked in order with v.fminidx.s
+    data_mem.clear();
+    for (int tid = 0; tid < 2 * THREADS_PER_WARP; ++tid) {
+        data_mem[610 + tid] = float_to_bits(float(tid % 3));
+        data_mem[650 + tid] = float_to_bits(float(tid % 5));
+        data_mem[690 + tid] = float_to_bits(1.5f);
+    }
+    data_mem[600] = float_to_bits(4.25f);
+    data_mem[601] = float_to_bits(-2.5f);
+
+    loadProgramFromHex("../../assembler/tests/expected_output/minidx.instr.hex");
+    loadAndRun(instr_mem);
+
+    for (int tid = 0; tid < 2 * THREADS_PER_WARP; ++tid) {
+        const float candidates[3] = {float(tid % 3), float(tid % 5), 1.5f};
+        int best = 0;
+        for (int k = 1; k < 3; ++k) {
+            if (candidates[k] < candidates[best]) best = k;
+        }
+        EXPECT_EQ(data_mem[900 + tid], float_to_bits(candidates[best])) << "v.fminidx.s value failed for thread " << tid;
+        EXPECT_EQ(data_mem[950 + tid], best) << "v.fminidx.s index failed for thread " << tid;
+    }
+    EXPECT_EQ(data_mem[1000], float_to_bits(-2.5f)) << "s.fminidx.s value failed";
+    EXPECT_EQ(data_mem[1001], 1) << "s.fminidx.s index failed";
+}
+
+TEST_F(ComputeCoreTestbench, PackedBf16Test) {
+    // Round to nearest even bfloat16 and back
+    auto to_bf16 = [](float f) -> uint32_t {
+        uint32_t bits = float_to_bits(f);
+        return (bits + 0x7FFF + ((bits >> 16) & 1)) >> 16;
+    };
+    auto from_bf16 = [](uint32_t h) { return bits_to_float(h << 16); };
+
+    // Every thread holds the (x, y) of a point and of a centroid as bfloat16 pairs
+    data_mem.clear();
+    for (int tid = 0; tid < 2 * THREADS_PER_WARP; ++tid) {
+        data_mem[610 + tid] = (to_bf16(0.75f * tid) << 16) | to_bf16(1.5f * tid + 0.3f);
+        data_mem[650 + tid] = (to_bf16(12.5f) << 16) | to_bf16(7.1f);
+    }
+    data_mem[600] = float_to_bits(3.14159f);
+    data_mem[601] = float_to_bits(-1234.5678f);
+
+    loadProgramFromHex("../../assembler/tests/expected_output/bf16.instr.hex");
+    loadAndRun(instr_mem);
+
+    for (int tid = 0; tid < 2 * THREADS_PER_WARP; ++tid) {
+        float d_lo = from_bf16(to_bf16(from_bf16(data_mem[610 + tid] & 0xFFFF) - from_bf16(data_mem[650 + tid] & 0xFFFF)));
+        float d_hi = from_bf16(to_bf16(from_bf16(data_mem[610 + tid] >> 16) - from_bf16(data_mem[650 + tid] >> 16)));
+        uint32_t sq_lo = to_bf16(d_lo * d_lo);
+        uint32_t sq_hi = to_bf16(d_hi * d_hi);
+
+        EXPECT_EQ(data_mem[900 + tid], (sq_hi << 16) | sq_lo) << "v.fsqdiff.bf2 failed for thread " << tid;
+        EXPECT_EQ(data_mem[950 + tid], float_to_bits(from_bf16(sq_lo) + from_bf16(sq_hi))) << "bf16 unpack failed for thread " << tid;
+    }
+
+    uint32_t packed = (to_bf16(-1234.5678f) << 16) | to_bf16(3.14159f);
+    EXPECT_EQ(data_mem[1000], packed) << "s.fcvt.bf2.s failed";
+    EXPECT_EQ(data_mem[1001], (to_bf16(2 * from_bf16(packed >> 16)) << 16) | to_bf16(2 * from_bf16(packed & 0xFFFF))) << "s.fadd.bf2 failed";
+}
+
+TEST_F(ComputeCoreTestbench, ScratchpadTest) {
+    // Every thread stores tid + 100 to shared word tid, then after the barrier
+    // reads its neighbour's word and word 0 back and stores them to global memory
+    data_mem.clear();
+
+    loadProgramFromHex("../../assembler/tests/expected_output/shared.instr.hex");
+    loadAndRun(instr_mem);
+
+    for (int tid = 0; tid < 2 * THREADS_PER_WARP; ++tid) {
+        if (tid < 2 * THREADS_PER_WARP - 1) {
+            EXPECT_EQ(data_mem[800 + tid], tid + 101) << "Shared neighbour read failed for thread " << tid;
+        }
+        EXPECT_EQ(data_mem[850 + tid], 100) << "Shared broadcast read failed for thread " << tid;
+    }
+
+    // The shared data never reaches the memory controller
+    for (int word = 0; word < 2 * THREADS_PER_WARP; ++word) {
+        EXPECT_EQ(data_mem.count(0x00100000 + 4 * word), 0);
+    }
+    EXPECT_EQ(top->coalescer_lane_requests, 2 * 2 * THREADS_PER_WARP);
+
+    // One store and two loads per thread, lanes of a warp hit different banks or the same word
+    EXPECT_EQ(top->scratchpad_accesses, 3 * 2 * THREADS_PER_WARP);
+    EXPECT_EQ(top->scratchpad_bank_conflicts, 0);
+}
+
 TEST_F(ComputeCoreTestbench, KMeansKernelVerification) {
     // ========================================================================
     // 1. SETUP: Load the compiled program and prepare the input data.
@@ -0,0 +1,18 @@
+#!/bin/bash
+
+# Tests of the host tools in tools/
+# Builds trace_diff and its test (tools/tests/trace_diff_test.cpp) into logs/tools and runs the test on the
+# fixture traces it writes to logs/tools/fixtures, then checks the C++ mirrors of common.svh
+# (tools/tests/perf_counters_test.cpp)
+# Usage: ./tools/test_tools.sh [gtest arguments]
+
+SCRIPT_DIR=$(dirname "$(realpath "$0")")
+cd "$SCRIPT_DIR/.." || exit
+
+mkdir -p logs/tools
+g++ -std=c++17 -O2 -o logs/tools/trace_diff tools/trace_diff.cpp || exit 2
+g++ -std=c++17 -O2 -o logs/tools/trace_diff_test tools/tests/trace_diff_test.cpp -lgtest -lpthread || exit 2
+g++ -std=c++17 -O2 -o logs/tools/perf_counters_test tools/tests/perf_counters_test.cpp -lgtest -lpthread || exit 2
+
+TRACE_DIFF=logs/tools/trace_diff ./logs/tools/trace_diff_test "$@" || exit 1
+./logs/tools/perf_counters_test "$@"
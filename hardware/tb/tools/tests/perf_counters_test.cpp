@@ -0,0 +1,95 @@
+// Checks the C++ mirrors of common.svh against it
+// > code/perf_counters.h: the word index of every perf_counter_t counter and NUM_WARP_STATES
+// > test/profiler.h: the names and the number of the warp_state_t states
+// The enums are read from $COMMON_SVH, ../rtl/lock_in/common.svh by default (test_tools.sh runs from hardware/tb)
+//
+// Build and run: ../test_tools.sh
+
+#include "../../../../code/perf_counters.h"
+#include "../../test/profiler.h"
+
+#include <gtest/gtest.h>
+
+#include <cstdlib>
+#include <fstream>
+#include <map>
+#include <regex>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#define COUNTER(name) {#name, name}
+
+class PerfCountersTest : public ::testing::Test {
+protected:
+    std::string svh;
+
+    void SetUp() override {
+        const char* path = std::getenv("COMMON_SVH");
+        std::ifstream file(path ? path : "../rtl/lock_in/common.svh");
+        ASSERT_TRUE(file.is_open()) << "Could not open common.svh";
+        std::stringstream ss;
+        ss << file.rdbuf();
+        svh = ss.str();
+    }
+
+    // Members of `typedef enum ... { ... } <type>;` in declaration order, comments dropped
+    std::vector<std::string> enumMembers(const std::string& type) {
+        std::vector<std::string> members;
+        size_t end = svh.find("} " + type + ";");
+        size_t begin = svh.rfind('{', end);
+        if (end == std::string::npos || begin == std::string::npos) return members;
+
+        std::string body = std::regex_replace(svh.substr(begin + 1, end - begin - 1), std::regex("//[^\n]*"), "");
+        std::regex member("[A-Za-z_][A-Za-z0-9_]*");
+        for (auto it = std::sregex_iterator(body.begin(), body.end(), member); it != std::sregex_iterator(); ++it) {
+            members.push_back(it->str());
+        }
+        return members;
+    }
+
+    int defineValue(const std::string& name) {
+        std::smatch match;
+        std::regex define("`define " + name + " ([0-9]+)");
+        return std::regex_search(svh, match, define) ? std::stoi(match[1]) : -1;
+    }
+};
+
+TEST_F(PerfCountersTest, CounterIndices) {
+    const std::map<std::string, int> indices = {
+        COUNTER(PERF_CYCLES), COUNTER(PERF_MEM_BUSY_CYCLES), COUNTER(PERF_BLOCKS),
+        COUNTER(PERF_INSTRUCTIONS_SCALAR), COUNTER(PERF_INSTRUCTIONS_VECTOR), COUNTER(PERF_INSTRUCTIONS_FPU),
+        COUNTER(PERF_INSTRUCTIONS_MEMORY), COUNTER(PERF_ACTIVE_LANES), COUNTER(PERF_LSU_WAIT_CYCLES),
+        COUNTER(PERF_ICACHE_HITS), COUNTER(PERF_ICACHE_MISSES), COUNTER(PERF_COALESCER_LANE_REQUESTS),
+        COUNTER(PERF_COALESCER_MEM_TRANSACTIONS), COUNTER(PERF_SCRATCHPAD_ACCESSES),
+        COUNTER(PERF_SCRATCHPAD_BANK_CONFLICTS), COUNTER(PERF_WARP_ISSUE_CYCLES), COUNTER(PERF_WARP_STALL_CYCLES),
+        COUNTER(PERF_WARP_IDLE_CYCLES), COUNTER(PERF_WARP_STATE_CYCLES),
+    };
+
+    std::vector<std::string> members = enumMembers("perf_counter_t");
+    ASSERT_FALSE(members.empty()) << "perf_counter_t not found";
+    EXPECT_EQ(members.size(), indices.size()) << "perf_counters.h and perf_counter_t have different counters";
+    for (size_t i = 0; i < members.size(); i++) {
+        auto it = indices.find(members[i]);
+        ASSERT_NE(it, indices.end()) << members[i] << " is missing from perf_counters.h";
+        EXPECT_EQ(it->second, int(i)) << members[i];
+    }
+
+    EXPECT_EQ(NUM_WARP_STATES, defineValue("NUM_WARP_STATES"));
+}
+
+TEST_F(PerfCountersTest, WarpStates) {
+    std::vector<std::string> members = enumMembers("warp_state_t");
+    ASSERT_EQ(int(members.size()), defineValue("NUM_WARP_STATES"));
+    ASSERT_EQ(int(members.size()), PROFILER_NUM_WARP_STATES);
+    for (size_t i = 0; i < members.size(); i++) {
+        EXPECT_EQ(members[i], "WARP_" + std::string(WARP_STATE_NAMES[i])) << "State " << i;
+    }
+    EXPECT_EQ(members[PROFILER_WARP_IDLE], "WARP_IDLE");
+    EXPECT_EQ(members[PROFILER_WARP_DONE], "WARP_DONE");
+}
+
+int main(int argc, char **argv) {
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
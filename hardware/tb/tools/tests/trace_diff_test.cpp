@@ -0,0 +1,136 @@
+// Tests of trace_diff on small fixture traces written with TraceWriter
+// > Every test writes trace A and trace B of two warps, runs the trace_diff binary on them and checks its exit
+//   code and report
+// > The binary is taken from $TRACE_DIFF, logs/tools/trace_diff by default (where test_tools.sh and trace.sh
+//   build it)
+//
+// Build and run: ../test_tools.sh
+
+#include "../trace_format.h"
+
+#include <gtest/gtest.h>
+#include <sys/wait.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <string>
+
+#define FIXTURE_FOLDER "logs/tools/fixtures"
+
+class TraceDiffTest : public ::testing::Test {
+protected:
+    struct Result {
+        int exit_code;
+        std::string output;
+    };
+
+    void SetUp() override {
+        std::system("mkdir -p " FIXTURE_FOLDER);
+        const char* binary = std::getenv("TRACE_DIFF");
+        trace_diff = binary ? binary : "logs/tools/trace_diff";
+    }
+
+    static std::string fixture(const std::string& name) {
+        return std::string(FIXTURE_FOLDER) + "/" + name;
+    }
+
+    // Two warps of block 0 on core 0, four instructions each at pc 0..3, one retire every `step` cycles.
+    // Warp 1 retires `slow_pc` another `delay` cycles late, and writes `rd_offset` more into rd at pc 2
+    static void writeKernel(const std::string& path, uint32_t step = 2, uint32_t slow_pc = 0, uint32_t delay = 0,
+                            uint32_t rd_offset = 0, int warps = 2) {
+        TraceWriter writer(path);
+        ASSERT_TRUE(writer.isOpen()) << path;
+        for (int warp = 0; warp < warps; warp++) {
+            uint32_t cycle = 10 + warp;
+            for (uint32_t pc = 0; pc < 4; pc++) {
+                cycle += step + (pc == slow_pc ? delay : 0);
+                uint32_t flags = pc == 3 ? TRACE_FLAG_HALT : TRACE_FLAG_WRITE_RD;
+                uint32_t rd_value = 0x100 * pc + warp + (warp == 1 && pc == 2 ? rd_offset : 0);
+                writer.retire(cycle, 0, warp, flags, 0, pc, 0xFFFF, rd_value);
+            }
+        }
+    }
+
+    Result run(const std::string& a, const std::string& b, const std::string& extra = "") {
+        std::string command = trace_diff + " " + a + " " + b + " " + extra + " 2>&1";
+        Result result{-1, ""};
+        FILE* pipe = popen(command.c_str(), "r");
+        if (!pipe) return result;
+        char buffer[256];
+        while (std::fgets(buffer, sizeof(buffer), pipe)) {
+            result.output += buffer;
+        }
+        int status = pclose(pipe);
+        result.exit_code = WIFEXITED(status) ? WEXITSTATUS(status) : -1;
+        return result;
+    }
+
+    std::string trace_diff;
+};
+
+TEST_F(TraceDiffTest, SameTraces) {
+    writeKernel(fixture("same_a.bin"));
+    writeKernel(fixture("same_b.bin"));
+
+    Result result = run(fixture("same_a.bin"), fixture("same_b.bin"));
+    EXPECT_EQ(result.exit_code, 0) << result.output;
+    EXPECT_NE(result.output.find("8 instructions, 2 warps"), std::string::npos) << result.output;
+    EXPECT_NE(result.output.find("Same behaviour"), std::string::npos) << result.output;
+}
+
+TEST_F(TraceDiffTest, DifferentResult) {
+    writeKernel(fixture("result_a.bin"));
+    writeKernel(fixture("result_b.bin"), 2, 0, 0, 1);
+
+    Result result = run(fixture("result_a.bin"), fixture("result_b.bin"));
+    EXPECT_EQ(result.exit_code, 1) << result.output;
+    EXPECT_NE(result.output.find("First divergence: block 0 warp 1, instruction 2"), std::string::npos) << result.output;
+    EXPECT_NE(result.output.find("rd=0x00000201"), std::string::npos) << result.output;
+    EXPECT_NE(result.output.find("rd=0x00000202"), std::string::npos) << result.output;
+}
+
+TEST_F(TraceDiffTest, MissingWarp) {
+    writeKernel(fixture("warp_a.bin"));
+    writeKernel(fixture("warp_b.bin"), 2, 0, 0, 0, 1);
+
+    Result result = run(fixture("warp_a.bin"), fixture("warp_b.bin"));
+    EXPECT_EQ(result.exit_code, 1) << result.output;
+    EXPECT_NE(result.output.find("block 0 warp 1: only in A"), std::string::npos) << result.output;
+}
+
+// Same behaviour, B spends 5 more cycles on pc 2 in both warps: only that region moves
+TEST_F(TraceDiffTest, SlowerRegion) {
+    writeKernel(fixture("slow_a.bin"));
+    writeKernel(fixture("slow_b.bin"), 2, 2, 5);
+
+    Result result = run(fixture("slow_a.bin"), fixture("slow_b.bin"));
+    EXPECT_EQ(result.exit_code, 0) << result.output;
+    EXPECT_NE(result.output.find("pc 0x0002                      4          14         +10"), std::string::npos)
+        << result.output;
+    EXPECT_NE(result.output.find("pc 0x0001                      4           4          +0"), std::string::npos)
+        << result.output;
+
+    // Through a line map: pc 1 and 2 are C line 7, pc 3 has no C line
+    std::ofstream lines(fixture("slow.lines"));
+    lines << "0 1 0\n1 2 7\n2 3 7\n3 4 0\n";
+    lines.close();
+    result = run(fixture("slow_a.bin"), fixture("slow_b.bin"), "--lines " + fixture("slow.lines"));
+    EXPECT_EQ(result.exit_code, 0) << result.output;
+    EXPECT_NE(result.output.find("c line 7                       8          18         +10"), std::string::npos)
+        << result.output;
+    EXPECT_NE(result.output.find("asm line 4"), std::string::npos) << result.output;
+}
+
+TEST_F(TraceDiffTest, BadArguments) {
+    writeKernel(fixture("args_a.bin"));
+
+    EXPECT_EQ(run(fixture("args_a.bin"), fixture("does_not_exist.bin")).exit_code, 2);
+    EXPECT_EQ(run(fixture("args_a.bin"), fixture("args_a.bin"), "--frobnicate").exit_code, 2);
+    EXPECT_EQ(run(fixture("args_a.bin"), fixture("args_a.bin"), "--lines " + fixture("does_not_exist.lines")).exit_code, 2);
+}
+
+int main(int argc, char **argv) {
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,211 @@
+// Compares two retire traces (trace_format.h), e.g. the RTL before and after a scheduler change or the RTL
+// against a software model
+// > The records are split into one stream per (block, warp), which stays comparable when the blocks land on
+//   other cores or the warps are scheduled in another order
+// > Reports the first divergence (pc, execution mask, flags or rd value), earliest in cycles of the first trace
+// > Charges every instruction the cycles since the previous retire of its stream and compares the totals per
+//   region: PC by default, source line with --lines <kernel.lines> (C line when there is one, asm line otherwise)
+//
+// Build: g++ -std=c++17 -O2 -o trace_diff trace_diff.cpp (trace.sh and test_tools.sh build it into logs/tools)
+// Tests: ./test_tools.sh, on the fixture traces of tests/trace_diff_test.cpp
+// Usage: ./trace_diff <a.bin> <b.bin> [--lines <kernel.lines>] [--top <n>]
+// Exit code: 0 same behaviour, 1 diverged, 2 bad arguments or unreadable traces
+
+#include "trace_format.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace std;
+
+using StreamKey = pair<uint32_t, uint32_t>; // (block, warp)
+using Streams = map<StreamKey, vector<TraceRecord>>;
+
+struct LineInfo {
+    int asm_line;
+    int c_line;
+};
+
+static Streams splitStreams(const vector<TraceRecord>& records) {
+    Streams streams;
+    for (const TraceRecord& record : records) {
+        streams[{record.block, record.warp()}].push_back(record);
+    }
+    // A warp only retires in order, the sort just guards against cores flushing out of order
+    for (auto& [key, stream] : streams) {
+        stable_sort(stream.begin(), stream.end(),
+                    [](const TraceRecord& a, const TraceRecord& b) { return a.cycle < b.cycle; });
+    }
+    return streams;
+}
+
+static bool sameBehaviour(const TraceRecord& a, const TraceRecord& b) {
+    return a.pc == b.pc && a.mask == b.mask && a.flags() == b.flags() && a.rd_value == b.rd_value;
+}
+
+static string describe(const TraceRecord& record) {
+    ostringstream text;
+    text << "pc=0x" << hex << setw(4) << setfill('0') << record.pc << " mask=0x" << setw(4) << record.mask
+         << " flags=" << dec << record.flags() << " rd=0x" << hex << setw(8) << record.rd_value << dec
+         << " (cycle " << record.cycle << ", core " << record.core() << ")";
+    return text.str();
+}
+
+static string regionName(uint32_t pc, const map<uint32_t, LineInfo>& lines) {
+    auto it = lines.find(pc);
+    if (it == lines.end()) {
+        ostringstream text;
+        text << "pc 0x" << hex << setw(4) << setfill('0') << pc;
+        return text.str();
+    }
+    if (it->second.c_line > 0) return "c line " + to_string(it->second.c_line);
+    return "asm line " + to_string(it->second.asm_line);
+}
+
+// Cycles since the previous retire of the same stream, the first instruction of a stream is charged nothing
+static map<string, uint64_t> regionCycles(const Streams& streams, const map<uint32_t, LineInfo>& lines) {
+    map<string, uint64_t> cycles;
+    for (const auto& [key, stream] : streams) {
+        for (size_t i = 1; i < stream.size(); i++) {
+            cycles[regionName(stream[i].pc, lines)] += stream[i].cycle - stream[i - 1].cycle;
+        }
+    }
+    return cycles;
+}
+
+static uint64_t span(const vector<TraceRecord>& records) {
+    if (records.empty()) return 0;
+    uint32_t first = records.front().cycle, last = records.front().cycle;
+    for (const TraceRecord& record : records) {
+        first = min(first, record.cycle);
+        last = max(last, record.cycle);
+    }
+    return last - first;
+}
+
+int main(int argc, char** argv) {
+    if (argc < 3) {
+        cerr << "Usage: " << argv[0] << " <a.bin> <b.bin> [--lines <kernel.lines>] [--top <n>]" << endl;
+        return 2;
+    }
+
+    string lines_path;
+    size_t top = 10;
+    for (int i = 3; i < argc; i++) {
+        string arg = argv[i];
+        if (arg == "--lines" && i + 1 < argc) {
+            lines_path = argv[++i];
+        } else if (arg == "--top" && i + 1 < argc) {
+            top = strtoul(argv[++i], nullptr, 10);
+        } else {
+            cerr << "Unknown argument: " << arg << endl;
+            return 2;
+        }
+    }
+
+    vector<TraceRecord> trace_a, trace_b;
+    if (!readTrace(argv[1], trace_a)) { cerr << "Error: Could not open trace: " << argv[1] << endl; return 2; }
+    if (!readTrace(argv[2], trace_b)) { cerr << "Error: Could not open trace: " << argv[2] << endl; return 2; }
+
+    map<uint32_t, LineInfo> lines;
+    if (!lines_path.empty()) {
+        ifstream file(lines_path);
+        if (!file.is_open()) { cerr << "Error: Could not open line map: " << lines_path << endl; return 2; }
+        uint32_t pc;
+        int asm_line, c_line;
+        while (file >> pc >> asm_line >> c_line) {
+            lines[pc] = {asm_line, c_line};
+        }
+    }
+
+    Streams streams_a = splitStreams(trace_a);
+    Streams streams_b = splitStreams(trace_b);
+
+    cout << "A: " << argv[1] << ": " << trace_a.size() << " instructions, " << streams_a.size()
+         << " warps, " << span(trace_a) << " cycles" << endl;
+    cout << "B: " << argv[2] << ": " << trace_b.size() << " instructions, " << streams_b.size()
+         << " warps, " << span(trace_b) << " cycles" << endl;
+
+    // --- Behaviour ---
+    bool diverged = false;
+    uint32_t divergence_cycle = 0;
+    string divergence;
+
+    auto report = [&](uint32_t cycle, const string& text) {
+        if (!diverged || cycle < divergence_cycle) {
+            diverged = true;
+            divergence_cycle = cycle;
+            divergence = text;
+        }
+    };
+
+    for (const auto& [key, stream_a] : streams_a) {
+        ostringstream where;
+        where << "block " << key.first << " warp " << key.second;
+
+        auto it = streams_b.find(key);
+        if (it == streams_b.end()) {
+            report(stream_a.front().cycle, where.str() + ": only in A");
+            continue;
+        }
+        const vector<TraceRecord>& stream_b = it->second;
+
+        size_t common = min(stream_a.size(), stream_b.size());
+        size_t i = 0;
+        while (i < common && sameBehaviour(stream_a[i], stream_b[i])) i++;
+
+        if (i < common) {
+            report(stream_a[i].cycle, where.str() + ", instruction " + to_string(i) + "\n  A: " +
+                   describe(stream_a[i]) + "\n  B: " + describe(stream_b[i]));
+        } else if (stream_a.size() != stream_b.size()) {
+            const TraceRecord& last = stream_a.size() > stream_b.size() ? stream_a[i] : stream_a.back();
+            report(last.cycle, where.str() + ": A retires " + to_string(stream_a.size()) + " instructions, B " +
+                   to_string(stream_b.size()));
+        }
+    }
+    for (const auto& [key, stream_b] : streams_b) {
+        if (!streams_a.count(key)) {
+            report(stream_b.front().cycle, "block " + to_string(key.first) + " warp " + to_string(key.second) +
+                   ": only in B");
+        }
+    }
+
+    if (diverged) {
+        cout << "\nFirst divergence: " << divergence << endl;
+    } else {
+        cout << "\nSame behaviour: every warp retires the same instructions with the same results" << endl;
+    }
+
+    // --- Cycles ---
+    map<string, uint64_t> cycles_a = regionCycles(streams_a, lines);
+    map<string, uint64_t> cycles_b = regionCycles(streams_b, lines);
+
+    vector<pair<string, int64_t>> deltas;
+    for (const auto& [region, cycles] : cycles_a) {
+        deltas.push_back({region, int64_t(cycles_b[region]) - int64_t(cycles)});
+    }
+    for (const auto& [region, cycles] : cycles_b) {
+        if (!cycles_a.count(region)) deltas.push_back({region, int64_t(cycles)});
+    }
+    sort(deltas.begin(), deltas.end(), [](const auto& a, const auto& b) {
+        return llabs(a.second) > llabs(b.second) || (llabs(a.second) == llabs(b.second) && a.first < b.first);
+    });
+
+    cout << "\nCycles per region (B - A), largest changes first:" << endl;
+    cout << "  " << left << setw(20) << "region" << right << setw(12) << "A" << setw(12) << "B" << setw(12) << "delta" << endl;
+    for (size_t i = 0; i < deltas.size() && i < top; i++) {
+        const string& region = deltas[i].first;
+        cout << "  " << left << setw(20) << region << right << setw(12) << cycles_a[region] << setw(12)
+             << cycles_b[region] << setw(12) << showpos << deltas[i].second << noshowpos << endl;
+    }
+
+    return diverged ? 1 : 0;
+}
@@ -0,0 +1,88 @@
+#pragma once
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+// RETIRE TRACE FORMAT
+// > One fixed size record per retired instruction, six little endian 32-bit words, no header
+// > Written by the RTL (gpu.sv / compute_core.sv built with +define+TRACE_RETIRE, run with +trace=<file>) and by
+//   software models of the core through TraceWriter, so both sides can be compared with trace_diff
+// > Records of one (block, warp) pair are in retire order, the cores' records are interleaved by cycle
+// > rd_value is the value written to rd (0 when nothing is written), vector instructions fold their enabled
+//   lanes with foldLanes() so a record stays one word wide whatever the warp size
+
+#define TRACE_FLAG_SCALAR   (1u << 0) // Scalar instruction
+#define TRACE_FLAG_WRITE_RD (1u << 1) // Writes rd, rd_value is valid
+#define TRACE_FLAG_HALT     (1u << 2) // exit
+
+struct TraceRecord {
+    uint32_t cycle;
+    uint32_t core_warp_flags; // [31:16] core, [15:8] warp, [7:0] flags
+    uint32_t block;
+    uint32_t pc;
+    uint32_t mask;
+    uint32_t rd_value;
+
+    uint32_t core() const { return core_warp_flags >> 16; }
+    uint32_t warp() const { return (core_warp_flags >> 8) & 0xFF; }
+    uint32_t flags() const { return core_warp_flags & 0xFF; }
+};
+static_assert(sizeof(TraceRecord) == 24, "Trace records are six 32-bit words");
+
+// Same fold as the RTL: every enabled lane's value rotated left by its lane index, xored together
+static inline uint32_t foldLanes(const uint32_t* values, uint32_t mask, int lanes) {
+    uint32_t folded = 0;
+    for (int i = 0; i < lanes; i++) {
+        if ((mask >> i) & 1) {
+            folded ^= (values[i] << i) | (values[i] >> ((32 - i) % 32));
+        }
+    }
+    return folded;
+}
+
+static inline bool readTrace(const std::string& path, std::vector<TraceRecord>& records) {
+    FILE* file = std::fopen(path.c_str(), "rb");
+    if (!file) return false;
+
+    uint8_t bytes[sizeof(TraceRecord)];
+    while (std::fread(bytes, 1, sizeof(bytes), file) == sizeof(bytes)) {
+        uint32_t words[6];
+        for (int w = 0; w < 6; w++) {
+            words[w] = uint32_t(bytes[4 * w]) | uint32_t(bytes[4 * w + 1]) << 8 |
+                       uint32_t(bytes[4 * w + 2]) << 16 | uint32_t(bytes[4 * w + 3]) << 24;
+        }
+        records.push_back({words[0], words[1], words[2], words[3], words[4], words[5]});
+    }
+    std::fclose(file);
+    return true;
+}
+
+// For software models, writes records in the same layout as the RTL
+class TraceWriter {
+public:
+    explicit TraceWriter(const std::string& path) : file(std::fopen(path.c_str(), "wb")) {}
+    ~TraceWriter() { if (file) std::fclose(file); }
+    TraceWriter(const TraceWriter&) = delete;
+    TraceWriter& operator=(const TraceWriter&) = delete;
+
+    bool isOpen() const { return file != nullptr; }
+
+    void retire(uint32_t cycle, uint32_t core, uint32_t warp, uint32_t flags, uint32_t block,
+                uint32_t pc, uint32_t mask, uint32_t rd_value) {
+        if (!file) return;
+        uint32_t words[6] = {cycle, (core & 0xFFFF) << 16 | (warp & 0xFF) << 8 | (flags & 0xFF), block, pc, mask,
+                             (flags & TRACE_FLAG_WRITE_RD) ? rd_value : 0};
+        uint8_t bytes[sizeof(TraceRecord)];
+        for (int w = 0; w < 6; w++) {
+            for (int b = 0; b < 4; b++) {
+                bytes[4 * w + b] = uint8_t(words[w] >> (8 * b));
+            }
+        }
+        std::fwrite(bytes, 1, sizeof(bytes), file);
+    }
+
+private:
+    FILE* file;
+};
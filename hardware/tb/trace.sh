@@ -0,0 +1,45 @@
+#!/bin/bash
+
+# Retire trace diff
+# Builds the GPU testbench (test/gpu-scaling_tb.cpp) twice with the retire trace enabled, once per set of
+# Verilator flags, runs the same test on both and compares the traces with tools/trace_diff.cpp: the first
+# divergence shows whether the change is behaviour preserving, the per-region deltas where the cycles went.
+# Usage: ./trace.sh "<verilator flags A>" "<verilator flags B>" [gtest filter] [line map]
+#   e.g. ./trace.sh "-GWARP_SCHEDULER=0 -CFLAGS -DWARP_SCHEDULER=0" "-GWARP_SCHEDULER=1 -CFLAGS -DWARP_SCHEDULER=1" \
+#                   GpuKernelTestbench.KMeansAssignScaling ../../assembler/tests/expected_output/kmeans_assign.lines
+
+SCRIPT_DIR=$(dirname "$(realpath "$0")")
+cd "$SCRIPT_DIR" || exit
+
+if [[ $# -lt 2 ]]; then
+    echo "Usage: $0 \"<verilator flags A>\" \"<verilator flags B>\" [gtest filter] [line map]"
+    exit 2
+fi
+
+flags_a=$1
+flags_b=$2
+filter=${3:-GpuKernelTestbench.KMeansAssignScaling}
+line_map=$4
+
+# Built next to the logs, the source folder only holds sources
+mkdir -p logs/tools
+g++ -std=c++17 -O2 -o logs/tools/trace_diff tools/trace_diff.cpp || exit 2
+
+for side in a b; do
+    if [[ $side == a ]]; then flags=$flags_a; else flags=$flags_b; fi
+    VERILATOR_FLAGS="+define+TRACE_RETIRE ${flags}" \
+    SIM_ARGS="+trace=logs/trace_${side}.bin --gtest_filter=${filter}" \
+        ./doit.sh test/gpu-scaling_tb.cpp > "logs/trace_${side}.log"
+
+    if [[ ! -s logs/trace_${side}.bin ]]; then
+        tail -n 20 "logs/trace_${side}.log"
+        echo "No trace written for: ${flags}"
+        exit 2
+    fi
+done
+
+if [[ -n "$line_map" ]]; then
+    ./logs/tools/trace_diff logs/trace_a.bin logs/trace_b.bin --lines "$line_map"
+else
+    ./logs/tools/trace_diff logs/trace_a.bin logs/trace_b.bin
+fi
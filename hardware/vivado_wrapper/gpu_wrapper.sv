@@ -45,6 +45,20 @@ module gpu_wrapper (
     logic [DATA_MEM_NUM_CHANNELS_PARAM-1:0]   dmem_write_ready_in = '1; // Always ready
     logic [`DATA_WIDTH-1:0]                   dmem_read_data_in   [DATA_MEM_NUM_CHANNELS_PARAM]; // Data can be X
 
+    // --- Command Queue (only the legacy execution_start launch is used) ---
+    logic                                     queue_push_in = 1'b0;
+    logic [`LAUNCH_FLAG_WIDTH-1:0]            queue_push_flags_in = '0;
+
+    // --- DMA Engine (DDR and its data memory port tied off like the memories above) ---
+    logic                                     dma_start_in = 1'b0;
+    logic [31:0]                              dma_descriptor_in = 32'd0;
+    logic                                     ddr_read_ready_in = 1'b1;
+    logic                                     ddr_write_ready_in = 1'b1;
+    logic [`DATA_WIDTH-1:0]                   ddr_read_data_in;
+    logic                                     dma_mem_read_ready_in = 1'b1;
+    logic                                     dma_mem_write_ready_in = 1'b1;
+    logic [`DATA_WIDTH-1:0]                   dma_mem_read_data_in;
+
     (* dont_touch = "true" *)
     gpu #(
         .DATA_MEM_NUM_CHANNELS      (DATA_MEM_NUM_CHANNELS_PARAM),
@@ -64,6 +78,35 @@ module gpu_wrapper (
         .execution_start            (execution_start_in),
         .execution_done             (execution_done_internal),
 
+        // --- Command Queue ---
+        .queue_push                 (queue_push_in),
+        .queue_push_flags           (queue_push_flags_in),
+        .queue_resume               (1'b0),
+        .queue_interrupt_clear      (1'b0),
+        .queue_full                 (),
+        .queue_busy                 (),
+        .queue_fenced               (),
+        .queue_interrupt            (),
+        .queue_count                (),
+        .queue_completed            (),
+
+        // --- Performance Counters ---
+        .perf_read_address          ('0),
+        .perf_read_data             (),
+
+        // --- DMA Engine ---
+        .dma_start                  (dma_start_in),
+        .dma_descriptor_address     (dma_descriptor_in),
+        .dma_busy                   (),
+        .dma_done                   (),
+        .dma_completed_descriptors  (),
+        .dma_transferred_words      (),
+
+        // --- Warp Trace (simulation only) ---
+        .debug_warp_state           (),
+        .debug_warp_pc              (),
+        .debug_warp_execution_mask  (),
+
         // --- Instruction Memory Interface ---
         .instruction_mem_read_valid   (imem_read_valid_out),
         .instruction_mem_read_address (imem_read_address_out),
@@ -78,7 +121,27 @@ module gpu_wrapper (
         .data_mem_write_valid       (dmem_write_valid_out),
         .data_mem_write_address     (dmem_write_address_out),
         .data_mem_write_data        (dmem_write_data_out),
-        .data_mem_write_ready       (dmem_write_ready_in)
+        .data_mem_write_ready       (dmem_write_ready_in),
+
+        // --- DDR ---
+        .ddr_read_valid             (),
+        .ddr_read_address           (),
+        .ddr_read_ready             (ddr_read_ready_in),
+        .ddr_read_data              (ddr_read_data_in),
+        .ddr_write_valid            (),
+        .ddr_write_address          (),
+        .ddr_write_data             (),
+        .ddr_write_ready            (ddr_write_ready_in),
+
+        // --- DMA Data Memory Port ---
+        .dma_mem_read_valid         (),
+        .dma_mem_read_address       (),
+        .dma_mem_read_ready         (dma_mem_read_ready_in),
+        .dma_mem_read_data          (dma_mem_read_data_in),
+        .dma_mem_write_valid        (),
+        .dma_mem_write_address      (),
+        .dma_mem_write_data         (),
+        .dma_mem_write_ready        (dma_mem_write_ready_in)
     );
 
     assign gpu_done_led = execution_done_internal;